@@ -1,8 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <exception>
 #include <string>
 
+#include "Vypr/Scanner/SourceManager.hpp"
+
 namespace Vypr
 {
   enum class CompileErrorId
@@ -15,24 +18,42 @@ namespace Vypr
     InvalidOperands,
     ConstantTooLarge,
     UnimplementedFeature,
-    InvalidCast
+    InvalidCast,
+    InvalidToken
   };
 
   class CompileError : std::exception
   {
   public:
-    CompileError(CompileErrorId id, size_t line, size_t column,
-                 std::wstring content = L"");
+    CompileError(CompileErrorId id, uint32_t offset, std::string content = "");
+
+    /// @brief Resolves `offset` to a line and column and includes them in the
+    /// message. Errors only carry an offset until they are reported so the
+    /// line table is never built for a successful compile.
+    ///
+    /// @param sourceManager Source manager of the file the error occurred in.
+    void SetLocation(const SourceManager &sourceManager);
 
     const char *what() const noexcept override;
 
     CompileErrorId id;
+
+    /// @brief Byte offset in the source where the error occurred.
+    uint32_t offset;
+
+    /// @brief 1-indexed line of the error or 0 until `SetLocation` is called.
     size_t line;
+
+    /// @brief 1-indexed column of the error or 0 until `SetLocation` is
+    /// called.
     size_t column;
-    std::wstring description;
+
+    std::string description;
 
   private:
-    static std::wstring GetCompileErrorMessage(CompileErrorId);
+    static std::string GetCompileErrorMessage(CompileErrorId);
+
+    void BuildMessage();
 
     std::string m_message;
   };
@@ -12,10 +12,9 @@ namespace Vypr
   {
   public:
     BinaryOpNode(BinaryOp op, std::unique_ptr<ExpressionNode> &&lhs,
-                 std::unique_ptr<ExpressionNode> &&rhs, size_t column,
-                 size_t line);
+                 std::unique_ptr<ExpressionNode> &&rhs, uint32_t offset);
 
-    std::wstring PrettyPrint(int level) const override;
+    std::string PrettyPrint(int level) const override;
 
     static std::unique_ptr<ExpressionNode> Parse(
         std::unique_ptr<ExpressionNode> &base, CLangLexer &lexer,
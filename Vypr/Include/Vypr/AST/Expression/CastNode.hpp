@@ -18,7 +18,7 @@ namespace Vypr
     /// @brief Print the AST tree for the cast node.
     /// @param level Indentation level of the current tree position.
     /// @return String containing the remaining sub-tree starting at this node.
-    std::wstring PrettyPrint(int level) const override;
+    std::string PrettyPrint(int level) const override;
 
     /// @brief Generate IR tree based on the sub-tree starting at this node.
     /// @param context Current compilation context.
@@ -2,9 +2,11 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 #include <variant>
 
 #include "Vypr/AST/Expression/ExpressionNode.hpp"
+#include "Vypr/Lexer/NumericLiteral.hpp"
 
 namespace Vypr
 {
@@ -24,19 +26,16 @@ namespace Vypr
     ///
     /// @param type Type of the constant being stored.
     /// @param value Value of the constant being stored.
-    /// @param column Column in the source file where the constant
+    /// @param offset Byte offset in the source file where the constant
     /// starts.
-    ///
-    /// @param line Line in the source file where the
-    /// constant starts.
     ConstantNode(std::unique_ptr<StorageType> &&type, ConstantValue value,
-                 size_t column, size_t line);
+                 uint32_t offset);
 
     /// @brief Print information about the constant.
     ///
     /// @param level Indentation level.
     /// @returns String containing information about the constant.
-    std::wstring PrettyPrint(int level) const override;
+    std::string PrettyPrint(int level) const override;
 
     /// @brief Generate temporary variable for this constant in IR structure.
     ///
@@ -45,8 +44,8 @@ namespace Vypr
     /// structure.
     llvm::Value *GenerateCode(Context &context) const override;
 
-    /// @brief Parse the constant from the lexer and convert any numerics to
-    /// their bit representations.
+    /// @brief Parse the constant from the lexer and select the type of any
+    /// numeric constant from the value the lexer converted.
     ///
     /// @param lexer Lexer with a constant token on the front.
     /// @returns Constant node that was constructed.
@@ -54,10 +53,10 @@ namespace Vypr
 
   private:
     static std::unique_ptr<ConstantNode> ParseIntegerConstant(
-        const CLangToken &token);
+        const NumericLiteral &number, uint32_t offset);
 
     static std::unique_ptr<ConstantNode> ParseFloatConstant(
-        const CLangToken &token);
+        const NumericLiteral &number, uint32_t offset);
 
     static std::unique_ptr<ConstantNode> ParseStringLiteral(
         const CLangToken &token, CLangLexer &lexer);
@@ -13,19 +13,19 @@ namespace Vypr
   public:
     ExpressionNode();
 
-    ExpressionNode(std::unique_ptr<StorageType> &&type, size_t column,
-                   size_t line);
+    ExpressionNode(std::unique_ptr<StorageType> &&type, uint32_t offset);
 
     static std::unique_ptr<ExpressionNode> Parse(CLangLexer &lexer,
                                                  TypeTable &symbolTable,
                                                  int precedenceLevel = 15);
 
-    virtual std::wstring PrettyPrint(int level) const;
+    virtual std::string PrettyPrint(int level) const;
 
     virtual llvm::Value *GenerateCode(Context &context) const;
 
     std::unique_ptr<StorageType> type;
-    size_t column;
-    size_t line;
+
+    /// @brief Byte offset in the source where the expression starts.
+    uint32_t offset;
   };
 } // namespace Vypr
\ No newline at end of file
@@ -11,9 +11,9 @@ namespace Vypr
   {
   public:
     PostfixOpNode(PostfixOp op, std::unique_ptr<ExpressionNode> &&expression,
-                  size_t column, size_t line);
+                  uint32_t offset);
 
-    std::wstring PrettyPrint(int level) const override;
+    std::string PrettyPrint(int level) const override;
 
   private:
     PostfixOp m_op;
@@ -12,9 +12,9 @@ namespace Vypr
   {
   public:
     UnaryOpNode(UnaryOp op, std::unique_ptr<ExpressionNode> &&expression,
-                size_t column, size_t line);
+                uint32_t offset);
 
-    std::wstring PrettyPrint(int level) const override;
+    std::string PrettyPrint(int level) const override;
 
     static std::unique_ptr<ExpressionNode> Parse(CLangLexer &lexer,
                                                  TypeTable &symbolTable);
@@ -15,17 +15,19 @@ namespace Vypr
     /// `symbolTable`.
     ///
     /// @param type Type of the symbol.
-    /// @param symbol Name of the symbol.
-    /// @param column Column in the source file where the symble name starts.
-    /// @param line Line in the source file where the symbol name starts.
-    VariableNode(std::unique_ptr<StorageType> &&type, std::wstring symbol,
-                 size_t column, size_t line);
+    /// @param symbol Interned name of the symbol.
+    /// @param name Name of the symbol. The view must outlive the node, which
+    /// views from an `IdentifierTable` do.
+    /// @param offset Byte offset in the source file where the symbol name
+    /// starts.
+    VariableNode(std::unique_ptr<StorageType> &&type, Identifier symbol,
+                 std::string_view name, uint32_t offset);
 
     /// @brief Print information about the variable.
     ///
     /// @param level Indentation level.
     /// @returns String containing information about the variable.
-    std::wstring PrettyPrint(int level) const override;
+    std::string PrettyPrint(int level) const override;
 
     /// @brief Generate a temporary variable for the symbol and its
     /// location in IR structure.
@@ -47,6 +49,7 @@ namespace Vypr
                                                TypeTable &symbolTable);
 
   private:
-    std::wstring m_symbol;
+    Identifier m_symbol;
+    std::string_view m_name;
   };
 } // namespace Vypr
\ No newline at end of file
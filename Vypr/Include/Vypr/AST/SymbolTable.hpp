@@ -1,11 +1,16 @@
 #pragma once
 
-#include <string>
+#include <memory>
 #include <unordered_map>
 #include <vector>
 
+#include "Vypr/Lexer/IdentifierTable.hpp"
+
 namespace Vypr
 {
+  /// @brief Scoped map from interned identifiers to symbol information. Keys
+  /// are the integer identifiers of an `IdentifierTable`, so lookups never
+  /// hash or compare names.
   template <typename T> class SymbolTable
   {
   public:
@@ -15,14 +20,18 @@ namespace Vypr
 
     void PopScope();
 
-    bool IsDuplicate(const std::wstring &symbol) const;
+    bool IsDuplicate(Identifier symbol) const;
+
+    void AddSymbol(Identifier symbol, T type);
 
-    void AddSymbol(const std::wstring &symbol, T type);
+    T GetSymbol(Identifier symbol) const;
 
-    T GetSymbol(const std::wstring &symbol) const;
+    /// @returns Symbols of the outermost scope, which every other scope is
+    /// pushed on top of.
+    const std::unordered_map<Identifier, T> &GetGlobalScope() const;
 
   private:
-    std::vector<std::unordered_map<std::wstring, T>> m_tables;
+    std::vector<std::unordered_map<Identifier, T>> m_tables;
   };
 
   class StorageType;
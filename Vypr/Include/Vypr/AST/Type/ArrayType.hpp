@@ -20,7 +20,17 @@ namespace Vypr
     std::unique_ptr<StorageType> Check(BinaryOp op,
                                        const StorageType &other) const override;
 
-    std::wstring PrettyPrint() const override;
+    std::string PrettyPrint() const override;
+
+    inline const StorageType &GetStorage() const
+    {
+      return *m_storage;
+    }
+
+    inline size_t GetSize() const
+    {
+      return m_size;
+    }
 
   private:
     std::unique_ptr<StorageType> CheckArithmetic(
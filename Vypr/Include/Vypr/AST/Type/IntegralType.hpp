@@ -59,8 +59,8 @@ namespace Vypr
                                        const StorageType &other) const override;
 
     /// @brief Print the type in a readable format.
-    /// @return Wide string containing the readable type.
-    std::wstring PrettyPrint() const override;
+    /// @return String containing the readable type.
+    std::string PrettyPrint() const override;
 
     /// @brief Retrieve the mapping between the LLVM IR type and the current
     /// `integral`.
@@ -47,8 +47,15 @@ namespace Vypr
     llvm::Type *GetIRType(Context &context) const override;
 
     /// @brief Print the type in a readable format.
-    /// @return Wide string containing the readable type.
-    std::wstring PrettyPrint() const override;
+    /// @return String containing the readable type.
+    std::string PrettyPrint() const override;
+
+    /// @brief Get the type pointed to.
+    /// @return Type pointed to by this pointer type.
+    inline const StorageType &GetStorage() const
+    {
+      return *m_storage;
+    }
 
   private:
     std::unique_ptr<StorageType> CheckArithmetic(
@@ -28,7 +28,7 @@ namespace Vypr
 
     llvm::Type *GetIRType(Context &context) const override;
 
-    std::wstring PrettyPrint() const override;
+    std::string PrettyPrint() const override;
 
     Real real;
 
@@ -68,8 +68,8 @@ namespace Vypr
                                                const StorageType &other) const;
 
     /// @brief Print the type in a readable format.
-    /// @return Wide string containing the readable type.
-    virtual std::wstring PrettyPrint() const;
+    /// @return String containing the readable type.
+    virtual std::string PrettyPrint() const;
 
     /// @brief Get the type used in the IR structure.
     /// @param context Current IR context for symbol storage and code gen.
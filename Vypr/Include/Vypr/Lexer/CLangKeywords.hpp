@@ -0,0 +1,148 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+#include "Vypr/Lexer/CLangTokenType.hpp"
+
+namespace Vypr
+{
+  /// @brief Spelling of a keyword and the token type it lexes to.
+  struct CLangKeyword
+  {
+    std::string_view spelling;
+    CLangTokenType type;
+  };
+
+  /// @brief Every keyword of the C language grammar.
+  constexpr std::array Keywords = {
+      CLangKeyword{"auto", CLangTokenType::Auto},
+      CLangKeyword{"break", CLangTokenType::Break},
+      CLangKeyword{"case", CLangTokenType::Case},
+      CLangKeyword{"char", CLangTokenType::CharType},
+      CLangKeyword{"double", CLangTokenType::DoubleType},
+      CLangKeyword{"int", CLangTokenType::IntegerType},
+      CLangKeyword{"float", CLangTokenType::FloatType},
+      CLangKeyword{"long", CLangTokenType::LongType},
+      CLangKeyword{"short", CLangTokenType::ShortType},
+      CLangKeyword{"const", CLangTokenType::Const},
+      CLangKeyword{"continue", CLangTokenType::Continue},
+      CLangKeyword{"default", CLangTokenType::Default},
+      CLangKeyword{"do", CLangTokenType::Do},
+      CLangKeyword{"else", CLangTokenType::Else},
+      CLangKeyword{"enum", CLangTokenType::Enumeration},
+      CLangKeyword{"extern", CLangTokenType::Extern},
+      CLangKeyword{"for", CLangTokenType::For},
+      CLangKeyword{"goto", CLangTokenType::Goto},
+      CLangKeyword{"if", CLangTokenType::If},
+      CLangKeyword{"inline", CLangTokenType::Inline},
+      CLangKeyword{"register", CLangTokenType::Register},
+      CLangKeyword{"restrict", CLangTokenType::Restrict},
+      CLangKeyword{"return", CLangTokenType::Return},
+      CLangKeyword{"signed", CLangTokenType::Signed},
+      CLangKeyword{"sizeof", CLangTokenType::Sizeof},
+      CLangKeyword{"static", CLangTokenType::Static},
+      CLangKeyword{"struct", CLangTokenType::Struct},
+      CLangKeyword{"switch", CLangTokenType::Switch},
+      CLangKeyword{"typedef", CLangTokenType::Typedef},
+      CLangKeyword{"union", CLangTokenType::Union},
+      CLangKeyword{"unsigned", CLangTokenType::Unsigned},
+      CLangKeyword{"void", CLangTokenType::Void},
+      CLangKeyword{"volatile", CLangTokenType::Volatile},
+      CLangKeyword{"while", CLangTokenType::While},
+      CLangKeyword{"_Alignas", CLangTokenType::AlignAs},
+      CLangKeyword{"_Alignof", CLangTokenType::AlignOf},
+      CLangKeyword{"_Atomic", CLangTokenType::Atomic},
+      CLangKeyword{"_Bool", CLangTokenType::Boolean},
+      CLangKeyword{"_Complex", CLangTokenType::Complex},
+      CLangKeyword{"_Generic", CLangTokenType::Generic},
+      CLangKeyword{"_Imaginary", CLangTokenType::Imaginary},
+      CLangKeyword{"_Noreturn", CLangTokenType::NoReturn},
+      CLangKeyword{"_Static_assert", CLangTokenType::StaticAssert},
+      CLangKeyword{"_Thread_local", CLangTokenType::ThreadLocal},
+  };
+
+  /// @brief Number of slots in `KeywordSlots`.
+  constexpr size_t KeywordSlotCount = 128;
+
+  /// @brief Marks a slot of `KeywordSlots` that no keyword hashes to.
+  constexpr uint8_t NoKeyword = UINT8_MAX;
+
+  /// @brief Hash of an identifier from its length and first and last
+  /// characters. The multipliers were chosen so that no two keywords share a
+  /// slot, which is checked below.
+  ///
+  /// @param text Identifier of at least one character.
+  /// @returns Slot of `text` in `KeywordSlots`.
+  constexpr size_t KeywordHash(std::string_view text)
+  {
+    return (text.size() + static_cast<unsigned char>(text.front()) * 10 +
+            static_cast<unsigned char>(text.back()) * 3) %
+           KeywordSlotCount;
+  }
+
+  /// @brief Index into `Keywords` of the keyword hashing to each slot, or
+  /// `NoKeyword`. Built at compile time so lexing needs no static
+  /// initialization.
+  constexpr std::array<uint8_t, KeywordSlotCount> KeywordSlots = [] {
+    std::array<uint8_t, KeywordSlotCount> slots{};
+    slots.fill(NoKeyword);
+    for (size_t i = 0; i < Keywords.size(); i++)
+    {
+      slots[KeywordHash(Keywords[i].spelling)] = static_cast<uint8_t>(i);
+    }
+    return slots;
+  }();
+
+  static_assert(
+      [] {
+        for (size_t i = 0; i < Keywords.size(); i++)
+        {
+          if (KeywordSlots[KeywordHash(Keywords[i].spelling)] != i)
+          {
+            return false;
+          }
+        }
+        return true;
+      }(),
+      "Keywords collide in KeywordSlots; choose new KeywordHash multipliers");
+
+  /// @brief Classifies an identifier as a keyword with a single hash and a
+  /// single comparison.
+  ///
+  /// @param text Spelling of the identifier.
+  /// @returns Token type of the keyword spelled `text` or
+  /// `CLangTokenType::Identifier` if it is not a keyword.
+  constexpr CLangTokenType FindKeyword(std::string_view text)
+  {
+    if (text.empty())
+    {
+      return CLangTokenType::Identifier;
+    }
+
+    uint8_t slot = KeywordSlots[KeywordHash(text)];
+    if (slot == NoKeyword || Keywords[slot].spelling != text)
+    {
+      return CLangTokenType::Identifier;
+    }
+    return Keywords[slot].type;
+  }
+
+  /// @brief Spelling shared by every token of a keyword type, used to
+  /// recover the text of keyword tokens without the source.
+  ///
+  /// @param type Token type.
+  /// @returns Spelling of `type` or an empty view if it is not a keyword.
+  constexpr std::string_view GetKeywordSpelling(CLangTokenType type)
+  {
+    for (const CLangKeyword &keyword : Keywords)
+    {
+      if (keyword.type == type)
+      {
+        return keyword.spelling;
+      }
+    }
+    return {};
+  }
+} // namespace Vypr
@@ -1,68 +1,289 @@
 #pragma once
 
-#include <exception>
 #include <memory>
-#include <optional>
 #include <string>
+#include <string_view>
 
 #include "Vypr/Lexer/CLangToken.hpp"
+#include "Vypr/Lexer/DiagnosticSink.hpp"
+#include "Vypr/Lexer/IdentifierTable.hpp"
+#include "Vypr/Lexer/LiteralTable.hpp"
+#include "Vypr/Lexer/TokenBuffer.hpp"
 #include "Vypr/Scanner/Scanner.hpp"
 
 namespace Vypr
 {
-  /// @brief Exception that can happen while trying to parse an input.
-  struct ParsingException : std::exception
+  class Preprocessor;
+  class TokenPipeline;
+  struct PreprocessorOptions;
+
+  /// @brief Position in a lexer's token stream that can be returned to.
+  struct TokenMark
   {
-    ParsingException(std::wstring message, size_t column, size_t line);
+    /// @brief Number of tokens preceding the position.
+    uint32_t index;
+  };
 
-    /// @brief Brief explanation of the exception that was encountered.
-    std::wstring message;
+  /// @brief Change made to a source between two lexes of it.
+  struct SourceEdit
+  {
+    /// @brief Byte offset of the change in the source before it.
+    uint32_t offset;
 
-    /// @brief 1-indexed column that the exception was encountered at.
-    size_t column;
+    /// @brief Number of bytes removed at `offset`.
+    uint32_t removedLength;
 
-    /// @brief 1-indexed line that the exception was encountered at.
-    size_t line;
+    /// @brief Number of bytes inserted at `offset` in their place.
+    uint32_t insertedLength;
   };
 
   /// @brief C language lexer. Parses a raw file or string stream into tokens
   /// defined in the C language grammar.
   ///
-  /// Only metadata about a stream is held by the lexer. Streams are passed when
-  /// requesting a token.
+  /// By default tokens are lexed as the parser asks for them and only those
+  /// that are peeked or marked are buffered. `Tokenize` instead lexes the
+  /// whole source into the token buffer in one pass, after which the parser
+  /// reads tokens by index. Lexing then runs as a single tight loop and can
+  /// be timed separately from parsing.
+  ///
+  /// Malformed input never throws. The lexer reports a diagnostic, returns a
+  /// token of type `CLangTokenType::Error` spanning the malformed text and
+  /// carries on after it, so half-typed code lexes about as fast as finished
+  /// code.
   class CLangLexer
   {
   public:
-    CLangLexer(std::unique_ptr<Scanner> scanner);
+    /// @brief Smallest chunk `Tokenize` gives a thread of its own. Smaller
+    /// chunks are not worth starting a thread for.
+    static constexpr size_t MinimumChunkSize = 64 * 1024;
+
+    /// @param scanner Source of the characters to lex.
+    /// @param identifiers Table that identifier names are interned into. Share
+    /// a table between lexers, symbol tables and code generation so that all
+    /// of them agree on identifiers.
+    CLangLexer(std::unique_ptr<Scanner> scanner,
+               std::shared_ptr<IdentifierTable> identifiers =
+                   std::make_shared<IdentifierTable>());
+
+    ~CLangLexer();
 
     /// @brief Fetch a token from the front of the stream. Whitespace is ignored
     /// and tokens are not parsed across vertical whitespace.
     ///
     /// @param source Stream to fetch token from.
     /// @returns A `CLangToken` parsed from the stream. Token is of type
-    /// `CLangToken::NoToken` when EOF is reached or a token
-    /// couldn't be parsed.
+    /// `CLangToken::NoToken` when EOF is reached and `CLangToken::Error`
+    /// when a token couldn't be parsed, in which case its value is the index
+    /// of its diagnostic.
     CLangToken GetToken();
 
-    /// @brief Peek a token from the front of the stream. Whitespace is ignored
-    /// and tokens are not parsed across vertical whitespace.
+    /// @brief Peek a token ahead of the front of the stream without consuming
+    /// it. Tokens up to the peeked one are lexed and buffered if they have
+    /// not been already.
+    ///
+    /// @param lookAhead Number of tokens to skip over.
+    /// @returns The `lookAhead`th token from the front of the stream. Token is
+    /// of type `CLangToken::NoToken` when EOF is reached.
+    CLangToken PeekToken(size_t lookAhead = 0);
+
+    /// @brief Lexes the rest of the source into the token buffer. `GetToken`
+    /// and `PeekToken` read from the buffer afterwards and never lex again.
+    ///
+    /// A source held in memory that has not been read from yet can be lexed
+    /// on several threads. It is cut at `FindSplitPoints` into chunks of at
+    /// least `MinimumChunkSize` bytes, each chunk is lexed by a lexer of its
+    /// own, and the chunks' tokens, identifiers and literals are merged in
+    /// order. The result is the same as lexing on one thread.
+    ///
+    /// @param threadCount Most threads to lex on, including the calling one.
+    void Tokenize(size_t threadCount = 1);
+
+    /// @brief Moves lexing to a thread of its own, which lexes ahead of the
+    /// parser through a `TokenPipeline` while the parser keeps calling
+    /// `GetToken` and `PeekToken` as before. Lexing and parsing then overlap
+    /// on large sources. Does nothing for streamed sources or once tokens
+    /// have been read.
+    void StartPipeline();
+
+    /// @brief Runs the source through a `Preprocessor`, so that `GetToken`
+    /// and `PeekToken` return the tokens left after preprocessing, with
+    /// those of included files spliced in. A streamed source is read to its
+    /// end first, since directives may refer to anything after them, and is
+    /// then no longer lexed as it arrives. Does nothing once tokens have been
+    /// read.
+    ///
+    /// @param options Where to look for included files.
+    void StartPreprocessor(const PreprocessorOptions &options);
+
+    /// @returns Preprocessor started by `StartPreprocessor` or `nullptr`.
+    inline const Preprocessor *GetPreprocessor() const
+    {
+      return m_preprocessor.get();
+    }
+
+    /// @brief Brings the tokens of a tokenized source up to date with an edit
+    /// to it, for editors that lex again on every keystroke.
     ///
-    /// @param source Stream to peek token from.
-    /// @returns A `CLangToken` parsed from the stream. Token is of
-    /// type `CLangToken::NoToken` when EOF is reached or a token
-    /// couldn't be parsed.
-    CLangToken PeekToken();
+    /// Lexing restarts after the last token the edit cannot have changed and
+    /// stops as soon as it reaches the end of an old token past the edit.
+    /// The source after that point is unchanged, so the old tokens from there
+    /// on are kept and only moved. Lexing is proportional to the size of the
+    /// edit; splicing the token buffer copies its tail but lexes none of it.
+    ///
+    /// The lexer must have been tokenized before any token was consumed,
+    /// without a preprocessor, and is rewound to the first token. Values of
+    /// the replaced constants and string literals are left in the literal
+    /// table.
+    ///
+    /// @param edit Change made to the source.
+    /// @param scanner Scanner holding the whole edited source in memory.
+    /// @returns Number of tokens that were lexed again.
+    size_t Relex(const SourceEdit &edit, std::unique_ptr<Scanner> scanner);
+
+    /// @returns Buffered tokens. After `Tokenize` these are every token from
+    /// the first one not yet consumed when it was called.
+    inline const TokenBuffer &GetTokens() const
+    {
+      return m_tokens;
+    }
+
+    /// @brief Marks the current position in the token stream so the parser can
+    /// speculate and return to it with `Reset`. Marking is constant time and
+    /// copies no tokens. Tokens lexed while a mark is held are buffered, so
+    /// the mark must be released once it is no longer needed.
+    ///
+    /// @returns Mark of the current position.
+    TokenMark Mark();
+
+    /// @brief Returns to a marked position. Tokens following the mark are
+    /// replayed from the buffer rather than lexed again.
+    ///
+    /// @param mark Mark that has not been released.
+    void Reset(TokenMark mark);
+
+    /// @brief Releases a mark returned by `Mark`.
+    ///
+    /// @param mark Mark to release.
+    void Release(TokenMark mark);
+
+    /// @returns Table that identifier names are interned into.
+    inline IdentifierTable &GetIdentifiers() const
+    {
+      return *m_identifiers;
+    }
+
+    /// @returns Table holding the values of lexed constants and string
+    /// literals.
+    inline const LiteralTable &GetLiterals() const
+    {
+      return m_literals;
+    }
+
+    /// @brief Recovers the text of a token. Identifiers are spelled by their
+    /// interned name, character constants and string literals by their value
+    /// in the literal table, and other tokens by the source buffer. Streamed
+    /// sources are not kept, so keywords and punctuators lexed from them are
+    /// given the spelling shared by their type and numeric constants have no
+    /// spelling; read their value with `LiteralTable::GetNumber` instead. The
+    /// same goes for relocated tokens, such as those of included files, and
+    /// for tokens split by a line splice.
+    ///
+    /// @param token Token returned by this lexer.
+    /// @returns Text of `token`. Views of character constants and string
+    /// literals are invalidated by lexing another token.
+    std::string_view GetSpelling(const CLangToken &token) const;
+
+    /// @returns Diagnostics of the tokens lexed so far, which `Error` tokens
+    /// refer to by index.
+    inline const DiagnosticSink &GetDiagnostics() const
+    {
+      return m_diagnostics;
+    }
+
+    /// @returns Source manager resolving token offsets to lines and columns.
+    inline const SourceManager &GetSourceManager() const
+    {
+      return m_scanner->GetSourceManager();
+    }
 
   private:
+    friend class TokenPipeline;
+
+    /// @brief Most characters past its end that lexing a token reads.
+    /// Punctuators are told apart by up to three characters.
+    static constexpr uint32_t MaximumLookAhead = 2;
+
+    /// @brief Number of characters read at once from a streamed source that
+    /// is read to its end before preprocessing.
+    static constexpr size_t StreamedReadSize = 16 * 1024;
+
+    /// @brief Lexes the next token from the scanner, skipping whitespace and
+    /// comments.
+    ///
+    /// @returns Token lexed or a token of type `CLangToken::NoToken` at EOF.
+    CLangToken LexToken();
+
+    /// @brief Parses the token at the scanner's position, which is not
+    /// whitespace, a comment or a line splice.
+    ///
+    /// @returns Token parsed or a token of type `CLangToken::NoToken` at EOF.
+    CLangToken ParseToken();
+
+    /// @brief Lexes again a token that a line splice may continue, from a
+    /// copy of the rest of its line with the splices removed. Tokens split by
+    /// a splice are rare, so this is kept off the path of other tokens.
+    ///
+    /// @param start Mark at the start of the token.
+    /// @returns Token starting at `start`, or a token of type
+    /// `CLangToken::NoToken` if the splice joined the start of a comment,
+    /// which is skipped.
+    CLangToken ParseSplicedToken(ScannerMark start);
+
+    /// @brief Takes the next token from the preprocessor or the pipeline if
+    /// one was started and lexes it otherwise.
+    ///
+    /// @returns Next token or a token of type `CLangToken::NoToken` at EOF.
+    CLangToken ReadToken();
+
+    /// @brief Lexes a whole source on several threads and merges the chunks
+    /// into the token buffer.
+    ///
+    /// @param source Source of the scanner, which has not been read from.
+    /// @param chunkCount Number of chunks to try to split the source into.
+    void TokenizeChunks(std::string_view source, size_t chunkCount);
+
+    /// @brief Records the first problem found in the token being lexed. The
+    /// token becomes an `Error` token once it has been skipped.
+    ///
+    /// @param id Problem found at the scanner's position.
+    void Fail(DiagnosticId id);
+
+    /// @brief Records the first problem found in the token being lexed at
+    /// a position other than the scanner's.
+    ///
+    /// @param id Problem found.
+    /// @param offset Source offset of the problem.
+    void Fail(DiagnosticId id, uint32_t offset);
+
+    /// @brief Skips a malformed string literal or character constant to its
+    /// closing quote or the end of its line.
+    ///
+    /// @param start Mark at the literal's opening quote.
+    void SkipQuoted(ScannerMark start);
+
+    /// @brief Drops consumed tokens from the front of the buffer when no mark
+    /// refers to them.
+    void DropConsumed();
+
     /// @brief Parses a punctuator from the source.
     ///
-    /// @param source Stream of `wchar_t`.
+    /// @param source Stream of `char`.
     /// @returns Token of the punctuator.
     CLangToken ParsePunctuator();
 
     /// @brief Parses an identifier or keyword from source.
     ///
-    /// @param source Stream of `wchar_t`.
+    /// @param source Stream of `char`.
     /// @returns Token of the keyword or identifier.
     CLangToken ParseIdentifier();
 
@@ -70,86 +291,111 @@ namespace Vypr
     /// either
     /// `'u'` for UTF-16 or `'U'` for UTF-32.
     ///
-    /// @param source Stream of `wchar_t`.
-    /// @returns String containing the unicode character.
-    std::wstring ParseUniversalCharacter();
+    /// @param source Stream of `char`.
+    /// @returns UTF-8 encoding of the unicode character or an empty string if
+    /// it is malformed.
+    std::string ParseUniversalCharacter();
 
     /// @brief Parses a numerical constant from source.
     ///
-    /// @param source Stream of `wchar_t`.
-    /// @returns Token containing either a float constant or integer constant.
+    /// @param source Stream of `char`.
+    /// @returns Token containing either a float constant or integer constant,
+    /// whose converted value is added to the literal table.
     CLangToken ParseNumericalConstant();
 
-    /// @brief Parses and convert a binary number from source.
+    /// @brief Converts the digits of an integer constant. Fails when an
+    /// octal constant has a digit above 7 or the value does not fit in 64
+    /// bits.
     ///
-    /// @param source Stream of `wchar_t`.
-    /// @returns Binary number converted to decimal.
+    /// @param digits Digits of the constant without a prefix or suffix.
+    /// @param radix Radix of the prefix. Decimal digits with a leading zero
+    /// are octal.
+    /// @param offset Source offset of the first digit.
+    /// @param number Constant receiving the value.
+    void ConvertInteger(std::string_view digits, unsigned radix,
+                        uint32_t offset, NumericLiteral &number);
+
+    /// @brief Converts a floating constant. A `float` constant that is out of
+    /// range becomes a `double` one. Fails when it is out of range as a
+    /// `double`.
     ///
-    /// @throws `ParsingException` Thrown when a binary number contains values
-    /// other than 0 and 1.
-    std::wstring ParseBinaryConstant();
+    /// @param text Constant without a prefix or suffix.
+    /// @param hexadecimal Whether the constant had a `0x` prefix.
+    /// @param offset Source offset of the constant.
+    /// @param number Constant receiving the value, with its suffix parsed.
+    void ConvertFloating(std::string_view text, bool hexadecimal,
+                         uint32_t offset, NumericLiteral &number);
+
+    /// @brief Parses the digits of a binary constant. Fails when there are
+    /// none or they are followed by a decimal digit.
+    void ParseBinarySequence();
 
     /// @brief Parses a number with a integral part, an optional fraction part,
     /// and an optional exponent part.
     ///
-    /// @param source Stream of `wchar_t`.
-    /// @param parser Function to parse integral and fraction parts
-    /// @param exponentDelimiter Delimiter between fraction and exponent.
-    /// @param requireExponent Require exponent if floating point.
-    /// @returns True if floating point and a integer or floating point string.
-    std::tuple<bool, std::wstring> ParseFloatableConstant(
-        std::wstring (CLangLexer::*parser)(), char exponentDelimiter,
-        bool requireExponent);
-
-    /// @brief Parses a hexadecimal number from source.
-    ///
-    /// @param source Stream of `wchar_t`.
-    /// @returns Hexadecimal number in string format.
-    ///
-    /// @throws `ParsingException` Thrown when a hexadecimal number contains
-    /// values other [0-9a-zA-Z].
-    std::wstring ParseHexadecimalSequence();
+    /// @param hexadecimal Whether the number had a `0x` prefix, which takes
+    /// hexadecimal digits and requires a `p` exponent if floating point.
+    /// @returns Whether the number is floating point.
+    bool ParseFloatableConstant(bool hexadecimal);
 
-    /// @brief Parses integer from source.
+    /// @brief Parses a run of digits from source.
     ///
-    /// @param source Stream of `wchar_t`.
-    /// @returns Decimal integer.
-    ///
-    /// @throws `ParsingException` Thrown if sequence not found.
-    std::wstring ParseIntegerSequence();
+    /// @param hexadecimal Whether to parse hexadecimal instead of decimal
+    /// digits.
+    /// @param required Whether to fail if there are no digits.
+    void ParseDigitSequence(bool hexadecimal, bool required);
 
     /// @brief Parses an integer suffix of u, U, l, L, ll, LL.
     ///
-    /// @param source Stream of `wchar_t`.
-    /// @returns Integer suffix or empty string if one is not available.
-    std::wstring ParseIntegerSuffix();
+    /// @returns Suffix flags of `NumericLiteral`, or zero if there is no
+    /// suffix.
+    uint8_t ParseIntegerSuffix();
 
     /// @brief Parses an float suffix of f, F, l, L.
     ///
-    /// @param source Stream of `wchar_t`.
-    /// @returns Float suffix or empty string if one is not available.
-    std::wstring ParseFloatSuffix();
+    /// @returns `NumericLiteral::Float` for f and F, otherwise zero.
+    uint8_t ParseFloatSuffix();
 
     /// @brief Parses a character literal
     ///
-    /// @param source Stream of `wchar_t`.
-    ///  @returns     /// Character literal sans the quotation.
-    ///
+    /// @returns Token of the character constant, whose value sans the
+    /// quotation is added to the literal table.
     CLangToken ParseCharacterConstant();
 
-    /// @brief Parse an escape sequence.
-    ///
-    /// @param source Stream of `wchar_t`.
-    /// @returns Character derived from the escape sequence.
-    wchar_t ParseEscapeSequence();
+    /// @brief Parse an escape sequence and appends the UTF-8 encoded
+    /// character it stands for to the literal being built.
+    void ParseEscapeSequence();
 
-    /// @brief Parse a string literal.
+    /// @brief Parse a string literal, decoding it straight into the literal
+    /// table.
     ///
-    /// @param source Stream of `wchar_t`.
-    /// @returns String literal sans the quotation.
+    /// @returns Token of the string literal, whose value sans the quotation
+    /// is added to the literal table.
     CLangToken ParseStringLiteral();
 
     std::unique_ptr<Scanner> m_scanner;
-    std::optional<CLangToken> m_lookAheadBuffer;
+    std::shared_ptr<IdentifierTable> m_identifiers;
+    LiteralTable m_literals;
+    DiagnosticSink m_diagnostics;
+    TokenBuffer m_tokens;
+    std::unique_ptr<TokenPipeline> m_pipeline;
+    std::unique_ptr<Preprocessor> m_preprocessor;
+
+    /// @brief Index in `m_tokens` of the token at the front of the stream.
+    size_t m_next;
+
+    /// @brief Number of tokens dropped from the front of `m_tokens`, which
+    /// marks count from.
+    uint32_t m_dropped;
+
+    uint32_t m_markCount;
+
+    /// @brief Whether `Tokenize` has buffered every token.
+    bool m_tokenized;
+
+    /// @brief Whether the token being lexed has failed, and the first
+    /// problem found in it.
+    bool m_failed;
+    Diagnostic m_failure;
   };
 } // namespace Vypr
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "Vypr/Lexer/CLangTokenType.hpp"
+
+namespace Vypr
+{
+  /// @brief Punctuator found at the front of a source.
+  struct CLangPunctuator
+  {
+    /// @brief Token type of the punctuator or `CLangTokenType::NoToken` if
+    /// the source does not start with one.
+    CLangTokenType type;
+
+    /// @brief Number of characters spelling the punctuator.
+    size_t length;
+  };
+
+  /// @brief Finds the longest punctuator spelled by the front of a source.
+  /// Every punctuator is at most three characters long, so a switch over
+  /// those characters is enough to munch maximally without hashing or
+  /// building strings.
+  ///
+  /// @param first First character of the source.
+  /// @param second Second character of the source or any character that is
+  /// not a punctuator if there is none.
+  /// @param third Third character of the source, as with `second`.
+  /// @returns Longest punctuator starting the source.
+  constexpr CLangPunctuator FindPunctuator(char first, char second, char third)
+  {
+    using enum CLangTokenType;
+
+    switch (first)
+    {
+    case '[':
+      return {LeftBracket, 1};
+    case ']':
+      return {RightBracket, 1};
+    case '(':
+      return {LeftParenthesis, 1};
+    case ')':
+      return {RightParenthesis, 1};
+    case '{':
+      return {LeftDragon, 1};
+    case '}':
+      return {RightDragon, 1};
+    case '~':
+      return {Tilde, 1};
+    case '?':
+      return {TernaryProposition, 1};
+    case ':':
+      return {TernaryDecision, 1};
+    case ';':
+      return {StatementDelimiter, 1};
+    case ',':
+      return {Comma, 1};
+    case '.':
+      if (second == '.' && third == '.')
+      {
+        return {Variadic, 3};
+      }
+      return {Period, 1};
+    case '-':
+      switch (second)
+      {
+      case '>':
+        return {Arrow, 2};
+      case '-':
+        return {Decrement, 2};
+      case '=':
+        return {SubtractAssign, 2};
+      default:
+        return {Subtract, 1};
+      }
+    case '+':
+      switch (second)
+      {
+      case '+':
+        return {Increment, 2};
+      case '=':
+        return {AddAssign, 2};
+      default:
+        return {Add, 1};
+      }
+    case '*':
+      return second == '=' ? CLangPunctuator{MultiplyAssign, 2}
+                           : CLangPunctuator{Star, 1};
+    case '/':
+      return second == '=' ? CLangPunctuator{DivideAssign, 2}
+                           : CLangPunctuator{Divide, 1};
+    case '%':
+      return second == '=' ? CLangPunctuator{ModuloAssign, 2}
+                           : CLangPunctuator{Modulo, 1};
+    case '!':
+      return second == '=' ? CLangPunctuator{NotEqual, 2}
+                           : CLangPunctuator{Exclamation, 1};
+    case '=':
+      return second == '=' ? CLangPunctuator{Equal, 2}
+                           : CLangPunctuator{Assign, 1};
+    case '^':
+      return second == '=' ? CLangPunctuator{XorAssign, 2}
+                           : CLangPunctuator{Xor, 1};
+    case '#':
+      return second == '#' ? CLangPunctuator{PreprocessorConcat, 2}
+                           : CLangPunctuator{Preprocessor, 1};
+    case '&':
+      switch (second)
+      {
+      case '&':
+        return {LogicalAnd, 2};
+      case '=':
+        return {AndAssign, 2};
+      default:
+        return {And, 1};
+      }
+    case '|':
+      switch (second)
+      {
+      case '|':
+        return {LogicalOr, 2};
+      case '=':
+        return {OrAssign, 2};
+      default:
+        return {Or, 1};
+      }
+    case '<':
+      switch (second)
+      {
+      case '<':
+        return third == '=' ? CLangPunctuator{LeftShiftAssign, 3}
+                            : CLangPunctuator{ShiftLeft, 2};
+      case '=':
+        return {LessEqual, 2};
+      default:
+        return {LessThan, 1};
+      }
+    case '>':
+      switch (second)
+      {
+      case '>':
+        return third == '=' ? CLangPunctuator{RightShiftAssign, 3}
+                            : CLangPunctuator{ShiftRight, 2};
+      case '=':
+        return {GreaterEqual, 2};
+      default:
+        return {GreaterThan, 1};
+      }
+    default:
+      return {NoToken, 0};
+    }
+  }
+
+  /// @brief Spelling shared by every token of a punctuator type, used to
+  /// recover the text of punctuator tokens without the source.
+  ///
+  /// @param type Token type.
+  /// @returns Spelling of `type` or an empty view if it is not a punctuator.
+  constexpr std::string_view GetPunctuatorSpelling(CLangTokenType type)
+  {
+    using enum CLangTokenType;
+
+    switch (type)
+    {
+    case LeftBracket:
+      return "[";
+    case RightBracket:
+      return "]";
+    case LeftParenthesis:
+      return "(";
+    case RightParenthesis:
+      return ")";
+    case LeftDragon:
+      return "{";
+    case RightDragon:
+      return "}";
+    case Period:
+      return ".";
+    case Arrow:
+      return "->";
+    case Increment:
+      return "++";
+    case Decrement:
+      return "--";
+    case Star:
+      return "*";
+    case Add:
+      return "+";
+    case Subtract:
+      return "-";
+    case Tilde:
+      return "~";
+    case Exclamation:
+      return "!";
+    case Divide:
+      return "/";
+    case Modulo:
+      return "%";
+    case ShiftLeft:
+      return "<<";
+    case ShiftRight:
+      return ">>";
+    case LessThan:
+      return "<";
+    case GreaterThan:
+      return ">";
+    case LessEqual:
+      return "<=";
+    case GreaterEqual:
+      return ">=";
+    case Equal:
+      return "==";
+    case NotEqual:
+      return "!=";
+    case And:
+      return "&";
+    case Or:
+      return "|";
+    case Xor:
+      return "^";
+    case LogicalAnd:
+      return "&&";
+    case LogicalOr:
+      return "||";
+    case TernaryProposition:
+      return "?";
+    case TernaryDecision:
+      return ":";
+    case StatementDelimiter:
+      return ";";
+    case Variadic:
+      return "...";
+    case Assign:
+      return "=";
+    case MultiplyAssign:
+      return "*=";
+    case DivideAssign:
+      return "/=";
+    case ModuloAssign:
+      return "%=";
+    case AddAssign:
+      return "+=";
+    case SubtractAssign:
+      return "-=";
+    case LeftShiftAssign:
+      return "<<=";
+    case RightShiftAssign:
+      return ">>=";
+    case AndAssign:
+      return "&=";
+    case XorAssign:
+      return "^=";
+    case OrAssign:
+      return "|=";
+    case Comma:
+      return ",";
+    case Preprocessor:
+      return "#";
+    case PreprocessorConcat:
+      return "##";
+    default:
+      return {};
+    }
+  }
+} // namespace Vypr
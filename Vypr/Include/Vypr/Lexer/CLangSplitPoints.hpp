@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Vypr
+{
+  /// @brief Finds offsets where a C source can be cut into chunks that lex to
+  /// the same tokens on their own as they do in place.
+  ///
+  /// Every point is the start of a line that does not begin inside a comment,
+  /// string literal or character constant. A single pass tracks only which of
+  /// those the scan is in, jumping between quotes and slashes a vector block
+  /// at a time, so it runs several times faster than lexing the source.
+  ///
+  /// @param source Whole source to split.
+  /// @param chunkCount Number of chunks wanted.
+  /// @returns Increasing offsets of up to `chunkCount - 1` split points. The
+  /// `i`th chunk starts at the first usable line start at or after
+  /// `i * source.size() / chunkCount`, so fewer points are returned when
+  /// lines or comments are longer than a chunk.
+  std::vector<uint32_t> FindSplitPoints(std::string_view source,
+                                        size_t chunkCount);
+} // namespace Vypr
@@ -1,31 +1,72 @@
 #pragma once
 
-#include <string>
+#include <cstdint>
 
 #include "Vypr/Lexer/CLangTokenType.hpp"
+#include "Vypr/Lexer/IdentifierTable.hpp"
+#include "Vypr/Scanner/SourceManager.hpp"
 
 namespace Vypr
 {
   /// @brief Token emitted by the lexer. These tokens are defined in the C
   /// language grammar.
   ///
-  /// Identifiers and constants contain the text they were parsed
-  /// with.
+  /// Tokens are 16 bytes and trivially copyable. They do not hold their
+  /// text; the lexer recovers it with `CLangLexer::GetSpelling`.
   struct CLangToken
   {
-    /// @brief No position is defined for the line or column;
-    static constexpr size_t NoPosition = 0;
+    /// @brief No position is defined for the token.
+    static constexpr uint32_t NoPosition = SourceManager::NoOffset;
+
+    /// @brief `value` of tokens that have none.
+    static constexpr uint32_t NoValue = UINT32_MAX;
+
+    /// @brief Flag of tokens that are the first on their line.
+    static constexpr uint8_t StartOfLine = 1 << 0;
+
+    /// @brief Flag of tokens preceded by whitespace or a comment.
+    static constexpr uint8_t LeadingSpace = 1 << 1;
+
+    /// @brief Flag of tokens that did not come from the lexer's source, such
+    /// as those of included files. Their offset is that of the source text
+    /// that brought them in and they are not spelled by the source buffer.
+    static constexpr uint8_t Relocated = 1 << 2;
+
+    /// @brief Flag of identifiers naming a macro that may not be expanded,
+    /// because they were found while expanding that same macro.
+    static constexpr uint8_t NoExpand = 1 << 3;
+
+    /// @brief Flag of tokens whose source text is split by a line splice, a
+    /// backslash ending a line. They are not spelled by the source buffer.
+    static constexpr uint8_t Spliced = 1 << 4;
 
     /// @brief Type of keyword, identifier, constant or token.
     CLangTokenType type = CLangTokenType::NoToken;
 
-    /// @brief Raw string used to create token.
-    std::wstring content = L"";
+    /// @brief Combination of the flags above.
+    uint8_t flags = 0;
+
+    /// @brief Byte offset of the token in the file it was created from. Use
+    /// the lexer's `SourceManager` to resolve it to a line and column.
+    uint32_t offset = NoPosition;
 
-    /// @brief 1-indexed line of the file token was created from.
-    size_t line = NoPosition;
+    /// @brief Number of source bytes spelling the token.
+    uint32_t length = 0;
 
-    /// @brief 1-indexed column of the file token was created from.
-    size_t column = NoPosition;
+    /// @brief Interned name of identifiers in the lexer's `IdentifierTable`,
+    /// index of constants and string literals in the lexer's
+    /// `LiteralTable`, or `NoValue` for other tokens.
+    uint32_t value = NoValue;
+
+    /// @returns Interned name of an identifier token or `Identifier::None`
+    /// for other tokens.
+    inline Identifier GetIdentifier() const
+    {
+      return type == CLangTokenType::Identifier
+                 ? static_cast<Identifier>(value)
+                 : Identifier::None;
+    }
   };
+
+  static_assert(sizeof(CLangToken) == 16);
 } // namespace Vypr
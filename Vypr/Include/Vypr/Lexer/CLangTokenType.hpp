@@ -1,11 +1,14 @@
 #pragma once
 
+#include <cstdint>
+
 namespace Vypr
 {
   /// @brief Token types for the C language grammar.
-  enum class CLangTokenType
+  enum class CLangTokenType : uint8_t
   {
     NoToken,
+    Error,
     IntegerConstant,
     FloatConstant,
     CharacterConstant,
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Vypr
+{
+  /// @brief Problems the lexer and preprocessor report instead of throwing.
+  /// The message of each is only looked up when it is printed.
+  enum class DiagnosticId : uint8_t
+  {
+    MalformedUniversalCharacter,
+    ExpectedBinaryDigits,
+    InvalidBinaryDigit,
+    ExpectedHexadecimalDigits,
+    ExpectedDecimalDigits,
+    ExpectedHexadecimalExponent,
+    InvalidIntegerSuffix,
+    InvalidFloatSuffix,
+    EmptyCharacterConstant,
+    UnterminatedCharacterConstant,
+    ExpectedHexadecimalEscape,
+    UnknownEscapeSequence,
+    UnterminatedStringLiteral,
+    InvalidOctalDigit,
+    ConstantTooLarge,
+    IncludeNotFound,
+    IncludeNestingTooDeep,
+    MalformedDirective,
+    UnknownDirective,
+    UnterminatedConditional,
+    UnmatchedConditional,
+    InvalidCondition,
+    ErrorDirective,
+    UnterminatedMacroCall,
+    MacroArgumentCount,
+    InvalidTokenPaste
+  };
+
+  /// @brief Problem found at a position in a source.
+  struct Diagnostic
+  {
+    DiagnosticId id;
+
+    /// @brief Byte offset in the source where the problem was found.
+    uint32_t offset;
+  };
+
+  /// @brief Collects the diagnostics of a source in the order they are
+  /// found. Reporting one appends eight bytes and never throws, so malformed
+  /// input costs little more to lex than well-formed input.
+  ///
+  /// The sink is not synchronized.
+  class DiagnosticSink
+  {
+  public:
+    DiagnosticSink() = default;
+
+    DiagnosticSink(const DiagnosticSink &) = delete;
+    DiagnosticSink &operator=(const DiagnosticSink &) = delete;
+    DiagnosticSink(DiagnosticSink &&) = default;
+    DiagnosticSink &operator=(DiagnosticSink &&) = default;
+
+    /// @brief Records a diagnostic.
+    ///
+    /// @param id Problem that was found.
+    /// @param offset Byte offset of the problem in the source.
+    /// @returns Index of the diagnostic.
+    uint32_t Report(DiagnosticId id, uint32_t offset);
+
+    /// @brief Copies every diagnostic of another sink to the end of this one.
+    ///
+    /// @param other Sink to copy from.
+    /// @param offset Offset added to the positions of `other`'s diagnostics.
+    /// @returns Index in this sink of the first diagnostic of `other`.
+    uint32_t Append(const DiagnosticSink &other, uint32_t offset);
+
+    /// @brief Moves the diagnostics reported last into the place of a range
+    /// of earlier ones, which are removed. Used when the tokens of part of
+    /// an edited source are lexed again.
+    ///
+    /// @param first Index of the first diagnostic to replace.
+    /// @param count Number of diagnostics to replace.
+    /// @param from Index of the first diagnostic to move. Those from `from`
+    /// to the end are moved to `first`.
+    /// @param shift Amount added to the offsets of the diagnostics between
+    /// the replaced and the moved ones, wrapping around.
+    void Splice(uint32_t first, uint32_t count, uint32_t from,
+                uint32_t shift);
+
+    /// @param index Index returned by `Report`.
+    /// @returns Diagnostic at `index`.
+    inline const Diagnostic &Get(uint32_t index) const
+    {
+      return m_diagnostics[index];
+    }
+
+    /// @returns Number of diagnostics reported.
+    inline size_t GetCount() const
+    {
+      return m_diagnostics.size();
+    }
+
+    /// @param id Problem to describe.
+    /// @returns Message describing `id`.
+    static std::string_view GetMessage(DiagnosticId id);
+
+  private:
+    std::vector<Diagnostic> m_diagnostics;
+  };
+} // namespace Vypr
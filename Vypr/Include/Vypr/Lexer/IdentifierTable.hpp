@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Vypr
+{
+  /// @brief Interned name handed out by an `IdentifierTable`. Two identifiers
+  /// from the same table are equal exactly when their names are.
+  enum class Identifier : uint32_t
+  {
+    /// @brief Identifier of tokens that are not names.
+    None = UINT32_MAX
+  };
+
+  /// @brief Arena of interned identifier names. Each distinct name is stored
+  /// once and is referred to by a 32-bit `Identifier`, so symbol tables can
+  /// key on integers and repeated names take no extra memory.
+  ///
+  /// Names are never moved once interned; views returned by `GetName` stay
+  /// valid for the lifetime of the table. The table is not synchronized.
+  class IdentifierTable
+  {
+  public:
+    IdentifierTable();
+
+    IdentifierTable(const IdentifierTable &) = delete;
+    IdentifierTable &operator=(const IdentifierTable &) = delete;
+
+    /// @brief Finds the identifier of a name, adding the name to the table if
+    /// it has not been seen before.
+    ///
+    /// @param name Name to intern.
+    /// @returns Identifier of `name`.
+    Identifier Intern(std::string_view name);
+
+    /// @param name Name to look up.
+    /// @returns Identifier of `name` or `Identifier::None` if it has not been
+    /// interned.
+    Identifier Find(std::string_view name) const;
+
+    /// @param identifier Identifier returned by this table.
+    /// @returns Name of `identifier`.
+    inline std::string_view GetName(Identifier identifier) const
+    {
+      return m_names[static_cast<uint32_t>(identifier)];
+    }
+
+    /// @returns Number of distinct names in the table.
+    inline size_t GetCount() const
+    {
+      return m_names.size();
+    }
+
+  private:
+    /// @brief Copies a name into the arena.
+    ///
+    /// @param name Name to copy.
+    /// @returns View of the copy.
+    std::string_view Store(std::string_view name);
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char *m_blockCursor;
+    size_t m_blockRemaining;
+    std::vector<std::string_view> m_names;
+    std::unordered_map<std::string_view, Identifier> m_identifiers;
+  };
+} // namespace Vypr
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "Vypr/Lexer/NumericLiteral.hpp"
+
+namespace Vypr
+{
+  /// @brief Values of the constants and string literals in a source, in the
+  /// form the parser reads them in. Tokens refer to their value by a 32-bit
+  /// index so that they stay small and trivially copyable.
+  ///
+  /// Character constants and string literals are packed back to back in one
+  /// array with a 32-bit end offset each, so a literal costs four bytes over
+  /// its characters. The lexer decodes literals straight into the array with
+  /// `Extend`, and the parser joins adjacent string literals, whose values
+  /// are stored one after another, with `Join` instead of copying them.
+  /// Views returned by `Get` and `Join` are invalidated by the next `Add` or
+  /// `Extend`.
+  ///
+  /// Integer and floating constants are stored already converted, with
+  /// separate indices into an array of 64-bit values and one of suffixes, so
+  /// a number costs nine bytes instead of a padded `NumericLiteral`. The
+  /// table is not synchronized.
+  class LiteralTable
+  {
+  public:
+    LiteralTable() = default;
+
+    LiteralTable(const LiteralTable &) = delete;
+    LiteralTable &operator=(const LiteralTable &) = delete;
+    LiteralTable(LiteralTable &&) = default;
+    LiteralTable &operator=(LiteralTable &&) = default;
+
+    /// @brief Copies a value into the table. Equal values are not merged.
+    ///
+    /// @param value Value of a constant or string literal.
+    /// @returns Index of the value.
+    uint32_t Add(std::string_view value);
+
+    /// @brief Appends characters to the value being built, which is stored
+    /// in place and becomes a value once `Finish` is called.
+    ///
+    /// @param characters Next characters of the value.
+    inline void Extend(std::string_view characters)
+    {
+      m_characters.insert(m_characters.end(), characters.begin(),
+                          characters.end());
+    }
+
+    /// @brief Ends the value being built with `Extend`.
+    ///
+    /// @returns Index of the value.
+    uint32_t Finish();
+
+    /// @brief Drops the characters of the value being built with `Extend`.
+    void Discard();
+
+    /// @brief Stores the value of a numeric constant.
+    ///
+    /// @param number Converted value of an integer or floating constant.
+    /// @returns Index of the value.
+    uint32_t AddNumber(const NumericLiteral &number);
+
+    /// @brief Copies every value of another table to the end of this one.
+    /// Numeric values are offset by `GetNumberCount()` from before the call.
+    ///
+    /// @param other Table to copy from.
+    /// @returns Index in this table of the first string value of `other`.
+    uint32_t Append(const LiteralTable &other);
+
+    /// @param index Index returned by `Add`.
+    /// @returns Value at `index`.
+    inline std::string_view Get(uint32_t index) const
+    {
+      uint32_t start = index == 0 ? 0 : m_ends[index - 1];
+      return {m_characters.data() + start, m_ends[index] - start};
+    }
+
+    /// @brief Views a run of values that are stored back to back as one, such
+    /// as adjacent string literals lexed one after another.
+    ///
+    /// @param first Index of the first value.
+    /// @param last Index of the last value, at least `first`.
+    /// @returns Characters of every value from `first` to `last`.
+    inline std::string_view Join(uint32_t first, uint32_t last) const
+    {
+      uint32_t start = first == 0 ? 0 : m_ends[first - 1];
+      return {m_characters.data() + start, m_ends[last] - start};
+    }
+
+    /// @param index Index returned by `AddNumber`.
+    /// @returns Numeric value at `index`.
+    inline NumericLiteral GetNumber(uint32_t index) const
+    {
+      NumericLiteral number;
+      std::memcpy(&number, &m_numbers[index], sizeof(m_numbers[index]));
+      number.suffix = m_suffixes[index];
+      return number;
+    }
+
+    /// @returns Number of string values in the table.
+    inline size_t GetCount() const
+    {
+      return m_ends.size();
+    }
+
+    /// @returns Number of numeric values in the table.
+    inline size_t GetNumberCount() const
+    {
+      return m_numbers.size();
+    }
+
+  private:
+    std::vector<char> m_characters;
+    std::vector<uint32_t> m_ends;
+    std::vector<uint64_t> m_numbers;
+    std::vector<uint8_t> m_suffixes;
+  };
+} // namespace Vypr
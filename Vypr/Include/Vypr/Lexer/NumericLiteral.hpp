@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace Vypr
+{
+  /// @brief Value of an integer or floating constant, converted by the lexer
+  /// in the same pass that scans it.
+  struct NumericLiteral
+  {
+    /// @brief Suffix flag of `u` or `U`.
+    static constexpr uint8_t Unsigned = 1 << 0;
+
+    /// @brief Suffix flag of `l` or `L` on an integer constant.
+    static constexpr uint8_t Long = 1 << 1;
+
+    /// @brief Suffix flag of `ll` or `LL`.
+    static constexpr uint8_t LongLong = 1 << 2;
+
+    /// @brief Suffix flag of `f` or `F`. It is cleared when the value does
+    /// not fit in a `float`, which makes the constant a `double`.
+    static constexpr uint8_t Float = 1 << 3;
+
+    union
+    {
+      /// @brief Value of an integer constant.
+      uint64_t integer;
+
+      /// @brief Value of a floating constant. Constants with the `Float`
+      /// suffix are rounded to `float` first.
+      double real;
+    };
+
+    /// @brief Combination of the suffix flags above.
+    uint8_t suffix;
+  };
+
+  /// @brief Converts the digits of an integer constant. Runs of eight digits
+  /// are loaded as one 64-bit word and combined in a few multiplications
+  /// where the target is little-endian.
+  ///
+  /// @param digits Digits of `radix`, without a prefix or suffix.
+  /// @param radix Either 2, 8, 10 or 16.
+  /// @returns Value of `digits` or nothing if it does not fit in 64 bits.
+  std::optional<uint64_t> ConvertDigits(std::string_view digits,
+                                        unsigned radix);
+
+  /// @brief Converts the text of a floating constant with correct rounding.
+  ///
+  /// @param text Digits, fraction and exponent of the constant, without a
+  /// `0x` prefix or suffix.
+  /// @param hexadecimal Whether `text` is a hexadecimal floating constant.
+  /// @param isFloat Whether to round to `float` instead of `double`.
+  /// @returns Value of `text` or nothing if it is out of range.
+  std::optional<double> ConvertReal(std::string_view text, bool hexadecimal,
+                                    bool isFloat);
+} // namespace Vypr
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstdint>
+
+#include "Vypr/Lexer/CLangToken.hpp"
+
+namespace Vypr
+{
+  /// @brief Sequence of tokens stored as a structure of arrays. Each field
+  /// of `CLangToken` has an array of its own, so the parser's scans over
+  /// token types touch one byte per token and no padding is stored.
+  ///
+  /// The arrays share one capacity so appending checks it once. They are
+  /// grown and shrunk with `realloc`, which remaps large buffers instead of
+  /// copying them.
+  class TokenBuffer
+  {
+  public:
+    /// @brief Bytes stored per token, excluding unused capacity.
+    static constexpr size_t BytesPerToken =
+        sizeof(CLangTokenType) + sizeof(uint8_t) + 3 * sizeof(uint32_t);
+
+    TokenBuffer();
+    ~TokenBuffer();
+
+    TokenBuffer(const TokenBuffer &) = delete;
+    TokenBuffer &operator=(const TokenBuffer &) = delete;
+
+    /// @brief Adds a token to the end of the buffer.
+    ///
+    /// @param token Token to add.
+    inline void Append(const CLangToken &token)
+    {
+      if (m_size == m_capacity)
+      {
+        Reallocate(m_capacity < MinimumCapacity ? MinimumCapacity
+                                                : m_capacity * 2);
+      }
+      m_types[m_size] = token.type;
+      m_flags[m_size] = token.flags;
+      m_offsets[m_size] = token.offset;
+      m_lengths[m_size] = token.length;
+      m_values[m_size] = token.value;
+      m_size += 1;
+    }
+
+    /// @brief Replaces a range of tokens with the tokens of another buffer.
+    /// The tokens after the range are moved, so this is linear in the size
+    /// of the buffer but only copies memory.
+    ///
+    /// @param first Index of the first token to replace.
+    /// @param count Number of tokens to replace.
+    /// @param tokens Tokens to insert at `first`.
+    void Replace(size_t first, size_t count, const TokenBuffer &tokens);
+
+    /// @brief Adds to the offsets of the tokens from `first` on.
+    ///
+    /// @param first Index of the first token to move.
+    /// @param shift Amount to add. Offsets wrap around, so a shift towards
+    /// the start of the source is given as its two's complement.
+    void ShiftOffsets(size_t first, uint32_t shift);
+
+    /// @brief Adds to the values of the tokens of one type from `first` on.
+    ///
+    /// @param first Index of the first token to update.
+    /// @param type Type of the tokens to update.
+    /// @param shift Amount to add, wrapping around like `ShiftOffsets`.
+    void ShiftValues(size_t first, CLangTokenType type, uint32_t shift);
+
+    /// @brief Removes every token, keeping the allocated capacity.
+    void Clear();
+
+    /// @brief Allocates space for at least `count` tokens.
+    ///
+    /// @param count Number of tokens to make room for.
+    void Reserve(size_t count);
+
+    /// @brief Releases unused capacity once no more tokens will be added, so
+    /// that a whole file takes `BytesPerToken` per token.
+    void ShrinkToFit();
+
+    /// @param index Index of a token in the buffer.
+    /// @returns Token at `index`.
+    inline CLangToken operator[](size_t index) const
+    {
+      return {.type = m_types[index],
+              .flags = m_flags[index],
+              .offset = m_offsets[index],
+              .length = m_lengths[index],
+              .value = m_values[index]};
+    }
+
+    /// @param index Index of a token in the buffer.
+    /// @returns Type of the token at `index`.
+    inline CLangTokenType GetType(size_t index) const
+    {
+      return m_types[index];
+    }
+
+    /// @param index Index of a token in the buffer.
+    /// @returns Source offset of the token at `index`.
+    inline uint32_t GetOffset(size_t index) const
+    {
+      return m_offsets[index];
+    }
+
+    /// @returns Number of tokens in the buffer.
+    inline size_t GetSize() const
+    {
+      return m_size;
+    }
+
+    /// @returns Bytes allocated for tokens, including unused capacity.
+    inline size_t GetCapacityBytes() const
+    {
+      return m_capacity * BytesPerToken;
+    }
+
+  private:
+    /// @brief Capacity of the first allocation.
+    static constexpr size_t MinimumCapacity = 256;
+
+    /// @brief Resizes every array to hold `capacity` tokens.
+    ///
+    /// @param capacity Number of tokens to hold, at least `GetSize()`.
+    ///
+    /// @throws `std::bad_alloc` Thrown when memory cannot be allocated.
+    void Reallocate(size_t capacity);
+
+    CLangTokenType *m_types;
+    uint8_t *m_flags;
+    uint32_t *m_offsets;
+    uint32_t *m_lengths;
+    uint32_t *m_values;
+    size_t m_size;
+    size_t m_capacity;
+  };
+} // namespace Vypr
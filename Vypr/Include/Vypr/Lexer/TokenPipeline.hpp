@@ -0,0 +1,121 @@
+#pragma once
+
+#include <exception>
+#include <memory>
+#include <stop_token>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Vypr/Lexer/CLangToken.hpp"
+#include "Vypr/Lexer/DiagnosticSink.hpp"
+#include "Vypr/Lexer/IdentifierTable.hpp"
+#include "Vypr/Lexer/LiteralTable.hpp"
+#include "Vypr/Lexer/TokenBuffer.hpp"
+#include "Vypr/Util/SpscRing.hpp"
+
+namespace Vypr
+{
+  class CLangLexer;
+
+  /// @brief Run of tokens handed from the lexing thread of a `TokenPipeline`
+  /// to the parsing thread, with the values they refer to. Literals and
+  /// diagnostics are indexed from zero in every batch.
+  struct TokenBatch
+  {
+    TokenBuffer tokens;
+    LiteralTable literals;
+    DiagnosticSink diagnostics;
+
+    /// @brief Names of the identifiers first seen in this batch, in the order
+    /// the lexing thread interned them. The views point into its identifier
+    /// table, whose names never move.
+    std::vector<std::string_view> names;
+
+    /// @brief Exception lexing stopped on, if any.
+    std::exception_ptr error;
+
+    /// @brief Whether this is the last batch of the source.
+    bool last = false;
+  };
+
+  /// @brief Lexes a source on a thread of its own while the parser consumes
+  /// its tokens, so that lexing and parsing overlap.
+  ///
+  /// The lexing thread runs a `CLangLexer` with tables of its own, since the
+  /// tables are not synchronized, and pushes its tokens in batches through
+  /// an `SpscRing`. The parsing thread merges each batch's values into the
+  /// tables of the parser's lexer as it takes the batch. Once the ring is
+  /// full the lexing thread waits, so it stays at most `BatchCount` batches
+  /// ahead.
+  class TokenPipeline
+  {
+  public:
+    /// @brief Tokens per batch. Handing a batch over may wake the other
+    /// thread, so batches are large enough for that to be rare, yet small
+    /// enough that parsing starts right away.
+    static constexpr size_t BatchSize = 4096;
+
+    /// @brief Batches the ring holds before the lexing thread waits.
+    static constexpr size_t BatchCount = 16;
+
+    /// @brief Starts lexing a source on a new thread.
+    ///
+    /// @param source Source held in memory, which must outlive the pipeline.
+    explicit TokenPipeline(std::string_view source);
+
+    /// @brief Stops the lexing thread, which is waited for.
+    ~TokenPipeline();
+
+    TokenPipeline(const TokenPipeline &) = delete;
+    TokenPipeline &operator=(const TokenPipeline &) = delete;
+
+    /// @brief Takes the next token, waiting for the lexing thread if it has
+    /// not been lexed yet. The values of each new batch are appended to the
+    /// given tables, which the returned tokens refer to.
+    ///
+    /// @param literals Table receiving the values of constants and string
+    /// literals.
+    /// @param diagnostics Sink receiving the diagnostics of `Error` tokens.
+    /// @param identifiers Table that identifier names are interned into.
+    /// @returns Next token or a token of type `CLangTokenType::NoToken` at
+    /// the end of the source.
+    CLangToken GetToken(LiteralTable &literals, DiagnosticSink &diagnostics,
+                        IdentifierTable &identifiers);
+
+  private:
+    /// @brief Lexes the source into batches until it ends or a stop is
+    /// requested. Runs on the lexing thread.
+    ///
+    /// @param stop Token that the destructor requests a stop through.
+    void Produce(std::stop_token stop);
+
+    /// @brief Takes the next batch from the ring and merges its values into
+    /// the parser's tables.
+    void TakeBatch(LiteralTable &literals, DiagnosticSink &diagnostics,
+                   IdentifierTable &identifiers);
+
+    /// @brief Lexer of the lexing thread.
+    std::unique_ptr<CLangLexer> m_lexer;
+
+    SpscRing<std::unique_ptr<TokenBatch>> m_ring;
+
+    /// @brief Batch being consumed and the index of its next token.
+    std::unique_ptr<TokenBatch> m_batch;
+    size_t m_next;
+
+    /// @brief Parser's identifier of each identifier of the lexing thread.
+    std::vector<uint32_t> m_identifiers;
+
+    /// @brief Indices in the parser's tables of the current batch's first
+    /// numeric value, string value and diagnostic.
+    uint32_t m_firstNumber;
+    uint32_t m_firstLiteral;
+    uint32_t m_firstDiagnostic;
+
+    /// @brief Whether the last batch has been taken.
+    bool m_finished;
+
+    std::jthread m_thread;
+  };
+} // namespace Vypr
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Vypr
+{
+  class CLangLexer;
+
+  /// @brief Identity of a version of a file: the file it is, by device and
+  /// inode, and when it was last written and how large it was.
+  struct FileIdentity
+  {
+    uint64_t device;
+    uint64_t inode;
+
+    /// @brief Time of the last write in the file system's own units.
+    int64_t modified;
+    uint64_t size;
+
+    bool operator==(const FileIdentity &) const = default;
+  };
+
+  /// @brief Counts of the lookups a `HeaderCache` answered.
+  struct HeaderCacheStatistics
+  {
+    /// @brief Number of lookups answered with a file lexed before.
+    uint64_t hits = 0;
+
+    /// @brief Number of lookups that mapped and lexed the file.
+    uint64_t misses = 0;
+
+    /// @brief Bytes of source the hits did not map and lex again.
+    uint64_t bytesSaved = 0;
+  };
+
+  /// @brief Files mapped and tokenized once for every translation unit a
+  /// process compiles. Preprocessors sharing the cache enter a header that
+  /// another has already read without touching the file again.
+  ///
+  /// Files are keyed by `FileIdentity` rather than by path, so links to one
+  /// file share an entry and a file written since it was cached is read
+  /// again. Each file is lexed into an identifier table of its own, since
+  /// the tables of translation units are not synchronized, and is read-only
+  /// once cached. Readers map its identifiers into their own table.
+  ///
+  /// The cache is synchronized. A file looked up by several threads at once
+  /// is lexed by the first, while the others wait for its tokens. Entries
+  /// are kept until the cache is destroyed.
+  class HeaderCache
+  {
+  public:
+    HeaderCache() = default;
+
+    HeaderCache(const HeaderCache &) = delete;
+    HeaderCache &operator=(const HeaderCache &) = delete;
+
+    /// @brief Finds the tokens of the current version of a file, mapping and
+    /// tokenizing it if it has not been seen before.
+    ///
+    /// @param path Path of the file.
+    /// @returns Lexer that tokenized the file, which holds its mapping, its
+    /// tokens and the tables they refer to.
+    ///
+    /// @throws `std::system_error` Thrown when the file can't be mapped.
+    std::shared_ptr<const CLangLexer> Get(const std::filesystem::path &path);
+
+    /// @returns Counts of the lookups so far.
+    HeaderCacheStatistics GetStatistics() const;
+
+  private:
+    struct FileIdentityHash
+    {
+      size_t operator()(const FileIdentity &identity) const;
+    };
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<FileIdentity,
+                       std::shared_future<std::shared_ptr<const CLangLexer>>,
+                       FileIdentityHash>
+        m_files;
+    HeaderCacheStatistics m_statistics;
+  };
+} // namespace Vypr
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "Vypr/Lexer/CLangToken.hpp"
+#include "Vypr/Lexer/IdentifierTable.hpp"
+
+namespace Vypr
+{
+  /// @brief Definition of a macro. Its parameters and replacement list are
+  /// stored in the arrays of its `MacroTable`.
+  struct Macro
+  {
+    /// @brief Flag of macros defined with a parameter list.
+    static constexpr uint8_t FunctionLike = 1 << 0;
+
+    /// @brief Flag of function-like macros whose last parameter is `...`.
+    static constexpr uint8_t Variadic = 1 << 1;
+
+    Identifier name;
+
+    /// @brief Index of the first replacement token in the table.
+    uint32_t firstToken;
+    uint32_t tokenCount;
+
+    /// @brief Index of the first parameter name in the table.
+    uint32_t firstParameter;
+    uint32_t parameterCount;
+
+    /// @brief Combination of `FunctionLike` and `Variadic`.
+    uint8_t flags;
+  };
+
+  /// @brief Macros defined while preprocessing a translation unit. Macros are
+  /// looked up by identifier in an array, so telling whether an identifier
+  /// names a macro costs one load and no hashing.
+  ///
+  /// Replacement lists are stored as packed tokens back to back in one array,
+  /// with values that refer to the tables of the lexer the preprocessor
+  /// feeds, and parameter names likewise in another. Redefining a macro
+  /// leaves its old definition in the arrays. The table is not synchronized.
+  class MacroTable
+  {
+  public:
+    MacroTable() = default;
+
+    MacroTable(const MacroTable &) = delete;
+    MacroTable &operator=(const MacroTable &) = delete;
+
+    /// @brief Defines a macro, replacing any previous definition of the name.
+    ///
+    /// @param name Name of the macro.
+    /// @param parameters Parameter names of a function-like macro.
+    /// @param replacement Tokens the macro is replaced with.
+    /// @param flags Combination of `Macro::FunctionLike` and
+    /// `Macro::Variadic`.
+    void Define(Identifier name, std::span<const Identifier> parameters,
+                std::span<const CLangToken> replacement, uint8_t flags);
+
+    /// @brief Removes the definition of a macro if there is one.
+    ///
+    /// @param name Name of the macro.
+    void Undefine(Identifier name);
+
+    /// @param name Identifier to look up.
+    /// @returns Definition of the macro named `name` or `nullptr` if there is
+    /// none. The pointer is invalidated by the next `Define`.
+    inline const Macro *Find(Identifier name) const
+    {
+      uint32_t index = static_cast<uint32_t>(name);
+      if (index >= m_definitions.size() || m_definitions[index] == NoMacro)
+      {
+        return nullptr;
+      }
+      return &m_macros[m_definitions[index]];
+    }
+
+    /// @param name Identifier to look up.
+    /// @returns Whether a macro named `name` is defined.
+    inline bool IsDefined(Identifier name) const
+    {
+      return Find(name) != nullptr;
+    }
+
+    /// @param macro Definition returned by `Find`.
+    /// @returns Replacement list of `macro`.
+    inline std::span<const CLangToken> GetReplacement(const Macro &macro) const
+    {
+      return {m_tokens.data() + macro.firstToken, macro.tokenCount};
+    }
+
+    /// @param macro Definition returned by `Find`.
+    /// @returns Parameter names of `macro`.
+    inline std::span<const Identifier> GetParameters(const Macro &macro) const
+    {
+      return {m_parameters.data() + macro.firstParameter,
+              macro.parameterCount};
+    }
+
+    /// @param index Index in the table of a replacement token, counting from
+    /// `Macro::firstToken`.
+    /// @returns Replacement token at `index`.
+    inline const CLangToken &GetToken(uint32_t index) const
+    {
+      return m_tokens[index];
+    }
+
+    /// @returns Number of macros defined.
+    inline size_t GetCount() const
+    {
+      return m_count;
+    }
+
+    /// @returns Number that changes whenever a macro is defined or
+    /// undefined, so that results depending on the definitions can tell
+    /// when they are stale.
+    inline uint32_t GetGeneration() const
+    {
+      return m_generation;
+    }
+
+    /// @param name Identifier to look up.
+    /// @returns Generation in which `name` was last defined or undefined, or
+    /// zero if it never was. Results that only depend on a few names are
+    /// stale once one of these is past the generation they were made in.
+    inline uint32_t GetGeneration(Identifier name) const
+    {
+      uint32_t index = static_cast<uint32_t>(name);
+      return index < m_changed.size() ? m_changed[index] : 0;
+    }
+
+  private:
+    /// @brief Index in `m_definitions` of identifiers that are not macros.
+    static constexpr uint32_t NoMacro = UINT32_MAX;
+
+    /// @brief Index in `m_macros` of the definition of each identifier.
+    std::vector<uint32_t> m_definitions;
+
+    /// @brief Generation in which each identifier was last defined or
+    /// undefined.
+    std::vector<uint32_t> m_changed;
+    std::vector<Macro> m_macros;
+    std::vector<CLangToken> m_tokens;
+    std::vector<Identifier> m_parameters;
+    size_t m_count = 0;
+    uint32_t m_generation = 0;
+  };
+} // namespace Vypr
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "Vypr/AST/SymbolTable.hpp"
+#include "Vypr/Lexer/IdentifierTable.hpp"
+#include "Vypr/Lexer/LiteralTable.hpp"
+#include "Vypr/Preprocessor/MacroTable.hpp"
+
+namespace Vypr
+{
+  class MappedFileScanner;
+
+  /// @brief Snapshot of the state a compile reaches after reading a common
+  /// prelude: the interned identifiers, the macros defined and the symbols of
+  /// the outermost scope of the `TypeTable`. Loading one replaces lexing,
+  /// preprocessing and declaring the prelude again.
+  ///
+  /// The file is a header of section offsets followed by flat arrays of
+  /// fixed-size records: identifier names and their ends, the values of
+  /// constants and string literals used by macros, macro records with their
+  /// packed replacement tokens and parameters, and symbol records with their
+  /// types. It is mapped read-only and checked once when opened, so that
+  /// loading copies records without validating them again. Files are in the
+  /// byte order of the machine that wrote them, so one written in another
+  /// order fails the version check.
+  class PrecompiledHeader
+  {
+  public:
+    /// @brief Version of the file format. Bump it whenever the layout of the
+    /// file, `CLangToken` or `CLangTokenType` changes.
+    static constexpr uint32_t Version = 1;
+
+    /// @brief Writes a precompiled header. Macros whose replacement list
+    /// holds an `Error` token are left out, since its diagnostic belongs to
+    /// the compile that wrote the file.
+    ///
+    /// @param path Path of the file to write.
+    /// @param identifiers Table every identifier of `macros` and `types` was
+    /// interned into.
+    /// @param macros Macros defined by the prelude.
+    /// @param literals Table the values of the replacement tokens are in.
+    /// @param types Symbols declared by the prelude.
+    ///
+    /// @throws `std::system_error` Thrown when the file can't be written.
+    static void Write(const std::filesystem::path &path,
+                      const IdentifierTable &identifiers,
+                      const MacroTable &macros, const LiteralTable &literals,
+                      const TypeTable &types);
+
+    /// @brief Maps a precompiled header, checks it and interns its
+    /// identifiers.
+    ///
+    /// @param path Path of a file written by `Write`.
+    /// @param identifiers Table to intern the identifiers into, which the
+    /// loaded macros and symbols refer to.
+    ///
+    /// @throws `std::system_error` Thrown when the file can't be mapped.
+    /// @throws `std::runtime_error` Thrown when the file is not a precompiled
+    /// header of this `Version`.
+    PrecompiledHeader(const std::filesystem::path &path,
+                      std::shared_ptr<IdentifierTable> identifiers);
+
+    ~PrecompiledHeader();
+
+    PrecompiledHeader(const PrecompiledHeader &) = delete;
+    PrecompiledHeader &operator=(const PrecompiledHeader &) = delete;
+
+    /// @brief Defines the macros of the prelude.
+    ///
+    /// @param macros Table to define the macros in.
+    /// @param literals Table receiving the values of the replacement tokens,
+    /// which is that of the lexer the macros are expanded for.
+    void LoadMacros(MacroTable &macros, LiteralTable &literals) const;
+
+    /// @brief Declares the symbols of the prelude in the current scope.
+    ///
+    /// @param types Table to declare the symbols in.
+    void LoadSymbols(TypeTable &types) const;
+
+    /// @returns Table the identifiers were interned into.
+    inline const std::shared_ptr<IdentifierTable> &GetIdentifiers() const
+    {
+      return m_identifiers;
+    }
+
+  private:
+    std::unique_ptr<MappedFileScanner> m_file;
+    std::string_view m_image;
+    std::shared_ptr<IdentifierTable> m_identifiers;
+
+    /// @brief Identifier in `m_identifiers` of each identifier of the file.
+    std::vector<Identifier> m_names;
+  };
+} // namespace Vypr
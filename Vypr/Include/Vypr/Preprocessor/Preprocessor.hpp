@@ -0,0 +1,594 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Vypr/Lexer/CLangToken.hpp"
+#include "Vypr/Lexer/DiagnosticSink.hpp"
+#include "Vypr/Lexer/IdentifierTable.hpp"
+#include "Vypr/Lexer/LiteralTable.hpp"
+#include "Vypr/Preprocessor/MacroTable.hpp"
+
+namespace Vypr
+{
+  class CLangLexer;
+  class HeaderCache;
+  class PrecompiledHeader;
+
+  /// @brief Where a `Preprocessor` looks for included files.
+  struct PreprocessorOptions
+  {
+    /// @brief Path of the main source. Quoted includes in it are looked up
+    /// in its directory first, or in the working directory if it is empty.
+    std::filesystem::path sourcePath;
+
+    /// @brief Directories searched for included files, in order.
+    std::vector<std::filesystem::path> includeDirectories;
+
+    /// @brief Precompiled prelude whose macros are defined before the main
+    /// source is read, or `nullptr`. It must have been opened with the
+    /// identifier table of the lexer.
+    std::shared_ptr<const PrecompiledHeader> precompiledHeader;
+
+    /// @brief Cache that included files are read through, shared with the
+    /// other translation units of the process, or `nullptr` to map and lex
+    /// every file entered.
+    std::shared_ptr<HeaderCache> headerCache;
+  };
+
+  /// @brief Counts of the work a `Preprocessor` did and avoided.
+  struct PreprocessorStatistics
+  {
+    /// @brief Number of files opened and lexed, including the main source.
+    uint32_t filesEntered = 0;
+
+    /// @brief Number of the files entered whose tokens were taken from the
+    /// `HeaderCache`.
+    uint32_t cachedFiles = 0;
+
+    /// @brief Number of includes skipped without opening the file, because it
+    /// was marked `#pragma once` or its include guard was already defined.
+    uint32_t includesSkipped = 0;
+
+    /// @brief Number of macro invocations replaced in the output. Those in
+    /// the replacement of a cached expansion are part of it and are not
+    /// counted.
+    uint32_t macrosExpanded = 0;
+
+    /// @brief Number of object-like macro invocations replaced by the cached
+    /// result of expanding the macro, without expanding the macros in it.
+    uint32_t cachedExpansions = 0;
+
+    /// @brief Number of object-like macro invocations that expanded the
+    /// macro to cache the result, because it had not been cached or a macro
+    /// it used was defined or undefined since.
+    uint32_t cacheMisses = 0;
+  };
+
+  /// @brief Runs the preprocessing directives of a source and hands the
+  /// parser the tokens that remain, with those of included files spliced in.
+  ///
+  /// Every file is tokenized in one pass when it is entered, and directives
+  /// are recognized on its token buffer by a `#` at the start of a line, so
+  /// directive lines are never lexed twice. Skipped groups are walked token by
+  /// token, counting nested conditionals, without evaluating anything.
+  ///
+  /// A file whose tokens are all inside one `#ifndef` group, like a header
+  /// with an include guard, is remembered with its guard macro. Including it
+  /// again while the macro is defined is then skipped without opening the
+  /// file, as are files marked `#pragma once`.
+  ///
+  /// Macros are expanded on tokens, never on text. An invocation pushes a
+  /// context that replays the macro's packed replacement list, or for a
+  /// function-like macro the list with the arguments substituted, and the
+  /// context is rescanned ahead of the file with the macro disabled. Tokens
+  /// of contexts live in one arena that grows and shrinks with the context
+  /// stack, and the buffers of argument substitution are kept per nesting
+  /// level, so that once they have grown expanding allocates nothing.
+  ///
+  /// The full expansion of an object-like macro is cached the first time it
+  /// is invoked while no other macro is being expanded, and later such
+  /// invocations replay the cached tokens without expanding the macros in
+  /// them again. Each entry records the identifiers looked up while
+  /// expanding it, and is only made again once one of those is defined or
+  /// undefined, so unrelated directives such as include guards keep it.
+  ///
+  /// Included files are read through a `HeaderCache` if one is given. Their
+  /// tokens then refer to the tables of the cached lexer, which are shared
+  /// read-only, so identifiers are mapped to the preprocessor's table as
+  /// they are read and literals are copied as for any other file.
+  ///
+  /// Tokens of included files are given the offset of the `#include` in the
+  /// main source that brought them in and the `CLangToken::Relocated` flag,
+  /// so that diagnostics of headers point at a line of the main source.
+  /// Tokens of macro expansions are likewise given the offset of the macro
+  /// name.
+  class Preprocessor
+  {
+  public:
+    /// @brief Most files that may be open at once, which stops files that
+    /// include themselves.
+    static constexpr size_t MaximumIncludeDepth = 200;
+
+    /// @param source Main source, which must outlive the preprocessor.
+    /// @param identifiers Table that identifier names of every file are
+    /// interned into.
+    /// @param options Where to look for included files.
+    Preprocessor(std::string_view source,
+                 std::shared_ptr<IdentifierTable> identifiers,
+                 const PreprocessorOptions &options);
+
+    ~Preprocessor();
+
+    Preprocessor(const Preprocessor &) = delete;
+    Preprocessor &operator=(const Preprocessor &) = delete;
+
+    /// @brief Runs directives and expands macros up to the next token that is
+    /// not part of either. Values of constants and string literals are copied
+    /// to the given tables, which the returned tokens refer to.
+    ///
+    /// @param literals Table receiving the values of constants and string
+    /// literals.
+    /// @param diagnostics Sink receiving the diagnostics of `Error` tokens.
+    /// @returns Next token or a token of type `CLangTokenType::NoToken` at
+    /// the end of the main source. Malformed directives become `Error`
+    /// tokens spanning the directive, and malformed macro invocations ones
+    /// spanning the macro name.
+    CLangToken GetToken(LiteralTable &literals, DiagnosticSink &diagnostics);
+
+    /// @brief Defines the macros of a precompiled prelude.
+    ///
+    /// @param header Precompiled header opened with the identifier table of
+    /// the preprocessor.
+    /// @param literals Table of the lexer being fed, receiving the values of
+    /// the replacement tokens.
+    void Load(const PrecompiledHeader &header, LiteralTable &literals);
+
+    /// @returns Macros defined so far.
+    inline const MacroTable &GetMacros() const
+    {
+      return m_macros;
+    }
+
+    /// @returns Counts of the files entered and skipped so far.
+    inline const PreprocessorStatistics &GetStatistics() const
+    {
+      return m_statistics;
+    }
+
+  private:
+    /// @brief How far a file has been found to be wrapped in an include
+    /// guard.
+    enum class GuardState : uint8_t
+    {
+      /// @brief Nothing but whitespace and comments has been read yet.
+      Start,
+
+      /// @brief The file started with `#ifndef`, whose group is still open.
+      Open,
+
+      /// @brief The group of the first `#ifndef` ended and nothing has
+      /// followed it yet.
+      Closed,
+
+      /// @brief The file is not guarded.
+      None
+    };
+
+    /// @brief File being read and the position in its tokens.
+    struct Frame
+    {
+      /// @brief Lexer that tokenized the file.
+      std::shared_ptr<const CLangLexer> file;
+
+      /// @brief Identifier in the preprocessor's table of each identifier of
+      /// `file`, or `nullptr` if it was lexed into that table.
+      const Identifier *names;
+
+      /// @brief Canonical path of the file and the directory it is in.
+      std::string path;
+      std::filesystem::path directory;
+
+      /// @brief Index of the next token to read.
+      size_t next;
+
+      /// @brief Offset of the `#include` in the main source that the file
+      /// was entered from, or `CLangToken::NoPosition` for the main source.
+      uint32_t includeOffset;
+
+      /// @brief Number of conditionals open when the file was entered.
+      size_t conditionalBase;
+
+      GuardState guardState;
+
+      /// @brief Macro tested by the guard and the number of conditionals
+      /// open inside its group.
+      Identifier guardMacro;
+      size_t guardDepth;
+    };
+
+    /// @brief Conditional whose group is being read.
+    struct Conditional
+    {
+      /// @brief Index of the `#` of its `#if` in the file's tokens.
+      size_t start;
+
+      /// @brief Whether its `#else` has been read.
+      bool sawElse;
+    };
+
+    /// @brief Directive line of the top frame.
+    struct Directive
+    {
+      /// @brief Index of the `#` and one past the last token of the line.
+      size_t start;
+      size_t end;
+
+      /// @brief Name of the directive or `Identifier::None` if it has none.
+      Identifier name;
+    };
+
+    /// @brief Storage of the tokens of a context.
+    enum class ContextSource : uint8_t
+    {
+      /// @brief Replacement list in the macro table.
+      Replacement,
+
+      /// @brief Cached expansion of an object-like macro.
+      Cache,
+
+      /// @brief Tokens pushed onto the arena.
+      Arena
+    };
+
+    /// @brief Run of tokens read ahead of the files, such as the replacement
+    /// of a macro invocation.
+    struct Context
+    {
+      ContextSource source;
+
+      /// @brief Whether reaching the end of the context ends the input,
+      /// which expands an argument or a condition on its own.
+      bool barrier;
+
+      /// @brief Flags of the macro name, given to the first token.
+      uint8_t flags;
+
+      /// @brief Macro disabled while the context is read, or
+      /// `Identifier::None`.
+      Identifier macro;
+
+      /// @brief Indices of the first, next and one past the last token.
+      uint32_t begin;
+      uint32_t next;
+      uint32_t end;
+
+      /// @brief Offset given to the tokens, or `CLangToken::NoPosition` to
+      /// keep theirs.
+      uint32_t offset;
+
+      /// @brief Size of the arena before the context was pushed.
+      uint32_t arenaBase;
+    };
+
+    /// @brief Index of an argument that has not been expanded, or of a cache
+    /// entry that has not been made.
+    static constexpr uint32_t NoExpansion = UINT32_MAX;
+
+    /// @brief Index returned by `FindParameter` for tokens that are not
+    /// parameters.
+    static constexpr size_t NoParameter = SIZE_MAX;
+
+    /// @brief Buffers of the function-like macro invocations at one level of
+    /// nested expansion, kept to reuse their storage.
+    struct Scratch
+    {
+      /// @brief Tokens of the arguments, back to back, and the index of the
+      /// first token of each followed by the end of the last.
+      std::vector<CLangToken> arguments;
+      std::vector<uint32_t> bounds;
+
+      /// @brief Fully expanded arguments and the start and end of each in
+      /// `expanded`, or `NoExpansion` if it has not been expanded.
+      std::vector<CLangToken> expanded;
+      std::vector<uint32_t> expandedBounds;
+
+      /// @brief Replacement list being substituted.
+      std::vector<CLangToken> result;
+
+      /// @brief Expansion of an object-like macro being cached.
+      std::vector<CLangToken> cached;
+    };
+
+    /// @brief Cached expansion of an object-like macro.
+    struct CacheEntry
+    {
+      /// @brief Generation of the macro table the entry was made in, or
+      /// `NoExpansion`.
+      uint32_t generation = NoExpansion;
+
+      /// @brief Whether the expansion could be cached, and where its tokens
+      /// are in `m_cacheTokens`.
+      bool cached = false;
+      uint32_t begin = 0;
+      uint32_t end = 0;
+
+      /// @brief Where the identifiers looked up while expanding the macro,
+      /// the macro's own name among them, are in `m_cacheDependencies`.
+      uint32_t firstDependency = 0;
+      uint32_t dependencyEnd = 0;
+    };
+
+    /// @brief Takes the next token without expanding it. Contexts are read
+    /// before the files, and directives of the files are run.
+    ///
+    /// @returns Next token or a token of type `CLangTokenType::NoToken` at
+    /// a barrier or the end of the main source.
+    CLangToken ReadToken();
+
+    /// @returns Type of the token `ReadToken` would return, without running
+    /// a directive or leaving a file. Directives are seen as a `#`.
+    CLangTokenType PeekTokenType();
+
+    /// @brief Takes the next token of the files, running directives.
+    CLangToken ReadFileToken();
+
+    /// @brief Takes the next token of a context.
+    CLangToken TakeToken(Context &context);
+
+    /// @brief Replaces a macro invocation with a context if a token starts
+    /// one. Names of disabled macros are flagged `CLangToken::NoExpand`.
+    ///
+    /// @param token Token just read.
+    /// @returns Whether the token was the name of an invocation, which it
+    /// replaced.
+    bool Expand(CLangToken &token);
+
+    /// @brief Replaces an invocation of an object-like macro.
+    void ExpandObject(const Macro &macro, const CLangToken &name);
+
+    /// @brief Collects the arguments of an invocation of a function-like
+    /// macro and replaces it with its substituted replacement list.
+    void ExpandFunction(const Macro &macro, const CLangToken &name);
+
+    /// @brief Substitutes the collected arguments into a replacement list.
+    ///
+    /// @param scratch Buffers holding the arguments and receiving the
+    /// result.
+    void Substitute(const Macro &macro, Scratch &scratch);
+
+    /// @brief Fully expands a context on its own, as if it were the rest of
+    /// the input.
+    ///
+    /// @param context Context to expand, which is read as a barrier.
+    /// @param output Vector receiving the expansion.
+    void ExpandIsolated(Context context, std::vector<CLangToken> &output);
+
+    /// @brief Caches the full expansion of an object-like macro unless it is
+    /// incomplete on its own, e.g. it invokes a function-like macro without
+    /// closing the argument list.
+    void CacheExpansion(const Macro &macro, CacheEntry &entry);
+
+    /// @returns Whether a cache entry was made and none of the identifiers
+    /// it depends on has been defined or undefined since.
+    bool IsCurrent(const CacheEntry &entry) const;
+
+    /// @brief Drops the tokens and dependencies that entries made again
+    /// left behind. No cached expansion may be being replayed.
+    void CompactCache();
+
+    /// @brief Pushes tokens onto the arena.
+    ///
+    /// @returns Context reading the tokens, with no macro disabled.
+    Context PushArena(std::span<const CLangToken> tokens);
+
+    void PushContext(const Context &context);
+    void PopContext();
+
+    /// @returns Scratch buffers of a nesting level.
+    Scratch &GetScratch(size_t depth);
+
+    /// @returns Index among the parameters of `macro` of the parameter a
+    /// token names, or `NoParameter`.
+    size_t FindParameter(const Macro &macro, const CLangToken &token) const;
+
+    /// @brief Pastes two tokens into one with `##`.
+    ///
+    /// @returns Token spelled by the two spellings joined, or a token of
+    /// type `CLangTokenType::NoToken` if they do not spell a single token.
+    CLangToken Paste(const CLangToken &left, const CLangToken &right);
+
+    /// @brief Appends the spelling of a token. Constants and string literals
+    /// are spelled from their value, so escapes and number formats are not
+    /// kept as written.
+    void AppendSpelling(const CLangToken &token, std::string &text) const;
+
+    /// @brief Reads the directive line at the next token of the top frame
+    /// and moves past it.
+    Directive ReadDirective();
+
+    /// @brief Runs a directive of a group that is not skipped.
+    void RunDirective(const Directive &directive);
+
+    /// @brief Runs an `#include` directive.
+    void RunInclude(const Directive &directive);
+
+    /// @brief Runs a `#define` directive.
+    void RunDefine(const Directive &directive);
+
+    /// @brief Opens a conditional and skips its first group unless the
+    /// group is taken.
+    ///
+    /// @param directive `#if`, `#ifdef` or `#ifndef` directive.
+    /// @param taken Whether the condition of the directive holds.
+    void StartConditional(const Directive &directive, bool taken);
+
+    /// @brief Expands the macros in the condition of an `#if` or `#elif`
+    /// directive, except the operands of `defined`, and evaluates it. A
+    /// malformed condition is reported and does not hold.
+    ///
+    /// @returns Whether the condition holds.
+    bool EvaluateCondition(const Directive &directive);
+
+    /// @brief Skips the rest of a conditional group up to the `#elif` or
+    /// `#else` of the next group that is taken or to the `#endif`.
+    ///
+    /// @param taken Whether a group of the conditional was already taken,
+    /// in which case every following group is skipped.
+    void SkipGroup(bool taken);
+
+    /// @brief Closes the innermost conditional.
+    void EndConditional();
+
+    /// @brief Opens an included file and makes it the top frame.
+    ///
+    /// @param path Canonical path of the file.
+    /// @param includeOffset Offset in the main source of the `#include`.
+    void Enter(const std::string &path, uint32_t includeOffset);
+
+    /// @brief Leaves the top frame once its tokens have all been read.
+    void Leave();
+
+    /// @brief Finds the file an `#include` of the top frame names.
+    ///
+    /// @param name Name between the quotes or angle brackets.
+    /// @param angled Whether the name was between angle brackets, in which
+    /// case the directory of the including file is not searched.
+    /// @returns Canonical path of the file or an empty string if there is
+    /// none.
+    const std::string &Resolve(std::string_view name, bool angled);
+
+    /// @brief Queues an `Error` token spanning tokens of the top frame.
+    ///
+    /// @param id Problem found.
+    /// @param start Index of the first token spanned.
+    /// @param end One past the index of the last token spanned.
+    void Fail(DiagnosticId id, size_t start, size_t end);
+
+    /// @brief Queues an `Error` token in place of a token that was read.
+    /// While an expansion is being cached, marks it incomplete instead.
+    ///
+    /// @param id Problem found.
+    /// @param token Token the problem was found at.
+    void Fail(DiagnosticId id, const CLangToken &token);
+
+    /// @brief Copies a token of the top frame to the tables of the lexer the
+    /// preprocessor feeds.
+    CLangToken Relocate(CLangToken token) const;
+
+    /// @returns Interned name of a token of the top frame or
+    /// `Identifier::None` if it is not an identifier.
+    Identifier GetIdentifier(size_t index) const;
+
+    std::shared_ptr<IdentifierTable> m_identifiers;
+    std::vector<std::filesystem::path> m_includeDirectories;
+    MacroTable m_macros;
+    PreprocessorStatistics m_statistics;
+
+    /// @brief Tables of the lexer being fed, set by each `GetToken`.
+    LiteralTable *m_literals;
+    DiagnosticSink *m_diagnostics;
+
+    /// @brief Files being read, the main source first.
+    std::vector<Frame> m_frames;
+
+    /// @brief Open conditionals of every frame, innermost last.
+    std::vector<Conditional> m_conditionals;
+
+    /// @brief `Error` tokens of malformed directives and invocations,
+    /// returned before the next token.
+    std::vector<CLangToken> m_errors;
+    size_t m_nextError;
+
+    /// @brief Canonical paths of files marked `#pragma once`.
+    std::unordered_set<std::string> m_onceFiles;
+
+    /// @brief Guard macro of each file found to have an include guard.
+    std::unordered_map<std::string, Identifier> m_guards;
+
+    /// @brief Identifiers of the files entered from `m_headerCache`, keyed by
+    /// their lexer, which the entry keeps alive.
+    struct CachedNames
+    {
+      std::shared_ptr<const CLangLexer> file;
+      std::vector<Identifier> names;
+    };
+
+    std::shared_ptr<HeaderCache> m_headerCache;
+    std::unordered_map<const CLangLexer *, CachedNames> m_cachedNames;
+
+    /// @brief Canonical path each include name resolved to, keyed by the
+    /// directory searched first and the name.
+    std::unordered_map<std::string, std::string> m_resolved;
+
+    /// @brief Parameters and replacement list of the macro being defined,
+    /// kept to reuse their storage.
+    std::vector<Identifier> m_parameters;
+    std::vector<CLangToken> m_replacement;
+
+    /// @brief Contexts being read, innermost last, and the tokens of those
+    /// read from the arena.
+    std::vector<Context> m_contexts;
+    std::vector<CLangToken> m_arena;
+
+    /// @brief Whether each macro is disabled, by identifier, and the number
+    /// disabled.
+    std::vector<bool> m_disabled;
+    size_t m_disabledCount;
+
+    /// @brief Buffers of each level of nested expansion and the current
+    /// level.
+    std::deque<Scratch> m_scratch;
+    size_t m_depth;
+
+    /// @brief Cached expansion of each object-like macro, by identifier, the
+    /// tokens and dependencies of the entries, and the number of those left
+    /// behind by entries made again.
+    std::vector<CacheEntry> m_cache;
+    std::vector<CLangToken> m_cacheTokens;
+    std::vector<Identifier> m_cacheDependencies;
+    size_t m_cacheGarbage;
+
+    /// @brief Whether an expansion is being cached and whether it was found
+    /// incomplete.
+    bool m_caching;
+    bool m_cacheFailed;
+
+    /// @brief Condition being evaluated before and after expansion.
+    std::vector<CLangToken> m_condition;
+    std::vector<CLangToken> m_expandedCondition;
+
+    /// @brief Spellings of the tokens being pasted or stringized.
+    std::string m_spelling;
+
+    /// @brief Interned names of the directives and of `defined`, `once` and
+    /// `__VA_ARGS__`.
+    Identifier m_include;
+    Identifier m_define;
+    Identifier m_undef;
+    Identifier m_ifdef;
+    Identifier m_ifndef;
+    Identifier m_elif;
+    Identifier m_endif;
+    Identifier m_pragma;
+    Identifier m_error;
+    Identifier m_line;
+    Identifier m_warning;
+    Identifier m_defined;
+    Identifier m_once;
+    Identifier m_variadicArguments;
+
+    /// @brief Names of the `if` and `else` directives, which are lexed as
+    /// keywords.
+    Identifier m_if;
+    Identifier m_else;
+  };
+} // namespace Vypr
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <string_view>
+
+#include "Vypr/Scanner/Scanner.hpp"
+
+namespace Vypr
+{
+  /// @brief Scanner over a UTF-8 buffer owned by the caller. The buffer is
+  /// scanned in place and is never copied.
+  class BufferScanner : public Scanner
+  {
+  public:
+    /// @brief Constructs a scanner over `source`. The buffer is borrowed and
+    /// must outlive the scanner.
+    ///
+    /// @param source UTF-8 encoded buffer to retrieve characters from.
+    BufferScanner(std::string_view source = {});
+  };
+} // namespace Vypr
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace Vypr
+{
+  /// @brief Bit flags describing how the C lexer treats a byte. Classes are
+  /// ASCII only so lexing does not depend on the current locale; bytes of
+  /// multi-byte UTF-8 sequences only belong to `Identifier`.
+  namespace CharacterClass
+  {
+    constexpr uint8_t Whitespace = 1 << 0;
+    constexpr uint8_t Digit = 1 << 1;
+    constexpr uint8_t Alpha = 1 << 2;
+    constexpr uint8_t HexDigit = 1 << 3;
+
+    /// @brief Single character punctuators, which also start every longer
+    /// punctuator.
+    constexpr uint8_t Punctuator = 1 << 4;
+
+    /// @brief Continues an identifier. Every byte that is not whitespace, a
+    /// punctuator, a quote or `\` (which starts a universal character).
+    constexpr uint8_t Identifier = 1 << 5;
+  } // namespace CharacterClass
+
+  /// @brief `CharacterClass` flags of every byte.
+  constexpr std::array<uint8_t, 256> CharacterClasses = [] {
+    std::array<uint8_t, 256> classes{};
+    for (int c = 0; c < 256; c++)
+    {
+      uint8_t flags = 0;
+      if (c == ' ' || (c >= '\t' && c <= '\r'))
+      {
+        flags |= CharacterClass::Whitespace;
+      }
+      if (c >= '0' && c <= '9')
+      {
+        flags |= CharacterClass::Digit | CharacterClass::HexDigit;
+      }
+      if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'))
+      {
+        flags |= CharacterClass::Alpha;
+      }
+      if ((c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F'))
+      {
+        flags |= CharacterClass::HexDigit;
+      }
+      for (char punctuator : "[](){}.*+-~!/%<>&|^?:;=,#")
+      {
+        if (punctuator != '\0' && c == punctuator)
+        {
+          flags |= CharacterClass::Punctuator;
+        }
+      }
+      bool isSeparator =
+          (flags & CharacterClass::Whitespace) != 0 ||
+          (flags & CharacterClass::Punctuator) != 0 || c == '"' || c == '\'';
+      if (!isSeparator && c != '\\')
+      {
+        flags |= CharacterClass::Identifier;
+      }
+      classes[c] = flags;
+    }
+    return classes;
+  }();
+
+  /// @returns Whether `c` belongs to any of the `CharacterClass` flags in
+  /// `characterClass`.
+  constexpr bool HasCharacterClass(char c, uint8_t characterClass)
+  {
+    return (CharacterClasses[static_cast<unsigned char>(c)] & characterClass) !=
+           0;
+  }
+
+  constexpr bool IsSpace(char c)
+  {
+    return HasCharacterClass(c, CharacterClass::Whitespace);
+  }
+
+  constexpr bool IsDigit(char c)
+  {
+    return HasCharacterClass(c, CharacterClass::Digit);
+  }
+
+  constexpr bool IsAlpha(char c)
+  {
+    return HasCharacterClass(c, CharacterClass::Alpha);
+  }
+
+  constexpr bool IsHexDigit(char c)
+  {
+    return HasCharacterClass(c, CharacterClass::HexDigit);
+  }
+
+  constexpr bool IsPunctuator(char c)
+  {
+    return HasCharacterClass(c, CharacterClass::Punctuator);
+  }
+
+  constexpr bool IsIdentifier(char c)
+  {
+    return HasCharacterClass(c, CharacterClass::Identifier);
+  }
+} // namespace Vypr
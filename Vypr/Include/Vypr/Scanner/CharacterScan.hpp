@@ -0,0 +1,70 @@
+#pragma once
+
+namespace Vypr
+{
+  /// @brief Finds the end of a run of ASCII whitespace (space, `\t`, `\n`,
+  /// `\v`, `\f` and `\r`). Scans a vector block at a time when available.
+  ///
+  /// @param begin Start of the range to scan.
+  /// @param end End of the range to scan.
+  /// @returns First character in `[begin, end)` that is not whitespace or
+  /// `end` if there is none.
+  const char *FindNonWhitespace(const char *begin, const char *end);
+
+  /// @brief Finds a character. Scans a vector block at a time when available.
+  ///
+  /// @param begin Start of the range to scan.
+  /// @param end End of the range to scan.
+  /// @param character Character to find.
+  /// @returns First occurrence of `character` in `[begin, end)` or `end` if
+  /// there is none.
+  const char *FindCharacter(const char *begin, const char *end,
+                            char character);
+
+  /// @brief Finds the first of either of two characters. Scans a vector
+  /// block at a time when available.
+  ///
+  /// @param begin Start of the range to scan.
+  /// @param end End of the range to scan.
+  /// @param first First character to find.
+  /// @param second Second character to find.
+  /// @returns First occurrence of either character in `[begin, end)` or
+  /// `end` if there is none.
+  const char *FindAny(const char *begin, const char *end, char first,
+                      char second);
+
+  /// @brief Finds the first of any of three characters. Scans a vector block
+  /// at a time when available.
+  ///
+  /// @param begin Start of the range to scan.
+  /// @param end End of the range to scan.
+  /// @param first First character to find.
+  /// @param second Second character to find.
+  /// @param third Third character to find.
+  /// @returns First occurrence of any of the characters in `[begin, end)` or
+  /// `end` if there is none.
+  const char *FindAny(const char *begin, const char *end, char first,
+                      char second, char third);
+
+  /// @brief Finds two adjacent characters, such as the `*/` closing a block
+  /// comment. Scans a vector block at a time when available.
+  ///
+  /// @param begin Start of the range to scan.
+  /// @param end End of the range to scan.
+  /// @param first First character of the pair.
+  /// @param second Second character of the pair.
+  /// @returns Position of the first occurrence of the pair in `[begin, end)`
+  /// or `end` if there is none.
+  const char *FindPair(const char *begin, const char *end, char first,
+                       char second);
+
+  /// @brief Finds the end of a run of `CharacterClass::Identifier` bytes.
+  /// Letters, digits, `_` and non-ASCII bytes are matched a vector block at a
+  /// time; any other byte is classified through `CharacterClasses`.
+  ///
+  /// @param begin Start of the range to scan.
+  /// @param end End of the range to scan.
+  /// @returns First character in `[begin, end)` that does not continue an
+  /// identifier or `end` if there is none.
+  const char *FindIdentifierEnd(const char *begin, const char *end);
+} // namespace Vypr
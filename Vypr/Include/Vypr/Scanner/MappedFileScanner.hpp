@@ -0,0 +1,32 @@
+#pragma once
+
+#include <filesystem>
+
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+namespace Vypr
+{
+  /// @brief Scanner over a file that is memory mapped for the lifetime of the
+  /// scanner. The file is scanned in place without reading it into memory.
+  class MappedFileScanner : public BufferScanner
+  {
+  public:
+    /// @brief Maps the file at `path` read-only.
+    ///
+    /// @param path Path of the UTF-8 encoded source file.
+    ///
+    /// @throws `std::system_error` Thrown when the file can't be opened or
+    /// mapped, or is larger than `SourceManager::MaxSize` bytes.
+    MappedFileScanner(const std::filesystem::path &path);
+
+    MappedFileScanner(const MappedFileScanner &) = delete;
+    MappedFileScanner &operator=(const MappedFileScanner &) = delete;
+
+    /// @brief Unmaps the file.
+    ~MappedFileScanner() override;
+
+  private:
+    void *m_mapping;
+    size_t m_size;
+  };
+} // namespace Vypr
@@ -1,79 +1,437 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
+#include <string_view>
+
+#include "Vypr/Scanner/CharacterScan.hpp"
+#include "Vypr/Scanner/SourceManager.hpp"
 
 namespace Vypr
 {
-  /// @brief Retrieves characters from a source and keeps track of line and
-  /// column counts.
+  /// @brief Position in a scanner's source that can be returned to.
+  struct ScannerMark
+  {
+    /// @brief Byte offset from the start of the source.
+    uint32_t offset;
+  };
+
+  /// @brief Retrieves UTF-8 code units from a contiguous window over a source.
+  /// Positions are byte offsets from the start of the source; line and column
+  /// numbers are resolved on demand through the `SourceManager`.
+  ///
+  /// Derived scanners only decide where the window comes from. Every read goes
+  /// through the non-virtual members below so character loops in the lexer
+  /// inline down to pointer increments. Scanners that hold the whole source in
+  /// one window never need more; streaming scanners override `Refill`, which
+  /// is only reached when a read runs off the end of the window.
+  ///
+  /// Views returned by the scanner point into the window. They stay valid for
+  /// the lifetime of a whole-source scanner, and until the next read on a
+  /// streaming scanner.
+  ///
+  /// Speculative scanning uses `Mark` and `Reset`, both of which are constant
+  /// time. A mark keeps a streaming scanner from discarding the characters
+  /// after it until it is released.
   class Scanner
   {
   public:
-    /// @brief Initializes line and column state.
-    Scanner();
+    /// @brief Returned when reading past the end of the source. `0xFF` never
+    /// appears in well-formed UTF-8.
+    static constexpr char EndOfFile = '\xFF';
 
     virtual ~Scanner() = default;
 
-    /// @brief Builds a string from the scanner while `condition` holds true or
-    /// there is no more characters in the source.
+    /// @brief Consumes characters from the scanner while `condition` holds true
+    /// or there is no more characters in the source.
     ///
-    /// @param condition Condition function if true continues to append
-    /// characters to resulting string.
-    /// @returns String prefix of the  scanner source such that all resulting
-    /// character hold true for `condition`.
-    std::wstring NextWhile(bool (*condition)(wchar_t));
+    /// @param condition Condition function if true continues to consume
+    /// characters.
+    /// @returns View of the consumed prefix of the scanner source such that all
+    /// characters hold true for `condition`.
+    template <typename Condition>
+    std::string_view NextWhile(Condition condition)
+    {
+      size_t length = 0;
+      while (true)
+      {
+        const char *cursor = m_cursor + length;
+        while (cursor < m_end && condition(*cursor))
+        {
+          cursor += 1;
+        }
+        length = static_cast<size_t>(cursor - m_cursor);
+        if (cursor < m_end || !Refill(length + 1))
+        {
+          break;
+        }
+      }
+      return Next(length);
+    }
+
+    /// @brief Consumes a run of characters that continue an identifier, a
+    /// vector block at a time where available.
+    ///
+    /// @returns View of the consumed run.
+    inline std::string_view NextIdentifierRun()
+    {
+      size_t length = 0;
+      while (true)
+      {
+        const char *cursor = FindIdentifierEnd(m_cursor + length, m_end);
+        length = static_cast<size_t>(cursor - m_cursor);
+        if (cursor < m_end || !Refill(length + 1))
+        {
+          break;
+        }
+      }
+      return Next(length);
+    }
+
+    /// @brief Consumes a run of characters of a string literal, up to the
+    /// next `"`, `\\` or newline, a vector block at a time where available.
+    ///
+    /// @returns View of the consumed run.
+    inline std::string_view NextStringRun()
+    {
+      size_t length = 0;
+      while (true)
+      {
+        const char *cursor =
+            FindAny(m_cursor + length, m_end, '"', '\\', '\n');
+        length = static_cast<size_t>(cursor - m_cursor);
+        if (cursor < m_end || !Refill(length + 1))
+        {
+          break;
+        }
+      }
+      return Next(length);
+    }
+
+    /// @brief Consumes a run of ASCII whitespace, a vector block at a time
+    /// where available.
+    ///
+    /// @returns Whether the run contained a newline.
+    inline bool SkipWhitespace()
+    {
+      bool newline = false;
+      do
+      {
+        const char *start = m_cursor;
+        m_cursor = FindNonWhitespace(m_cursor, m_end);
+
+        // Runs between tokens are short, so a plain loop beats a vector scan.
+        for (; start < m_cursor && !newline; start++)
+        {
+          newline = *start == '\n';
+        }
+      } while (m_cursor == m_end && Refill(1));
+      return newline;
+    }
+
+    /// @brief Consumes characters up to, but not including, the next newline
+    /// that is not part of a line splice, or to the end of the source.
+    inline void SkipLine()
+    {
+      while (true)
+      {
+        do
+        {
+          m_cursor = FindAny(m_cursor, m_end, '\n', '\\');
+        } while (m_cursor == m_end && Refill(1));
+
+        if (m_cursor == m_end || *m_cursor == '\n')
+        {
+          return;
+        }
+        size_t splice = GetSpliceLength();
+        Next(splice > 0 ? splice : 1);
+      }
+    }
 
+    /// @brief Measures the line splices at a position: backslashes each
+    /// followed by a newline, or by a carriage return and a newline. Splices
+    /// join two lines into one before the source is tokenized, so they are
+    /// neither whitespace nor part of the token they split.
+    ///
+    /// @param offset Number of characters to skip when looking ahead.
+    /// @returns Number of characters of the splices, or zero if there are
+    /// none.
+    inline size_t GetSpliceLength(size_t offset = 0)
+    {
+      size_t length = 0;
+      while (LookAhead(offset + length) == '\\')
+      {
+        if (LookAhead(offset + length + 1) == '\n')
+        {
+          length += 2;
+        }
+        else if (LookAhead(offset + length + 1) == '\r' &&
+                 LookAhead(offset + length + 2) == '\n')
+        {
+          length += 3;
+        }
+        else
+        {
+          break;
+        }
+      }
+      return length;
+    }
+
+    /// @brief Consumes characters up to and including the next `*/`, which
+    /// a line splice may split, or to the end of the source.
+    ///
+    /// @returns Whether a `*/` was found.
+    inline bool SkipBlockComment()
+    {
+      while (true)
+      {
+        const char *found = FindPair(m_cursor, m_end, '*', '/');
+
+        // Splices are rare, so they are only looked at after a `*` followed
+        // by a backslash before the first plain `*/`.
+        const char *spliced = FindPair(m_cursor, found, '*', '\\');
+        if (spliced != found)
+        {
+          m_cursor = spliced + 1;
+          Next(GetSpliceLength());
+          if (Matches('/'))
+          {
+            Next();
+            return true;
+          }
+          continue;
+        }
+        if (found != m_end)
+        {
+          m_cursor = found + 2;
+          return true;
+        }
+
+        // Keep a trailing `*` and backslash since the rest of a `*/` may be
+        // in the next window.
+        if (m_end - m_cursor > 2)
+        {
+          m_cursor = m_end - 2;
+        }
+        if (!Refill(3))
+        {
+          m_cursor = m_end;
+          return false;
+        }
+      }
+    }
+
+    /// @returns Byte offset of the current cursor from the start of the
+    /// source.
+    inline uint32_t GetOffset() const
+    {
+      return m_windowOffset + static_cast<uint32_t>(m_cursor - m_window);
+    }
+
+    /// @brief Resolves the current cursor through the source manager. This
+    /// builds the line table on first use and is meant for diagnostics.
+    ///
     /// @returns 1-indexed line count of the current cursor.
     inline size_t GetLine() const
     {
-      return m_line;
+      return m_sourceManager.GetLocation(GetOffset()).line;
     };
 
+    /// @brief Resolves the current cursor through the source manager. This
+    /// builds the line table on first use and is meant for diagnostics.
+    ///
     /// @returns 1-indexed column count of the current cursor.
     inline size_t GetColumn() const
     {
-      return m_column;
+      return m_sourceManager.GetLocation(GetOffset()).column;
     };
 
-    /// @brief Retrieves the next character from the scanner source or `EOF` if
-    /// the source is empty. Increments the line and column counts accordingly.
+    /// @returns Source manager resolving offsets into this scanner's source.
+    inline const SourceManager &GetSourceManager() const
+    {
+      return m_sourceManager;
+    }
+
+    /// @brief Retrieves the next character from the scanner source or
+    /// `EndOfFile` if the source is empty.
     ///
     /// @returns Next character in the scanner source.
-    wchar_t Next();
+    inline char Next()
+    {
+      if (m_cursor >= m_end && !Refill(1))
+      {
+        return EndOfFile;
+      }
+      return *m_cursor++;
+    }
 
     /// @brief Retrieves `max(length,remaining)` characters from the scanner
-    /// source. Increments the line and column counts accordingly.
+    /// source.
     ///
     /// @param length Number of characters to attempt to retrieve.
-    /// @returns String of the front `length` characters. The resulting string
-    /// can have less than `length` characters if the source does not have that
-    /// many.
-    std::wstring Next(size_t length);
+    /// @returns View of the front `length` characters. The view can have less
+    /// than `length` characters if the source does not have that many.
+    inline std::string_view Next(size_t length)
+    {
+      std::string_view buffer = LookAhead(0, length);
+      m_cursor += buffer.size();
+      return buffer;
+    }
 
     /// @brief Peeks `max(length,remaining)` characters from the scanner
-    /// source.
+    /// source without copying them.
     ///
     /// @param offset Number of characters to skip when looking ahead.
     /// @param length Number of characters to attempt to retrieve.
-    /// @returns String of the front `length` characters. The resulting string
-    /// can have less than `length` characters if the source does not have that
-    /// many.
-    std::wstring LookAhead(int offset, int length) const;
+    /// @returns View of the front `length` characters. The view can have less
+    /// than `length` characters if the source does not have that many.
+    inline std::string_view LookAhead(size_t offset, size_t length)
+    {
+      length = std::min(length, SIZE_MAX - offset);
+      if (static_cast<size_t>(m_end - m_cursor) < offset + length)
+      {
+        Refill(offset + length);
+      }
+
+      size_t remaining = static_cast<size_t>(m_end - m_cursor);
+      if (offset >= remaining)
+      {
+        return {};
+      }
+      return {m_cursor + offset, std::min(length, remaining - offset)};
+    }
+
+    /// @param text Characters to compare against.
+    /// @returns Whether the source continues with `text`.
+    inline bool Matches(std::string_view text)
+    {
+      return LookAhead(0, text.size()) == text;
+    }
+
+    /// @param character Character to compare against.
+    /// @returns Whether the next character of the source is `character`.
+    inline bool Matches(char character)
+    {
+      return LookAhead(0) == character;
+    }
 
-    /// @brief Peeks the next character from the scanner source or `EOF` if
-    /// the source is empty.
+    /// @brief Peeks the next character from the scanner source or
+    /// `EndOfFile` if the source is empty.
     ///
-    /// @param offsetNumber of characters to skip when looking ahead.
+    /// @param offset Number of characters to skip when looking ahead.
     /// @returns `offset`th character in the scanner source.
-    virtual wchar_t LookAhead(int offset) const = 0;
+    inline char LookAhead(size_t offset)
+    {
+      if (offset >= static_cast<size_t>(m_end - m_cursor) &&
+          !Refill(offset + 1))
+      {
+        return EndOfFile;
+      }
+      return m_cursor[offset];
+    }
 
     /// @returns Whether more characters are available from the scanner source.
-    virtual bool Finished() = 0;
+    inline bool Finished()
+    {
+      return m_cursor >= m_end && !Refill(1);
+    }
 
-  private:
-    virtual wchar_t NextInternal() = 0;
+    /// @brief Marks the current position so it can be returned to with
+    /// `Reset`. The mark must be released once it is no longer needed.
+    ///
+    /// @returns Mark of the current position.
+    inline ScannerMark Mark()
+    {
+      return Retain({GetOffset()});
+    }
 
-    size_t m_column;
-    size_t m_line;
+    /// @brief Keeps another reference to a mark that has not been released,
+    /// or to a position that has not been scanned past since it was marked.
+    ///
+    /// @param mark Position to keep.
+    /// @returns `mark`, which must be released separately.
+    inline ScannerMark Retain(ScannerMark mark)
+    {
+      m_markCount += 1;
+      m_markedOffset = std::min(m_markedOffset, mark.offset);
+      return mark;
+    }
+
+    /// @brief Releases a mark. Streaming scanners may discard the characters
+    /// following a position once all of its marks are released.
+    ///
+    /// @param mark Mark returned by `Mark` or `Retain`.
+    inline void Release(ScannerMark)
+    {
+      m_markCount -= 1;
+      if (m_markCount == 0)
+      {
+        m_markedOffset = SourceManager::NoOffset;
+      }
+    }
+
+    /// @brief Returns to a marked position. Line and column numbers are
+    /// derived from the offset so there is no other state to restore.
+    ///
+    /// @param mark Mark that has not been released.
+    inline void Reset(ScannerMark mark)
+    {
+      m_cursor = m_window + (mark.offset - m_windowOffset);
+    }
+
+  protected:
+    /// @brief Initializes the scanner over an empty window.
+    Scanner();
+
+    /// @brief Replaces the window with a whole source and rewinds to its
+    /// start.
+    ///
+    /// @param source UTF-8 encoded buffer to retrieve characters from. The
+    /// buffer must outlive the scanner or the next call to `Reset`.
+    void Reset(std::string_view source);
+
+    /// @brief Called when a read needs characters past the end of the window.
+    /// Streaming scanners override this to slide the window forward with
+    /// `SetWindow`. The characters from the cursor to the end of the current
+    /// window must be kept, in order, at the start of the new window.
+    ///
+    /// @param minimum Number of characters wanted past the cursor.
+    /// @returns Whether at least `minimum` characters are now available past
+    /// the cursor.
+    virtual bool Refill(size_t minimum);
+
+    /// @returns Unconsumed characters of the current window.
+    inline std::string_view GetUnconsumed() const
+    {
+      return {m_cursor, static_cast<size_t>(m_end - m_cursor)};
+    }
+
+    /// @returns Characters of the current window that must be kept, which are
+    /// the unconsumed characters and any following an unreleased mark.
+    std::string_view GetRetained() const;
+
+    /// @brief Replaces the window with one whose start is the start of
+    /// `GetRetained`. The cursor keeps its offset into the source.
+    ///
+    /// @param window Characters starting at the first retained character.
+    void SetWindow(std::string_view window);
+
+    /// @brief Records characters of a streamed source with the source manager
+    /// before they leave the window.
+    ///
+    /// @param characters Characters following those previously appended.
+    void AppendSource(std::string_view characters);
+
+  private:
+    const char *m_window;
+    const char *m_cursor;
+    const char *m_end;
+    uint32_t m_windowOffset;
+    uint32_t m_markedOffset;
+    uint32_t m_markCount;
+    SourceManager m_sourceManager;
   };
-} // namespace Vypr
\ No newline at end of file
+} // namespace Vypr
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Vypr
+{
+  /// @brief 1-indexed line and byte column of a position in a source.
+  struct SourceLocation
+  {
+    size_t line;
+    size_t column;
+  };
+
+  /// @brief Maps 32-bit byte offsets into a source buffer to line and column
+  /// numbers.
+  ///
+  /// Positions are carried through the pipeline as offsets. The table of line
+  /// starts is only built the first time a location is requested, which is
+  /// usually when a diagnostic is printed, so successful compiles never pay
+  /// for it. The lazy build is not synchronized; a manager must not be queried
+  /// from several threads at once.
+  ///
+  /// Streamed sources are never held in full. Their characters are passed to
+  /// `Append` as they are read and only the line table is kept, at four bytes
+  /// per line.
+  ///
+  /// Sources are limited to `MaxSize` bytes, just under 4 GiB, so that every
+  /// position has an offset and `NoOffset` stays free. Mapped and streamed
+  /// sources past the limit are rejected when they are read.
+  class SourceManager
+  {
+  public:
+    /// @brief Offset used for positions that are not in the source.
+    static constexpr uint32_t NoOffset = UINT32_MAX;
+
+    /// @brief Largest size of a source in bytes.
+    static constexpr uint32_t MaxSize = UINT32_MAX - 1;
+
+    /// @param source UTF-8 encoded buffer that offsets refer to. The buffer is
+    /// borrowed and must outlive the manager.
+    SourceManager(std::string_view source = {});
+
+    /// @brief Replaces the buffer that offsets refer to and drops the line
+    /// table.
+    ///
+    /// @param source UTF-8 encoded buffer that offsets refer to.
+    void Reset(std::string_view source);
+
+    /// @brief Extends a streamed source. The characters are scanned for line
+    /// starts immediately and are not kept.
+    ///
+    /// @param characters Characters following those previously appended.
+    ///
+    /// @throws `std::system_error` Thrown when the source would grow past
+    /// `MaxSize` bytes.
+    void Append(std::string_view characters);
+
+    /// @brief Resolves an offset to its line and column. Builds the line
+    /// table if this is the first lookup.
+    ///
+    /// @param offset Byte offset into the source. Offsets past the end of the
+    /// source resolve to the end of the source.
+    /// @returns 1-indexed line and column of `offset`.
+    SourceLocation GetLocation(uint32_t offset) const;
+
+    /// @returns Buffer that offsets refer to. Empty for streamed sources.
+    inline std::string_view GetSource() const
+    {
+      return m_source;
+    }
+
+  private:
+    /// @brief Records the start of every line in the source.
+    void BuildLineTable() const;
+
+    /// @brief Records the start of every line following a newline in
+    /// `characters`.
+    ///
+    /// @param characters Characters to scan for newlines.
+    /// @param offset Offset of the first of `characters` in the source.
+    void AddLineStarts(std::string_view characters, uint32_t offset) const;
+
+    std::string_view m_source;
+    uint32_t m_size;
+    mutable std::vector<uint32_t> m_lineStarts;
+  };
+} // namespace Vypr
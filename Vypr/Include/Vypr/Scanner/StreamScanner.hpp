@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+
+#include "Vypr/Scanner/Scanner.hpp"
+
+namespace Vypr
+{
+  /// @brief Scanner over a file descriptor that is read a chunk at a time, such
+  /// as standard input or a pipe. Only the characters of the token being
+  /// scanned, those after an unreleased mark and the rest of the current chunk
+  /// are held in memory, so memory stays bounded by the chunk size and the
+  /// longest token or speculation instead of growing with the source. Reads
+  /// return as soon as the producer has written anything, so lexing proceeds
+  /// while the producer is still writing.
+  class StreamScanner : public Scanner
+  {
+  public:
+    /// @brief Default number of characters read from the descriptor at once.
+    static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+    /// @brief Constructs a scanner reading from `fileDescriptor`. The
+    /// descriptor is borrowed and is not closed by the scanner.
+    ///
+    /// @param fileDescriptor Descriptor of a UTF-8 encoded source opened for
+    /// reading.
+    /// @param chunkSize Number of characters read from the descriptor at once.
+    StreamScanner(int fileDescriptor, size_t chunkSize = DefaultChunkSize);
+
+    StreamScanner(const StreamScanner &) = delete;
+    StreamScanner &operator=(const StreamScanner &) = delete;
+
+  protected:
+    /// @brief Slides the retained characters to the front of the buffer and
+    /// reads from the descriptor until `minimum` characters are available. The
+    /// buffer only grows when the retained characters do not fit in it.
+    ///
+    /// @throws `std::system_error` Thrown when reading from the descriptor
+    /// fails.
+    bool Refill(size_t minimum) override;
+
+  private:
+    int m_fileDescriptor;
+    bool m_finished;
+    size_t m_capacity;
+    std::unique_ptr<char[]> m_buffer;
+  };
+} // namespace Vypr
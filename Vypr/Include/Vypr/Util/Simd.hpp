@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define VYPR_SIMD
+#define VYPR_SIMD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define VYPR_SIMD
+#define VYPR_SIMD_SSE2
+#endif
+
+namespace Vypr
+{
+  /// @brief Thin wrapper over the widest byte-wise vector instructions the
+  /// compiler targets so scanning loops are written once. AVX2 is used when
+  /// the build enables it (e.g. `-mavx2` or `-march=native`), SSE2 on any other
+  /// x86-64 build. `VYPR_SIMD` is defined when either is available; otherwise
+  /// callers fall back to scalar loops.
+  namespace Simd
+  {
+#if defined(VYPR_SIMD_AVX2)
+    using Block = __m256i;
+
+    /// @brief Mask with a bit set for every byte in a block.
+    constexpr uint32_t FullMask = UINT32_MAX;
+
+    inline Block Load(const char *data)
+    {
+      return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+    }
+
+    inline Block Splat(char character)
+    {
+      return _mm256_set1_epi8(character);
+    }
+
+    inline Block Equal(Block lhs, Block rhs)
+    {
+      return _mm256_cmpeq_epi8(lhs, rhs);
+    }
+
+    /// @brief Signed byte-wise greater-than. Bytes 0x80-0xFF compare as
+    /// negative.
+    inline Block Greater(Block lhs, Block rhs)
+    {
+      return _mm256_cmpgt_epi8(lhs, rhs);
+    }
+
+    inline Block And(Block lhs, Block rhs)
+    {
+      return _mm256_and_si256(lhs, rhs);
+    }
+
+    inline Block Or(Block lhs, Block rhs)
+    {
+      return _mm256_or_si256(lhs, rhs);
+    }
+
+    /// @returns Bit `i` set when the high bit of byte `i` is set.
+    inline uint32_t Mask(Block block)
+    {
+      return static_cast<uint32_t>(_mm256_movemask_epi8(block));
+    }
+#elif defined(VYPR_SIMD_SSE2)
+    using Block = __m128i;
+
+    /// @brief Mask with a bit set for every byte in a block.
+    constexpr uint32_t FullMask = 0xFFFF;
+
+    inline Block Load(const char *data)
+    {
+      return _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    }
+
+    inline Block Splat(char character)
+    {
+      return _mm_set1_epi8(character);
+    }
+
+    inline Block Equal(Block lhs, Block rhs)
+    {
+      return _mm_cmpeq_epi8(lhs, rhs);
+    }
+
+    /// @brief Signed byte-wise greater-than. Bytes 0x80-0xFF compare as
+    /// negative.
+    inline Block Greater(Block lhs, Block rhs)
+    {
+      return _mm_cmpgt_epi8(lhs, rhs);
+    }
+
+    inline Block And(Block lhs, Block rhs)
+    {
+      return _mm_and_si128(lhs, rhs);
+    }
+
+    inline Block Or(Block lhs, Block rhs)
+    {
+      return _mm_or_si128(lhs, rhs);
+    }
+
+    /// @returns Bit `i` set when the high bit of byte `i` is set.
+    inline uint32_t Mask(Block block)
+    {
+      return static_cast<uint32_t>(_mm_movemask_epi8(block));
+    }
+#endif
+  } // namespace Simd
+} // namespace Vypr
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace Vypr
+{
+  /// @brief Bounded lock-free queue from one producer thread to one consumer
+  /// thread. Each side owns one index and only reads the other's when its
+  /// cached copy says the ring is full or empty, so the two threads share a
+  /// cache line only that often.
+  ///
+  /// `Push` blocks while the ring is full, which holds the producer back when
+  /// it gets too far ahead, and `Pop` blocks while it is empty. Both wait on
+  /// the other side's index instead of spinning.
+  ///
+  /// @tparam T Default constructible, movable type of the values.
+  template <typename T>
+  class SpscRing
+  {
+  public:
+    /// @param capacity Most values held at once. Rounded up to a power of
+    /// two.
+    explicit SpscRing(size_t capacity)
+        : m_slots(std::bit_ceil(capacity)), m_mask(m_slots.size() - 1),
+          m_head(0), m_cachedTail(0), m_tail(0), m_cachedHead(0)
+    {
+    }
+
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    /// @brief Adds a value to the back of the ring unless it is full. Called
+    /// only by the producer.
+    ///
+    /// @param value Value to add, moved from if it is added.
+    /// @returns Whether the value was added.
+    bool TryPush(T &value)
+    {
+      size_t tail = m_tail.load(std::memory_order_relaxed);
+      if (tail - m_cachedHead == m_slots.size())
+      {
+        m_cachedHead = m_head.load(std::memory_order_acquire);
+        if (tail - m_cachedHead == m_slots.size())
+        {
+          return false;
+        }
+      }
+
+      m_slots[tail & m_mask] = std::move(value);
+      m_tail.store(tail + 1, std::memory_order_release);
+      m_tail.notify_one();
+      return true;
+    }
+
+    /// @brief Adds a value to the back of the ring, waiting for the consumer
+    /// to make room if it is full. Called only by the producer.
+    ///
+    /// @param value Value to add.
+    void Push(T value)
+    {
+      while (!TryPush(value))
+      {
+        m_head.wait(m_cachedHead, std::memory_order_acquire);
+      }
+    }
+
+    /// @brief Takes the value at the front of the ring unless it is empty.
+    /// Called only by the consumer.
+    ///
+    /// @param value Receives the value taken.
+    /// @returns Whether a value was taken.
+    bool TryPop(T &value)
+    {
+      size_t head = m_head.load(std::memory_order_relaxed);
+      if (head == m_cachedTail)
+      {
+        m_cachedTail = m_tail.load(std::memory_order_acquire);
+        if (head == m_cachedTail)
+        {
+          return false;
+        }
+      }
+
+      value = std::move(m_slots[head & m_mask]);
+      m_head.store(head + 1, std::memory_order_release);
+      m_head.notify_one();
+      return true;
+    }
+
+    /// @brief Takes the value at the front of the ring, waiting for the
+    /// producer if it is empty. Called only by the consumer.
+    ///
+    /// @returns Value taken.
+    T Pop()
+    {
+      T value;
+      while (!TryPop(value))
+      {
+        m_tail.wait(m_cachedTail, std::memory_order_acquire);
+      }
+      return value;
+    }
+
+    /// @returns Most values held at once.
+    inline size_t GetCapacity() const
+    {
+      return m_slots.size();
+    }
+
+  private:
+    /// @brief Size of the cache lines the two sides' indices are kept apart
+    /// by.
+    static constexpr size_t CacheLineSize = 64;
+
+    std::vector<T> m_slots;
+    size_t m_mask;
+
+    /// @brief Index of the next value to take, written by the consumer, and
+    /// the consumer's copy of `m_tail`.
+    alignas(CacheLineSize) std::atomic<size_t> m_head;
+    size_t m_cachedTail;
+
+    /// @brief Index of the next slot to fill, written by the producer, and
+    /// the producer's copy of `m_head`.
+    alignas(CacheLineSize) std::atomic<size_t> m_tail;
+    size_t m_cachedHead;
+  };
+} // namespace Vypr
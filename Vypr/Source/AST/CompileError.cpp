@@ -1,61 +1,75 @@
 #include "Vypr/AST/CompileError.hpp"
 
-#include <codecvt>
-#include <locale>
 #include <unordered_map>
 
 namespace Vypr
 {
-  CompileError::CompileError(CompileErrorId id, size_t line, size_t column,
-                             std::wstring content)
-      : id(id), line(line), column(column),
+  CompileError::CompileError(CompileErrorId id, uint32_t offset,
+                             std::string content)
+      : id(id), offset(offset), line(0), column(0),
         description(GetCompileErrorMessage(id))
   {
-    constexpr size_t ZeroPadLength = 4;
-
     if (!content.empty())
     {
-      description += L" at " + content;
+      description += " at " + content;
+    }
+
+    BuildMessage();
+  }
+
+  void CompileError::SetLocation(const SourceManager &sourceManager)
+  {
+    if (offset == SourceManager::NoOffset)
+    {
+      return;
     }
 
-    std::wstring message = L"[" + std::to_wstring(line) + L", " +
-                           std::to_wstring(column) + L"] CE";
+    SourceLocation location = sourceManager.GetLocation(offset);
+    line = location.line;
+    column = location.column;
+    BuildMessage();
+  }
+
+  void CompileError::BuildMessage()
+  {
+    constexpr size_t ZeroPadLength = 4;
 
-    std::wstring errorId = std::to_wstring(static_cast<int>(id));
-    message += std::wstring(ZeroPadLength - errorId.length(), L'0') + errorId;
+    m_message = "[" + std::to_string(line) + ", " + std::to_string(column) +
+                "] CE";
 
-    message += L": " + description;
+    std::string errorId = std::to_string(static_cast<int>(id));
+    m_message += std::string(ZeroPadLength - errorId.length(), '0') + errorId;
 
-    m_message =
-        std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>().to_bytes(
-            message);
+    m_message += ": " + description;
   }
 
-  std::wstring CompileError::GetCompileErrorMessage(CompileErrorId id)
+  std::string CompileError::GetCompileErrorMessage(CompileErrorId id)
   {
     switch (id)
     {
     case CompileErrorId::ExpectedExpression:
-      return L"Expected expression";
+      return "Expected expression";
     case CompileErrorId::ExpectedConstant:
-      return L"Expected constant";
+      return "Expected constant";
     case CompileErrorId::ExpectedIdentifier:
-      return L"Expected identifier";
+      return "Expected identifier";
     case CompileErrorId::ExpectedGroupEnd:
-      return L"Expected group end";
+      return "Expected group end";
     case CompileErrorId::UndefinedSymbol:
-      return L"Undefined symbol";
+      return "Undefined symbol";
     case CompileErrorId::InvalidOperands:
-      return L"Invalid operands";
+      return "Invalid operands";
     case CompileErrorId::ConstantTooLarge:
-      return L"Constant is too large";
+      return "Constant is too large";
     case CompileErrorId::UnimplementedFeature:
-      return L"Unimplemented feature";
+      return "Unimplemented feature";
     case CompileErrorId::InvalidCast:
-      return L"Cast is invalid";
+      return "Cast is invalid";
+    case CompileErrorId::InvalidToken:
+      return "Invalid token";
     }
 
-    return L"Unknown error";
+    return "Unknown error";
   }
 
   const char *CompileError::what() const noexcept
@@ -39,36 +39,36 @@ namespace Vypr
       {BinaryOp::Xor, 8},          {BinaryOp::Or, 9},
       {BinaryOp::LogicalAnd, 10},  {BinaryOp::LogicalOr, 11}};
 
-  const std::unordered_map<BinaryOp, std::wstring> BinaryOperationNames = {
-      {BinaryOp::Add, L"Add"},
-      {BinaryOp::Subtract, L"Subtract"},
-      {BinaryOp::Multiply, L"Multiply"},
-      {BinaryOp::Divide, L"Divide"},
-      {BinaryOp::Modulo, L"Modulo"},
-      {BinaryOp::ShiftLeft, L"ShiftLeft"},
-      {BinaryOp::ShiftRight, L"ShiftRight"},
-      {BinaryOp::LessThan, L"LessThan"},
-      {BinaryOp::LessEqual, L"LessEqual"},
-      {BinaryOp::GreaterThan, L"GreaterThan"},
-      {BinaryOp::GreaterEqual, L"GreaterEqual"},
-      {BinaryOp::Equal, L"Equal"},
-      {BinaryOp::NotEqual, L"NotEqual"},
-      {BinaryOp::And, L"And"},
-      {BinaryOp::Xor, L"Xor"},
-      {BinaryOp::Or, L"Or"},
-      {BinaryOp::LogicalAnd, L"LogicalAnd"},
-      {BinaryOp::LogicalOr, L"LogicalOr"}};
+  const std::unordered_map<BinaryOp, std::string> BinaryOperationNames = {
+      {BinaryOp::Add, "Add"},
+      {BinaryOp::Subtract, "Subtract"},
+      {BinaryOp::Multiply, "Multiply"},
+      {BinaryOp::Divide, "Divide"},
+      {BinaryOp::Modulo, "Modulo"},
+      {BinaryOp::ShiftLeft, "ShiftLeft"},
+      {BinaryOp::ShiftRight, "ShiftRight"},
+      {BinaryOp::LessThan, "LessThan"},
+      {BinaryOp::LessEqual, "LessEqual"},
+      {BinaryOp::GreaterThan, "GreaterThan"},
+      {BinaryOp::GreaterEqual, "GreaterEqual"},
+      {BinaryOp::Equal, "Equal"},
+      {BinaryOp::NotEqual, "NotEqual"},
+      {BinaryOp::And, "And"},
+      {BinaryOp::Xor, "Xor"},
+      {BinaryOp::Or, "Or"},
+      {BinaryOp::LogicalAnd, "LogicalAnd"},
+      {BinaryOp::LogicalOr, "LogicalOr"}};
 
   BinaryOpNode::BinaryOpNode(BinaryOp op, std::unique_ptr<ExpressionNode> &&lhs,
                              std::unique_ptr<ExpressionNode> &&rhs,
-                             size_t column, size_t line)
-      : ExpressionNode(nullptr, column, line), m_op(op), m_lhs(std::move(lhs)),
+                             uint32_t offset)
+      : ExpressionNode(nullptr, offset), m_op(op), m_lhs(std::move(lhs)),
         m_rhs(std::move(rhs))
   {
     type = m_lhs->type->Check(op, *m_rhs->type);
     if (type == nullptr)
     {
-      throw CompileError(CompileErrorId::InvalidOperands, column, line);
+      throw CompileError(CompileErrorId::InvalidOperands, offset);
     }
     CastType();
   }
@@ -205,7 +205,7 @@ namespace Vypr
       CastTypeReal();
       break;
     default:
-      throw CompileError(CompileErrorId::UnimplementedFeature, 0, 0);
+      throw CompileError(CompileErrorId::UnimplementedFeature, offset);
     }
   }
 
@@ -252,10 +252,10 @@ namespace Vypr
     }
   }
 
-  std::wstring BinaryOpNode::PrettyPrint(int level) const
+  std::string BinaryOpNode::PrettyPrint(int level) const
   {
-    std::wstring result = ExpressionNode::PrettyPrint(level);
-    result += L"BinaryOpNode(" + BinaryOperationNames.at(m_op) + L")\n";
+    std::string result = ExpressionNode::PrettyPrint(level);
+    result += "BinaryOpNode(" + BinaryOperationNames.at(m_op) + ")\n";
     result += m_lhs->PrettyPrint(level + 1);
     result += m_rhs->PrettyPrint(level + 1);
     return result;
@@ -272,12 +272,11 @@ namespace Vypr
         lexer, symbolTable, BinaryOperationPrecedence.at(op));
     if (rhs == nullptr)
     {
-      throw CompileError(CompileErrorId::ExpectedExpression, opToken.column,
-                         opToken.line);
+      throw CompileError(CompileErrorId::ExpectedExpression, opToken.offset);
     }
 
     return std::make_unique<BinaryOpNode>(op, std::move(base), std::move(rhs),
-                                          opToken.column, opToken.line);
+                                          opToken.offset);
   }
 
   llvm::Value *BinaryOpNode::GenerateCode(Context &context) const
@@ -391,6 +390,6 @@ namespace Vypr
       break;
     }
 
-    throw CompileError(CompileErrorId::UnimplementedFeature, 0, 0);
+    throw CompileError(CompileErrorId::UnimplementedFeature, offset);
   }
 } // namespace Vypr
\ No newline at end of file
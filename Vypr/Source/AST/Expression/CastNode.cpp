@@ -8,16 +8,15 @@ namespace Vypr
 {
   CastNode::CastNode(std::unique_ptr<StorageType> &&castType,
                      std::unique_ptr<ExpressionNode> &&expression)
-      : ExpressionNode(std::move(castType), expression->column,
-                       expression->line),
+      : ExpressionNode(std::move(castType), expression->offset),
         expression(std::move(expression))
   {
   }
 
-  std::wstring CastNode::PrettyPrint(int level) const
+  std::string CastNode::PrettyPrint(int level) const
   {
-    std::wstring result = ExpressionNode::PrettyPrint(level);
-    result += L"CastNode\n";
+    std::string result = ExpressionNode::PrettyPrint(level);
+    result += "CastNode\n";
     result += expression->PrettyPrint(level + 1);
     return result;
   }
@@ -38,7 +37,7 @@ namespace Vypr
       break;
     }
 
-    throw CompileError(CompileErrorId::InvalidCast, 0, 0);
+    throw CompileError(CompileErrorId::InvalidCast, offset);
   }
 
   llvm::Value *CastNode::CastToIntegral(Context &context,
@@ -51,7 +50,7 @@ namespace Vypr
     case StorageMetaType::Pointer:
       if (dynamic_cast<IntegralType *>(type.get())->integral != Integral::Long)
       {
-        throw CompileError(CompileErrorId::InvalidCast, 0, 0);
+        throw CompileError(CompileErrorId::InvalidCast, offset);
       }
       return context.builder.CreatePtrToInt(childExpression,
                                             type->GetIRType(context));
@@ -64,7 +63,7 @@ namespace Vypr
       break;
     }
 
-    throw CompileError(CompileErrorId::UnimplementedFeature, 0, 0);
+    throw CompileError(CompileErrorId::UnimplementedFeature, offset);
   }
 
   llvm::Value *CastNode::CastToReal(Context &context,
@@ -90,7 +89,7 @@ namespace Vypr
       return context.builder.CreateFPExt(childExpression,
                                          type->GetIRType(context));
     default:
-      throw CompileError(CompileErrorId::InvalidCast, 0, 0);
+      throw CompileError(CompileErrorId::InvalidCast, offset);
     }
   }
 
@@ -101,7 +100,7 @@ namespace Vypr
         dynamic_cast<IntegralType *>(expression->type.get())->integral !=
             Integral::Long)
     {
-      throw CompileError(CompileErrorId::InvalidCast, 0, 0);
+      throw CompileError(CompileErrorId::InvalidCast, offset);
     }
 
     return context.builder.CreateIntToPtr(childExpression,
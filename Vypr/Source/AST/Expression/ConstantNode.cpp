@@ -1,8 +1,5 @@
 #include "Vypr/AST/Expression/ConstantNode.hpp"
 
-#include <codecvt>
-#include <locale>
-
 #include "Vypr/AST/CompileError.hpp"
 #include "Vypr/AST/Type/IntegralType.hpp"
 #include "Vypr/AST/Type/PointerType.hpp"
@@ -14,24 +11,21 @@
 namespace Vypr
 {
   ConstantNode::ConstantNode(std::unique_ptr<StorageType> &&type,
-                             ConstantValue value, size_t column, size_t line)
-      : ExpressionNode(std::move(type), column, line), m_value(value)
+                             ConstantValue value, uint32_t offset)
+      : ExpressionNode(std::move(type), offset), m_value(value)
   {
   }
 
-  std::wstring ConstantNode::PrettyPrint(int level) const
+  std::string ConstantNode::PrettyPrint(int level) const
   {
-    std::wstring result = ExpressionNode::PrettyPrint(level);
-    result += L"Constant(";
+    std::string result = ExpressionNode::PrettyPrint(level);
+    result += "Constant(";
     std::visit(
         overloaded{
-            [&](auto arg) { result += std::to_wstring(arg); },
-            [&](const std::string &arg) {
-              std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-              result += L"\"" + converter.from_bytes(arg) + L"\"";
-            }},
+            [&](auto arg) { result += std::to_string(arg); },
+            [&](const std::string &arg) { result += "\"" + arg + "\""; }},
         m_value);
-    result += L")\n";
+    result += ")\n";
     return result;
   }
 
@@ -80,77 +74,38 @@ namespace Vypr
     switch (nextToken.type)
     {
     case CLangTokenType::IntegerConstant:
-      return ParseIntegerConstant(nextToken);
+      return ParseIntegerConstant(
+          lexer.GetLiterals().GetNumber(nextToken.value), nextToken.offset);
     case CLangTokenType::FloatConstant:
-      return ParseFloatConstant(nextToken);
+      return ParseFloatConstant(lexer.GetLiterals().GetNumber(nextToken.value),
+                                nextToken.offset);
     case CLangTokenType::CharacterConstant:
       return std::make_unique<ConstantNode>(
           std::make_unique<IntegralType>(Integral::Byte, false, false, false),
-          (uint8_t)std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t>()
-              .to_bytes(nextToken.content)[0],
-          nextToken.column, nextToken.line);
+          static_cast<uint8_t>(lexer.GetSpelling(nextToken)[0]),
+          nextToken.offset);
     case CLangTokenType::StringLiteral:
       return ParseStringLiteral(nextToken, lexer);
     default:
-      throw CompileError(CompileErrorId::ExpectedConstant, nextToken.line,
-                         nextToken.column);
+      throw CompileError(CompileErrorId::ExpectedConstant, nextToken.offset);
     }
   }
 
   std::unique_ptr<ConstantNode> ConstantNode::ParseIntegerConstant(
-      const CLangToken &token)
+      const NumericLiteral &number, uint32_t offset)
   {
-    bool isUnsigned = false;
+    bool isUnsigned = number.suffix & NumericLiteral::Unsigned;
     int longCount = 0;
-
-    int postfix = 0;
-    auto iter = token.content.crbegin();
-    while (iter != token.content.crend() && (*iter == 'u' || *iter == 'l'))
-    {
-      if (*iter == 'u')
-      {
-        isUnsigned = true;
-      }
-      else if (*iter == 'l')
-      {
-        longCount += 1;
-      }
-      postfix += 1;
-      iter++;
-    }
-
-    int prefix = 0;
-    int radix = 10;
-    if (token.content.starts_with(L"0b"))
+    if (number.suffix & NumericLiteral::LongLong)
     {
-      prefix = 2;
-      radix = 2;
+      longCount = 2;
     }
-    else if (token.content.starts_with(L"0x"))
+    else if (number.suffix & NumericLiteral::Long)
     {
-      prefix = 2;
-      radix = 16;
-    }
-    else if (token.content.starts_with(L"0"))
-    {
-      prefix = 0;
-      radix = 8;
-    }
-
-    std::wstring constant =
-        token.content.substr(prefix, token.content.length() - postfix - prefix);
-
-    uint64_t proxyValue;
-    try
-    {
-      proxyValue = std::stoull(constant, nullptr, radix);
-    }
-    catch (...)
-    {
-      throw CompileError(CompileErrorId::ConstantTooLarge, token.column,
-                         token.line, token.content);
+      longCount = 1;
     }
 
+    uint64_t proxyValue = number.integer;
     bool valueParsed = false;
     ConstantValue value;
     while (!valueParsed)
@@ -192,78 +147,39 @@ namespace Vypr
         false);
 
     return std::make_unique<ConstantNode>(std::move(constantType), value,
-                                          token.column, token.line);
+                                          offset);
   }
 
   std::unique_ptr<ConstantNode> ConstantNode::ParseFloatConstant(
-      const CLangToken &token)
+      const NumericLiteral &number, uint32_t offset)
   {
-    bool isDouble = true;
-
-    int postfix = 0;
-    auto iter = token.content.crbegin();
-    while (iter != token.content.crend() && (*iter == 'f' || *iter == 'l'))
+    if (number.suffix & NumericLiteral::Float)
     {
-      if (*iter == 'l')
-      {
-        isDouble = true;
-      }
-      else if (*iter == 'f')
-      {
-        isDouble = false;
-      }
-      postfix += 1;
-      iter++;
-    }
-
-    std::wstring constant =
-        token.content.substr(0, token.content.length() - postfix);
-
-    std::unique_ptr<StorageType> constantType;
-    ConstantValue value;
-    bool valueParsed = false;
-    while (!valueParsed)
-    {
-      try
-      {
-        if (isDouble)
-        {
-          constantType = std::make_unique<RealType>(Real::Double, false, false);
-          value = std::stod(constant);
-        }
-        else
-        {
-          constantType = std::make_unique<RealType>(Real::Float, false, false);
-          value = std::stof(constant);
-        }
-        valueParsed = true;
-      }
-      catch (...)
-      {
-        if (!isDouble)
-        {
-          isDouble = true;
-        }
-        else
-        {
-          throw CompileError(CompileErrorId::ConstantTooLarge, token.column,
-                             token.line, token.content);
-        }
-      }
+      return std::make_unique<ConstantNode>(
+          std::make_unique<RealType>(Real::Float, false, false),
+          static_cast<float>(number.real), offset);
     }
-    return std::make_unique<ConstantNode>(std::move(constantType), value,
-                                          token.column, token.line);
+    return std::make_unique<ConstantNode>(
+        std::make_unique<RealType>(Real::Double, false, false), number.real,
+        offset);
   }
 
   std::unique_ptr<ConstantNode> ConstantNode::ParseStringLiteral(
       const CLangToken &token, CLangLexer &lexer)
   {
-    std::wstring_convert<std::codecvt_utf8<wchar_t>, wchar_t> converter;
-    std::string stringLiteral = converter.to_bytes(token.content);
+    // Adjacent literals lexed one after another are stored back to back, so
+    // they are joined by viewing them as one. Literals stored elsewhere, such
+    // as those of a relexed edit, are appended.
+    uint32_t last = token.value;
+    while (lexer.PeekToken().type == CLangTokenType::StringLiteral &&
+           lexer.PeekToken().value == last + 1)
+    {
+      last = lexer.GetToken().value;
+    }
+    std::string stringLiteral(lexer.GetLiterals().Join(token.value, last));
     while (lexer.PeekToken().type == CLangTokenType::StringLiteral)
     {
-      CLangToken nextLiteral = lexer.GetToken();
-      stringLiteral += converter.to_bytes(nextLiteral.content);
+      stringLiteral += lexer.GetSpelling(lexer.GetToken());
     }
 
     std::unique_ptr<StorageType> storageType =
@@ -271,6 +187,6 @@ namespace Vypr
     std::unique_ptr<StorageType> pointerType =
         std::make_unique<PointerType>(storageType, false, false);
     return std::make_unique<ConstantNode>(std::move(pointerType), stringLiteral,
-                                          token.column, token.line);
+                                          token.offset);
   }
 } // namespace Vypr
\ No newline at end of file
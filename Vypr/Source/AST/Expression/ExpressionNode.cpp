@@ -10,24 +10,24 @@
 namespace Vypr
 {
 
-  ExpressionNode::ExpressionNode() : column(0), line(0)
+  ExpressionNode::ExpressionNode() : offset(SourceManager::NoOffset)
   {
   }
 
   ExpressionNode::ExpressionNode(std::unique_ptr<StorageType> &&type,
-                                 size_t column, size_t line)
-      : type(std::move(type)), column(column), line(line)
+                                 uint32_t offset)
+      : type(std::move(type)), offset(offset)
   {
   }
 
-  std::wstring ExpressionNode::PrettyPrint(int level) const
+  std::string ExpressionNode::PrettyPrint(int level) const
   {
-    std::wstring result;
+    std::string result;
     for (int i = 0; i < level; i++)
     {
-      result += L"  ";
+      result += "  ";
     }
-    result += L"|> <" + type->PrettyPrint() + L"> ";
+    result += "|> <" + type->PrettyPrint() + "> ";
     return result;
   }
 
@@ -57,8 +57,8 @@ namespace Vypr
         CLangToken groupClose = lexer.GetToken();
         if (groupClose.type != CLangTokenType::RightParenthesis)
         {
-          throw CompileError(CompileErrorId::ExpectedGroupEnd, groupClose.line,
-                             groupClose.column);
+          throw CompileError(CompileErrorId::ExpectedGroupEnd,
+                             groupClose.offset);
         }
         break;
       }
@@ -71,6 +71,9 @@ namespace Vypr
       case CLangTokenType::Identifier:
         base = VariableNode::Parse(lexer, symbolTable);
         break;
+      case CLangTokenType::Error:
+        throw CompileError(CompileErrorId::InvalidToken, nextToken.offset,
+                           std::string(lexer.GetSpelling(nextToken)));
       default:
         break;
       }
@@ -90,15 +93,13 @@ namespace Vypr
       {
         lexer.GetToken();
         base = std::make_unique<PostfixOpNode>(
-            PostfixOp::Increment, std::move(base), nextToken.column,
-            nextToken.line);
+            PostfixOp::Increment, std::move(base), nextToken.offset);
       }
       else if (nextToken.type == CLangTokenType::Decrement)
       {
         lexer.GetToken();
         base = std::make_unique<PostfixOpNode>(
-            PostfixOp::Decrement, std::move(base), nextToken.column,
-            nextToken.line);
+            PostfixOp::Decrement, std::move(base), nextToken.offset);
       }
       else if (nextToken.type == CLangTokenType::RightParenthesis)
       {
@@ -6,30 +6,30 @@ namespace Vypr
 {
   PostfixOpNode::PostfixOpNode(PostfixOp op,
                                std::unique_ptr<ExpressionNode> &&expression,
-                               size_t column, size_t line)
-      : ExpressionNode(nullptr, column, line), m_op(op),
+                               uint32_t offset)
+      : ExpressionNode(nullptr, offset), m_op(op),
         m_expression(std::move(expression))
   {
     type = m_expression->type->Check(op);
     if (type == nullptr)
     {
-      throw CompileError(CompileErrorId::InvalidOperands, column, line);
+      throw CompileError(CompileErrorId::InvalidOperands, offset);
     }
   }
 
-  std::wstring PostfixOpNode::PrettyPrint(int level) const
+  std::string PostfixOpNode::PrettyPrint(int level) const
   {
-    std::wstring result = ExpressionNode::PrettyPrint(level);
-    result += L"PostfixOp(";
+    std::string result = ExpressionNode::PrettyPrint(level);
+    result += "PostfixOp(";
     if (m_op == PostfixOp::Increment)
     {
-      result += L"Increment";
+      result += "Increment";
     }
     else if (m_op == PostfixOp::Decrement)
     {
-      result += L"Decrement";
+      result += "Decrement";
     }
-    result += L")\n";
+    result += ")\n";
     result += m_expression->PrettyPrint(level + 1);
     return result;
   }
@@ -16,26 +16,26 @@ namespace Vypr
       {CLangTokenType::And, UnaryOp::AddressOf},
       {CLangTokenType::Sizeof, UnaryOp::Sizeof}};
 
-  const std::unordered_map<UnaryOp, std::wstring> BinaryOperationNames = {
-      {UnaryOp::Increment, L"Increment"},
-      {UnaryOp::Decrement, L"Decrement"},
-      {UnaryOp::Negate, L"Negate"},
-      {UnaryOp::LogicalNot, L"LogicalNot"},
-      {UnaryOp::Not, L"Not"},
-      {UnaryOp::Deref, L"Deref"},
-      {UnaryOp::AddressOf, L"AddressOf"},
-      {UnaryOp::Sizeof, L"Sizeof"}};
+  const std::unordered_map<UnaryOp, std::string> BinaryOperationNames = {
+      {UnaryOp::Increment, "Increment"},
+      {UnaryOp::Decrement, "Decrement"},
+      {UnaryOp::Negate, "Negate"},
+      {UnaryOp::LogicalNot, "LogicalNot"},
+      {UnaryOp::Not, "Not"},
+      {UnaryOp::Deref, "Deref"},
+      {UnaryOp::AddressOf, "AddressOf"},
+      {UnaryOp::Sizeof, "Sizeof"}};
 
   UnaryOpNode::UnaryOpNode(UnaryOp op,
                            std::unique_ptr<ExpressionNode> &&expression,
-                           size_t column, size_t line)
-      : ExpressionNode(nullptr, column, line), m_op(op),
+                           uint32_t offset)
+      : ExpressionNode(nullptr, offset), m_op(op),
         m_expression(std::move(expression))
   {
     type = m_expression->type->Check(op);
     if (type == nullptr)
     {
-      throw CompileError(CompileErrorId::InvalidOperands, column, line);
+      throw CompileError(CompileErrorId::InvalidOperands, offset);
     }
 
     if (op == UnaryOp::LogicalNot &&
@@ -50,10 +50,10 @@ namespace Vypr
     }
   }
 
-  std::wstring UnaryOpNode::PrettyPrint(int level) const
+  std::string UnaryOpNode::PrettyPrint(int level) const
   {
-    std::wstring result = ExpressionNode::PrettyPrint(level);
-    result += L"UnaryOpNode(" + BinaryOperationNames.at(m_op) + L")\n";
+    std::string result = ExpressionNode::PrettyPrint(level);
+    result += "UnaryOpNode(" + BinaryOperationNames.at(m_op) + ")\n";
     result += m_expression->PrettyPrint(level + 1);
     return result;
   }
@@ -64,7 +64,6 @@ namespace Vypr
     CLangToken opToken = lexer.GetToken();
     return std::make_unique<UnaryOpNode>(
         UnaryOperations.at(opToken.type),
-        ExpressionNode::Parse(lexer, symbolTable, 1), opToken.column,
-        opToken.line);
+        ExpressionNode::Parse(lexer, symbolTable, 1), opToken.offset);
   }
 } // namespace Vypr
\ No newline at end of file
@@ -7,15 +7,16 @@
 namespace Vypr
 {
   VariableNode::VariableNode(std::unique_ptr<StorageType> &&type,
-                             std::wstring symbol, size_t column, size_t line)
-      : ExpressionNode(std::move(type), column, line), m_symbol(symbol)
+                             Identifier symbol, std::string_view name,
+                             uint32_t offset)
+      : ExpressionNode(std::move(type), offset), m_symbol(symbol), m_name(name)
   {
   }
 
-  std::wstring VariableNode::PrettyPrint(int level) const
+  std::string VariableNode::PrettyPrint(int level) const
   {
-    return ExpressionNode::PrettyPrint(level) + L"Variable(" + m_symbol +
-           L")\n";
+    return ExpressionNode::PrettyPrint(level) + "Variable(" +
+           std::string(m_name) + ")\n";
   }
 
   llvm::Value *VariableNode::GenerateCode(Context &context) const
@@ -87,22 +88,22 @@ namespace Vypr
     CLangToken nextToken = lexer.GetToken();
     if (nextToken.type != CLangTokenType::Identifier)
     {
-      throw CompileError(CompileErrorId::ExpectedIdentifier, nextToken.line,
-                         nextToken.column);
+      throw CompileError(CompileErrorId::ExpectedIdentifier, nextToken.offset);
     }
 
+    Identifier identifier = nextToken.GetIdentifier();
     std::shared_ptr<Vypr::StorageType> symbol =
-        symbolTable.GetSymbol(nextToken.content);
+        symbolTable.GetSymbol(identifier);
     if (symbol == nullptr)
     {
-      throw CompileError(CompileErrorId::UndefinedSymbol, nextToken.column,
-                         nextToken.line, nextToken.content);
+      throw CompileError(CompileErrorId::UndefinedSymbol, nextToken.offset,
+                         std::string(lexer.GetSpelling(nextToken)));
     }
 
     std::unique_ptr<StorageType> symbolType = symbol->Clone();
     symbolType->isLValue = true;
-    return std::make_unique<VariableNode>(std::move(symbolType),
-                                          nextToken.content, nextToken.column,
-                                          nextToken.line);
+    return std::make_unique<VariableNode>(
+        std::move(symbolType), identifier,
+        lexer.GetIdentifiers().GetName(identifier), nextToken.offset);
   }
 } // namespace Vypr
\ No newline at end of file
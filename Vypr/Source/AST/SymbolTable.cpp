@@ -23,42 +23,48 @@ namespace Vypr
   }
 
   template <typename T>
-  bool SymbolTable<T>::IsDuplicate(const std::wstring &symbol) const
+  bool SymbolTable<T>::IsDuplicate(Identifier symbol) const
   {
     return m_tables.back().contains(symbol);
   }
 
   template <typename T>
-  void SymbolTable<T>::AddSymbol(const std::wstring &symbol, T type)
+  void SymbolTable<T>::AddSymbol(Identifier symbol, T type)
   {
-    if (!m_tables.back().contains(symbol))
-    {
-      m_tables.back().insert({symbol, std::move(type)});
-    }
+    m_tables.back().try_emplace(symbol, std::move(type));
   }
 
   template <typename T>
-  T SymbolTable<T>::GetSymbol(const std::wstring &symbol) const
+  T SymbolTable<T>::GetSymbol(Identifier symbol) const
   {
     for (auto table = m_tables.rbegin(); table != m_tables.rend(); table++)
     {
-      if (table->contains(symbol))
+      auto entry = table->find(symbol);
+      if (entry != table->end())
       {
-        return table->at(symbol);
+        return entry->second;
       }
     }
     return {};
   }
 
+  template <typename T>
+  const std::unordered_map<Identifier, T> &
+  SymbolTable<T>::GetGlobalScope() const
+  {
+    return m_tables.front();
+  }
+
   template <>
   std::shared_ptr<StorageType> SymbolTable<
-      std::shared_ptr<StorageType>>::GetSymbol(const std::wstring &symbol) const
+      std::shared_ptr<StorageType>>::GetSymbol(Identifier symbol) const
   {
     for (auto table = m_tables.rbegin(); table != m_tables.rend(); table++)
     {
-      if (table->contains(symbol))
+      auto entry = table->find(symbol);
+      if (entry != table->end())
       {
-        return table->at(symbol)->Clone();
+        return entry->second->Clone();
       }
     }
     return nullptr;
@@ -105,12 +105,12 @@ namespace Vypr
     return resultType;
   }
 
-  std::wstring ArrayType::PrettyPrint() const
+  std::string ArrayType::PrettyPrint() const
   {
-    std::wstring result = StorageType::PrettyPrint();
-    result += L"Array(";
+    std::string result = StorageType::PrettyPrint();
+    result += "Array(";
     result += m_storage->PrettyPrint();
-    result += L")";
+    result += ")";
     return result;
   }
 } // namespace Vypr
\ No newline at end of file
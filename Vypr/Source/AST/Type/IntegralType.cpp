@@ -193,19 +193,19 @@ namespace Vypr
     return (context.builder.*(TypeBuilders.at(integral)))();
   }
 
-  std::wstring IntegralType::PrettyPrint() const
+  std::string IntegralType::PrettyPrint() const
   {
-    static const std::unordered_map<Integral, std::wstring> PrimitiveTypeNames =
-        {{Integral::Bool, L"Bool"},
-         {Integral::Byte, L"Byte"},
-         {Integral::Short, L"Short"},
-         {Integral::Int, L"Int"},
-         {Integral::Long, L"Long"}};
-
-    std::wstring result = StorageType::PrettyPrint();
+    static const std::unordered_map<Integral, std::string> PrimitiveTypeNames =
+        {{Integral::Bool, "Bool"},
+         {Integral::Byte, "Byte"},
+         {Integral::Short, "Short"},
+         {Integral::Int, "Int"},
+         {Integral::Long, "Long"}};
+
+    std::string result = StorageType::PrettyPrint();
     if (isUnsigned)
     {
-      result += L"U";
+      result += "U";
     }
     result += PrimitiveTypeNames.at(integral);
     return result;
@@ -98,12 +98,12 @@ namespace Vypr
     return resultType;
   }
 
-  std::wstring PointerType::PrettyPrint() const
+  std::string PointerType::PrettyPrint() const
   {
-    std::wstring result = StorageType::PrettyPrint();
-    result += L"Pointer(";
+    std::string result = StorageType::PrettyPrint();
+    result += "Pointer(";
     result += m_storage->PrettyPrint();
-    result += L")";
+    result += ")";
     return result;
   }
 
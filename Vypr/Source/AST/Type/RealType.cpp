@@ -128,16 +128,16 @@ namespace Vypr
     return context.builder.getDoubleTy();
   }
 
-  std::wstring RealType::PrettyPrint() const
+  std::string RealType::PrettyPrint() const
   {
-    std::wstring result = StorageType::PrettyPrint();
+    std::string result = StorageType::PrettyPrint();
     if (real == Real::Float)
     {
-      result += L"Float";
+      result += "Float";
     }
     else
     {
-      result += L"Double";
+      result += "Double";
     }
     return result;
   }
@@ -32,22 +32,22 @@ namespace Vypr
     return nullptr;
   };
 
-  std::wstring StorageType::PrettyPrint() const
+  std::string StorageType::PrettyPrint() const
   {
-    std::wstring result;
+    std::string result;
     if (isLValue)
     {
-      result += L"(L) ";
+      result += "(L) ";
     }
 
     if (isConst)
     {
-      result += L"const ";
+      result += "const ";
     }
 
     if (m_type == StorageMetaType::Void)
     {
-      result += L"Void";
+      result += "Void";
     }
 
     return result;
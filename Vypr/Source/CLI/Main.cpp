@@ -1,16 +1,25 @@
+#include <filesystem>
+#include <iomanip>
 #include <iostream>
 #include <llvm/IR/Verifier.h>
 #include <llvm/Support/TargetSelect.h>
+#include <stdexcept>
 #include <string>
+#include <system_error>
 
 #include "Vypr/AST/CompileError.hpp"
 #include "Vypr/AST/Expression/ExpressionNode.hpp"
 #include "Vypr/AST/Type/IntegralType.hpp"
 #include "Vypr/CodeGen/Context.hpp"
 #include "Vypr/Lexer/CLangLexer.hpp"
-#include "Vypr/Scanner/StringScanner.hpp"
+#include "Vypr/Preprocessor/HeaderCache.hpp"
+#include "Vypr/Preprocessor/PrecompiledHeader.hpp"
+#include "Vypr/Preprocessor/Preprocessor.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+#include "Vypr/Scanner/MappedFileScanner.hpp"
+#include "Vypr/Scanner/StreamScanner.hpp"
 
-int main(int, char **)
+int main(int argc, char **argv)
 {
   auto context = std::make_unique<Vypr::Context>("module");
 
@@ -20,17 +29,140 @@ int main(int, char **)
   llvm::InitializeAllAsmParsers();
   llvm::InitializeAllAsmPrinters();
 
-  Vypr::CLangLexer lexer(
-      std::make_unique<Vypr::StringScanner>(L"1.0f + (3 & 1)"));
+  // `-emit-pch` writes the state reached after the source as a precompiled
+  // header instead of compiling it, and `-include-pch` starts from one.
+  // `-stats` prints what preprocessing did and avoided.
+  Vypr::PreprocessorOptions preprocessorOptions;
+  preprocessorOptions.headerCache = std::make_shared<Vypr::HeaderCache>();
+  std::filesystem::path emitPath;
+  std::filesystem::path includePath;
+  bool printStatistics = false;
+  for (int i = 2; i < argc; i++)
+  {
+    std::string argument = argv[i];
+    if (argument == "-I" && i + 1 < argc)
+    {
+      preprocessorOptions.includeDirectories.emplace_back(argv[++i]);
+    }
+    else if (argument.starts_with("-I"))
+    {
+      preprocessorOptions.includeDirectories.emplace_back(argument.substr(2));
+    }
+    else if (argument == "-emit-pch" && i + 1 < argc)
+    {
+      emitPath = argv[++i];
+    }
+    else if (argument == "-include-pch" && i + 1 < argc)
+    {
+      includePath = argv[++i];
+    }
+    else if (argument == "-stats")
+    {
+      printStatistics = true;
+    }
+  }
+
+  std::unique_ptr<Vypr::Scanner> scanner;
+  try
+  {
+    if (argc > 1 && std::string(argv[1]) == "-")
+    {
+      scanner = std::make_unique<Vypr::StreamScanner>(0);
+    }
+    else if (argc > 1)
+    {
+      scanner = std::make_unique<Vypr::MappedFileScanner>(argv[1]);
+      preprocessorOptions.sourcePath = argv[1];
+    }
+    else
+    {
+      scanner = std::make_unique<Vypr::BufferScanner>("1.0f + (3 & 1)");
+    }
+  }
+  catch (const std::system_error &e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+
+  auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+  std::shared_ptr<const Vypr::PrecompiledHeader> precompiledHeader;
+  try
+  {
+    if (!includePath.empty())
+    {
+      precompiledHeader =
+          std::make_shared<Vypr::PrecompiledHeader>(includePath, identifiers);
+      preprocessorOptions.precompiledHeader = precompiledHeader;
+    }
+  }
+  catch (const std::exception &e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  Vypr::CLangLexer lexer(std::move(scanner), identifiers);
 
   try
   {
     Vypr::TypeTable typeTable;
-    typeTable.AddSymbol(L"var", std::make_shared<Vypr::IntegralType>(
-                                    Vypr::Integral::Int, false, false, true));
+    typeTable.AddSymbol(identifiers->Intern("var"),
+                        std::make_shared<Vypr::IntegralType>(
+                            Vypr::Integral::Int, false, false, true));
+    if (precompiledHeader)
+    {
+      precompiledHeader->LoadSymbols(typeTable);
+    }
+
+    lexer.StartPreprocessor(preprocessorOptions);
+    lexer.Tokenize();
+    if (printStatistics && lexer.GetPreprocessor())
+    {
+      const Vypr::PreprocessorStatistics &statistics =
+          lexer.GetPreprocessor()->GetStatistics();
+      Vypr::HeaderCacheStatistics cache =
+          preprocessorOptions.headerCache->GetStatistics();
+      uint64_t lookups = cache.hits + cache.misses;
+      std::cerr << "Files entered:        " << statistics.filesEntered
+                << "\nIncludes skipped:     " << statistics.includesSkipped
+                << "\nMacros expanded:      " << statistics.macrosExpanded
+                << "\nCached expansions:    " << statistics.cachedExpansions
+                << "\nCache misses:         " << statistics.cacheMisses
+                << "\nHeader cache hits:    " << cache.hits << " of "
+                << lookups << " (" << std::fixed << std::setprecision(1)
+                << (lookups > 0 ? 100.0 * cache.hits / lookups : 0.0)
+                << "%)\nHeader bytes saved:   " << cache.bytesSaved
+                << std::endl;
+    }
+    const Vypr::DiagnosticSink &diagnostics = lexer.GetDiagnostics();
+    for (uint32_t i = 0; i < diagnostics.GetCount(); i++)
+    {
+      Vypr::Diagnostic diagnostic = diagnostics.Get(i);
+      Vypr::SourceLocation location =
+          lexer.GetSourceManager().GetLocation(diagnostic.offset);
+      std::cerr << "[" << location.line << ", " << location.column
+                << "] " << Vypr::DiagnosticSink::GetMessage(diagnostic.id)
+                << std::endl;
+    }
+    if (diagnostics.GetCount() > 0)
+    {
+      return 1;
+    }
+
+    if (!emitPath.empty())
+    {
+      // Empty sources are not preprocessed.
+      Vypr::MacroTable noMacros;
+      const Vypr::Preprocessor *preprocessor = lexer.GetPreprocessor();
+      Vypr::PrecompiledHeader::Write(
+          emitPath, *identifiers,
+          preprocessor ? preprocessor->GetMacros() : noMacros,
+          lexer.GetLiterals(), typeTable);
+      return 0;
+    }
 
     auto expression = Vypr::ExpressionNode::Parse(lexer, typeTable);
-    std::wcout << expression->PrettyPrint(0) << std::endl;
+    std::cout << expression->PrettyPrint(0) << std::endl;
 
     // Temp
     llvm::Function *function = llvm::Function::Create(
@@ -44,7 +176,7 @@ int main(int, char **)
         context->module, context->builder.getInt32Ty(), false,
         llvm::GlobalValue::InternalLinkage, context->builder.getInt32(42));
     context->builder.CreateStore(context->builder.getInt32(42), variable);
-    context->symbolTable.AddSymbol(L"var", variable);
+    context->symbolTable.AddSymbol(identifiers->Intern("var"), variable);
     // Temp
 
     llvm::Value *ret = expression->GenerateCode(*context);
@@ -61,7 +193,13 @@ int main(int, char **)
   }
   catch (Vypr::CompileError &e)
   {
-    std::wcerr << e.what() << std::endl;
+    e.SetLocation(lexer.GetSourceManager());
+    std::cerr << e.what() << std::endl;
+  }
+  catch (const std::system_error &e)
+  {
+    std::cerr << e.what() << std::endl;
+    return 1;
   }
 
   return 0;
@@ -1,133 +1,756 @@
 #include "Vypr/Lexer/CLangLexer.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <exception>
+#include <optional>
 #include <string>
+#include <thread>
+#include <vector>
 
-#include "Vypr/Lexer/CLangTokenMap.hpp"
+#include "Vypr/Lexer/CLangKeywords.hpp"
+#include "Vypr/Lexer/CLangPunctuators.hpp"
+#include "Vypr/Lexer/CLangSplitPoints.hpp"
 #include "Vypr/Lexer/CLangTokenType.hpp"
+#include "Vypr/Lexer/TokenPipeline.hpp"
+#include "Vypr/Preprocessor/Preprocessor.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+#include "Vypr/Scanner/CharacterClass.hpp"
+#include "Vypr/Scanner/StringScanner.hpp"
 
 namespace Vypr
 {
-  ParsingException::ParsingException(std::wstring message, size_t column,
-                                     size_t line)
-      : message(message), column(column), line(line)
+  namespace
   {
-  }
+    char ToLower(char c)
+    {
+      return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    bool IsUtf8Continuation(char c)
+    {
+      return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+    }
+
+    void AppendUtf8(std::string &buffer, uint32_t codepoint)
+    {
+      if (codepoint < 0x80)
+      {
+        buffer += static_cast<char>(codepoint);
+      }
+      else if (codepoint < 0x800)
+      {
+        buffer += static_cast<char>(0xC0 | (codepoint >> 6));
+        buffer += static_cast<char>(0x80 | (codepoint & 0x3F));
+      }
+      else if (codepoint < 0x10000)
+      {
+        buffer += static_cast<char>(0xE0 | (codepoint >> 12));
+        buffer += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        buffer += static_cast<char>(0x80 | (codepoint & 0x3F));
+      }
+      else
+      {
+        buffer += static_cast<char>(0xF0 | (codepoint >> 18));
+        buffer += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+        buffer += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+        buffer += static_cast<char>(0x80 | (codepoint & 0x3F));
+      }
+    }
+  } // namespace
 
-  CLangLexer::CLangLexer(std::unique_ptr<Scanner> scanner)
-      : m_scanner(std::move(scanner))
+  CLangLexer::CLangLexer(std::unique_ptr<Scanner> scanner,
+                         std::shared_ptr<IdentifierTable> identifiers)
+      : m_scanner(std::move(scanner)), m_identifiers(std::move(identifiers)),
+        m_next(0), m_dropped(0), m_markCount(0), m_tokenized(false),
+        m_failed(false), m_failure{}
   {
   }
 
+  CLangLexer::~CLangLexer() = default;
+
   CLangToken CLangLexer::GetToken()
   {
-    if (m_lookAheadBuffer.has_value())
+    if (m_next < m_tokens.GetSize())
     {
-      CLangToken token = *m_lookAheadBuffer;
-      m_lookAheadBuffer = {};
-      return token;
+      return m_tokens[m_next++];
+    }
+    if (m_tokenized)
+    {
+      return {};
+    }
+
+    CLangToken token = ReadToken();
+    if (m_markCount > 0 && token.type != CLangTokenType::NoToken)
+    {
+      m_tokens.Append(token);
+      m_next += 1;
+    }
+    else
+    {
+      DropConsumed();
+    }
+    return token;
+  }
+
+  CLangToken CLangLexer::PeekToken(size_t lookAhead)
+  {
+    DropConsumed();
+    while (m_next + lookAhead >= m_tokens.GetSize())
+    {
+      if (m_tokenized)
+      {
+        return {};
+      }
+
+      CLangToken token = ReadToken();
+      if (token.type == CLangTokenType::NoToken)
+      {
+        return token;
+      }
+      m_tokens.Append(token);
+    }
+    return m_tokens[m_next + lookAhead];
+  }
+
+  void CLangLexer::Tokenize(size_t threadCount)
+  {
+    std::string_view source = GetSourceManager().GetSource();
+    size_t chunkCount = std::min(threadCount, source.size() / MinimumChunkSize);
+    if (chunkCount > 1 && m_scanner->GetOffset() == 0 && !m_tokenized)
+    {
+      TokenizeChunks(source, chunkCount);
+      return;
+    }
+
+    DropConsumed();
+    while (!m_tokenized)
+    {
+      CLangToken token = ReadToken();
+      if (token.type == CLangTokenType::NoToken)
+      {
+        m_tokenized = true;
+      }
+      else
+      {
+        m_tokens.Append(token);
+      }
+    }
+    m_tokens.ShrinkToFit();
+  }
+
+  void CLangLexer::TokenizeChunks(std::string_view source, size_t chunkCount)
+  {
+    std::vector<uint32_t> starts = FindSplitPoints(source, chunkCount);
+    starts.insert(starts.begin(), 0);
+
+    std::vector<std::unique_ptr<CLangLexer>> chunks;
+    for (size_t i = 0; i < starts.size(); i++)
+    {
+      size_t end = i + 1 < starts.size() ? starts[i + 1] : source.size();
+      chunks.push_back(std::make_unique<CLangLexer>(
+          std::make_unique<BufferScanner>(
+              source.substr(starts[i], end - starts[i]))));
+    }
+
+    // Lexing only throws when memory runs out, which is passed on once
+    // every thread has finished.
+    std::vector<std::exception_ptr> errors(chunks.size());
+    auto tokenizeChunk = [&](size_t chunk) {
+      try
+      {
+        chunks[chunk]->Tokenize();
+      }
+      catch (...)
+      {
+        errors[chunk] = std::current_exception();
+      }
+    };
+    {
+      std::vector<std::jthread> threads;
+      for (size_t i = 1; i < chunks.size(); i++)
+      {
+        threads.emplace_back(tokenizeChunk, i);
+      }
+      tokenizeChunk(0);
+    }
+    for (const std::exception_ptr &error : errors)
+    {
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+
+    size_t tokenCount = 0;
+    for (const std::unique_ptr<CLangLexer> &chunk : chunks)
+    {
+      tokenCount += chunk->m_tokens.GetSize();
+    }
+    m_tokens.Reserve(tokenCount);
+
+    // Interning each chunk's names in the order the chunk first saw them
+    // hands out identifiers in the order of their first use in the source.
+    std::vector<uint32_t> identifiers;
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+      const CLangLexer &chunk = *chunks[i];
+      identifiers.resize(chunk.m_identifiers->GetCount());
+      for (uint32_t name = 0; name < identifiers.size(); name++)
+      {
+        identifiers[name] = static_cast<uint32_t>(m_identifiers->Intern(
+            chunk.m_identifiers->GetName(static_cast<Identifier>(name))));
+      }
+      uint32_t firstNumber =
+          static_cast<uint32_t>(m_literals.GetNumberCount());
+      uint32_t firstLiteral = m_literals.Append(chunk.m_literals);
+      uint32_t firstDiagnostic =
+          m_diagnostics.Append(chunk.m_diagnostics, starts[i]);
+
+      for (size_t index = 0; index < chunk.m_tokens.GetSize(); index++)
+      {
+        CLangToken token = chunk.m_tokens[index];
+        token.offset += starts[i];
+        if (token.type == CLangTokenType::Identifier)
+        {
+          token.value = identifiers[token.value];
+        }
+        else if (token.type == CLangTokenType::Error)
+        {
+          token.value += firstDiagnostic;
+        }
+        else if (token.type == CLangTokenType::IntegerConstant ||
+                 token.type == CLangTokenType::FloatConstant)
+        {
+          token.value += firstNumber;
+        }
+        else if (token.value != CLangToken::NoValue)
+        {
+          token.value += firstLiteral;
+        }
+
+        // The newline ending the previous chunk precedes its first token.
+        if (index == 0 && i > 0)
+        {
+          token.flags |= CLangToken::LeadingSpace;
+        }
+        m_tokens.Append(token);
+      }
+    }
+
+    m_scanner->Next(source.size());
+    m_tokenized = true;
+  }
+
+  void CLangLexer::StartPipeline()
+  {
+    std::string_view source = GetSourceManager().GetSource();
+    if (source.empty() || m_scanner->GetOffset() != 0 || m_tokenized ||
+        m_pipeline)
+    {
+      return;
+    }
+
+    m_pipeline = std::make_unique<TokenPipeline>(source);
+    m_scanner->Next(source.size());
+  }
+
+  void CLangLexer::StartPreprocessor(const PreprocessorOptions &options)
+  {
+    if (m_scanner->GetOffset() != 0 || m_tokenized || m_pipeline ||
+        m_preprocessor)
+    {
+      return;
+    }
+
+    // Directives may refer to anything after them, so a streamed source is
+    // read to its end and preprocessed like a buffered one.
+    std::string_view source = GetSourceManager().GetSource();
+    if (source.empty() && !m_scanner->Finished())
+    {
+      std::string streamed;
+      while (!m_scanner->Finished())
+      {
+        streamed += m_scanner->Next(StreamedReadSize);
+      }
+      m_scanner = std::make_unique<StringScanner>(std::move(streamed));
+      source = GetSourceManager().GetSource();
     }
+    if (source.empty())
+    {
+      return;
+    }
+
+    m_preprocessor =
+        std::make_unique<Preprocessor>(source, m_identifiers, options);
+    if (options.precompiledHeader)
+    {
+      m_preprocessor->Load(*options.precompiledHeader, m_literals);
+    }
+    m_scanner->Next(source.size());
+  }
 
+  size_t CLangLexer::Relex(const SourceEdit &edit,
+                           std::unique_ptr<Scanner> scanner)
+  {
+    m_pipeline.reset();
+    m_scanner = std::move(scanner);
+    m_next = 0;
+
+    // Find the first token that ends close enough to the edit to have read
+    // it. Lexing restarts at the end of the token before, so that the
+    // whitespace in between sets the flags of the first relexed token.
+    size_t size = m_tokens.GetSize();
+    size_t first = 0;
+    size_t last = size;
+    while (first < last)
+    {
+      size_t middle = first + (last - first) / 2;
+      CLangToken token = m_tokens[middle];
+      if (token.offset + token.length + MaximumLookAhead <= edit.offset)
+      {
+        first = middle + 1;
+      }
+      else
+      {
+        last = middle;
+      }
+    }
+
+    // A token followed by a line splice read past it, to the character after
+    // the splice.
+    while (first > 0)
+    {
+      CLangToken previous = m_tokens[first - 1];
+      if (m_scanner->LookAhead(previous.offset + previous.length) != '\\')
+      {
+        break;
+      }
+      first--;
+    }
+
+    uint32_t restart = 0;
+    if (first > 0)
+    {
+      CLangToken previous = m_tokens[first - 1];
+      restart = previous.offset + previous.length;
+    }
+    m_scanner->Next(restart);
+
+    // Lexing an unchanged source from where an old token ended gives the
+    // same tokens as before, so lexing stops at the first such position past
+    // the edit.
+    uint32_t editEnd = edit.offset + edit.removedLength;
+    uint32_t shift = edit.insertedLength - edit.removedLength;
+    uint32_t reported = static_cast<uint32_t>(m_diagnostics.GetCount());
+    TokenBuffer relexed;
+    size_t old = first;
+    size_t kept = size;
+    while (true)
+    {
+      uint32_t position = m_scanner->GetOffset();
+      while (old < size &&
+             (m_tokens.GetOffset(old) < editEnd ||
+              m_tokens.GetOffset(old) + m_tokens[old].length + shift <
+                  position))
+      {
+        old++;
+      }
+      if (old < size &&
+          m_tokens.GetOffset(old) + m_tokens[old].length + shift == position)
+      {
+        kept = old + 1;
+        break;
+      }
+
+      CLangToken token = LexToken();
+      if (token.type == CLangTokenType::NoToken)
+      {
+        break;
+      }
+      relexed.Append(token);
+    }
+
+    // Diagnostics are kept in token order, so those of the replaced tokens
+    // are swapped for the new ones in place.
+    uint32_t firstDiagnostic = reported;
+    uint32_t replacedDiagnostics = 0;
+    if (reported > 0)
+    {
+      size_t index = first;
+      while (index < size && m_tokens.GetType(index) != CLangTokenType::Error)
+      {
+        index++;
+      }
+      if (index < size)
+      {
+        firstDiagnostic = m_tokens[index].value;
+      }
+      for (; index < kept; index++)
+      {
+        if (m_tokens.GetType(index) == CLangTokenType::Error)
+        {
+          replacedDiagnostics += 1;
+        }
+      }
+    }
+    uint32_t relexedDiagnostics =
+        static_cast<uint32_t>(m_diagnostics.GetCount()) - reported;
+    m_diagnostics.Splice(firstDiagnostic, replacedDiagnostics, reported,
+                         shift);
+    relexed.ShiftValues(0, CLangTokenType::Error, firstDiagnostic - reported);
+
+    m_tokens.Replace(first, kept - first, relexed);
+    size_t tail = first + relexed.GetSize();
+    m_tokens.ShiftOffsets(tail, shift);
+    if (relexedDiagnostics != replacedDiagnostics)
+    {
+      m_tokens.ShiftValues(tail, CLangTokenType::Error,
+                           relexedDiagnostics - replacedDiagnostics);
+    }
+
+    m_scanner->Next(GetSourceManager().GetSource().size());
+    return relexed.GetSize();
+  }
+
+  TokenMark CLangLexer::Mark()
+  {
+    m_markCount += 1;
+    return {m_dropped + static_cast<uint32_t>(m_next)};
+  }
+
+  void CLangLexer::Reset(TokenMark mark)
+  {
+    m_next = mark.index - m_dropped;
+  }
+
+  void CLangLexer::Release(TokenMark)
+  {
+    m_markCount -= 1;
+  }
+
+  void CLangLexer::DropConsumed()
+  {
+    if (m_markCount == 0 && m_next > 0 && m_next == m_tokens.GetSize() &&
+        !m_tokenized)
+    {
+      m_dropped += static_cast<uint32_t>(m_next);
+      m_next = 0;
+      m_tokens.Clear();
+    }
+  }
+
+  CLangToken CLangLexer::ReadToken()
+  {
+    if (m_preprocessor)
+    {
+      return m_preprocessor->GetToken(m_literals, m_diagnostics);
+    }
+    if (m_pipeline)
+    {
+      return m_pipeline->GetToken(m_literals, m_diagnostics, *m_identifiers);
+    }
+    return LexToken();
+  }
+
+  CLangToken CLangLexer::LexToken()
+  {
+    bool startOfLine = m_scanner->GetOffset() == 0;
+    bool leadingSpace = false;
     while (!m_scanner->Finished())
     {
-      m_scanner->NextWhile(reinterpret_cast<bool (*)(wchar_t)>(iswspace));
+      uint32_t whitespace = m_scanner->GetOffset();
+      startOfLine = m_scanner->SkipWhitespace() || startOfLine;
+      leadingSpace = leadingSpace || m_scanner->GetOffset() != whitespace;
 
-      if (m_scanner->LookAhead(0, 2) == L"//")
+      // A line splice joins its lines without leaving whitespace between
+      // them.
+      if (size_t splice = m_scanner->GetSpliceLength())
       {
-        m_scanner->NextWhile([](wchar_t c) { return c != '\n'; });
+        m_scanner->Next(splice);
+        continue;
       }
-      else if (m_scanner->LookAhead(0, 2) == L"/*")
+      if (m_scanner->Matches("//"))
+      {
+        m_scanner->SkipLine();
+        leadingSpace = true;
+        continue;
+      }
+      if (m_scanner->Matches("/*"))
       {
         m_scanner->Next(2);
-        while (!m_scanner->Finished() && m_scanner->LookAhead(0, 2) != L"*/")
+        m_scanner->SkipBlockComment();
+        leadingSpace = true;
+        continue;
+      }
+
+      ScannerMark start = m_scanner->Mark();
+      CLangToken token = ParseToken();
+
+      // Only a splice right after a token can continue it. Literals have
+      // taken the splices inside them already and end at their quote.
+      if (m_scanner->Matches('\\') &&
+          token.type != CLangTokenType::CharacterConstant &&
+          token.type != CLangTokenType::StringLiteral)
+      {
+        size_t splice = m_scanner->GetSpliceLength();
+        std::string_view next = m_scanner->LookAhead(splice, 1);
+        if (splice > 0 && !next.empty() && !IsSpace(next[0]))
         {
-          m_scanner->Next();
+          token = ParseSplicedToken(start);
         }
-        m_scanner->Next(2);
       }
-      else if (iswdigit(m_scanner->LookAhead(0)) ||
-               (m_scanner->LookAhead(0) == '.' &&
-                iswdigit(m_scanner->LookAhead(1))))
+      m_scanner->Release(start);
+      if (token.type == CLangTokenType::NoToken)
       {
-        return ParseNumericalConstant();
+        if (m_scanner->GetOffset() == start.offset)
+        {
+          break;
+        }
+        leadingSpace = true;
+        continue;
       }
-      else if (PunctuatorMap.contains(m_scanner->LookAhead(0, 1)))
+
+      if (m_failed)
       {
-        return ParsePunctuator();
+        token.type = CLangTokenType::Error;
+        token.value = m_diagnostics.Report(m_failure.id, m_failure.offset);
+        m_failed = false;
       }
-      else if (m_scanner->LookAhead(0) == '\'')
+
+      token.length = m_scanner->GetOffset() - token.offset;
+      token.flags |= (startOfLine ? CLangToken::StartOfLine : 0) |
+                     (leadingSpace ? CLangToken::LeadingSpace : 0);
+      return token;
+    }
+
+    return {};
+  }
+
+  CLangToken CLangLexer::ParseToken()
+  {
+    if (IsDigit(m_scanner->LookAhead(0)) ||
+        (m_scanner->LookAhead(0) == '.' && IsDigit(m_scanner->LookAhead(1))))
+    {
+      return ParseNumericalConstant();
+    }
+    if (IsPunctuator(m_scanner->LookAhead(0)))
+    {
+      return ParsePunctuator();
+    }
+    if (m_scanner->Matches('\''))
+    {
+      return ParseCharacterConstant();
+    }
+    if (m_scanner->Matches('"'))
+    {
+      return ParseStringLiteral();
+    }
+    if (m_scanner->Finished())
+    {
+      return {};
+    }
+    return ParseIdentifier();
+  }
+
+  CLangToken CLangLexer::ParseSplicedToken(ScannerMark start)
+  {
+    // Copy the line up to the first whitespace, which ends every token but a
+    // literal, keeping the offset of each character from the start.
+    m_scanner->Reset(start);
+    m_failed = false;
+    std::string line;
+    std::vector<uint32_t> offsets;
+    bool quoted = false;
+    size_t offset = 0;
+    while (true)
+    {
+      offset += m_scanner->GetSpliceLength(offset);
+      std::string_view next = m_scanner->LookAhead(offset, 1);
+      if (next.empty() || next[0] == '\n' || (!quoted && IsSpace(next[0])))
       {
-        return ParseCharacterConstant();
+        break;
       }
-      else if (m_scanner->LookAhead(0) == '"')
+      quoted = quoted || next[0] == '"' || next[0] == '\'';
+      line += next[0];
+      offsets.push_back(static_cast<uint32_t>(offset));
+      offset += 1;
+    }
+
+    if (line.starts_with("//") || line.starts_with("/*"))
+    {
+      m_scanner->Next(offsets[1] + 1);
+      if (line[1] == '/')
       {
-        return ParseStringLiteral();
+        m_scanner->SkipLine();
       }
-      else if (!m_scanner->Finished())
+      else
       {
-        return ParseIdentifier();
+        m_scanner->SkipBlockComment();
       }
+      return {};
     }
 
-    return {};
+    CLangLexer lexer(std::make_unique<BufferScanner>(line), m_identifiers);
+    CLangToken token = lexer.LexToken();
+
+    // The line starts with the token, so lexing it gives a token no longer
+    // than the line, which the offsets below are read at. Should that ever
+    // not hold, the token is lexed in place up to the splice instead.
+    if (token.length == 0 || token.length > offsets.size())
+    {
+      m_scanner->Reset(start);
+      m_failed = false;
+      return ParseToken();
+    }
+    switch (token.type)
+    {
+    case CLangTokenType::IntegerConstant:
+    case CLangTokenType::FloatConstant:
+      token.value =
+          m_literals.AddNumber(lexer.m_literals.GetNumber(token.value));
+      break;
+    case CLangTokenType::CharacterConstant:
+    case CLangTokenType::StringLiteral:
+      token.value = m_literals.Add(lexer.m_literals.Get(token.value));
+      break;
+    case CLangTokenType::Error: {
+      uint32_t position = lexer.m_diagnostics.Get(token.value).offset;
+      Fail(lexer.m_diagnostics.Get(token.value).id,
+           start.offset + (position < offsets.size()
+                               ? offsets[position]
+                               : offsets.back() + 1));
+      break;
+    }
+    default:
+      break;
+    }
+
+    uint32_t length = offsets[token.length - 1] + 1;
+    m_scanner->Next(length);
+    token.offset = start.offset;
+    token.flags = length != token.length ? CLangToken::Spliced : 0;
+    return token;
   }
 
-  CLangToken CLangLexer::PeekToken()
+  void CLangLexer::Fail(DiagnosticId id)
   {
-    if (!m_lookAheadBuffer.has_value())
+    Fail(id, m_scanner->GetOffset());
+  }
+
+  void CLangLexer::Fail(DiagnosticId id, uint32_t offset)
+  {
+    if (!m_failed)
     {
-      m_lookAheadBuffer = GetToken();
+      m_failed = true;
+      m_failure = {.id = id, .offset = offset};
     }
-    return *m_lookAheadBuffer;
   }
 
-  CLangToken CLangLexer::ParsePunctuator()
+  void CLangLexer::SkipQuoted(ScannerMark start)
   {
-    CLangToken token = {.line = m_scanner->GetLine(),
-                        .column = m_scanner->GetColumn()};
-    do
+    m_scanner->Reset(start);
+    char quote = m_scanner->Next();
+
+    // These are the rules `FindSplitPoints` skips literals by, so a source
+    // with errors splits into chunks that lex as they would in place.
+    if (quote == '\'' && !m_scanner->Matches('\\') && !m_scanner->Finished())
     {
-      token.content += m_scanner->Next();
-    } while (
-        !m_scanner->Finished() &&
-            PunctuatorMap.contains(token.content + m_scanner->LookAhead(0)) ||
-        PunctuatorMap.contains(token.content + m_scanner->LookAhead(0, 2)));
-    token.type = PunctuatorMap.at(token.content);
+      m_scanner->Next();
+    }
+    while (!m_scanner->Finished() && !m_scanner->Matches('\n'))
+    {
+      char character = m_scanner->Next();
+      if (character == quote)
+      {
+        break;
+      }
+      if (character == '\\')
+      {
+        m_scanner->Next(m_scanner->Matches("\r\n") ? 2 : 1);
+      }
+    }
+  }
+
+  std::string_view CLangLexer::GetSpelling(const CLangToken &token) const
+  {
+    switch (token.type)
+    {
+    case CLangTokenType::NoToken:
+      return {};
+    case CLangTokenType::Identifier:
+      return m_identifiers->GetName(token.GetIdentifier());
+    case CLangTokenType::CharacterConstant:
+    case CLangTokenType::StringLiteral:
+      return m_literals.Get(token.value);
+    default:
+      break;
+    }
+
+    std::string_view source = GetSourceManager().GetSource();
+    if (!source.empty() &&
+        !(token.flags & (CLangToken::Relocated | CLangToken::Spliced)))
+    {
+      return source.substr(token.offset, token.length);
+    }
+
+    std::string_view spelling = GetPunctuatorSpelling(token.type);
+    return spelling.empty() ? GetKeywordSpelling(token.type) : spelling;
+  }
+
+  CLangToken CLangLexer::ParsePunctuator()
+  {
+    CLangToken token = {.offset = m_scanner->GetOffset()};
+    CLangPunctuator punctuator =
+        FindPunctuator(m_scanner->LookAhead(0), m_scanner->LookAhead(1),
+                       m_scanner->LookAhead(2));
+    token.type = punctuator.type;
+    m_scanner->Next(punctuator.length);
     return token;
   }
 
   CLangToken CLangLexer::ParseIdentifier()
   {
     CLangToken token = {.type = CLangTokenType::Identifier,
-                        .line = m_scanner->GetLine(),
-                        .column = m_scanner->GetColumn()};
-    while (!m_scanner->Finished() &&
-           !PunctuatorMap.contains(m_scanner->LookAhead(0, 1)) &&
-           m_scanner->LookAhead(0) != '"' && m_scanner->LookAhead(0) != '\'' &&
-           !iswspace(m_scanner->LookAhead(0)))
-    {
-      token.content += m_scanner->Next();
-      if (token.content.back() == '\\')
-      {
-        token.content.pop_back();
-        std::wstring uChar = ParseUniversalCharacter();
+                        .offset = m_scanner->GetOffset()};
+    std::string_view name = m_scanner->NextIdentifierRun();
+
+    // The run stays in the window until the scanner looks past the character
+    // after it, which may refill the window and move it. The run is copied
+    // before looking for a universal character name or a line splice.
+    std::string spelling;
+    if (m_scanner->Matches('\\'))
+    {
+      spelling = name;
+      name = spelling;
+      while (m_scanner->Matches('\\') && m_scanner->GetSpliceLength() == 0)
+      {
+        m_scanner->Next();
+        std::string uChar = ParseUniversalCharacter();
         if (uChar.empty())
         {
-          throw ParsingException(L"Malformatted universal character",
-                                 token.column, token.line);
+          Fail(DiagnosticId::MalformedUniversalCharacter);
         }
-        token.content += uChar;
+        spelling += uChar;
+        spelling += m_scanner->NextIdentifierRun();
+      }
+      if (m_failed)
+      {
+        return token;
       }
+      name = spelling;
     }
 
-    if (KeywordMap.contains(token.content))
+    token.type = FindKeyword(name);
+    if (token.type == CLangTokenType::Identifier)
     {
-      token.type = KeywordMap.at(token.content);
+      token.value = static_cast<uint32_t>(m_identifiers->Intern(name));
     }
 
     return token;
   }
 
-  std::wstring CLangLexer::ParseUniversalCharacter()
+  std::string CLangLexer::ParseUniversalCharacter()
   {
     constexpr size_t Utf16CodeSize = 4;
     constexpr size_t Utf32CodeSize = 8;
@@ -135,354 +758,442 @@ namespace Vypr
     if (m_scanner->Finished() ||
         (m_scanner->LookAhead(0) != 'U' && m_scanner->LookAhead(0) != 'u'))
     {
-      return L"";
+      return "";
     }
 
     size_t codeSize = m_scanner->Next() == 'u' ? Utf16CodeSize : Utf32CodeSize;
 
-    std::wstring unicodeCharacter = m_scanner->Next(codeSize);
-    if (unicodeCharacter.length() != codeSize)
+    // Only hex digits are consumed so that a malformed character never
+    // swallows a quote or newline that follows it.
+    std::string_view unicodeCharacter = m_scanner->LookAhead(0, codeSize);
+    size_t digitCount = 0;
+    while (digitCount < unicodeCharacter.size() &&
+           IsHexDigit(unicodeCharacter[digitCount]))
     {
-      return L"";
+      digitCount += 1;
     }
-
-    for (wchar_t codepoint : unicodeCharacter)
+    m_scanner->Next(digitCount);
+    if (digitCount != codeSize)
     {
-      if (!iswdigit(codepoint) && towlower(codepoint) < 'a' &&
-          towlower(codepoint) > 'f')
-      {
-        return L"";
-      }
+      return "";
     }
 
-    std::wstring buffer;
-    uint32_t codepoint = std::stoi(unicodeCharacter, nullptr, 16);
-#ifdef _WIN32
-    if (codeSize == Utf16CodeSize || codepoint < 0x10000)
+    uint32_t codepoint = 0;
+    for (char digit : unicodeCharacter)
     {
-      buffer += static_cast<wchar_t>(codepoint);
+      codepoint = codepoint * 16 +
+                  (IsDigit(digit) ? digit - '0' : ToLower(digit) - 'a' + 10);
     }
-    else
+
+    if (codepoint > 0x10FFFF)
     {
-      codepoint -= 0x10000;
-      buffer += static_cast<wchar_t>(((codepoint >> 10) & 0x3FF) | 0xD800);
-      buffer += static_cast<wchar_t>((codepoint & 0x3FF) | 0xDC00);
+      return "";
     }
-#else
-    buffer += static_cast<wchar_t>(codepoint);
-#endif
 
+    std::string buffer;
+    AppendUtf8(buffer, codepoint);
     return buffer;
   }
 
   CLangToken CLangLexer::ParseNumericalConstant()
   {
     CLangToken token = {.type = CLangTokenType::IntegerConstant,
-                        .line = m_scanner->GetLine(),
-                        .column = m_scanner->GetColumn()};
+                        .offset = m_scanner->GetOffset()};
+    ScannerMark start = m_scanner->Mark();
 
-    if (m_scanner->LookAhead(0, 2) == L"0b" ||
-        m_scanner->LookAhead(0, 2) == L"0B")
+    unsigned radix = 10;
+    uint32_t prefixLength = 0;
+    if (m_scanner->Matches("0b") || m_scanner->Matches("0B"))
     {
-      token.content += m_scanner->Next();
-      token.content += towlower(m_scanner->Next());
-      token.content += ParseBinaryConstant();
+      radix = 2;
+      prefixLength = 2;
+      m_scanner->Next(prefixLength);
+      ParseBinarySequence();
     }
-    else if (m_scanner->LookAhead(0, 2) == L"0x" ||
-             m_scanner->LookAhead(0, 2) == L"0X")
+    else
     {
-      token.content += m_scanner->Next();
-      token.content += towlower(m_scanner->Next());
+      if (m_scanner->Matches("0x") || m_scanner->Matches("0X"))
+      {
+        radix = 16;
+        prefixLength = 2;
+        m_scanner->Next(prefixLength);
+      }
 
-      const auto &[isFloatingPoint, content] = ParseFloatableConstant(
-          &CLangLexer::ParseHexadecimalSequence, 'p', true);
-      token.content += content;
-      if (isFloatingPoint)
+      if (ParseFloatableConstant(radix == 16))
       {
         token.type = CLangTokenType::FloatConstant;
       }
     }
-    else
+
+    uint32_t bodyLength = m_scanner->GetOffset() - start.offset - prefixLength;
+    uint8_t suffix = token.type == CLangTokenType::IntegerConstant
+                         ? ParseIntegerSuffix()
+                         : ParseFloatSuffix();
+    NumericLiteral number = {.integer = 0, .suffix = suffix};
+
+    if (!m_failed)
     {
-      const auto &[isFloatingPoint, content] =
-          ParseFloatableConstant(&CLangLexer::ParseIntegerSequence, 'e', false);
-      token.content += content;
-      if (isFloatingPoint)
+      // The mark keeps the whole constant in the scanner's window, so it is
+      // converted from the source without being copied.
+      uint32_t length = m_scanner->GetOffset() - start.offset;
+      m_scanner->Reset(start);
+      std::string_view body =
+          m_scanner->Next(length).substr(prefixLength, bodyLength);
+      if (token.type == CLangTokenType::IntegerConstant)
       {
-        token.type = CLangTokenType::FloatConstant;
+        ConvertInteger(body, radix, start.offset + prefixLength, number);
+      }
+      else
+      {
+        ConvertFloating(body, radix == 16, start.offset, number);
       }
     }
+    m_scanner->Release(start);
 
-    if (token.type == CLangTokenType::IntegerConstant)
+    if (m_failed)
     {
-      token.content += ParseIntegerSuffix();
-    }
-    else
-    {
-      token.content += ParseFloatSuffix();
+      // Resume after the rest of the malformed number.
+      m_scanner->NextWhile([](char c) { return IsIdentifier(c) || c == '.'; });
+      return token;
     }
 
+    token.value = m_literals.AddNumber(number);
     return token;
   }
 
-  std::wstring CLangLexer::ParseBinaryConstant()
+  void CLangLexer::ConvertInteger(std::string_view digits, unsigned radix,
+                                  uint32_t offset, NumericLiteral &number)
   {
-    std::wstring buffer;
-    while (iswdigit(m_scanner->LookAhead(0)))
+    if (radix == 10 && digits.size() > 1 && digits[0] == '0')
     {
-      buffer += m_scanner->Next();
-      if (buffer.back() != '0' && buffer.back() != '1')
+      radix = 8;
+      size_t invalid = digits.find_first_of("89");
+      if (invalid != std::string_view::npos)
       {
-        throw ParsingException(buffer + L" is not a valid binary number.",
-                               m_scanner->GetColumn(), m_scanner->GetLine());
+        Fail(DiagnosticId::InvalidOctalDigit,
+             offset + static_cast<uint32_t>(invalid));
+        return;
       }
     }
 
-    if (buffer.empty())
+    std::optional<uint64_t> value = ConvertDigits(digits, radix);
+    if (!value)
     {
-      throw ParsingException(L"Expected binary number.", m_scanner->GetColumn(),
-                             m_scanner->GetLine());
+      Fail(DiagnosticId::ConstantTooLarge, offset);
+      return;
     }
+    number.integer = *value;
+  }
 
-    return buffer;
+  void CLangLexer::ConvertFloating(std::string_view text, bool hexadecimal,
+                                   uint32_t offset, NumericLiteral &number)
+  {
+    std::optional<double> value =
+        ConvertReal(text, hexadecimal, number.suffix & NumericLiteral::Float);
+    if (!value && (number.suffix & NumericLiteral::Float))
+    {
+      number.suffix &= ~NumericLiteral::Float;
+      value = ConvertReal(text, hexadecimal, false);
+    }
+
+    if (!value)
+    {
+      Fail(DiagnosticId::ConstantTooLarge, offset);
+      return;
+    }
+    number.real = *value;
   }
 
-  std::tuple<bool, std::wstring> CLangLexer::ParseFloatableConstant(
-      std::wstring (CLangLexer::*parser)(), char exponentDelimiter,
-      bool requireExponent)
+  void CLangLexer::ParseBinarySequence()
+  {
+    bool empty =
+        m_scanner->NextWhile([](char c) { return c == '0' || c == '1'; })
+            .empty();
+    if (IsDigit(m_scanner->LookAhead(0)))
+    {
+      Fail(DiagnosticId::InvalidBinaryDigit);
+    }
+    else if (empty)
+    {
+      Fail(DiagnosticId::ExpectedBinaryDigits);
+    }
+  }
+
+  bool CLangLexer::ParseFloatableConstant(bool hexadecimal)
   {
-    std::wstring buffer;
     bool isFloatingPoint = false;
+    bool hasIntegralPart = false;
 
     if (m_scanner->LookAhead(0) != '.')
     {
-      buffer += (this->*parser)();
+      ParseDigitSequence(hexadecimal, true);
+      hasIntegralPart = true;
     }
 
     if (m_scanner->LookAhead(0) == '.')
     {
       isFloatingPoint = true;
+      m_scanner->Next();
 
-      buffer += m_scanner->Next();
-
-      try
-      {
-        buffer += (this->*parser)();
-      }
-      catch (const ParsingException &e)
-      {
-        if (buffer == L".")
-        {
-          throw e;
-        }
-      }
+      // The fraction may only be left out after an integral part.
+      ParseDigitSequence(hexadecimal, !hasIntegralPart);
     }
 
-    if (towlower(m_scanner->LookAhead(0)) == exponentDelimiter)
+    char exponentDelimiter = hexadecimal ? 'p' : 'e';
+    if (ToLower(m_scanner->LookAhead(0)) == exponentDelimiter)
     {
       isFloatingPoint = true;
-
-      buffer += towlower(m_scanner->Next());
+      m_scanner->Next();
 
       if (m_scanner->LookAhead(0) == '-' || m_scanner->LookAhead(0) == '+')
       {
-        buffer += m_scanner->Next();
+        m_scanner->Next();
       }
 
-      buffer += ParseIntegerSequence();
+      ParseDigitSequence(false, true);
     }
-    else if (isFloatingPoint && requireExponent)
+    else if (isFloatingPoint && hexadecimal)
     {
-      throw ParsingException(L"Invalid numerical constant.",
-                             m_scanner->GetColumn(), m_scanner->GetLine());
+      Fail(DiagnosticId::ExpectedHexadecimalExponent);
     }
-    else if (towlower(m_scanner->LookAhead(0)) == 'f')
+    else if (ToLower(m_scanner->LookAhead(0)) == 'f')
     {
       isFloatingPoint = true;
     }
 
-    return {isFloatingPoint, buffer};
+    return isFloatingPoint;
   }
 
-  std::wstring CLangLexer::ParseHexadecimalSequence()
+  void CLangLexer::ParseDigitSequence(bool hexadecimal, bool required)
   {
-    std::wstring buffer;
-    while (iswxdigit(m_scanner->LookAhead(0)))
-    {
-      buffer += towlower(m_scanner->Next());
-    }
-
-    if (buffer.empty())
+    bool empty = hexadecimal ? m_scanner->NextWhile(IsHexDigit).empty()
+                             : m_scanner->NextWhile(IsDigit).empty();
+    if (empty && required)
     {
-      throw ParsingException(L"Expected hexadecimal number.",
-                             m_scanner->GetColumn(), m_scanner->GetLine());
+      Fail(hexadecimal ? DiagnosticId::ExpectedHexadecimalDigits
+                       : DiagnosticId::ExpectedDecimalDigits);
     }
-
-    return buffer;
   }
 
-  std::wstring CLangLexer::ParseIntegerSequence()
+  uint8_t CLangLexer::ParseIntegerSuffix()
   {
-    std::wstring buffer;
-    while (iswdigit(m_scanner->LookAhead(0)))
-    {
-      buffer += m_scanner->Next();
-    }
-
-    if (buffer.empty())
+    uint8_t suffix = 0;
+    char previous = '\0';
+    while (IsAlpha(m_scanner->LookAhead(0)))
     {
-      throw ParsingException(L"Expected decimal number.",
-                             m_scanner->GetColumn(), m_scanner->GetLine());
-    }
-
-    return buffer;
-  }
-
-  std::wstring CLangLexer::ParseIntegerSuffix()
-  {
-    std::wstring buffer;
-    bool signUsed = false;
-    bool sizeUsed = false;
-    while (iswalpha(m_scanner->LookAhead(0)))
-    {
-      buffer += towlower(m_scanner->Next());
-
-      if (buffer.back() == 'u')
+      char c = ToLower(m_scanner->Next());
+      if (c == 'u' && !(suffix & NumericLiteral::Unsigned))
       {
-        if (signUsed)
-        {
-          throw ParsingException(L"Invalid suffix for integer constant " +
-                                     m_scanner->LookAhead(0, 1),
-                                 m_scanner->GetColumn(), m_scanner->GetLine());
-        }
-        signUsed = true;
+        suffix |= NumericLiteral::Unsigned;
       }
-      else if (buffer.back() == 'l')
+      else if (c == 'l' && !(suffix & (NumericLiteral::Long |
+                                       NumericLiteral::LongLong)))
       {
-        if (sizeUsed && buffer[buffer.size() - 2] != 'l')
-        {
-          throw ParsingException(L"Invalid suffix for integer constant " +
-                                     m_scanner->LookAhead(0, 1),
-                                 m_scanner->GetColumn(), m_scanner->GetLine());
-        }
-        sizeUsed = true;
+        suffix |= NumericLiteral::Long;
+      }
+      else if (c == 'l' && previous == 'l' &&
+               !(suffix & NumericLiteral::LongLong))
+      {
+        suffix = (suffix & ~NumericLiteral::Long) | NumericLiteral::LongLong;
       }
       else
       {
-        throw ParsingException(L"Invalid suffix for integer constant " +
-                                   m_scanner->LookAhead(0, 1),
-                               m_scanner->GetColumn(), m_scanner->GetLine());
+        Fail(DiagnosticId::InvalidIntegerSuffix);
+        break;
       }
+      previous = c;
     }
-    return buffer;
+    return suffix;
   }
 
-  std::wstring CLangLexer::ParseFloatSuffix()
+  uint8_t CLangLexer::ParseFloatSuffix()
   {
-    if (towlower(m_scanner->LookAhead(0)) == 'l' ||
-        towlower(m_scanner->LookAhead(0)) == 'f')
+    char c = ToLower(m_scanner->LookAhead(0));
+    if (c == 'f')
+    {
+      m_scanner->Next();
+      return NumericLiteral::Float;
+    }
+    else if (c == 'l')
     {
-      return std::wstring{static_cast<wchar_t>(towlower(m_scanner->Next()))};
+      // `long double` is lowered to `double`.
+      m_scanner->Next();
     }
-    else if (iswalpha(m_scanner->LookAhead(0)))
+    else if (IsAlpha(m_scanner->LookAhead(0)))
     {
-      throw ParsingException(L"Invalid suffix for floating point constant " +
-                                 m_scanner->LookAhead(0, 1),
-                             m_scanner->GetColumn(), m_scanner->GetLine());
+      Fail(DiagnosticId::InvalidFloatSuffix);
     }
 
-    return {};
+    return 0;
   }
 
   CLangToken CLangLexer::ParseCharacterConstant()
   {
     CLangToken token{.type = CLangTokenType::CharacterConstant,
-                     .line = m_scanner->GetLine(),
-                     .column = m_scanner->GetColumn()};
+                     .offset = m_scanner->GetOffset()};
+    ScannerMark start = m_scanner->Mark();
     m_scanner->Next();
+    m_scanner->Next(m_scanner->GetSpliceLength());
     if (m_scanner->LookAhead(0) == '\\')
     {
       m_scanner->Next();
-      token.content += ParseEscapeSequence();
+      ParseEscapeSequence();
     }
     else if (m_scanner->LookAhead(0) == '\'')
     {
-      throw ParsingException(L"Expected '\'' to end character literal.",
-                             m_scanner->GetColumn(), m_scanner->GetLine());
+      Fail(DiagnosticId::EmptyCharacterConstant);
     }
     else
     {
-      token.content += m_scanner->Next();
+      m_literals.Extend(m_scanner->Next(1));
+      m_literals.Extend(m_scanner->NextWhile(IsUtf8Continuation));
     }
 
-    if (m_scanner->LookAhead(0) != '\'')
+    m_scanner->Next(m_scanner->GetSpliceLength());
+    if (!m_failed && m_scanner->LookAhead(0) != '\'')
     {
-      throw ParsingException(L"Expected '\'' to end character literal.",
-                             m_scanner->GetColumn(), m_scanner->GetLine());
+      Fail(DiagnosticId::UnterminatedCharacterConstant);
     }
-    m_scanner->Next();
 
+    if (m_failed)
+    {
+      m_literals.Discard();
+      SkipQuoted(start);
+    }
+    else
+    {
+      m_scanner->Next();
+      token.value = m_literals.Finish();
+    }
+    m_scanner->Release(start);
     return token;
   }
 
-  wchar_t CLangLexer::ParseEscapeSequence()
+  void CLangLexer::ParseEscapeSequence()
   {
-    static const std::unordered_map<wchar_t, wchar_t> EscapeTranslations = {
-        {'a', '\a'},  {'b', '\b'},  {'e', '\e'}, {'f', '\f'},
-        {'n', '\n'},  {'r', '\r'},  {'t', '\t'}, {'v', '\v'},
-        {'\\', '\\'}, {'\'', '\''}, {'"', '"'},  {'?', '\?'}};
-    if (EscapeTranslations.contains(m_scanner->LookAhead(0)))
+    char escape = m_scanner->LookAhead(0);
+    char translation;
+    switch (escape)
     {
-      return EscapeTranslations.at(m_scanner->Next());
-    }
-
-    if (m_scanner->LookAhead(0) == 'x')
+    case 'a':
+      translation = '\a';
+      break;
+    case 'b':
+      translation = '\b';
+      break;
+    case 'e':
+      translation = '\x1B';
+      break;
+    case 'f':
+      translation = '\f';
+      break;
+    case 'n':
+      translation = '\n';
+      break;
+    case 'r':
+      translation = '\r';
+      break;
+    case 't':
+      translation = '\t';
+      break;
+    case 'v':
+      translation = '\v';
+      break;
+    case '\\':
+    case '\'':
+    case '"':
+    case '?':
+      translation = escape;
+      break;
+    case '\n':
+      // A line splice inside a literal adds nothing to its value.
+      m_scanner->Next();
+      return;
+    case '\r':
+      if (m_scanner->LookAhead(1) != '\n')
+      {
+        Fail(DiagnosticId::UnknownEscapeSequence);
+        return;
+      }
+      m_scanner->Next(2);
+      return;
+    case 'x':
     {
-      return stoi(
-          m_scanner->NextWhile([](wchar_t c) { return iswxdigit(c) != 0; }),
-          nullptr, 16);
+      m_scanner->Next();
+      std::string_view digits = m_scanner->NextWhile(IsHexDigit);
+      uint32_t value = 0;
+      if (std::from_chars(digits.data(), digits.data() + digits.size(), value,
+                          16)
+              .ec != std::errc{})
+      {
+        Fail(DiagnosticId::ExpectedHexadecimalEscape);
+        return;
+      }
+      char byte = static_cast<char>(value);
+      m_literals.Extend({&byte, 1});
+      return;
     }
-    else if (m_scanner->LookAhead(0) == 'u' || m_scanner->LookAhead(0) == 'U')
+    case 'u':
+    case 'U':
     {
-      return ParseUniversalCharacter()[0];
+      std::string universalCharacter = ParseUniversalCharacter();
+      if (universalCharacter.empty())
+      {
+        Fail(DiagnosticId::MalformedUniversalCharacter);
+      }
+      m_literals.Extend(universalCharacter);
+      return;
     }
-    else if (isdigit(m_scanner->LookAhead(0)))
-    {
-      return stoi(
-          m_scanner->NextWhile([](wchar_t c) { return isdigit(c) != 0; }),
-          nullptr, 8);
+    default:
+      if (IsDigit(escape))
+      {
+        std::string_view digits = m_scanner->NextWhile(IsDigit);
+        uint32_t value = 0;
+        std::from_chars(digits.data(), digits.data() + digits.size(), value,
+                        8);
+        char byte = static_cast<char>(value);
+        m_literals.Extend({&byte, 1});
+        return;
+      }
+      Fail(DiagnosticId::UnknownEscapeSequence);
+      return;
     }
 
-    throw ParsingException(L"Unknown escape sequence " +
-                               m_scanner->LookAhead(0, 1),
-                           m_scanner->GetColumn(), m_scanner->GetLine());
+    m_scanner->Next();
+    m_literals.Extend({&translation, 1});
   }
 
   CLangToken CLangLexer::ParseStringLiteral()
   {
     CLangToken token{.type = CLangTokenType::StringLiteral,
-                     .line = m_scanner->GetLine(),
-                     .column = m_scanner->GetColumn()};
+                     .offset = m_scanner->GetOffset()};
+    ScannerMark start = m_scanner->Mark();
     m_scanner->Next();
-    while (!m_scanner->Finished() && m_scanner->LookAhead(0) != '\n' &&
-           m_scanner->LookAhead(0) != '"')
+
+    // Runs without escapes are copied into the literal table as they are.
+    m_literals.Extend(m_scanner->NextStringRun());
+    while (!m_failed && m_scanner->LookAhead(0) == '\\')
     {
-      if (m_scanner->LookAhead(0) == '\\')
-      {
-        m_scanner->Next();
-        token.content += ParseEscapeSequence();
-      }
-      else
-      {
-        token.content += m_scanner->Next();
-      }
+      m_scanner->Next();
+      ParseEscapeSequence();
+      m_literals.Extend(m_scanner->NextStringRun());
     }
-    if (m_scanner->LookAhead(0) != '"')
+    if (!m_failed && m_scanner->LookAhead(0) != '"')
     {
-      throw ParsingException(L"Expected \" at the end of string literal.",
-                             m_scanner->GetColumn(), m_scanner->GetLine());
+      Fail(DiagnosticId::UnterminatedStringLiteral);
     }
-    m_scanner->Next();
+
+    if (m_failed)
+    {
+      m_literals.Discard();
+      SkipQuoted(start);
+    }
+    else
+    {
+      m_scanner->Next();
+      token.value = m_literals.Finish();
+    }
+    m_scanner->Release(start);
     return token;
   }
 } // namespace Vypr
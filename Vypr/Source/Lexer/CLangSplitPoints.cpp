@@ -0,0 +1,171 @@
+#include "Vypr/Lexer/CLangSplitPoints.hpp"
+
+#include <algorithm>
+
+#include "Vypr/Scanner/CharacterScan.hpp"
+
+namespace Vypr
+{
+  namespace
+  {
+    /// @returns First character at or after `begin` that is not part of a
+    /// line splice.
+    const char *SkipSplices(const char *begin, const char *end)
+    {
+      while (begin < end && *begin == '\\')
+      {
+        const char *next = begin + 1;
+        if (next < end && *next == '\r')
+        {
+          next += 1;
+        }
+        if (next == end || *next != '\n')
+        {
+          break;
+        }
+        begin = next + 1;
+      }
+      return begin;
+    }
+
+    /// @brief Skips the rest of a string literal or character constant the
+    /// way the lexer reads it.
+    ///
+    /// @param begin First character after the opening quote.
+    /// @param end End of the source.
+    /// @param quote Quote that closes the literal.
+    /// @returns Character following the closing quote, or the newline or end
+    /// of source that leaves the literal unterminated.
+    const char *SkipQuoted(const char *begin, const char *end, char quote)
+    {
+      // A character constant takes its first character as is, even a
+      // newline, unless it starts an escape sequence.
+      if (quote == '\'' && begin < end && *begin != '\\')
+      {
+        begin += 1;
+      }
+
+      while (true)
+      {
+        begin = FindAny(begin, end, quote, '\\', '\n');
+        if (begin == end || *begin == '\n')
+        {
+          return begin;
+        }
+        if (*begin == quote)
+        {
+          return begin + 1;
+        }
+        begin = SkipSplices(begin, end);
+        if (begin < end && *begin == '\\')
+        {
+          begin = std::min(begin + 2, end);
+        }
+      }
+    }
+
+    /// @returns Character following the `*/` that ends a block comment,
+    /// which a line splice may split, or `end`.
+    const char *SkipBlockComment(const char *begin, const char *end)
+    {
+      while (true)
+      {
+        const char *found = FindPair(begin, end, '*', '/');
+        const char *spliced = FindPair(begin, found, '*', '\\');
+        if (spliced == found)
+        {
+          return found == end ? end : found + 2;
+        }
+        begin = SkipSplices(spliced + 1, end);
+        if (begin < end && *begin == '/')
+        {
+          return begin + 1;
+        }
+      }
+    }
+
+    /// @returns Whether the newline ends a line that a line splice joins to
+    /// the next.
+    bool IsSpliced(const char *source, const char *newline)
+    {
+      if (newline > source && newline[-1] == '\r')
+      {
+        newline -= 1;
+      }
+      return newline > source && newline[-1] == '\\';
+    }
+
+    /// @returns Newline ending the line at `begin` once splices have joined
+    /// it to the lines after, or `end`.
+    const char *FindLineEnd(const char *source, const char *begin,
+                            const char *end)
+    {
+      const char *newline = FindCharacter(begin, end, '\n');
+      while (newline != end && IsSpliced(source, newline))
+      {
+        newline = FindCharacter(newline + 1, end, '\n');
+      }
+      return newline;
+    }
+  } // namespace
+
+  std::vector<uint32_t> FindSplitPoints(std::string_view source,
+                                        size_t chunkCount)
+  {
+    std::vector<uint32_t> points;
+    const char *begin = source.data();
+    const char *end = begin + source.size();
+    auto target = [&](size_t chunk) {
+      return begin + std::max<size_t>(source.size() * chunk / chunkCount, 1);
+    };
+
+    size_t chunk = 1;
+    const char *cursor = begin;
+    while (chunk < chunkCount && cursor < end)
+    {
+      // Lines may only be split in the code before the next quote or slash.
+      const char *special = FindAny(cursor, end, '"', '\'', '/');
+      while (chunk < chunkCount)
+      {
+        // A newline just before the target starts a line on it.
+        const char *from = std::max(cursor, target(chunk) - 1);
+        const char *newline =
+            from < special ? FindLineEnd(begin, from, special) : special;
+        if (newline == special || newline + 1 == end)
+        {
+          break;
+        }
+
+        const char *point = newline + 1;
+        points.push_back(static_cast<uint32_t>(point - begin));
+        while (chunk < chunkCount && target(chunk) <= point)
+        {
+          chunk += 1;
+        }
+      }
+
+      if (special == end)
+      {
+        break;
+      }
+      const char *next = SkipSplices(special + 1, end);
+      if (*special != '/')
+      {
+        cursor = SkipQuoted(next, end, *special);
+      }
+      else if (next < end && *next == '/')
+      {
+        cursor = FindLineEnd(begin, next + 1, end);
+      }
+      else if (next < end && *next == '*')
+      {
+        cursor = SkipBlockComment(next + 1, end);
+      }
+      else
+      {
+        cursor = special + 1;
+      }
+    }
+    return points;
+  }
+} // namespace Vypr
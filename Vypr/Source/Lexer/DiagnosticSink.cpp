@@ -0,0 +1,100 @@
+#include "Vypr/Lexer/DiagnosticSink.hpp"
+
+#include <algorithm>
+
+namespace Vypr
+{
+  uint32_t DiagnosticSink::Report(DiagnosticId id, uint32_t offset)
+  {
+    uint32_t index = static_cast<uint32_t>(m_diagnostics.size());
+    m_diagnostics.push_back({.id = id, .offset = offset});
+    return index;
+  }
+
+  uint32_t DiagnosticSink::Append(const DiagnosticSink &other, uint32_t offset)
+  {
+    uint32_t index = static_cast<uint32_t>(m_diagnostics.size());
+    m_diagnostics.reserve(m_diagnostics.size() + other.m_diagnostics.size());
+    for (Diagnostic diagnostic : other.m_diagnostics)
+    {
+      diagnostic.offset += offset;
+      m_diagnostics.push_back(diagnostic);
+    }
+    return index;
+  }
+
+  void DiagnosticSink::Splice(uint32_t first, uint32_t count, uint32_t from,
+                              uint32_t shift)
+  {
+    auto kept = m_diagnostics.begin() + first + count;
+    auto moved = m_diagnostics.begin() + from;
+    for (auto diagnostic = kept; diagnostic != moved; diagnostic++)
+    {
+      diagnostic->offset += shift;
+    }
+
+    std::rotate(kept, moved, m_diagnostics.end());
+    m_diagnostics.erase(m_diagnostics.begin() + first, kept);
+  }
+
+  std::string_view DiagnosticSink::GetMessage(DiagnosticId id)
+  {
+    switch (id)
+    {
+    case DiagnosticId::MalformedUniversalCharacter:
+      return "Malformatted universal character";
+    case DiagnosticId::ExpectedBinaryDigits:
+      return "Expected binary number";
+    case DiagnosticId::InvalidBinaryDigit:
+      return "Invalid digit in binary number";
+    case DiagnosticId::ExpectedHexadecimalDigits:
+      return "Expected hexadecimal number";
+    case DiagnosticId::ExpectedDecimalDigits:
+      return "Expected decimal number";
+    case DiagnosticId::ExpectedHexadecimalExponent:
+      return "Expected exponent in hexadecimal floating point constant";
+    case DiagnosticId::InvalidIntegerSuffix:
+      return "Invalid suffix for integer constant";
+    case DiagnosticId::InvalidFloatSuffix:
+      return "Invalid suffix for floating point constant";
+    case DiagnosticId::EmptyCharacterConstant:
+      return "Empty character constant";
+    case DiagnosticId::UnterminatedCharacterConstant:
+      return "Expected ' to end character constant";
+    case DiagnosticId::ExpectedHexadecimalEscape:
+      return "Expected hexadecimal escape sequence";
+    case DiagnosticId::UnknownEscapeSequence:
+      return "Unknown escape sequence";
+    case DiagnosticId::UnterminatedStringLiteral:
+      return "Expected \" at the end of string literal";
+    case DiagnosticId::InvalidOctalDigit:
+      return "Invalid digit in octal constant";
+    case DiagnosticId::ConstantTooLarge:
+      return "Constant is too large";
+    case DiagnosticId::IncludeNotFound:
+      return "Included file not found";
+    case DiagnosticId::IncludeNestingTooDeep:
+      return "Includes nested too deeply";
+    case DiagnosticId::MalformedDirective:
+      return "Malformed preprocessing directive";
+    case DiagnosticId::UnknownDirective:
+      return "Unknown preprocessing directive";
+    case DiagnosticId::UnterminatedConditional:
+      return "Expected #endif to end conditional";
+    case DiagnosticId::UnmatchedConditional:
+      return "Conditional directive without matching #if";
+    case DiagnosticId::InvalidCondition:
+      return "Invalid preprocessing condition";
+    case DiagnosticId::ErrorDirective:
+      return "#error directive";
+    case DiagnosticId::UnterminatedMacroCall:
+      return "Expected ) to end macro arguments";
+    case DiagnosticId::MacroArgumentCount:
+      return "Wrong number of macro arguments";
+    case DiagnosticId::InvalidTokenPaste:
+      return "Pasting does not form a single token";
+    }
+
+    return "Unknown error";
+  }
+} // namespace Vypr
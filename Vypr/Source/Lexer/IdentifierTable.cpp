@@ -0,0 +1,58 @@
+#include "Vypr/Lexer/IdentifierTable.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Vypr
+{
+  namespace
+  {
+    /// @brief Size of the arena blocks names are copied into. Longer names get
+    /// a block of their own.
+    constexpr size_t BlockSize = 16 * 1024;
+  } // namespace
+
+  IdentifierTable::IdentifierTable()
+      : m_blockCursor(nullptr), m_blockRemaining(0)
+  {
+  }
+
+  Identifier IdentifierTable::Intern(std::string_view name)
+  {
+    auto entry = m_identifiers.find(name);
+    if (entry != m_identifiers.end())
+    {
+      return entry->second;
+    }
+
+    // The key must refer to the arena copy rather than the caller's buffer.
+    std::string_view stored = Store(name);
+    Identifier identifier = static_cast<Identifier>(m_names.size());
+    m_names.push_back(stored);
+    m_identifiers.emplace(stored, identifier);
+    return identifier;
+  }
+
+  Identifier IdentifierTable::Find(std::string_view name) const
+  {
+    auto entry = m_identifiers.find(name);
+    return entry == m_identifiers.end() ? Identifier::None : entry->second;
+  }
+
+  std::string_view IdentifierTable::Store(std::string_view name)
+  {
+    if (m_blockCursor == nullptr || name.size() > m_blockRemaining)
+    {
+      size_t size = std::max(BlockSize, name.size());
+      m_blocks.push_back(std::make_unique<char[]>(size));
+      m_blockCursor = m_blocks.back().get();
+      m_blockRemaining = size;
+    }
+
+    char *destination = m_blockCursor;
+    std::memcpy(destination, name.data(), name.size());
+    m_blockCursor += name.size();
+    m_blockRemaining -= name.size();
+    return {destination, name.size()};
+  }
+} // namespace Vypr
@@ -0,0 +1,52 @@
+#include "Vypr/Lexer/LiteralTable.hpp"
+
+namespace Vypr
+{
+  uint32_t LiteralTable::Add(std::string_view value)
+  {
+    Extend(value);
+    return Finish();
+  }
+
+  uint32_t LiteralTable::Finish()
+  {
+    uint32_t index = static_cast<uint32_t>(m_ends.size());
+    m_ends.push_back(static_cast<uint32_t>(m_characters.size()));
+    return index;
+  }
+
+  void LiteralTable::Discard()
+  {
+    m_characters.resize(m_ends.empty() ? 0 : m_ends.back());
+  }
+
+  uint32_t LiteralTable::AddNumber(const NumericLiteral &number)
+  {
+    // Both members of the value's union are 64 bits at its start.
+    uint64_t value;
+    std::memcpy(&value, &number, sizeof(value));
+
+    uint32_t index = static_cast<uint32_t>(m_numbers.size());
+    m_numbers.push_back(value);
+    m_suffixes.push_back(number.suffix);
+    return index;
+  }
+
+  uint32_t LiteralTable::Append(const LiteralTable &other)
+  {
+    uint32_t index = static_cast<uint32_t>(m_ends.size());
+    uint32_t base = static_cast<uint32_t>(m_characters.size());
+    m_characters.insert(m_characters.end(), other.m_characters.begin(),
+                        other.m_characters.end());
+    m_ends.reserve(m_ends.size() + other.m_ends.size());
+    for (uint32_t otherEnd : other.m_ends)
+    {
+      m_ends.push_back(base + otherEnd);
+    }
+    m_numbers.insert(m_numbers.end(), other.m_numbers.begin(),
+                     other.m_numbers.end());
+    m_suffixes.insert(m_suffixes.end(), other.m_suffixes.begin(),
+                      other.m_suffixes.end());
+    return index;
+  }
+} // namespace Vypr
@@ -0,0 +1,198 @@
+#include "Vypr/Lexer/NumericLiteral.hpp"
+
+#include <bit>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+
+namespace Vypr
+{
+  namespace
+  {
+    /// @brief Number of digits combined at a time.
+    constexpr size_t BlockSize = 8;
+
+    /// @brief Loads eight digits as one word, the first in its lowest byte
+    /// on little-endian targets.
+    uint64_t LoadBlock(const char *digits)
+    {
+      uint64_t block;
+      std::memcpy(&block, digits, sizeof(block));
+      return block;
+    }
+
+    /// @returns Value of a block of eight decimal digits.
+    uint64_t CombineDecimal(uint64_t block)
+    {
+      // Pairs of digits are merged in every other byte, then the four pairs
+      // are scaled and summed in two multiplications.
+      block -= 0x3030303030303030;
+      block = block * 10 + (block >> 8);
+      return (((block & 0x000000FF000000FF) * 0x000F424000000064) +
+              (((block >> 16) & 0x000000FF000000FF) * 0x0000271000000001)) >>
+             32;
+    }
+
+    /// @returns Value of a block of eight digits of a radix with `Bits` bits
+    /// per digit.
+    template <unsigned Bits>
+    uint64_t CombinePowerOfTwo(uint64_t block)
+    {
+      if constexpr (Bits == 4)
+      {
+        block = (block & 0x0F0F0F0F0F0F0F0F) +
+                ((block >> 6) & 0x0101010101010101) * 9;
+      }
+      else
+      {
+        block -= 0x3030303030303030;
+      }
+
+      // Adjacent digits, then pairs, then halves are packed together.
+      block = ((block & 0x00FF00FF00FF00FF) << Bits) |
+              ((block >> 8) & 0x00FF00FF00FF00FF);
+      block = ((block & 0x0000FFFF0000FFFF) << (2 * Bits)) |
+              ((block >> 16) & 0x0000FFFF0000FFFF);
+      return ((block & 0xFFFFFFFF) << (4 * Bits)) | (block >> 32);
+    }
+
+    /// @returns Value of a digit of `Radix`.
+    template <unsigned Radix>
+    uint64_t GetDigitValue(char digit)
+    {
+      if constexpr (Radix == 16)
+      {
+        return static_cast<uint64_t>((digit & 0xF) + ((digit >> 6) & 1) * 9);
+      }
+      else
+      {
+        return static_cast<uint64_t>(digit - '0');
+      }
+    }
+
+    /// @brief Appends digits to a value that is known to stay within 64
+    /// bits.
+    template <unsigned Radix>
+    uint64_t Accumulate(uint64_t value, std::string_view digits)
+    {
+      const char *cursor = digits.data();
+      const char *end = cursor + digits.size();
+
+      if constexpr (std::endian::native == std::endian::little)
+      {
+        for (; end - cursor >= static_cast<std::ptrdiff_t>(BlockSize);
+             cursor += BlockSize)
+        {
+          uint64_t block = LoadBlock(cursor);
+          if constexpr (Radix == 10)
+          {
+            value = value * 100000000 + CombineDecimal(block);
+          }
+          else
+          {
+            constexpr unsigned Bits = std::countr_zero(Radix);
+            value = (value << (BlockSize * Bits)) |
+                    CombinePowerOfTwo<Bits>(block);
+          }
+        }
+      }
+
+      for (; cursor < end; cursor++)
+      {
+        value = value * Radix + GetDigitValue<Radix>(*cursor);
+      }
+      return value;
+    }
+
+    /// @brief Converts digits without leading zeros.
+    template <unsigned Radix>
+    std::optional<uint64_t> Convert(std::string_view digits)
+    {
+      if constexpr (Radix == 10)
+      {
+        // Any 19 decimal digits fit in 64 bits; only a 20th can overflow.
+        constexpr size_t SafeDigits = 19;
+        if (digits.size() <= SafeDigits)
+        {
+          return Accumulate<10>(0, digits);
+        }
+        if (digits.size() > SafeDigits + 1)
+        {
+          return std::nullopt;
+        }
+
+        uint64_t value = Accumulate<10>(0, digits.substr(0, SafeDigits));
+        uint64_t last = GetDigitValue<10>(digits.back());
+        if (value > (UINT64_MAX - last) / 10)
+        {
+          return std::nullopt;
+        }
+        return value * 10 + last;
+      }
+      else
+      {
+        // Only the leading digit can be partly outside of 64 bits.
+        constexpr unsigned Bits = std::countr_zero(Radix);
+        size_t width = digits.size() * Bits;
+        if (width > 64 &&
+            (width - 64 >= Bits ||
+             GetDigitValue<Radix>(digits[0]) >> (Bits - (width - 64)) != 0))
+        {
+          return std::nullopt;
+        }
+        return Accumulate<Radix>(0, digits);
+      }
+    }
+  } // namespace
+
+  std::optional<uint64_t> ConvertDigits(std::string_view digits,
+                                        unsigned radix)
+  {
+    // Leading zeros do not count towards the width of the value.
+    size_t significant = digits.find_first_not_of('0');
+    if (significant == std::string_view::npos)
+    {
+      return 0;
+    }
+    digits.remove_prefix(significant);
+
+    switch (radix)
+    {
+    case 2:
+      return Convert<2>(digits);
+    case 8:
+      return Convert<8>(digits);
+    case 16:
+      return Convert<16>(digits);
+    default:
+      return Convert<10>(digits);
+    }
+  }
+
+  std::optional<double> ConvertReal(std::string_view text, bool hexadecimal,
+                                    bool isFloat)
+  {
+    const char *end = text.data() + text.size();
+    std::chars_format format =
+        hexadecimal ? std::chars_format::hex : std::chars_format::general;
+
+    if (isFloat)
+    {
+      float value;
+      auto [parsed, error] = std::from_chars(text.data(), end, value, format);
+      if (error != std::errc() || parsed != end)
+      {
+        return std::nullopt;
+      }
+      return value;
+    }
+
+    double value;
+    auto [parsed, error] = std::from_chars(text.data(), end, value, format);
+    if (error != std::errc() || parsed != end)
+    {
+      return std::nullopt;
+    }
+    return value;
+  }
+} // namespace Vypr
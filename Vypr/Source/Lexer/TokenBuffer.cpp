@@ -0,0 +1,136 @@
+#include "Vypr/Lexer/TokenBuffer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace Vypr
+{
+  namespace
+  {
+    /// @brief Resizes an array of trivially copyable elements, freeing it
+    /// when `count` is zero.
+    template <typename T>
+    void Resize(T *&array, size_t count)
+    {
+      if (count == 0)
+      {
+        std::free(array);
+        array = nullptr;
+        return;
+      }
+
+      void *resized = std::realloc(array, count * sizeof(T));
+      if (resized == nullptr)
+      {
+        throw std::bad_alloc();
+      }
+      array = static_cast<T *>(resized);
+    }
+
+    /// @brief Replaces `count` elements at `first` with `replacementCount`
+    /// elements of `replacement`, moving the `tail` elements after them.
+    template <typename T>
+    void Splice(T *array, size_t first, size_t count, const T *replacement,
+                size_t replacementCount, size_t tail)
+    {
+      if (tail > 0)
+      {
+        std::memmove(array + first + replacementCount, array + first + count,
+                     tail * sizeof(T));
+      }
+      if (replacementCount > 0)
+      {
+        std::memcpy(array + first, replacement, replacementCount * sizeof(T));
+      }
+    }
+  } // namespace
+
+  TokenBuffer::TokenBuffer()
+      : m_types(nullptr), m_flags(nullptr), m_offsets(nullptr),
+        m_lengths(nullptr), m_values(nullptr), m_size(0), m_capacity(0)
+  {
+  }
+
+  TokenBuffer::~TokenBuffer()
+  {
+    std::free(m_types);
+    std::free(m_flags);
+    std::free(m_offsets);
+    std::free(m_lengths);
+    std::free(m_values);
+  }
+
+  void TokenBuffer::Replace(size_t first, size_t count,
+                            const TokenBuffer &tokens)
+  {
+    size_t size = m_size - count + tokens.m_size;
+    if (size > m_capacity)
+    {
+      Reallocate(std::max(size, m_capacity * 2));
+    }
+
+    size_t tail = m_size - first - count;
+    Splice(m_types, first, count, tokens.m_types, tokens.m_size, tail);
+    Splice(m_flags, first, count, tokens.m_flags, tokens.m_size, tail);
+    Splice(m_offsets, first, count, tokens.m_offsets, tokens.m_size, tail);
+    Splice(m_lengths, first, count, tokens.m_lengths, tokens.m_size, tail);
+    Splice(m_values, first, count, tokens.m_values, tokens.m_size, tail);
+    m_size = size;
+  }
+
+  void TokenBuffer::ShiftOffsets(size_t first, uint32_t shift)
+  {
+    for (size_t index = first; index < m_size; index++)
+    {
+      m_offsets[index] += shift;
+    }
+  }
+
+  void TokenBuffer::ShiftValues(size_t first, CLangTokenType type,
+                                uint32_t shift)
+  {
+    for (size_t index = first; index < m_size; index++)
+    {
+      if (m_types[index] == type)
+      {
+        m_values[index] += shift;
+      }
+    }
+  }
+
+  void TokenBuffer::Clear()
+  {
+    m_size = 0;
+  }
+
+  void TokenBuffer::Reserve(size_t count)
+  {
+    if (count > m_capacity)
+    {
+      Reallocate(count);
+    }
+  }
+
+  void TokenBuffer::ShrinkToFit()
+  {
+    if (m_size < m_capacity)
+    {
+      Reallocate(m_size);
+    }
+  }
+
+  void TokenBuffer::Reallocate(size_t capacity)
+  {
+    // Every array holds at least the smaller capacity if one of them fails
+    // to resize.
+    m_capacity = std::min(m_capacity, capacity);
+    Resize(m_types, capacity);
+    Resize(m_flags, capacity);
+    Resize(m_offsets, capacity);
+    Resize(m_lengths, capacity);
+    Resize(m_values, capacity);
+    m_capacity = capacity;
+  }
+} // namespace Vypr
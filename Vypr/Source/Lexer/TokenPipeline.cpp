@@ -0,0 +1,133 @@
+#include "Vypr/Lexer/TokenPipeline.hpp"
+
+#include <utility>
+
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+namespace Vypr
+{
+  TokenPipeline::TokenPipeline(std::string_view source)
+      : m_lexer(std::make_unique<CLangLexer>(
+            std::make_unique<BufferScanner>(source))),
+        m_ring(BatchCount), m_batch(std::make_unique<TokenBatch>()),
+        m_next(0), m_firstNumber(0), m_firstLiteral(0), m_firstDiagnostic(0),
+        m_finished(false),
+        m_thread([this](std::stop_token stop) { Produce(std::move(stop)); })
+  {
+  }
+
+  TokenPipeline::~TokenPipeline()
+  {
+    // The lexing thread may be waiting for room in the ring, so batches are
+    // drained until it has pushed its last one.
+    m_thread.request_stop();
+    while (!m_finished)
+    {
+      m_finished = m_ring.Pop()->last;
+    }
+  }
+
+  CLangToken TokenPipeline::GetToken(LiteralTable &literals,
+                                     DiagnosticSink &diagnostics,
+                                     IdentifierTable &identifiers)
+  {
+    while (m_next == m_batch->tokens.GetSize())
+    {
+      if (m_finished)
+      {
+        return {};
+      }
+      TakeBatch(literals, diagnostics, identifiers);
+    }
+
+    CLangToken token = m_batch->tokens[m_next++];
+    switch (token.type)
+    {
+    case CLangTokenType::Identifier:
+      token.value = m_identifiers[token.value];
+      break;
+    case CLangTokenType::Error:
+      token.value += m_firstDiagnostic;
+      break;
+    case CLangTokenType::IntegerConstant:
+    case CLangTokenType::FloatConstant:
+      token.value += m_firstNumber;
+      break;
+    default:
+      if (token.value != CLangToken::NoValue)
+      {
+        token.value += m_firstLiteral;
+      }
+      break;
+    }
+    return token;
+  }
+
+  void TokenPipeline::Produce(std::stop_token stop)
+  {
+    CLangLexer &lexer = *m_lexer;
+    size_t namesSent = 0;
+    bool last = false;
+    while (!last)
+    {
+      auto batch = std::make_unique<TokenBatch>();
+      try
+      {
+        batch->tokens.Reserve(BatchSize);
+        while (batch->tokens.GetSize() < BatchSize)
+        {
+          CLangToken token = lexer.LexToken();
+          if (token.type == CLangTokenType::NoToken)
+          {
+            last = true;
+            break;
+          }
+          batch->tokens.Append(token);
+        }
+
+        // The lexer starts every batch with empty tables so that values are
+        // indexed from zero in each.
+        std::swap(batch->literals, lexer.m_literals);
+        std::swap(batch->diagnostics, lexer.m_diagnostics);
+        for (; namesSent < lexer.m_identifiers->GetCount(); namesSent++)
+        {
+          batch->names.push_back(lexer.m_identifiers->GetName(
+              static_cast<Identifier>(namesSent)));
+        }
+      }
+      catch (...)
+      {
+        batch->error = std::current_exception();
+        last = true;
+      }
+
+      batch->last = last || stop.stop_requested();
+      last = batch->last;
+      m_ring.Push(std::move(batch));
+    }
+  }
+
+  void TokenPipeline::TakeBatch(LiteralTable &literals,
+                                DiagnosticSink &diagnostics,
+                                IdentifierTable &identifiers)
+  {
+    m_batch = m_ring.Pop();
+    m_next = 0;
+    m_finished = m_batch->last;
+    if (m_batch->error)
+    {
+      m_batch->tokens.Clear();
+      std::rethrow_exception(m_batch->error);
+    }
+
+    m_firstNumber = static_cast<uint32_t>(literals.GetNumberCount());
+    m_firstLiteral = literals.Append(m_batch->literals);
+    m_firstDiagnostic = diagnostics.Append(m_batch->diagnostics, 0);
+    for (std::string_view name : m_batch->names)
+    {
+      m_identifiers.push_back(
+          static_cast<uint32_t>(identifiers.Intern(name)));
+    }
+  }
+} // namespace Vypr
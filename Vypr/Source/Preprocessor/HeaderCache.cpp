@@ -0,0 +1,141 @@
+#include "Vypr/Preprocessor/HeaderCache.hpp"
+
+#include <cerrno>
+#include <exception>
+#include <system_error>
+#include <utility>
+
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Scanner/MappedFileScanner.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace Vypr
+{
+  namespace
+  {
+    /// @throws `std::system_error` Thrown when the file can't be opened.
+    FileIdentity GetIdentity(const std::filesystem::path &path)
+    {
+#ifdef _WIN32
+      HANDLE file = CreateFileW(
+          path.c_str(), FILE_READ_ATTRIBUTES,
+          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+          OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      BY_HANDLE_FILE_INFORMATION information;
+      bool found = file != INVALID_HANDLE_VALUE &&
+                   GetFileInformationByHandle(file, &information);
+      int error = static_cast<int>(GetLastError());
+      if (file != INVALID_HANDLE_VALUE)
+      {
+        CloseHandle(file);
+      }
+      if (!found)
+      {
+        throw std::system_error(error, std::system_category(),
+                                "Unable to map " + path.string());
+      }
+
+      auto join = [](DWORD high, DWORD low) {
+        return (static_cast<uint64_t>(high) << 32) | low;
+      };
+      return {.device = information.dwVolumeSerialNumber,
+              .inode = join(information.nFileIndexHigh,
+                            information.nFileIndexLow),
+              .modified = static_cast<int64_t>(
+                  join(information.ftLastWriteTime.dwHighDateTime,
+                       information.ftLastWriteTime.dwLowDateTime)),
+              .size = join(information.nFileSizeHigh,
+                           information.nFileSizeLow)};
+#else
+      struct stat status;
+      if (stat(path.c_str(), &status) != 0)
+      {
+        throw std::system_error(errno, std::generic_category(),
+                                "Unable to map " + path.string());
+      }
+
+#ifdef __APPLE__
+      const struct timespec &modified = status.st_mtimespec;
+#else
+      const struct timespec &modified = status.st_mtim;
+#endif
+      return {.device = static_cast<uint64_t>(status.st_dev),
+              .inode = static_cast<uint64_t>(status.st_ino),
+              .modified = static_cast<int64_t>(modified.tv_sec) *
+                              1'000'000'000 +
+                          modified.tv_nsec,
+              .size = static_cast<uint64_t>(status.st_size)};
+#endif
+    }
+  } // namespace
+
+  size_t HeaderCache::FileIdentityHash::operator()(
+      const FileIdentity &identity) const
+  {
+    // Inodes are unique on a device, so the rest only tells versions apart.
+    uint64_t hash = identity.inode * 0x9E3779B97F4A7C15ULL;
+    hash ^= identity.device + static_cast<uint64_t>(identity.modified) +
+            identity.size;
+    return static_cast<size_t>(hash ^ (hash >> 32));
+  }
+
+  std::shared_ptr<const CLangLexer> HeaderCache::Get(
+      const std::filesystem::path &path)
+  {
+    FileIdentity identity = GetIdentity(path);
+
+    // The file is lexed outside the lock, so that lookups of other files
+    // don't wait for it.
+    std::promise<std::shared_ptr<const CLangLexer>> promise;
+    std::shared_future<std::shared_ptr<const CLangLexer>> cached;
+    {
+      std::lock_guard lock(m_mutex);
+      auto [entry, inserted] =
+          m_files.try_emplace(identity, promise.get_future().share());
+      if (inserted)
+      {
+        m_statistics.misses += 1;
+      }
+      else
+      {
+        m_statistics.hits += 1;
+        m_statistics.bytesSaved += identity.size;
+        cached = entry->second;
+      }
+    }
+    if (cached.valid())
+    {
+      return cached.get();
+    }
+
+    try
+    {
+      auto file = std::make_shared<CLangLexer>(
+          std::make_unique<MappedFileScanner>(path));
+      file->Tokenize();
+      promise.set_value(file);
+      return file;
+    }
+    catch (...)
+    {
+      // Threads already waiting see the error. Later lookups try again.
+      promise.set_exception(std::current_exception());
+      std::lock_guard lock(m_mutex);
+      m_files.erase(identity);
+      throw;
+    }
+  }
+
+  HeaderCacheStatistics HeaderCache::GetStatistics() const
+  {
+    std::lock_guard lock(m_mutex);
+    return m_statistics;
+  }
+} // namespace Vypr
@@ -0,0 +1,47 @@
+#include "Vypr/Preprocessor/MacroTable.hpp"
+
+namespace Vypr
+{
+  void MacroTable::Define(Identifier name,
+                          std::span<const Identifier> parameters,
+                          std::span<const CLangToken> replacement,
+                          uint8_t flags)
+  {
+    uint32_t index = static_cast<uint32_t>(name);
+    if (index >= m_definitions.size())
+    {
+      m_definitions.resize(index + 1, NoMacro);
+      m_changed.resize(index + 1, 0);
+    }
+    if (m_definitions[index] == NoMacro)
+    {
+      m_count += 1;
+    }
+    m_generation += 1;
+    m_changed[index] = m_generation;
+
+    m_definitions[index] = static_cast<uint32_t>(m_macros.size());
+    m_macros.push_back(
+        {.name = name,
+         .firstToken = static_cast<uint32_t>(m_tokens.size()),
+         .tokenCount = static_cast<uint32_t>(replacement.size()),
+         .firstParameter = static_cast<uint32_t>(m_parameters.size()),
+         .parameterCount = static_cast<uint32_t>(parameters.size()),
+         .flags = flags});
+    m_tokens.insert(m_tokens.end(), replacement.begin(), replacement.end());
+    m_parameters.insert(m_parameters.end(), parameters.begin(),
+                        parameters.end());
+  }
+
+  void MacroTable::Undefine(Identifier name)
+  {
+    uint32_t index = static_cast<uint32_t>(name);
+    if (index < m_definitions.size() && m_definitions[index] != NoMacro)
+    {
+      m_definitions[index] = NoMacro;
+      m_count -= 1;
+      m_generation += 1;
+      m_changed[index] = m_generation;
+    }
+  }
+} // namespace Vypr
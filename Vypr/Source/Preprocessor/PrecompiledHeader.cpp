@@ -0,0 +1,649 @@
+#include "Vypr/Preprocessor/PrecompiledHeader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include "Vypr/AST/Type/ArrayType.hpp"
+#include "Vypr/AST/Type/IntegralType.hpp"
+#include "Vypr/AST/Type/PointerType.hpp"
+#include "Vypr/AST/Type/RealType.hpp"
+#include "Vypr/Scanner/MappedFileScanner.hpp"
+
+namespace Vypr
+{
+  namespace
+  {
+    constexpr std::array<char, 8> Magic = {'V', 'Y', 'P', 'R',
+                                           'P', 'C', 'H', '\0'};
+
+    /// @brief Last enumerator of `CLangTokenType`. Types above it come from
+    /// a corrupt file or one written for another version of the enum.
+    constexpr CLangTokenType LastTokenType = CLangTokenType::ThreadLocal;
+
+    /// @brief Arrays of the file, in the order they are laid out.
+    enum Section : uint32_t
+    {
+      /// @brief Characters of every identifier name, back to back.
+      Names,
+
+      /// @brief End of each name in `Names`, as `uint32_t`.
+      NameEnds,
+
+      /// @brief Characters of the string values used by macros.
+      Characters,
+
+      /// @brief End of each string value in `Characters`, as `uint32_t`.
+      CharacterEnds,
+
+      /// @brief Numeric values used by macros, as `PackedNumber`.
+      Numbers,
+
+      /// @brief `PackedMacro` of each macro.
+      Macros,
+
+      /// @brief Replacement tokens, as `CLangToken`, with values indexing
+      /// the sections above.
+      MacroTokens,
+
+      /// @brief Parameter names, as `uint32_t` indices of names.
+      Parameters,
+
+      /// @brief Types of the symbols, as `PackedType`.
+      Types,
+
+      /// @brief `PackedSymbol` of each symbol.
+      Symbols,
+
+      SectionCount
+    };
+
+    struct SectionEntry
+    {
+      /// @brief Offset of the array in the file and its size in bytes.
+      uint64_t offset;
+      uint64_t size;
+    };
+
+    struct FileHeader
+    {
+      std::array<char, 8> magic;
+      uint32_t version;
+      uint32_t sectionCount;
+      std::array<SectionEntry, SectionCount> sections;
+    };
+
+    struct PackedNumber
+    {
+      uint64_t bits;
+      uint8_t suffix;
+      std::array<uint8_t, 7> padding;
+    };
+
+    struct PackedMacro
+    {
+      uint32_t name;
+      uint32_t firstToken;
+      uint32_t tokenCount;
+      uint32_t firstParameter;
+      uint32_t parameterCount;
+      uint32_t flags;
+    };
+
+    /// @brief Type of a symbol, or of what a pointer or array type of it
+    /// refers to. The types of a symbol are stored innermost first, so each
+    /// pointer or array type wraps the type before it.
+    struct PackedType
+    {
+      static constexpr uint8_t Const = 1 << 0;
+      static constexpr uint8_t LValue = 1 << 1;
+      static constexpr uint8_t Unsigned = 1 << 2;
+
+      /// @brief `StorageMetaType` of the type.
+      uint8_t meta;
+
+      /// @brief `Integral` or `Real` of integral and real types.
+      uint8_t kind;
+
+      /// @brief Combination of the flags above.
+      uint8_t flags;
+      std::array<uint8_t, 5> padding;
+
+      /// @brief Length of array types.
+      uint64_t size;
+    };
+
+    struct PackedSymbol
+    {
+      uint32_t name;
+
+      /// @brief Index of the innermost type of the symbol and the number of
+      /// types it is made of.
+      uint32_t firstType;
+      uint32_t typeCount;
+      uint32_t padding;
+    };
+
+    /// @brief Sections are aligned so that their records could be read in
+    /// place.
+    constexpr size_t SectionAlignment = 8;
+
+    template <typename T> T ReadRecord(std::string_view image, size_t offset)
+    {
+      T record;
+      std::memcpy(&record, image.data() + offset, sizeof(T));
+      return record;
+    }
+
+    /// @brief Records of one section of a checked file.
+    template <typename T> class SectionReader
+    {
+    public:
+      SectionReader(std::string_view image, const FileHeader &header,
+                    Section section)
+          : m_image(image),
+            m_offset(static_cast<size_t>(header.sections[section].offset)),
+            m_count(static_cast<size_t>(header.sections[section].size /
+                                        sizeof(T)))
+      {
+      }
+
+      T operator[](size_t index) const
+      {
+        return ReadRecord<T>(m_image, m_offset + index * sizeof(T));
+      }
+
+      size_t GetCount() const
+      {
+        return m_count;
+      }
+
+    private:
+      std::string_view m_image;
+      size_t m_offset;
+      size_t m_count;
+    };
+
+    /// @brief Gets string `index` of a section of characters and one of
+    /// their ends.
+    std::string_view GetString(std::string_view image,
+                               const FileHeader &header, Section characters,
+                               Section ends, size_t index)
+    {
+      SectionReader<uint32_t> endReader(image, header, ends);
+      uint32_t start = index == 0 ? 0 : endReader[index - 1];
+      return image.substr(header.sections[characters].offset + start,
+                          endReader[index] - start);
+    }
+
+    /// @brief Appends `type` and the types it refers to, innermost first.
+    void PackType(const StorageType &type, std::vector<PackedType> &types)
+    {
+      PackedType packed = {
+          .meta = static_cast<uint8_t>(type.GetType()),
+          .kind = 0,
+          .flags = static_cast<uint8_t>((type.isConst ? PackedType::Const : 0) |
+                                        (type.isLValue ? PackedType::LValue
+                                                       : 0)),
+          .padding = {},
+          .size = 0};
+      switch (type.GetType())
+      {
+      case StorageMetaType::Integral: {
+        const auto &integral = static_cast<const IntegralType &>(type);
+        packed.kind = static_cast<uint8_t>(integral.integral);
+        packed.flags |= integral.isUnsigned ? PackedType::Unsigned : 0;
+        break;
+      }
+      case StorageMetaType::Real:
+        packed.kind =
+            static_cast<uint8_t>(static_cast<const RealType &>(type).real);
+        break;
+      case StorageMetaType::Pointer:
+        PackType(static_cast<const PointerType &>(type).GetStorage(), types);
+        break;
+      case StorageMetaType::Array: {
+        const auto &array = static_cast<const ArrayType &>(type);
+        PackType(array.GetStorage(), types);
+        packed.size = array.GetSize();
+        break;
+      }
+      default:
+        break;
+      }
+      types.push_back(packed);
+    }
+
+    /// @brief Checks that the records of a file only refer to what is in
+    /// it.
+    bool IsValid(std::string_view image)
+    {
+      if (image.size() < sizeof(FileHeader))
+      {
+        return false;
+      }
+      FileHeader header = ReadRecord<FileHeader>(image, 0);
+      if (header.magic != Magic ||
+          header.version != PrecompiledHeader::Version ||
+          header.sectionCount != SectionCount)
+      {
+        return false;
+      }
+
+      constexpr std::array<size_t, SectionCount> RecordSizes = {
+          1,
+          sizeof(uint32_t),
+          1,
+          sizeof(uint32_t),
+          sizeof(PackedNumber),
+          sizeof(PackedMacro),
+          sizeof(CLangToken),
+          sizeof(uint32_t),
+          sizeof(PackedType),
+          sizeof(PackedSymbol)};
+      for (uint32_t i = 0; i < SectionCount; i++)
+      {
+        SectionEntry entry = header.sections[i];
+        if (entry.offset > image.size() ||
+            entry.size > image.size() - entry.offset ||
+            entry.size % RecordSizes[i] != 0)
+        {
+          return false;
+        }
+      }
+
+      auto endsAreOrdered = [&](Section characters, Section ends) {
+        SectionReader<uint32_t> reader(image, header, ends);
+        uint32_t previous = 0;
+        for (size_t i = 0; i < reader.GetCount(); i++)
+        {
+          if (reader[i] < previous ||
+              reader[i] > header.sections[characters].size)
+          {
+            return false;
+          }
+          previous = reader[i];
+        }
+        return true;
+      };
+      if (!endsAreOrdered(Names, NameEnds) ||
+          !endsAreOrdered(Characters, CharacterEnds))
+      {
+        return false;
+      }
+
+      size_t nameCount = SectionReader<uint32_t>(image, header, NameEnds)
+                             .GetCount();
+      size_t stringCount =
+          SectionReader<uint32_t>(image, header, CharacterEnds).GetCount();
+      size_t numberCount =
+          SectionReader<PackedNumber>(image, header, Numbers).GetCount();
+
+      SectionReader<CLangToken> tokens(image, header, MacroTokens);
+      for (size_t i = 0; i < tokens.GetCount(); i++)
+      {
+        CLangToken token = tokens[i];
+        switch (token.type)
+        {
+        case CLangTokenType::NoToken:
+        case CLangTokenType::Error:
+          return false;
+        case CLangTokenType::Identifier:
+          if (token.value >= nameCount)
+          {
+            return false;
+          }
+          break;
+        case CLangTokenType::IntegerConstant:
+        case CLangTokenType::FloatConstant:
+          if (token.value >= numberCount)
+          {
+            return false;
+          }
+          break;
+        case CLangTokenType::CharacterConstant:
+        case CLangTokenType::StringLiteral:
+          if (token.value != CLangToken::NoValue && token.value >= stringCount)
+          {
+            return false;
+          }
+          break;
+        default:
+          if (token.type > LastTokenType)
+          {
+            return false;
+          }
+          break;
+        }
+      }
+
+      SectionReader<uint32_t> parameters(image, header, Parameters);
+      for (size_t i = 0; i < parameters.GetCount(); i++)
+      {
+        if (parameters[i] >= nameCount)
+        {
+          return false;
+        }
+      }
+
+      SectionReader<PackedMacro> macros(image, header, Macros);
+      for (size_t i = 0; i < macros.GetCount(); i++)
+      {
+        PackedMacro macro = macros[i];
+        if (macro.name >= nameCount ||
+            macro.firstToken > tokens.GetCount() ||
+            macro.tokenCount > tokens.GetCount() - macro.firstToken ||
+            macro.firstParameter > parameters.GetCount() ||
+            macro.parameterCount >
+                parameters.GetCount() - macro.firstParameter ||
+            macro.flags > (Macro::FunctionLike | Macro::Variadic))
+        {
+          return false;
+        }
+      }
+
+      // The innermost type of a symbol must stand on its own, and every
+      // other one must wrap it.
+      SectionReader<PackedType> types(image, header, Types);
+      SectionReader<PackedSymbol> symbols(image, header, Symbols);
+      for (size_t i = 0; i < symbols.GetCount(); i++)
+      {
+        PackedSymbol symbol = symbols[i];
+        if (symbol.name >= nameCount || symbol.typeCount == 0 ||
+            symbol.firstType > types.GetCount() ||
+            symbol.typeCount > types.GetCount() - symbol.firstType)
+        {
+          return false;
+        }
+        for (uint32_t j = 0; j < symbol.typeCount; j++)
+        {
+          PackedType type = types[symbol.firstType + j];
+          bool wraps =
+              type.meta == static_cast<uint8_t>(StorageMetaType::Pointer) ||
+              type.meta == static_cast<uint8_t>(StorageMetaType::Array);
+          bool valid =
+              type.meta == static_cast<uint8_t>(StorageMetaType::Void) ||
+              (type.meta == static_cast<uint8_t>(StorageMetaType::Integral) &&
+               type.kind <= static_cast<uint8_t>(Integral::Long)) ||
+              (type.meta == static_cast<uint8_t>(StorageMetaType::Real) &&
+               type.kind <= static_cast<uint8_t>(Real::Double));
+          if (j == 0 ? !valid : !wraps)
+          {
+            return false;
+          }
+        }
+      }
+      return true;
+    }
+  } // namespace
+
+  void PrecompiledHeader::Write(const std::filesystem::path &path,
+                                const IdentifierTable &identifiers,
+                                const MacroTable &macros,
+                                const LiteralTable &literals,
+                                const TypeTable &types)
+  {
+    std::string names;
+    std::vector<uint32_t> nameEnds;
+    for (uint32_t i = 0; i < identifiers.GetCount(); i++)
+    {
+      names.append(identifiers.GetName(static_cast<Identifier>(i)));
+      nameEnds.push_back(static_cast<uint32_t>(names.size()));
+    }
+
+    // Only the values used by the macros are written, renumbered in the
+    // order they are found.
+    std::string characters;
+    std::vector<uint32_t> characterEnds;
+    std::vector<PackedNumber> numbers;
+    std::vector<PackedMacro> packedMacros;
+    std::vector<CLangToken> tokens;
+    std::vector<uint32_t> parameters;
+    for (uint32_t i = 0; i < identifiers.GetCount(); i++)
+    {
+      const Macro *macro = macros.Find(static_cast<Identifier>(i));
+      if (macro == nullptr ||
+          std::ranges::any_of(macros.GetReplacement(*macro),
+                              [](const CLangToken &token) {
+                                return token.type == CLangTokenType::Error;
+                              }))
+      {
+        continue;
+      }
+
+      packedMacros.push_back(
+          {.name = i,
+           .firstToken = static_cast<uint32_t>(tokens.size()),
+           .tokenCount = macro->tokenCount,
+           .firstParameter = static_cast<uint32_t>(parameters.size()),
+           .parameterCount = macro->parameterCount,
+           .flags = macro->flags});
+      for (CLangToken token : macros.GetReplacement(*macro))
+      {
+        switch (token.type)
+        {
+        case CLangTokenType::IntegerConstant:
+        case CLangTokenType::FloatConstant: {
+          NumericLiteral number = literals.GetNumber(token.value);
+          PackedNumber packed = {.bits = 0,
+                                 .suffix = number.suffix,
+                                 .padding = {}};
+          std::memcpy(&packed.bits, &number.integer, sizeof(packed.bits));
+          token.value = static_cast<uint32_t>(numbers.size());
+          numbers.push_back(packed);
+          break;
+        }
+        case CLangTokenType::CharacterConstant:
+        case CLangTokenType::StringLiteral:
+          if (token.value != CLangToken::NoValue)
+          {
+            characters.append(literals.Get(token.value));
+            token.value = static_cast<uint32_t>(characterEnds.size());
+            characterEnds.push_back(static_cast<uint32_t>(characters.size()));
+          }
+          break;
+        default:
+          break;
+        }
+        tokens.push_back(token);
+      }
+      for (Identifier parameter : macros.GetParameters(*macro))
+      {
+        parameters.push_back(static_cast<uint32_t>(parameter));
+      }
+    }
+
+    // Symbols are sorted by name so that the same prelude always gives the
+    // same file.
+    std::vector<std::pair<Identifier, const StorageType *>> declared;
+    for (const auto &[name, type] : types.GetGlobalScope())
+    {
+      declared.emplace_back(name, type.get());
+    }
+    std::ranges::sort(declared, {},
+                      [](const auto &symbol) { return symbol.first; });
+    std::vector<PackedType> packedTypes;
+    std::vector<PackedSymbol> symbols;
+    for (const auto &[name, type] : declared)
+    {
+      uint32_t first = static_cast<uint32_t>(packedTypes.size());
+      PackType(*type, packedTypes);
+      symbols.push_back(
+          {.name = static_cast<uint32_t>(name),
+           .firstType = first,
+           .typeCount = static_cast<uint32_t>(packedTypes.size()) - first,
+           .padding = 0});
+    }
+
+    FileHeader header = {.magic = Magic,
+                         .version = Version,
+                         .sectionCount = SectionCount,
+                         .sections = {}};
+    std::string image(sizeof(FileHeader), '\0');
+    auto append = [&](Section section, const void *data, size_t size) {
+      image.resize((image.size() + SectionAlignment - 1) /
+                   SectionAlignment * SectionAlignment);
+      header.sections[section] = {.offset = image.size(), .size = size};
+      image.append(static_cast<const char *>(data), size);
+    };
+    auto appendVector = [&](Section section, const auto &records) {
+      append(section, records.data(),
+             records.size() * sizeof(records.front()));
+    };
+    append(Names, names.data(), names.size());
+    appendVector(NameEnds, nameEnds);
+    append(Characters, characters.data(), characters.size());
+    appendVector(CharacterEnds, characterEnds);
+    appendVector(Numbers, numbers);
+    appendVector(Macros, packedMacros);
+    appendVector(MacroTokens, tokens);
+    appendVector(Parameters, parameters);
+    appendVector(Types, packedTypes);
+    appendVector(Symbols, symbols);
+    std::memcpy(image.data(), &header, sizeof(header));
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(image.data(), static_cast<std::streamsize>(image.size()));
+    file.close();
+    if (!file)
+    {
+      throw std::system_error(errno, std::generic_category(),
+                              "Unable to write " + path.string());
+    }
+  }
+
+  PrecompiledHeader::PrecompiledHeader(
+      const std::filesystem::path &path,
+      std::shared_ptr<IdentifierTable> identifiers)
+      : m_file(std::make_unique<MappedFileScanner>(path)),
+        m_image(m_file->GetSourceManager().GetSource()),
+        m_identifiers(std::move(identifiers))
+  {
+    if (!IsValid(m_image))
+    {
+      throw std::runtime_error(path.string() +
+                               " is not a precompiled header of version " +
+                               std::to_string(Version));
+    }
+
+    FileHeader header = ReadRecord<FileHeader>(m_image, 0);
+    size_t count = SectionReader<uint32_t>(m_image, header, NameEnds)
+                       .GetCount();
+    m_names.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+      m_names.push_back(m_identifiers->Intern(
+          GetString(m_image, header, Names, NameEnds, i)));
+    }
+  }
+
+  PrecompiledHeader::~PrecompiledHeader() = default;
+
+  void PrecompiledHeader::LoadMacros(MacroTable &macros,
+                                     LiteralTable &literals) const
+  {
+    FileHeader header = ReadRecord<FileHeader>(m_image, 0);
+    SectionReader<PackedNumber> numbers(m_image, header, Numbers);
+    SectionReader<PackedMacro> packedMacros(m_image, header, Macros);
+    SectionReader<CLangToken> tokens(m_image, header, MacroTokens);
+    SectionReader<uint32_t> parameterNames(m_image, header, Parameters);
+
+    // Replacement tokens keep no offset into the prelude, which is not the
+    // source being compiled. They point at its start instead.
+    std::vector<CLangToken> replacement;
+    std::vector<Identifier> parameters;
+    for (size_t i = 0; i < packedMacros.GetCount(); i++)
+    {
+      PackedMacro macro = packedMacros[i];
+      replacement.clear();
+      for (uint32_t j = 0; j < macro.tokenCount; j++)
+      {
+        CLangToken token = tokens[macro.firstToken + j];
+        switch (token.type)
+        {
+        case CLangTokenType::Identifier:
+          token.value = static_cast<uint32_t>(m_names[token.value]);
+          break;
+        case CLangTokenType::IntegerConstant:
+        case CLangTokenType::FloatConstant: {
+          PackedNumber packed = numbers[token.value];
+          NumericLiteral number = {};
+          std::memcpy(&number.integer, &packed.bits, sizeof(packed.bits));
+          number.suffix = packed.suffix;
+          token.value = literals.AddNumber(number);
+          break;
+        }
+        case CLangTokenType::CharacterConstant:
+        case CLangTokenType::StringLiteral:
+          if (token.value != CLangToken::NoValue)
+          {
+            token.value = literals.Add(GetString(
+                m_image, header, Characters, CharacterEnds, token.value));
+          }
+          break;
+        default:
+          break;
+        }
+        token.offset = 0;
+        token.flags |= CLangToken::Relocated;
+        replacement.push_back(token);
+      }
+
+      parameters.clear();
+      for (uint32_t j = 0; j < macro.parameterCount; j++)
+      {
+        parameters.push_back(m_names[parameterNames[macro.firstParameter + j]]);
+      }
+      macros.Define(m_names[macro.name], parameters, replacement,
+                    static_cast<uint8_t>(macro.flags));
+    }
+  }
+
+  void PrecompiledHeader::LoadSymbols(TypeTable &types) const
+  {
+    FileHeader header = ReadRecord<FileHeader>(m_image, 0);
+    SectionReader<PackedType> packedTypes(m_image, header, Types);
+    SectionReader<PackedSymbol> symbols(m_image, header, Symbols);
+    for (size_t i = 0; i < symbols.GetCount(); i++)
+    {
+      PackedSymbol symbol = symbols[i];
+      std::unique_ptr<StorageType> type;
+      for (uint32_t j = 0; j < symbol.typeCount; j++)
+      {
+        PackedType packed = packedTypes[symbol.firstType + j];
+        bool isConst = (packed.flags & PackedType::Const) != 0;
+        bool isLValue = (packed.flags & PackedType::LValue) != 0;
+        switch (static_cast<StorageMetaType>(packed.meta))
+        {
+        case StorageMetaType::Integral:
+          type = std::make_unique<IntegralType>(
+              static_cast<Integral>(packed.kind),
+              (packed.flags & PackedType::Unsigned) != 0, isConst, isLValue);
+          break;
+        case StorageMetaType::Real:
+          type = std::make_unique<RealType>(static_cast<Real>(packed.kind),
+                                            isConst, isLValue);
+          break;
+        case StorageMetaType::Pointer:
+          type = std::make_unique<PointerType>(type, isConst, isLValue);
+          break;
+        case StorageMetaType::Array:
+          type = std::make_unique<ArrayType>(
+              type, static_cast<size_t>(packed.size), isLValue);
+          break;
+        default:
+          type = std::make_unique<StorageType>(StorageMetaType::Void, isConst,
+                                               isLValue);
+          break;
+        }
+      }
+      types.AddSymbol(m_names[symbol.name], std::move(type));
+    }
+  }
+} // namespace Vypr
@@ -0,0 +1,1788 @@
+#include "Vypr/Preprocessor/Preprocessor.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+#include <utility>
+
+#include "Vypr/Lexer/CLangKeywords.hpp"
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Lexer/CLangPunctuators.hpp"
+#include "Vypr/Preprocessor/HeaderCache.hpp"
+#include "Vypr/Preprocessor/PrecompiledHeader.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+#include "Vypr/Scanner/CharacterClass.hpp"
+#include "Vypr/Scanner/MappedFileScanner.hpp"
+
+namespace Vypr
+{
+  namespace
+  {
+    /// @brief Value of a preprocessing expression, in which every integer
+    /// is 64 bits wide.
+    struct ConditionValue
+    {
+      uint64_t bits;
+      bool isUnsigned;
+    };
+
+    /// @brief Evaluates the tokens of an `#if` condition, after macro
+    /// expansion, by recursive descent.
+    class ConditionParser
+    {
+    public:
+      /// @param tokens Tokens of the condition.
+      /// @param literals Table the values of the tokens are in.
+      /// @param macros Macros that `defined` tests for.
+      /// @param defined Interned name of `defined`.
+      ConditionParser(std::span<const CLangToken> tokens,
+                      const LiteralTable &literals, const MacroTable &macros,
+                      Identifier defined)
+          : m_tokens(tokens), m_literals(literals), m_macros(macros),
+            m_defined(defined), m_next(0), m_unevaluated(0), m_failed(false)
+      {
+      }
+
+      /// @returns Whether the condition holds, or nothing if it is
+      /// malformed.
+      std::optional<bool> Parse()
+      {
+        ConditionValue value = ParseConditional();
+        if (m_failed || m_next != m_tokens.size())
+        {
+          return std::nullopt;
+        }
+        return value.bits != 0;
+      }
+
+    private:
+      CLangTokenType PeekType() const
+      {
+        return m_next < m_tokens.size() ? m_tokens[m_next].type
+                                        : CLangTokenType::NoToken;
+      }
+
+      bool Accept(CLangTokenType type)
+      {
+        if (PeekType() != type)
+        {
+          return false;
+        }
+        m_next += 1;
+        return true;
+      }
+
+      ConditionValue Fail()
+      {
+        m_failed = true;
+        return {0, false};
+      }
+
+      ConditionValue ParseConditional()
+      {
+        ConditionValue condition = ParseBinary(0);
+        if (!Accept(CLangTokenType::TernaryProposition))
+        {
+          return condition;
+        }
+
+        bool holds = condition.bits != 0;
+        m_unevaluated += holds ? 0 : 1;
+        ConditionValue whenTrue = ParseConditional();
+        m_unevaluated -= holds ? 0 : 1;
+        if (!Accept(CLangTokenType::TernaryDecision))
+        {
+          return Fail();
+        }
+        m_unevaluated += holds ? 1 : 0;
+        ConditionValue whenFalse = ParseConditional();
+        m_unevaluated -= holds ? 1 : 0;
+
+        return {holds ? whenTrue.bits : whenFalse.bits,
+                whenTrue.isUnsigned || whenFalse.isUnsigned};
+      }
+
+      /// @returns Precedence of a binary operator, higher binding tighter, or
+      /// zero for other tokens.
+      static int GetPrecedence(CLangTokenType type)
+      {
+        switch (type)
+        {
+        case CLangTokenType::Star:
+        case CLangTokenType::Divide:
+        case CLangTokenType::Modulo:
+          return 10;
+        case CLangTokenType::Add:
+        case CLangTokenType::Subtract:
+          return 9;
+        case CLangTokenType::ShiftLeft:
+        case CLangTokenType::ShiftRight:
+          return 8;
+        case CLangTokenType::LessThan:
+        case CLangTokenType::GreaterThan:
+        case CLangTokenType::LessEqual:
+        case CLangTokenType::GreaterEqual:
+          return 7;
+        case CLangTokenType::Equal:
+        case CLangTokenType::NotEqual:
+          return 6;
+        case CLangTokenType::And:
+          return 5;
+        case CLangTokenType::Xor:
+          return 4;
+        case CLangTokenType::Or:
+          return 3;
+        case CLangTokenType::LogicalAnd:
+          return 2;
+        case CLangTokenType::LogicalOr:
+          return 1;
+        default:
+          return 0;
+        }
+      }
+
+      /// @brief Parses operators binding tighter than `minimum` by
+      /// precedence climbing.
+      ConditionValue ParseBinary(int minimum)
+      {
+        ConditionValue left = ParseUnary();
+        while (!m_failed)
+        {
+          CLangTokenType type = PeekType();
+          int precedence = GetPrecedence(type);
+          if (precedence <= minimum)
+          {
+            break;
+          }
+          m_next += 1;
+
+          bool shortCircuit =
+              (type == CLangTokenType::LogicalAnd && left.bits == 0) ||
+              (type == CLangTokenType::LogicalOr && left.bits != 0);
+          m_unevaluated += shortCircuit ? 1 : 0;
+          ConditionValue right = ParseBinary(precedence);
+          m_unevaluated -= shortCircuit ? 1 : 0;
+          left = Apply(type, left, right);
+        }
+        return left;
+      }
+
+      ConditionValue Apply(CLangTokenType type, ConditionValue left,
+                           ConditionValue right)
+      {
+        bool isUnsigned = left.isUnsigned || right.isUnsigned;
+        int64_t signedLeft = static_cast<int64_t>(left.bits);
+        int64_t signedRight = static_cast<int64_t>(right.bits);
+        switch (type)
+        {
+        case CLangTokenType::Star:
+          return {left.bits * right.bits, isUnsigned};
+        case CLangTokenType::Divide:
+        case CLangTokenType::Modulo:
+          if (right.bits == 0)
+          {
+            return m_unevaluated > 0 ? ConditionValue{0, isUnsigned} : Fail();
+          }
+          if (isUnsigned)
+          {
+            return {type == CLangTokenType::Divide ? left.bits / right.bits
+                                                   : left.bits % right.bits,
+                    true};
+          }
+          if (signedRight == -1)
+          {
+            // Negated with wrapping, which leaves INT64_MIN / -1 defined.
+            return {type == CLangTokenType::Divide ? 0 - left.bits : 0, false};
+          }
+          return {static_cast<uint64_t>(type == CLangTokenType::Divide
+                                            ? signedLeft / signedRight
+                                            : signedLeft % signedRight),
+                  false};
+        case CLangTokenType::Add:
+          return {left.bits + right.bits, isUnsigned};
+        case CLangTokenType::Subtract:
+          return {left.bits - right.bits, isUnsigned};
+        case CLangTokenType::ShiftLeft:
+          return {right.bits < 64 ? left.bits << right.bits : 0,
+                  left.isUnsigned};
+        case CLangTokenType::ShiftRight:
+          if (left.isUnsigned)
+          {
+            return {right.bits < 64 ? left.bits >> right.bits : 0, true};
+          }
+          return {static_cast<uint64_t>(signedLeft >> std::min<uint64_t>(
+                                                          right.bits, 63)),
+                  false};
+        case CLangTokenType::LessThan:
+          return {isUnsigned ? left.bits < right.bits
+                             : signedLeft < signedRight,
+                  false};
+        case CLangTokenType::GreaterThan:
+          return {isUnsigned ? left.bits > right.bits
+                             : signedLeft > signedRight,
+                  false};
+        case CLangTokenType::LessEqual:
+          return {isUnsigned ? left.bits <= right.bits
+                             : signedLeft <= signedRight,
+                  false};
+        case CLangTokenType::GreaterEqual:
+          return {isUnsigned ? left.bits >= right.bits
+                             : signedLeft >= signedRight,
+                  false};
+        case CLangTokenType::Equal:
+          return {left.bits == right.bits, false};
+        case CLangTokenType::NotEqual:
+          return {left.bits != right.bits, false};
+        case CLangTokenType::And:
+          return {left.bits & right.bits, isUnsigned};
+        case CLangTokenType::Xor:
+          return {left.bits ^ right.bits, isUnsigned};
+        case CLangTokenType::Or:
+          return {left.bits | right.bits, isUnsigned};
+        case CLangTokenType::LogicalAnd:
+          return {left.bits != 0 && right.bits != 0, false};
+        default:
+          return {left.bits != 0 || right.bits != 0, false};
+        }
+      }
+
+      ConditionValue ParseUnary()
+      {
+        if (Accept(CLangTokenType::Add))
+        {
+          return ParseUnary();
+        }
+        if (Accept(CLangTokenType::Subtract))
+        {
+          ConditionValue value = ParseUnary();
+          return {0 - value.bits, value.isUnsigned};
+        }
+        if (Accept(CLangTokenType::Tilde))
+        {
+          ConditionValue value = ParseUnary();
+          return {~value.bits, value.isUnsigned};
+        }
+        if (Accept(CLangTokenType::Exclamation))
+        {
+          return {ParseUnary().bits == 0, false};
+        }
+        return ParsePrimary();
+      }
+
+      ConditionValue ParsePrimary()
+      {
+        if (m_next == m_tokens.size())
+        {
+          return Fail();
+        }
+
+        CLangToken token = m_tokens[m_next++];
+        switch (token.type)
+        {
+        case CLangTokenType::LeftParenthesis: {
+          ConditionValue value = ParseConditional();
+          return Accept(CLangTokenType::RightParenthesis) ? value : Fail();
+        }
+        case CLangTokenType::IntegerConstant: {
+          NumericLiteral number = m_literals.GetNumber(token.value);
+          return {number.integer,
+                  (number.suffix & NumericLiteral::Unsigned) != 0 ||
+                      number.integer > INT64_MAX};
+        }
+        case CLangTokenType::CharacterConstant: {
+          std::string_view value = m_literals.Get(token.value);
+          if (value.empty())
+          {
+            return Fail();
+          }
+          return {static_cast<uint64_t>(static_cast<signed char>(value[0])),
+                  false};
+        }
+        case CLangTokenType::Identifier:
+          if (token.GetIdentifier() == m_defined)
+          {
+            return ParseDefined();
+          }
+          // Identifiers left after macro expansion stand for zero.
+          return {0, false};
+        default:
+          // So do keywords, which the preprocessor does not know of.
+          return GetKeywordSpelling(token.type).empty() ? Fail()
+                                                        : ConditionValue{0,
+                                                                         false};
+        }
+      }
+
+      ConditionValue ParseDefined()
+      {
+        bool parenthesized = Accept(CLangTokenType::LeftParenthesis);
+        if (PeekType() != CLangTokenType::Identifier)
+        {
+          return Fail();
+        }
+        Identifier name = m_tokens[m_next++].GetIdentifier();
+        if (parenthesized && !Accept(CLangTokenType::RightParenthesis))
+        {
+          return Fail();
+        }
+        return {m_macros.IsDefined(name), false};
+      }
+
+      std::span<const CLangToken> m_tokens;
+      const LiteralTable &m_literals;
+      const MacroTable &m_macros;
+      Identifier m_defined;
+      size_t m_next;
+
+      /// @brief Number of operands being parsed whose value is not used,
+      /// where division by zero is not an error.
+      int m_unevaluated;
+      bool m_failed;
+    };
+  } // namespace
+
+  Preprocessor::Preprocessor(std::string_view source,
+                             std::shared_ptr<IdentifierTable> identifiers,
+                             const PreprocessorOptions &options)
+      : m_identifiers(std::move(identifiers)),
+        m_includeDirectories(options.includeDirectories),
+        m_literals(nullptr), m_diagnostics(nullptr), m_nextError(0),
+        m_headerCache(options.headerCache), m_disabledCount(0), m_depth(0),
+        m_cacheGarbage(0), m_caching(false), m_cacheFailed(false)
+  {
+    IdentifierTable &table = *m_identifiers;
+    m_include = table.Intern("include");
+    m_define = table.Intern("define");
+    m_undef = table.Intern("undef");
+    m_ifdef = table.Intern("ifdef");
+    m_ifndef = table.Intern("ifndef");
+    m_elif = table.Intern("elif");
+    m_endif = table.Intern("endif");
+    m_pragma = table.Intern("pragma");
+    m_error = table.Intern("error");
+    m_line = table.Intern("line");
+    m_warning = table.Intern("warning");
+    m_defined = table.Intern("defined");
+    m_once = table.Intern("once");
+    m_variadicArguments = table.Intern("__VA_ARGS__");
+    m_if = table.Intern("if");
+    m_else = table.Intern("else");
+
+    auto file = std::make_shared<CLangLexer>(
+        std::make_unique<BufferScanner>(source), m_identifiers);
+    file->Tokenize();
+
+    std::string path;
+    if (!options.sourcePath.empty())
+    {
+      std::error_code error;
+      path = std::filesystem::weakly_canonical(options.sourcePath, error)
+                 .string();
+    }
+    m_frames.push_back({.file = std::move(file),
+                        .names = nullptr,
+                        .path = path,
+                        .directory = options.sourcePath.parent_path(),
+                        .next = 0,
+                        .includeOffset = CLangToken::NoPosition,
+                        .conditionalBase = 0,
+                        .guardState = GuardState::None,
+                        .guardMacro = Identifier::None,
+                        .guardDepth = 0});
+    m_statistics.filesEntered = 1;
+  }
+
+  Preprocessor::~Preprocessor() = default;
+
+  void Preprocessor::Load(const PrecompiledHeader &header,
+                          LiteralTable &literals)
+  {
+    header.LoadMacros(m_macros, literals);
+  }
+
+  CLangToken Preprocessor::GetToken(LiteralTable &literals,
+                                    DiagnosticSink &diagnostics)
+  {
+    m_literals = &literals;
+    m_diagnostics = &diagnostics;
+    while (true)
+    {
+      CLangToken token = ReadToken();
+      if (!Expand(token))
+      {
+        return token;
+      }
+    }
+  }
+
+  CLangToken Preprocessor::ReadToken()
+  {
+    if (m_nextError < m_errors.size())
+    {
+      return m_errors[m_nextError++];
+    }
+
+    while (!m_contexts.empty())
+    {
+      Context &context = m_contexts.back();
+      if (context.next < context.end)
+      {
+        return TakeToken(context);
+      }
+      if (context.barrier)
+      {
+        return {};
+      }
+      PopContext();
+    }
+    return ReadFileToken();
+  }
+
+  CLangTokenType Preprocessor::PeekTokenType()
+  {
+    if (m_nextError < m_errors.size())
+    {
+      return CLangTokenType::Error;
+    }
+
+    while (!m_contexts.empty())
+    {
+      Context context = m_contexts.back();
+      if (context.next < context.end)
+      {
+        return TakeToken(context).type;
+      }
+      if (context.barrier)
+      {
+        return CLangTokenType::NoToken;
+      }
+      PopContext();
+    }
+
+    if (m_frames.empty())
+    {
+      return CLangTokenType::NoToken;
+    }
+    const Frame &frame = m_frames.back();
+    const TokenBuffer &tokens = frame.file->GetTokens();
+    return frame.next < tokens.GetSize() ? tokens.GetType(frame.next)
+                                         : CLangTokenType::NoToken;
+  }
+
+  CLangToken Preprocessor::ReadFileToken()
+  {
+    while (true)
+    {
+      if (m_nextError < m_errors.size())
+      {
+        return m_errors[m_nextError++];
+      }
+      m_errors.clear();
+      m_nextError = 0;
+
+      if (m_frames.empty())
+      {
+        return {};
+      }
+
+      Frame &frame = m_frames.back();
+      const TokenBuffer &tokens = frame.file->GetTokens();
+      if (frame.next == tokens.GetSize())
+      {
+        Leave();
+        continue;
+      }
+
+      CLangToken token = tokens[frame.next];
+      if (token.type == CLangTokenType::Preprocessor &&
+          (token.flags & CLangToken::StartOfLine))
+      {
+        RunDirective(ReadDirective());
+        continue;
+      }
+
+      if (frame.guardState != GuardState::Open)
+      {
+        frame.guardState = GuardState::None;
+      }
+      frame.next += 1;
+      return Relocate(token);
+    }
+  }
+
+  CLangToken Preprocessor::TakeToken(Context &context)
+  {
+    uint32_t index = context.next++;
+    CLangToken token;
+    switch (context.source)
+    {
+    case ContextSource::Replacement:
+      token = m_macros.GetToken(index);
+      break;
+    case ContextSource::Cache:
+      token = m_cacheTokens[index];
+      break;
+    default:
+      token = m_arena[index];
+      break;
+    }
+
+    if (context.offset != CLangToken::NoPosition)
+    {
+      // The first token is spaced like the macro name it replaces, and no
+      // token of an expansion starts a line.
+      constexpr uint8_t Spacing =
+          CLangToken::StartOfLine | CLangToken::LeadingSpace;
+      token.offset = context.offset;
+      token.flags = index == context.begin
+                        ? (token.flags & ~Spacing) | context.flags
+                        : token.flags & ~CLangToken::StartOfLine;
+      token.flags |= CLangToken::Relocated;
+    }
+    return token;
+  }
+
+  bool Preprocessor::Expand(CLangToken &token)
+  {
+    if (token.type != CLangTokenType::Identifier ||
+        (token.flags & CLangToken::NoExpand))
+    {
+      return false;
+    }
+    // A cached expansion depends on the definition of every name it looks
+    // up, including those that are not macros yet.
+    if (m_caching)
+    {
+      m_cacheDependencies.push_back(token.GetIdentifier());
+    }
+    const Macro *found = m_macros.Find(token.GetIdentifier());
+    if (found == nullptr)
+    {
+      return false;
+    }
+
+    // A macro found again while it is being expanded is never expanded,
+    // not even once the expansion has ended.
+    uint32_t index = static_cast<uint32_t>(found->name);
+    if (index < m_disabled.size() && m_disabled[index])
+    {
+      token.flags |= CLangToken::NoExpand;
+      return false;
+    }
+
+    // Copied, since directives run while reading arguments may redefine it.
+    Macro macro = *found;
+    if (!(macro.flags & Macro::FunctionLike))
+    {
+      ExpandObject(macro, token);
+      return true;
+    }
+    if (PeekTokenType() != CLangTokenType::LeftParenthesis)
+    {
+      return false;
+    }
+    ExpandFunction(macro, token);
+    return true;
+  }
+
+  void Preprocessor::ExpandObject(const Macro &macro, const CLangToken &name)
+  {
+    // Expansions that only fill the cache are counted when it is replayed.
+    if (!m_caching)
+    {
+      m_statistics.macrosExpanded += 1;
+    }
+    Context context = {
+        .source = ContextSource::Replacement,
+        .barrier = false,
+        .flags = static_cast<uint8_t>(
+            name.flags & (CLangToken::StartOfLine | CLangToken::LeadingSpace)),
+        .macro = macro.name,
+        .begin = macro.firstToken,
+        .next = macro.firstToken,
+        .end = macro.firstToken + macro.tokenCount,
+        .offset = name.offset,
+        .arenaBase = static_cast<uint32_t>(m_arena.size())};
+
+    // Inside another expansion, the result depends on which macros are
+    // disabled, so only invocations outside of any are cached.
+    if (m_disabledCount == 0 && !m_caching)
+    {
+      uint32_t index = static_cast<uint32_t>(macro.name);
+      if (index >= m_cache.size())
+      {
+        m_cache.resize(index + 1);
+      }
+      CacheEntry &entry = m_cache[index];
+      if (!IsCurrent(entry))
+      {
+        m_statistics.cacheMisses += 1;
+        CacheExpansion(macro, entry);
+      }
+      if (entry.cached)
+      {
+        context.source = ContextSource::Cache;
+        context.begin = entry.begin;
+        context.next = entry.begin;
+        context.end = entry.end;
+        m_statistics.cachedExpansions += 1;
+      }
+    }
+    PushContext(context);
+  }
+
+  void Preprocessor::CacheExpansion(const Macro &macro, CacheEntry &entry)
+  {
+    // Expansions are only cached outside of any other, so none is being
+    // replayed from the cache while it is compacted.
+    if (entry.generation != NoExpansion)
+    {
+      m_cacheGarbage += entry.end - entry.begin + entry.dependencyEnd -
+                        entry.firstDependency;
+      entry.generation = NoExpansion;
+    }
+    if (m_cacheGarbage * 2 > m_cacheTokens.size() + m_cacheDependencies.size())
+    {
+      CompactCache();
+    }
+
+    uint32_t firstDependency =
+        static_cast<uint32_t>(m_cacheDependencies.size());
+    m_cacheDependencies.push_back(macro.name);
+    std::vector<CLangToken> &cached = GetScratch(m_depth).cached;
+    cached.clear();
+    m_caching = true;
+    m_cacheFailed = false;
+    ExpandIsolated({.source = ContextSource::Replacement,
+                    .barrier = true,
+                    .flags = 0,
+                    .macro = macro.name,
+                    .begin = macro.firstToken,
+                    .next = macro.firstToken,
+                    .end = macro.firstToken + macro.tokenCount,
+                    .offset = CLangToken::NoPosition,
+                    .arenaBase = static_cast<uint32_t>(m_arena.size())},
+                   cached);
+    m_caching = false;
+
+    // Each name is checked once however often the expansion looked it up.
+    auto dependencies = m_cacheDependencies.begin() + firstDependency;
+    std::sort(dependencies, m_cacheDependencies.end());
+    m_cacheDependencies.erase(
+        std::unique(dependencies, m_cacheDependencies.end()),
+        m_cacheDependencies.end());
+    entry.firstDependency = firstDependency;
+    entry.dependencyEnd = static_cast<uint32_t>(m_cacheDependencies.size());
+
+    entry.generation = m_macros.GetGeneration();
+    entry.cached = !m_cacheFailed;
+    if (entry.cached)
+    {
+      entry.begin = static_cast<uint32_t>(m_cacheTokens.size());
+      m_cacheTokens.insert(m_cacheTokens.end(), cached.begin(), cached.end());
+      entry.end = static_cast<uint32_t>(m_cacheTokens.size());
+    }
+  }
+
+  bool Preprocessor::IsCurrent(const CacheEntry &entry) const
+  {
+    if (entry.generation == m_macros.GetGeneration())
+    {
+      return true;
+    }
+    if (entry.generation == NoExpansion)
+    {
+      return false;
+    }
+    for (uint32_t i = entry.firstDependency; i < entry.dependencyEnd; i++)
+    {
+      if (m_macros.GetGeneration(m_cacheDependencies[i]) > entry.generation)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void Preprocessor::CompactCache()
+  {
+    std::vector<CLangToken> tokens;
+    std::vector<Identifier> dependencies;
+    for (CacheEntry &entry : m_cache)
+    {
+      if (entry.generation == NoExpansion)
+      {
+        continue;
+      }
+      uint32_t begin = static_cast<uint32_t>(tokens.size());
+      tokens.insert(tokens.end(), m_cacheTokens.begin() + entry.begin,
+                    m_cacheTokens.begin() + entry.end);
+      entry.begin = begin;
+      entry.end = static_cast<uint32_t>(tokens.size());
+
+      uint32_t firstDependency = static_cast<uint32_t>(dependencies.size());
+      dependencies.insert(
+          dependencies.end(),
+          m_cacheDependencies.begin() + entry.firstDependency,
+          m_cacheDependencies.begin() + entry.dependencyEnd);
+      entry.firstDependency = firstDependency;
+      entry.dependencyEnd = static_cast<uint32_t>(dependencies.size());
+    }
+    m_cacheTokens = std::move(tokens);
+    m_cacheDependencies = std::move(dependencies);
+    m_cacheGarbage = 0;
+  }
+
+  void Preprocessor::ExpandFunction(const Macro &macro,
+                                    const CLangToken &name)
+  {
+    if (!m_caching)
+    {
+      m_statistics.macrosExpanded += 1;
+    }
+    ReadToken();
+
+    // Arguments are split at commas outside of parentheses, except in the
+    // variadic argument, which takes every remaining one.
+    Scratch &scratch = GetScratch(m_depth);
+    scratch.arguments.clear();
+    scratch.bounds.assign(1, 0);
+    size_t named = macro.parameterCount;
+    bool variadic = (macro.flags & Macro::Variadic) != 0;
+    size_t nesting = 0;
+    while (true)
+    {
+      CLangToken token = ReadToken();
+      if (token.type == CLangTokenType::NoToken)
+      {
+        Fail(DiagnosticId::UnterminatedMacroCall, name);
+        return;
+      }
+      if (token.type == CLangTokenType::LeftParenthesis)
+      {
+        nesting += 1;
+      }
+      else if (token.type == CLangTokenType::RightParenthesis)
+      {
+        if (nesting == 0)
+        {
+          break;
+        }
+        nesting -= 1;
+      }
+      else if (token.type == CLangTokenType::Comma && nesting == 0 &&
+               (!variadic || scratch.bounds.size() <= named))
+      {
+        scratch.bounds.push_back(
+            static_cast<uint32_t>(scratch.arguments.size()));
+        continue;
+      }
+      scratch.arguments.push_back(token);
+    }
+    scratch.bounds.push_back(static_cast<uint32_t>(scratch.arguments.size()));
+
+    // `F()` passes no argument to a macro without parameters, and the
+    // variadic argument may be left out entirely.
+    size_t count = scratch.bounds.size() - 1;
+    if (count == 1 && named == 0 && !variadic && scratch.arguments.empty())
+    {
+      count = 0;
+    }
+    else if (variadic && count == named)
+    {
+      scratch.bounds.push_back(scratch.bounds.back());
+      count += 1;
+    }
+    if (count != named + (variadic ? 1 : 0))
+    {
+      Fail(DiagnosticId::MacroArgumentCount, name);
+      return;
+    }
+
+    Substitute(macro, scratch);
+    Context context = PushArena(scratch.result);
+    context.flags = static_cast<uint8_t>(
+        name.flags & (CLangToken::StartOfLine | CLangToken::LeadingSpace));
+    context.macro = macro.name;
+    context.offset = name.offset;
+    PushContext(context);
+  }
+
+  void Preprocessor::Substitute(const Macro &macro, Scratch &scratch)
+  {
+    scratch.result.clear();
+    scratch.expanded.clear();
+    scratch.expandedBounds.assign(2 * (scratch.bounds.size() - 1),
+                                  NoExpansion);
+    std::vector<CLangToken> &result = scratch.result;
+
+    auto raw = [&](size_t parameter) -> std::span<const CLangToken> {
+      uint32_t start = scratch.bounds[parameter];
+      return {scratch.arguments.data() + start,
+              scratch.bounds[parameter + 1] - start};
+    };
+
+    // Arguments are expanded on their own the first time they are
+    // substituted without `#` or `##`.
+    auto expanded = [&](size_t parameter) -> std::span<const CLangToken> {
+      uint32_t *bounds = &scratch.expandedBounds[2 * parameter];
+      if (bounds[0] == NoExpansion)
+      {
+        uint32_t start = static_cast<uint32_t>(scratch.expanded.size());
+        ExpandIsolated(PushArena(raw(parameter)), scratch.expanded);
+        bounds = &scratch.expandedBounds[2 * parameter];
+        bounds[0] = start;
+        bounds[1] = static_cast<uint32_t>(scratch.expanded.size());
+      }
+      return {scratch.expanded.data() + bounds[0], bounds[1] - bounds[0]};
+    };
+
+    // Start in `result` of the last operand, which `##` pastes onto.
+    size_t operandStart = 0;
+    uint32_t end = macro.firstToken + macro.tokenCount;
+    for (uint32_t i = macro.firstToken; i < end; i++)
+    {
+      CLangToken token = m_macros.GetToken(i);
+      size_t parameter = NoParameter;
+
+      if (token.type == CLangTokenType::Preprocessor && i + 1 < end &&
+          (parameter = FindParameter(macro, m_macros.GetToken(i + 1))) !=
+              NoParameter)
+      {
+        i += 1;
+        std::span<const CLangToken> argument = raw(parameter);
+        m_spelling.clear();
+        for (size_t k = 0; k < argument.size(); k++)
+        {
+          if (k > 0 && (argument[k].flags & (CLangToken::StartOfLine |
+                                             CLangToken::LeadingSpace)))
+          {
+            m_spelling.push_back(' ');
+          }
+          AppendSpelling(argument[k], m_spelling);
+        }
+        operandStart = result.size();
+        result.push_back(
+            {.type = CLangTokenType::StringLiteral,
+             .flags = static_cast<uint8_t>(token.flags &
+                                           CLangToken::LeadingSpace),
+             .offset = token.offset,
+             .length = token.length,
+             .value = m_literals->Add(m_spelling)});
+        continue;
+      }
+
+      if (token.type == CLangTokenType::PreprocessorConcat &&
+          i > macro.firstToken && i + 1 < end)
+      {
+        i += 1;
+        CLangToken right = m_macros.GetToken(i);
+        parameter = FindParameter(macro, right);
+        std::span<const CLangToken> operand =
+            parameter == NoParameter ? std::span<const CLangToken>(&right, 1)
+                                     : raw(parameter);
+
+        // An empty operand leaves the other one as it is.
+        size_t first = 0;
+        if (!operand.empty() && result.size() > operandStart)
+        {
+          CLangToken pasted = Paste(result.back(), operand[0]);
+          if (pasted.type != CLangTokenType::NoToken)
+          {
+            result.back() = pasted;
+            first = 1;
+          }
+          else
+          {
+            Fail(DiagnosticId::InvalidTokenPaste, result.back());
+          }
+        }
+        result.insert(result.end(), operand.begin() + first, operand.end());
+        continue;
+      }
+
+      operandStart = result.size();
+      parameter = FindParameter(macro, token);
+      if (parameter == NoParameter)
+      {
+        result.push_back(token);
+        continue;
+      }
+
+      bool pasted =
+          i + 1 < end && m_macros.GetToken(i + 1).type ==
+                             CLangTokenType::PreprocessorConcat;
+      std::span<const CLangToken> argument =
+          pasted ? raw(parameter) : expanded(parameter);
+      result.insert(result.end(), argument.begin(), argument.end());
+      if (result.size() > operandStart)
+      {
+        CLangToken &first = result[operandStart];
+        first.flags = static_cast<uint8_t>(
+            (first.flags &
+             ~(CLangToken::StartOfLine | CLangToken::LeadingSpace)) |
+            (token.flags & CLangToken::LeadingSpace));
+      }
+    }
+  }
+
+  void Preprocessor::ExpandIsolated(Context context,
+                                    std::vector<CLangToken> &output)
+  {
+    context.barrier = true;
+    PushContext(context);
+    m_depth += 1;
+    for (CLangToken token = ReadToken();
+         token.type != CLangTokenType::NoToken; token = ReadToken())
+    {
+      if (!Expand(token))
+      {
+        output.push_back(token);
+      }
+    }
+    m_depth -= 1;
+    PopContext();
+  }
+
+  Preprocessor::Context
+  Preprocessor::PushArena(std::span<const CLangToken> tokens)
+  {
+    uint32_t begin = static_cast<uint32_t>(m_arena.size());
+    m_arena.insert(m_arena.end(), tokens.begin(), tokens.end());
+    return {.source = ContextSource::Arena,
+            .barrier = false,
+            .flags = 0,
+            .macro = Identifier::None,
+            .begin = begin,
+            .next = begin,
+            .end = static_cast<uint32_t>(m_arena.size()),
+            .offset = CLangToken::NoPosition,
+            .arenaBase = begin};
+  }
+
+  void Preprocessor::PushContext(const Context &context)
+  {
+    if (context.macro != Identifier::None)
+    {
+      uint32_t index = static_cast<uint32_t>(context.macro);
+      if (index >= m_disabled.size())
+      {
+        m_disabled.resize(index + 1);
+      }
+      m_disabled[index] = true;
+      m_disabledCount += 1;
+    }
+    m_contexts.push_back(context);
+  }
+
+  void Preprocessor::PopContext()
+  {
+    const Context &context = m_contexts.back();
+    if (context.macro != Identifier::None)
+    {
+      m_disabled[static_cast<uint32_t>(context.macro)] = false;
+      m_disabledCount -= 1;
+    }
+    m_arena.resize(context.arenaBase);
+    m_contexts.pop_back();
+  }
+
+  Preprocessor::Scratch &Preprocessor::GetScratch(size_t depth)
+  {
+    while (m_scratch.size() <= depth)
+    {
+      m_scratch.emplace_back();
+    }
+    return m_scratch[depth];
+  }
+
+  size_t Preprocessor::FindParameter(const Macro &macro,
+                                     const CLangToken &token) const
+  {
+    Identifier name = token.GetIdentifier();
+    if (name == Identifier::None)
+    {
+      return NoParameter;
+    }
+    std::span<const Identifier> parameters = m_macros.GetParameters(macro);
+    for (size_t i = 0; i < parameters.size(); i++)
+    {
+      if (parameters[i] == name)
+      {
+        return i;
+      }
+    }
+    return (macro.flags & Macro::Variadic) && name == m_variadicArguments
+               ? parameters.size()
+               : NoParameter;
+  }
+
+  CLangToken Preprocessor::Paste(const CLangToken &left,
+                                 const CLangToken &right)
+  {
+    m_spelling.clear();
+    AppendSpelling(left, m_spelling);
+    AppendSpelling(right, m_spelling);
+    std::string_view text = m_spelling;
+    CLangToken token = {.type = CLangTokenType::NoToken,
+                        .flags = left.flags,
+                        .offset = left.offset,
+                        .length = static_cast<uint32_t>(text.size())};
+    if (text.empty())
+    {
+      return token;
+    }
+
+    // Identifiers and punctuators, which most pastes form, are recognized
+    // without lexing.
+    if (!IsDigit(text[0]) && std::ranges::all_of(text, IsIdentifier))
+    {
+      token.type = FindKeyword(text);
+      if (token.type == CLangTokenType::Identifier)
+      {
+        token.value = static_cast<uint32_t>(m_identifiers->Intern(text));
+      }
+      return token;
+    }
+    if (text.size() <= 3)
+    {
+      CLangPunctuator punctuator =
+          FindPunctuator(text[0], text.size() > 1 ? text[1] : '\0',
+                         text.size() > 2 ? text[2] : '\0');
+      if (punctuator.type != CLangTokenType::NoToken &&
+          punctuator.length == text.size())
+      {
+        token.type = punctuator.type;
+        return token;
+      }
+    }
+
+    CLangLexer lexer(std::make_unique<BufferScanner>(text), m_identifiers);
+    CLangToken lexed = lexer.GetToken();
+    if (lexed.type == CLangTokenType::Error || lexed.length != text.size() ||
+        lexer.GetToken().type != CLangTokenType::NoToken)
+    {
+      return token;
+    }
+    switch (lexed.type)
+    {
+    case CLangTokenType::IntegerConstant:
+    case CLangTokenType::FloatConstant:
+      token.value = m_literals->AddNumber(
+          lexer.GetLiterals().GetNumber(lexed.value));
+      break;
+    case CLangTokenType::CharacterConstant:
+    case CLangTokenType::StringLiteral:
+      token.value = m_literals->Add(lexer.GetLiterals().Get(lexed.value));
+      break;
+    default:
+      token.value = lexed.value;
+      break;
+    }
+    token.type = lexed.type;
+    return token;
+  }
+
+  void Preprocessor::AppendSpelling(const CLangToken &token,
+                                    std::string &text) const
+  {
+    char buffer[32];
+    switch (token.type)
+    {
+    case CLangTokenType::Identifier:
+      text.append(m_identifiers->GetName(token.GetIdentifier()));
+      break;
+    case CLangTokenType::IntegerConstant: {
+      NumericLiteral number = m_literals->GetNumber(token.value);
+      char *end = std::to_chars(buffer, std::end(buffer), number.integer).ptr;
+      text.append(buffer, end);
+      if (number.suffix & NumericLiteral::Unsigned)
+      {
+        text.push_back('u');
+      }
+      if (number.suffix & NumericLiteral::LongLong)
+      {
+        text.append("ll");
+      }
+      else if (number.suffix & NumericLiteral::Long)
+      {
+        text.push_back('l');
+      }
+      break;
+    }
+    case CLangTokenType::FloatConstant: {
+      NumericLiteral number = m_literals->GetNumber(token.value);
+      char *end = std::to_chars(buffer, std::end(buffer), number.real).ptr;
+      text.append(buffer, end);
+      if (std::string_view(buffer, end).find_first_of(".e") ==
+          std::string_view::npos)
+      {
+        text.push_back('.');
+      }
+      if (number.suffix & NumericLiteral::Float)
+      {
+        text.push_back('f');
+      }
+      break;
+    }
+    case CLangTokenType::CharacterConstant:
+    case CLangTokenType::StringLiteral: {
+      char quote = token.type == CLangTokenType::StringLiteral ? '"' : '\'';
+      std::string_view value = token.value == CLangToken::NoValue
+                                   ? std::string_view()
+                                   : m_literals->Get(token.value);
+      constexpr std::string_view Controls = "\a\b\t\n\v\f\r";
+      constexpr std::string_view Escapes = "abtnvfr";
+      text.push_back(quote);
+      for (char c : value)
+      {
+        size_t control = Controls.find(c);
+        if (c == quote || c == '\\')
+        {
+          text.push_back('\\');
+          text.push_back(c);
+        }
+        else if (control != std::string_view::npos)
+        {
+          text.push_back('\\');
+          text.push_back(Escapes[control]);
+        }
+        else if (static_cast<unsigned char>(c) < 0x20 || c == 0x7f)
+        {
+          text.push_back('\\');
+          text.push_back(static_cast<char>('0' + ((c >> 6) & 7)));
+          text.push_back(static_cast<char>('0' + ((c >> 3) & 7)));
+          text.push_back(static_cast<char>('0' + (c & 7)));
+        }
+        else
+        {
+          text.push_back(c);
+        }
+      }
+      text.push_back(quote);
+      break;
+    }
+    default: {
+      std::string_view spelling = GetPunctuatorSpelling(token.type);
+      text.append(spelling.empty() ? GetKeywordSpelling(token.type)
+                                   : spelling);
+      break;
+    }
+    }
+  }
+
+  Preprocessor::Directive Preprocessor::ReadDirective()
+  {
+    Frame &frame = m_frames.back();
+    const TokenBuffer &tokens = frame.file->GetTokens();
+    Directive directive = {.start = frame.next,
+                           .end = frame.next + 1,
+                           .name = Identifier::None};
+    while (directive.end < tokens.GetSize() &&
+           !(tokens[directive.end].flags & CLangToken::StartOfLine))
+    {
+      directive.end += 1;
+    }
+
+    if (directive.start + 1 < directive.end)
+    {
+      switch (tokens.GetType(directive.start + 1))
+      {
+      case CLangTokenType::Identifier:
+        directive.name = GetIdentifier(directive.start + 1);
+        break;
+      case CLangTokenType::If:
+        directive.name = m_if;
+        break;
+      case CLangTokenType::Else:
+        directive.name = m_else;
+        break;
+      default:
+        break;
+      }
+    }
+
+    frame.next = directive.end;
+    return directive;
+  }
+
+  void Preprocessor::RunDirective(const Directive &directive)
+  {
+    Frame &frame = m_frames.back();
+    const TokenBuffer &tokens = frame.file->GetTokens();
+    Identifier name = directive.name;
+
+    // Only an `#if` or `#ifndef` can open the group of an include guard, and
+    // nothing may follow the group once it is closed.
+    if (frame.guardState == GuardState::Closed ||
+        (frame.guardState == GuardState::Start && name != m_if &&
+         name != m_ifndef))
+    {
+      frame.guardState = GuardState::None;
+    }
+
+    if (directive.start + 1 == directive.end)
+    {
+      // The null directive does nothing.
+    }
+    else if (name == m_include)
+    {
+      RunInclude(directive);
+    }
+    else if (name == m_define)
+    {
+      RunDefine(directive);
+    }
+    else if (name == m_undef)
+    {
+      Identifier macro = directive.start + 3 == directive.end
+                             ? GetIdentifier(directive.start + 2)
+                             : Identifier::None;
+      if (macro == Identifier::None)
+      {
+        Fail(DiagnosticId::MalformedDirective, directive.start,
+             directive.end);
+        return;
+      }
+      m_macros.Undefine(macro);
+    }
+    else if (name == m_ifdef || name == m_ifndef)
+    {
+      Identifier macro = directive.start + 3 == directive.end
+                             ? GetIdentifier(directive.start + 2)
+                             : Identifier::None;
+      if (macro == Identifier::None)
+      {
+        Fail(DiagnosticId::MalformedDirective, directive.start,
+             directive.end);
+      }
+      else if (name == m_ifndef && frame.guardState == GuardState::Start)
+      {
+        frame.guardState = GuardState::Open;
+        frame.guardMacro = macro;
+        frame.guardDepth = m_conditionals.size() + 1;
+      }
+      bool defined = m_macros.IsDefined(macro);
+      StartConditional(directive, macro != Identifier::None &&
+                                      defined == (name == m_ifdef));
+    }
+    else if (name == m_if)
+    {
+      if (frame.guardState == GuardState::Start)
+      {
+        // `#if !defined X` and `#if !defined(X)` guard a file as well.
+        size_t count = directive.end - directive.start;
+        bool parenthesized =
+            count == 7 &&
+            tokens.GetType(directive.start + 4) ==
+                CLangTokenType::LeftParenthesis &&
+            tokens.GetType(directive.start + 6) ==
+                CLangTokenType::RightParenthesis;
+        Identifier macro =
+            (count == 5 || parenthesized) &&
+                    tokens.GetType(directive.start + 2) ==
+                        CLangTokenType::Exclamation &&
+                    GetIdentifier(directive.start + 3) == m_defined
+                ? GetIdentifier(directive.start + count - 2)
+                : Identifier::None;
+        if (macro != Identifier::None)
+        {
+          frame.guardState = GuardState::Open;
+          frame.guardMacro = macro;
+          frame.guardDepth = m_conditionals.size() + 1;
+        }
+        else
+        {
+          frame.guardState = GuardState::None;
+        }
+      }
+      StartConditional(directive, EvaluateCondition(directive));
+    }
+    else if (name == m_elif || name == m_else)
+    {
+      // The group that ends here was taken, so every group after it is
+      // skipped.
+      if (m_conditionals.size() == frame.conditionalBase ||
+          m_conditionals.back().sawElse)
+      {
+        Fail(DiagnosticId::UnmatchedConditional, directive.start,
+             directive.end);
+        return;
+      }
+      if (frame.guardState == GuardState::Open &&
+          m_conditionals.size() == frame.guardDepth)
+      {
+        frame.guardState = GuardState::None;
+      }
+      m_conditionals.back().sawElse = name == m_else;
+      SkipGroup(true);
+    }
+    else if (name == m_endif)
+    {
+      if (m_conditionals.size() == frame.conditionalBase)
+      {
+        Fail(DiagnosticId::UnmatchedConditional, directive.start,
+             directive.end);
+        return;
+      }
+      EndConditional();
+    }
+    else if (name == m_pragma)
+    {
+      if (directive.start + 3 == directive.end &&
+          GetIdentifier(directive.start + 2) == m_once &&
+          !frame.path.empty())
+      {
+        m_onceFiles.insert(frame.path);
+      }
+    }
+    else if (name == m_error)
+    {
+      Fail(DiagnosticId::ErrorDirective, directive.start, directive.end);
+    }
+    else if (name != m_line && name != m_warning)
+    {
+      Fail(DiagnosticId::UnknownDirective, directive.start, directive.end);
+    }
+  }
+
+  void Preprocessor::RunInclude(const Directive &directive)
+  {
+    const Frame &frame = m_frames.back();
+    const TokenBuffer &tokens = frame.file->GetTokens();
+    std::string_view source = frame.file->GetSourceManager().GetSource();
+
+    // The name is taken from the source as written, since neither escape
+    // sequences nor the tokens between angle brackets mean anything in it.
+    std::optional<std::string_view> name;
+    bool angled = false;
+    size_t first = directive.start + 2;
+    if (first + 1 == directive.end &&
+        tokens.GetType(first) == CLangTokenType::StringLiteral &&
+        source[tokens.GetOffset(first)] == '"')
+    {
+      CLangToken token = tokens[first];
+      name = source.substr(token.offset + 1, token.length - 2);
+    }
+    else if (first + 1 < directive.end &&
+             tokens.GetType(first) == CLangTokenType::LessThan &&
+             tokens.GetType(directive.end - 1) ==
+                 CLangTokenType::GreaterThan)
+    {
+      uint32_t start = tokens.GetOffset(first) + 1;
+      name = source.substr(start, tokens.GetOffset(directive.end - 1) - start);
+      angled = true;
+    }
+    if (!name || name->empty())
+    {
+      Fail(DiagnosticId::MalformedDirective, directive.start, directive.end);
+      return;
+    }
+
+    const std::string &path = Resolve(*name, angled);
+    if (path.empty())
+    {
+      Fail(DiagnosticId::IncludeNotFound, directive.start, directive.end);
+      return;
+    }
+
+    auto guard = m_guards.find(path);
+    if (m_onceFiles.contains(path) ||
+        (guard != m_guards.end() && m_macros.IsDefined(guard->second)))
+    {
+      m_statistics.includesSkipped += 1;
+      return;
+    }
+
+    if (m_frames.size() >= MaximumIncludeDepth)
+    {
+      Fail(DiagnosticId::IncludeNestingTooDeep, directive.start,
+           directive.end);
+      return;
+    }
+
+    uint32_t includeOffset = frame.includeOffset == CLangToken::NoPosition
+                                 ? tokens.GetOffset(directive.start)
+                                 : frame.includeOffset;
+    try
+    {
+      Enter(path, includeOffset);
+    }
+    catch (const std::system_error &)
+    {
+      Fail(DiagnosticId::IncludeNotFound, directive.start, directive.end);
+    }
+  }
+
+  void Preprocessor::RunDefine(const Directive &directive)
+  {
+    const TokenBuffer &tokens = m_frames.back().file->GetTokens();
+    size_t index = directive.start + 2;
+    Identifier name =
+        index < directive.end ? GetIdentifier(index) : Identifier::None;
+    if (name == Identifier::None)
+    {
+      Fail(DiagnosticId::MalformedDirective, directive.start, directive.end);
+      return;
+    }
+    index += 1;
+
+    // A parenthesis right after the name opens a parameter list. One after
+    // whitespace starts the replacement list.
+    m_parameters.clear();
+    uint8_t flags = 0;
+    if (index < directive.end &&
+        tokens.GetType(index) == CLangTokenType::LeftParenthesis &&
+        !(tokens[index].flags & CLangToken::LeadingSpace))
+    {
+      flags = Macro::FunctionLike;
+      index += 1;
+      bool closed = index < directive.end &&
+                    tokens.GetType(index) == CLangTokenType::RightParenthesis;
+      index += closed ? 1 : 0;
+      while (!closed && index + 1 < directive.end)
+      {
+        CLangTokenType parameter = tokens.GetType(index++);
+        if (parameter == CLangTokenType::Variadic)
+        {
+          flags |= Macro::Variadic;
+        }
+        else if (parameter == CLangTokenType::Identifier)
+        {
+          m_parameters.push_back(GetIdentifier(index - 1));
+        }
+        else
+        {
+          break;
+        }
+
+        CLangTokenType separator = tokens.GetType(index++);
+        closed = separator == CLangTokenType::RightParenthesis;
+        if (!closed && (separator != CLangTokenType::Comma ||
+                        (flags & Macro::Variadic)))
+        {
+          break;
+        }
+      }
+      if (!closed)
+      {
+        Fail(DiagnosticId::MalformedDirective, directive.start,
+             directive.end);
+        return;
+      }
+    }
+
+    m_replacement.clear();
+    for (; index < directive.end; index++)
+    {
+      m_replacement.push_back(Relocate(tokens[index]));
+    }
+    m_macros.Define(name, m_parameters, m_replacement, flags);
+  }
+
+  void Preprocessor::StartConditional(const Directive &directive, bool taken)
+  {
+    m_conditionals.push_back({.start = directive.start, .sawElse = false});
+    if (!taken)
+    {
+      SkipGroup(false);
+    }
+  }
+
+  bool Preprocessor::EvaluateCondition(const Directive &directive)
+  {
+    // The operand of `defined`, parenthesized or not, names a macro rather
+    // than invoking it.
+    const TokenBuffer &tokens = m_frames.back().file->GetTokens();
+    m_condition.clear();
+    int operand = 0;
+    for (size_t i = directive.start + 2; i < directive.end; i++)
+    {
+      CLangToken token = Relocate(tokens[i]);
+      if (operand > 0 && token.type == CLangTokenType::Identifier)
+      {
+        token.flags |= CLangToken::NoExpand;
+        operand = 0;
+      }
+      else
+      {
+        operand = operand > 0 && token.type == CLangTokenType::LeftParenthesis
+                      ? operand - 1
+                      : 0;
+      }
+      if (token.GetIdentifier() == m_defined)
+      {
+        operand = 2;
+      }
+      m_condition.push_back(token);
+    }
+
+    m_expandedCondition.clear();
+    ExpandIsolated(PushArena(m_condition), m_expandedCondition);
+    ConditionParser parser(m_expandedCondition, *m_literals, m_macros,
+                           m_defined);
+    std::optional<bool> holds = parser.Parse();
+    if (!holds)
+    {
+      Fail(DiagnosticId::InvalidCondition, directive.start, directive.end);
+    }
+    return holds.value_or(false);
+  }
+
+  void Preprocessor::SkipGroup(bool taken)
+  {
+    Frame &frame = m_frames.back();
+    const TokenBuffer &tokens = frame.file->GetTokens();
+    size_t depth = 0;
+    while (frame.next < tokens.GetSize())
+    {
+      if (tokens.GetType(frame.next) != CLangTokenType::Preprocessor ||
+          !(tokens[frame.next].flags & CLangToken::StartOfLine))
+      {
+        frame.next += 1;
+        continue;
+      }
+
+      Directive directive = ReadDirective();
+      Identifier name = directive.name;
+      if (name == m_if || name == m_ifdef || name == m_ifndef)
+      {
+        depth += 1;
+      }
+      else if (name == m_endif)
+      {
+        if (depth == 0)
+        {
+          EndConditional();
+          return;
+        }
+        depth -= 1;
+      }
+      else if (depth == 0 && (name == m_elif || name == m_else))
+      {
+        if (frame.guardState == GuardState::Open &&
+            m_conditionals.size() == frame.guardDepth)
+        {
+          frame.guardState = GuardState::None;
+        }
+        if (m_conditionals.back().sawElse)
+        {
+          Fail(DiagnosticId::UnmatchedConditional, directive.start,
+               directive.end);
+        }
+        else if (name == m_else)
+        {
+          m_conditionals.back().sawElse = true;
+          if (!taken)
+          {
+            return;
+          }
+        }
+        else if (!taken && EvaluateCondition(directive))
+        {
+          return;
+        }
+      }
+    }
+  }
+
+  void Preprocessor::EndConditional()
+  {
+    Frame &frame = m_frames.back();
+    if (frame.guardState == GuardState::Open &&
+        m_conditionals.size() == frame.guardDepth)
+    {
+      frame.guardState = GuardState::Closed;
+    }
+    m_conditionals.pop_back();
+  }
+
+  void Preprocessor::Enter(const std::string &path, uint32_t includeOffset)
+  {
+    std::shared_ptr<const CLangLexer> file;
+    const Identifier *names = nullptr;
+    if (m_headerCache)
+    {
+      // A file's names are interned once however often it is entered.
+      file = m_headerCache->Get(path);
+      auto [entry, inserted] = m_cachedNames.try_emplace(file.get());
+      if (inserted)
+      {
+        const IdentifierTable &table = file->GetIdentifiers();
+        entry->second.file = file;
+        entry->second.names.reserve(table.GetCount());
+        for (uint32_t name = 0; name < table.GetCount(); name++)
+        {
+          std::string_view spelling =
+              table.GetName(static_cast<Identifier>(name));
+          entry->second.names.push_back(m_identifiers->Intern(spelling));
+        }
+      }
+      names = entry->second.names.data();
+      m_statistics.cachedFiles += 1;
+    }
+    else
+    {
+      auto lexer = std::make_shared<CLangLexer>(
+          std::make_unique<MappedFileScanner>(path), m_identifiers);
+      lexer->Tokenize();
+      file = std::move(lexer);
+    }
+
+    m_frames.push_back(
+        {.file = std::move(file),
+         .names = names,
+         .path = path,
+         .directory = std::filesystem::path(path).parent_path(),
+         .next = 0,
+         .includeOffset = includeOffset,
+         .conditionalBase = m_conditionals.size(),
+         .guardState = GuardState::Start,
+         .guardMacro = Identifier::None,
+         .guardDepth = 0});
+    m_statistics.filesEntered += 1;
+  }
+
+  void Preprocessor::Leave()
+  {
+    Frame &frame = m_frames.back();
+    while (m_conditionals.size() > frame.conditionalBase)
+    {
+      size_t start = m_conditionals.back().start;
+      Fail(DiagnosticId::UnterminatedConditional, start, start + 1);
+      m_conditionals.pop_back();
+    }
+
+    if (frame.guardState == GuardState::Closed)
+    {
+      m_guards.insert_or_assign(frame.path, frame.guardMacro);
+    }
+    m_frames.pop_back();
+  }
+
+  const std::string &Preprocessor::Resolve(std::string_view name, bool angled)
+  {
+    const std::filesystem::path &directory = m_frames.back().directory;
+    std::string key = angled ? std::string("<") : directory.string();
+    key.push_back('\0');
+    key.append(name);
+
+    auto [entry, inserted] = m_resolved.try_emplace(std::move(key));
+    if (!inserted)
+    {
+      return entry->second;
+    }
+
+    auto find = [&](const std::filesystem::path &base) {
+      std::error_code error;
+      std::filesystem::path candidate = base / name;
+      if (!std::filesystem::is_regular_file(candidate, error))
+      {
+        return false;
+      }
+      entry->second =
+          std::filesystem::weakly_canonical(candidate, error).string();
+      return !error;
+    };
+
+    if (angled || !find(directory))
+    {
+      for (const std::filesystem::path &base : m_includeDirectories)
+      {
+        if (find(base))
+        {
+          break;
+        }
+      }
+    }
+    return entry->second;
+  }
+
+  void Preprocessor::Fail(DiagnosticId id, size_t start, size_t end)
+  {
+    const Frame &frame = m_frames.back();
+    const TokenBuffer &tokens = frame.file->GetTokens();
+    CLangToken first = tokens[start];
+    CLangToken last = tokens[end - 1];
+    CLangToken token = {.type = CLangTokenType::Error,
+                        .flags = first.flags,
+                        .offset = first.offset,
+                        .length = last.offset + last.length - first.offset};
+    if (frame.includeOffset != CLangToken::NoPosition)
+    {
+      token.flags |= CLangToken::Relocated;
+      token.offset = frame.includeOffset;
+    }
+    token.value = m_diagnostics->Report(id, token.offset);
+    m_errors.push_back(token);
+  }
+
+  void Preprocessor::Fail(DiagnosticId id, const CLangToken &token)
+  {
+    if (m_caching)
+    {
+      m_cacheFailed = true;
+      return;
+    }
+    m_errors.push_back({.type = CLangTokenType::Error,
+                        .flags = token.flags,
+                        .offset = token.offset,
+                        .length = token.length,
+                        .value = m_diagnostics->Report(id, token.offset)});
+  }
+
+  CLangToken Preprocessor::Relocate(CLangToken token) const
+  {
+    const Frame &frame = m_frames.back();
+    const CLangLexer &file = *frame.file;
+    switch (token.type)
+    {
+    case CLangTokenType::IntegerConstant:
+    case CLangTokenType::FloatConstant:
+      token.value =
+          m_literals->AddNumber(file.GetLiterals().GetNumber(token.value));
+      break;
+    case CLangTokenType::CharacterConstant:
+    case CLangTokenType::StringLiteral:
+      if (token.value != CLangToken::NoValue)
+      {
+        token.value = m_literals->Add(file.GetLiterals().Get(token.value));
+      }
+      break;
+    case CLangTokenType::Identifier:
+      if (frame.names != nullptr)
+      {
+        token.value = static_cast<uint32_t>(frame.names[token.value]);
+      }
+      break;
+    case CLangTokenType::Error: {
+      Diagnostic diagnostic = file.GetDiagnostics().Get(token.value);
+      token.value = m_diagnostics->Report(
+          diagnostic.id, frame.includeOffset == CLangToken::NoPosition
+                             ? diagnostic.offset
+                             : frame.includeOffset);
+      break;
+    }
+    default:
+      break;
+    }
+
+    if (frame.includeOffset != CLangToken::NoPosition)
+    {
+      token.flags |= CLangToken::Relocated;
+      token.offset = frame.includeOffset;
+    }
+    return token;
+  }
+
+  Identifier Preprocessor::GetIdentifier(size_t index) const
+  {
+    const Frame &frame = m_frames.back();
+    Identifier name = frame.file->GetTokens()[index].GetIdentifier();
+    return frame.names == nullptr || name == Identifier::None
+               ? name
+               : frame.names[static_cast<uint32_t>(name)];
+  }
+} // namespace Vypr
@@ -0,0 +1,9 @@
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+namespace Vypr
+{
+  BufferScanner::BufferScanner(std::string_view source)
+  {
+    Reset(source);
+  }
+} // namespace Vypr
@@ -0,0 +1,196 @@
+#include "Vypr/Scanner/CharacterScan.hpp"
+
+#include <bit>
+#include <cstddef>
+#include <cstring>
+
+#include "Vypr/Scanner/CharacterClass.hpp"
+#include "Vypr/Util/Simd.hpp"
+
+namespace Vypr
+{
+  const char *FindNonWhitespace(const char *begin, const char *end)
+  {
+    // Most runs between tokens are a single space, so check the first
+    // character before paying for a vector load.
+    if (begin < end && !IsSpace(*begin))
+    {
+      return begin;
+    }
+
+#ifdef VYPR_SIMD
+    const Simd::Block space = Simd::Splat(' ');
+    const Simd::Block belowTab = Simd::Splat('\t' - 1);
+    const Simd::Block aboveReturn = Simd::Splat('\r' + 1);
+    for (; end - begin >= static_cast<std::ptrdiff_t>(sizeof(Simd::Block));
+         begin += sizeof(Simd::Block))
+    {
+      Simd::Block block = Simd::Load(begin);
+      Simd::Block control = Simd::And(Simd::Greater(block, belowTab),
+                                      Simd::Greater(aboveReturn, block));
+      uint32_t whitespace =
+          Simd::Mask(Simd::Or(Simd::Equal(block, space), control));
+      if (whitespace != Simd::FullMask)
+      {
+        return begin + std::countr_one(whitespace);
+      }
+    }
+#endif
+
+    while (begin < end && IsSpace(*begin))
+    {
+      begin += 1;
+    }
+    return begin;
+  }
+
+  const char *FindCharacter(const char *begin, const char *end,
+                            char character)
+  {
+    // memchr is already vectorized by every C library worth targeting.
+    const void *found =
+        std::memchr(begin, character, static_cast<size_t>(end - begin));
+    return found == nullptr ? end : static_cast<const char *>(found);
+  }
+
+  const char *FindAny(const char *begin, const char *end, char first,
+                      char second)
+  {
+#ifdef VYPR_SIMD
+    const Simd::Block firstBlock = Simd::Splat(first);
+    const Simd::Block secondBlock = Simd::Splat(second);
+    for (; end - begin >= static_cast<std::ptrdiff_t>(sizeof(Simd::Block));
+         begin += sizeof(Simd::Block))
+    {
+      Simd::Block block = Simd::Load(begin);
+      uint32_t found = Simd::Mask(Simd::Or(Simd::Equal(block, firstBlock),
+                                           Simd::Equal(block, secondBlock)));
+      if (found != 0)
+      {
+        return begin + std::countr_zero(found);
+      }
+    }
+#endif
+
+    for (; begin < end; begin += 1)
+    {
+      if (*begin == first || *begin == second)
+      {
+        return begin;
+      }
+    }
+    return end;
+  }
+
+  const char *FindAny(const char *begin, const char *end, char first,
+                      char second, char third)
+  {
+#ifdef VYPR_SIMD
+    const Simd::Block firstBlock = Simd::Splat(first);
+    const Simd::Block secondBlock = Simd::Splat(second);
+    const Simd::Block thirdBlock = Simd::Splat(third);
+    for (; end - begin >= static_cast<std::ptrdiff_t>(sizeof(Simd::Block));
+         begin += sizeof(Simd::Block))
+    {
+      Simd::Block block = Simd::Load(begin);
+      uint32_t found = Simd::Mask(
+          Simd::Or(Simd::Or(Simd::Equal(block, firstBlock),
+                            Simd::Equal(block, secondBlock)),
+                   Simd::Equal(block, thirdBlock)));
+      if (found != 0)
+      {
+        return begin + std::countr_zero(found);
+      }
+    }
+#endif
+
+    for (; begin < end; begin += 1)
+    {
+      if (*begin == first || *begin == second || *begin == third)
+      {
+        return begin;
+      }
+    }
+    return end;
+  }
+
+  const char *FindPair(const char *begin, const char *end, char first,
+                       char second)
+  {
+#ifdef VYPR_SIMD
+    const Simd::Block firstBlock = Simd::Splat(first);
+    const Simd::Block secondBlock = Simd::Splat(second);
+    // Each iteration also reads the byte after the block for the second half
+    // of a pair that straddles two blocks.
+    for (; end - begin > static_cast<std::ptrdiff_t>(sizeof(Simd::Block));
+         begin += sizeof(Simd::Block))
+    {
+      uint32_t pairs = Simd::Mask(
+          Simd::And(Simd::Equal(Simd::Load(begin), firstBlock),
+                    Simd::Equal(Simd::Load(begin + 1), secondBlock)));
+      if (pairs != 0)
+      {
+        return begin + std::countr_zero(pairs);
+      }
+    }
+#endif
+
+    for (; end - begin >= 2; begin += 1)
+    {
+      if (begin[0] == first && begin[1] == second)
+      {
+        return begin;
+      }
+    }
+    return end;
+  }
+
+  const char *FindIdentifierEnd(const char *begin, const char *end)
+  {
+#ifdef VYPR_SIMD
+    const Simd::Block caseBit = Simd::Splat(0x20);
+    const Simd::Block belowA = Simd::Splat('a' - 1);
+    const Simd::Block aboveZ = Simd::Splat('z' + 1);
+    const Simd::Block belowZero = Simd::Splat('0' - 1);
+    const Simd::Block aboveNine = Simd::Splat('9' + 1);
+    const Simd::Block underscore = Simd::Splat('_');
+    const Simd::Block zero = Simd::Splat(0);
+#endif
+
+    while (begin < end)
+    {
+#ifdef VYPR_SIMD
+      if (end - begin >= static_cast<std::ptrdiff_t>(sizeof(Simd::Block)))
+      {
+        Simd::Block block = Simd::Load(begin);
+        // Setting the case bit folds A-Z onto a-z without folding any other
+        // byte into that range.
+        Simd::Block lower = Simd::Or(block, caseBit);
+        Simd::Block letters = Simd::And(Simd::Greater(lower, belowA),
+                                        Simd::Greater(aboveZ, lower));
+        Simd::Block digits = Simd::And(Simd::Greater(block, belowZero),
+                                       Simd::Greater(aboveNine, block));
+        // Non-ASCII bytes are negative as signed bytes.
+        Simd::Block other = Simd::Or(Simd::Equal(block, underscore),
+                                     Simd::Greater(zero, block));
+        uint32_t identifier =
+            Simd::Mask(Simd::Or(Simd::Or(letters, digits), other));
+        if (identifier == Simd::FullMask)
+        {
+          begin += sizeof(Simd::Block);
+          continue;
+        }
+        begin += std::countr_one(identifier);
+      }
+#endif
+
+      // Rarer identifier bytes such as `$` and the scalar tail.
+      if (!IsIdentifier(*begin))
+      {
+        return begin;
+      }
+      begin += 1;
+    }
+    return end;
+  }
+} // namespace Vypr
@@ -0,0 +1,134 @@
+#include "Vypr/Scanner/MappedFileScanner.hpp"
+
+#include <system_error>
+
+#include "Vypr/Scanner/SourceManager.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Vypr
+{
+  namespace
+  {
+    [[noreturn]] void ThrowMappingError(const std::filesystem::path &path)
+    {
+#ifdef _WIN32
+      int error = static_cast<int>(GetLastError());
+      const std::error_category &category = std::system_category();
+#else
+      int error = errno;
+      const std::error_category &category = std::generic_category();
+#endif
+      throw std::system_error(error, category,
+                              "Unable to map " + path.string());
+    }
+
+    [[noreturn]] void ThrowSizeError(const std::filesystem::path &path)
+    {
+      throw std::system_error(std::make_error_code(std::errc::file_too_large),
+                              "Unable to map " + path.string());
+    }
+  } // namespace
+
+  MappedFileScanner::MappedFileScanner(const std::filesystem::path &path)
+      : m_mapping(nullptr), m_size(0)
+  {
+#ifdef _WIN32
+    HANDLE file =
+        CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                    OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      ThrowMappingError(path);
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+      CloseHandle(file);
+      ThrowMappingError(path);
+    }
+    if (static_cast<uint64_t>(size.QuadPart) > SourceManager::MaxSize)
+    {
+      CloseHandle(file);
+      ThrowSizeError(path);
+    }
+    m_size = static_cast<size_t>(size.QuadPart);
+
+    if (m_size > 0)
+    {
+      HANDLE mapping =
+          CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      if (mapping != nullptr)
+      {
+        m_mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+
+    if (m_size > 0 && m_mapping == nullptr)
+    {
+      ThrowMappingError(path);
+    }
+#else
+    int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0)
+    {
+      ThrowMappingError(path);
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0)
+    {
+      close(file);
+      ThrowMappingError(path);
+    }
+    if (static_cast<uint64_t>(status.st_size) > SourceManager::MaxSize)
+    {
+      close(file);
+      ThrowSizeError(path);
+    }
+    m_size = static_cast<size_t>(status.st_size);
+
+    // Mapping an empty file is an error so empty files are left unmapped.
+    if (m_size > 0)
+    {
+      void *mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, file, 0);
+      if (mapping == MAP_FAILED)
+      {
+        close(file);
+        ThrowMappingError(path);
+      }
+      m_mapping = mapping;
+      madvise(m_mapping, m_size, MADV_SEQUENTIAL);
+    }
+    close(file);
+#endif
+
+    Reset({static_cast<const char *>(m_mapping), m_size});
+  }
+
+  MappedFileScanner::~MappedFileScanner()
+  {
+    if (m_mapping == nullptr)
+    {
+      return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(m_mapping);
+#else
+    munmap(m_mapping, m_size);
+#endif
+  }
+} // namespace Vypr
@@ -2,58 +2,50 @@
 
 namespace Vypr
 {
-  Scanner::Scanner() : m_column(1), m_line(1)
+  Scanner::Scanner()
+      : m_window(nullptr), m_cursor(nullptr), m_end(nullptr), m_windowOffset(0),
+        m_markedOffset(SourceManager::NoOffset), m_markCount(0)
   {
   }
 
-  std::wstring Scanner::NextWhile(bool (*condition)(wchar_t))
+  void Scanner::Reset(std::string_view source)
   {
-    std::wstring buffer;
-    while (!Finished() && condition(LookAhead(0)))
-    {
-      buffer += Next();
-    }
-    return buffer;
+    m_window = source.data();
+    m_cursor = source.data();
+    m_end = source.data() + source.size();
+    m_windowOffset = 0;
+    m_markedOffset = SourceManager::NoOffset;
+    m_markCount = 0;
+    m_sourceManager.Reset(source);
   }
 
-  wchar_t Scanner::Next()
+  bool Scanner::Refill(size_t)
   {
-    if (Finished())
-    {
-      return std::char_traits<wchar_t>::eof();
-    }
+    return false;
+  }
 
-    wchar_t nextCharacter = NextInternal();
-    if (nextCharacter == '\n')
-    {
-      m_line += 1;
-      m_column = 1;
-    }
-    else
+  std::string_view Scanner::GetRetained() const
+  {
+    const char *retained = m_cursor;
+    if (m_markedOffset < GetOffset())
     {
-      m_column += 1;
+      retained = m_window + (m_markedOffset - m_windowOffset);
     }
-    return nextCharacter;
+    return {retained, static_cast<size_t>(m_end - retained)};
   }
 
-  std::wstring Scanner::Next(size_t length)
+  void Scanner::SetWindow(std::string_view window)
   {
-    std::wstring buffer;
-    while (!Finished() && length > 0)
-    {
-      buffer += Next();
-      length -= 1;
-    }
-    return buffer;
+    const char *retained = GetRetained().data();
+    size_t cursor = static_cast<size_t>(m_cursor - retained);
+    m_windowOffset += static_cast<uint32_t>(retained - m_window);
+    m_window = window.data();
+    m_cursor = window.data() + cursor;
+    m_end = window.data() + window.size();
   }
 
-  std::wstring Scanner::LookAhead(int step, int length) const
+  void Scanner::AppendSource(std::string_view characters)
   {
-    std::wstring buffer;
-    for (int i = 0; i < length; i++)
-    {
-      buffer += LookAhead(step + i);
-    }
-    return buffer;
+    m_sourceManager.Append(characters);
   }
-} // namespace Vypr
\ No newline at end of file
+} // namespace Vypr
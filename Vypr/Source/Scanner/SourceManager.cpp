@@ -0,0 +1,94 @@
+#include "Vypr/Scanner/SourceManager.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <system_error>
+
+#include "Vypr/Util/Simd.hpp"
+
+namespace Vypr
+{
+  SourceManager::SourceManager(std::string_view source)
+      : m_source(source), m_size(static_cast<uint32_t>(source.size()))
+  {
+  }
+
+  void SourceManager::Reset(std::string_view source)
+  {
+    m_source = source;
+    m_size = static_cast<uint32_t>(source.size());
+    m_lineStarts.clear();
+  }
+
+  void SourceManager::Append(std::string_view characters)
+  {
+    if (characters.size() > MaxSize - m_size)
+    {
+      throw std::system_error(std::make_error_code(std::errc::file_too_large),
+                              "Unable to read source");
+    }
+    if (m_lineStarts.empty())
+    {
+      m_lineStarts.push_back(0);
+    }
+    AddLineStarts(characters, m_size);
+    m_size += static_cast<uint32_t>(characters.size());
+  }
+
+  SourceLocation SourceManager::GetLocation(uint32_t offset) const
+  {
+    if (m_lineStarts.empty())
+    {
+      BuildLineTable();
+    }
+
+    offset = std::min(offset, m_size);
+    auto lineStart =
+        std::upper_bound(m_lineStarts.begin(), m_lineStarts.end(), offset) - 1;
+    return {.line = static_cast<size_t>(lineStart - m_lineStarts.begin()) + 1,
+            .column = static_cast<size_t>(offset - *lineStart) + 1};
+  }
+
+  void SourceManager::BuildLineTable() const
+  {
+    m_lineStarts.push_back(0);
+    AddLineStarts(m_source, 0);
+  }
+
+  void SourceManager::AddLineStarts(std::string_view characters,
+                                    uint32_t offset) const
+  {
+    const char *data = characters.data();
+    size_t size = characters.size();
+    size_t index = 0;
+
+#ifdef VYPR_SIMD
+    const Simd::Block newline = Simd::Splat('\n');
+    for (; index + sizeof(Simd::Block) <= size; index += sizeof(Simd::Block))
+    {
+      uint32_t mask =
+          Simd::Mask(Simd::Equal(Simd::Load(data + index), newline));
+      while (mask != 0)
+      {
+        size_t lineStart = index + std::countr_zero(mask) + 1;
+        m_lineStarts.push_back(offset + static_cast<uint32_t>(lineStart));
+        mask &= mask - 1;
+      }
+    }
+#endif
+
+    // Tail of the vector loop, or the whole buffer on targets without it.
+    while (index < size)
+    {
+      const void *newline = std::memchr(data + index, '\n', size - index);
+      if (newline == nullptr)
+      {
+        break;
+      }
+      index = static_cast<size_t>(static_cast<const char *>(newline) - data);
+      index += 1;
+      m_lineStarts.push_back(offset + static_cast<uint32_t>(index));
+    }
+  }
+} // namespace Vypr
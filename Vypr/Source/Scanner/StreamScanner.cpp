@@ -0,0 +1,94 @@
+#include "Vypr/Scanner/StreamScanner.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace Vypr
+{
+  namespace
+  {
+    /// @returns Number of characters read, zero at the end of the stream or
+    /// negative on error.
+    long ReadSome(int fileDescriptor, char *buffer, size_t size)
+    {
+#ifdef _WIN32
+      return _read(fileDescriptor, buffer,
+                   static_cast<unsigned>(std::min<size_t>(size, INT_MAX)));
+#else
+      return static_cast<long>(read(fileDescriptor, buffer, size));
+#endif
+    }
+  } // namespace
+
+  StreamScanner::StreamScanner(int fileDescriptor, size_t chunkSize)
+      : m_fileDescriptor(fileDescriptor), m_finished(false),
+        m_capacity(std::max<size_t>(chunkSize, 1)),
+        m_buffer(std::make_unique<char[]>(m_capacity))
+  {
+    Reset(std::string_view());
+  }
+
+  bool StreamScanner::Refill(size_t minimum)
+  {
+    // Characters before the cursor are kept while a mark refers to them.
+    std::string_view retained = GetRetained();
+    size_t marked = retained.size() - GetUnconsumed().size();
+    size_t filled = retained.size();
+    if (m_finished)
+    {
+      return filled - marked >= minimum;
+    }
+
+    if (filled > 0)
+    {
+      std::memmove(m_buffer.get(), retained.data(), filled);
+    }
+    SetWindow({m_buffer.get(), filled});
+
+    while (filled - marked < minimum)
+    {
+      if (filled == m_capacity)
+      {
+        // A single token, or the characters after a mark, do not fit in the
+        // buffer.
+        auto grown = std::make_unique<char[]>(m_capacity * 2);
+        std::memcpy(grown.get(), m_buffer.get(), filled);
+        SetWindow({grown.get(), filled});
+        m_buffer = std::move(grown);
+        m_capacity *= 2;
+      }
+
+      long count = ReadSome(m_fileDescriptor, m_buffer.get() + filled,
+                            m_capacity - filled);
+      if (count < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        throw std::system_error(errno, std::generic_category(),
+                                "Unable to read source");
+      }
+      if (count == 0)
+      {
+        m_finished = true;
+        break;
+      }
+
+      AppendSource({m_buffer.get() + filled, static_cast<size_t>(count)});
+      filled += static_cast<size_t>(count);
+    }
+
+    SetWindow({m_buffer.get(), filled});
+    return filled - marked >= minimum;
+  }
+} // namespace Vypr
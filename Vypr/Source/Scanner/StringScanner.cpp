@@ -2,27 +2,8 @@
 
 namespace Vypr
 {
-  StringScanner::StringScanner(std::wstring source)
-      : m_buffer(source), m_index(0)
+  StringScanner::StringScanner(std::string source) : m_source(std::move(source))
   {
+    Reset(m_source);
   }
-
-  wchar_t StringScanner::NextInternal()
-  {
-    return m_buffer[m_index++];
-  }
-
-  wchar_t StringScanner::LookAhead(int stepSize) const
-  {
-    if (m_index + stepSize >= m_buffer.size())
-    {
-      return std::char_traits<wchar_t>::eof();
-    }
-    return m_buffer[m_index + stepSize];
-  }
-
-  bool StringScanner::Finished()
-  {
-    return m_index >= m_buffer.size();
-  }
-} // namespace Vypr
\ No newline at end of file
+} // namespace Vypr
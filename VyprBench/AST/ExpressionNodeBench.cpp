@@ -0,0 +1,176 @@
+#include <benchmark/benchmark.h>
+#include <iterator>
+#include <memory>
+#include <string>
+
+#include "CorpusGenerator.hpp"
+#include "Vypr/AST/Expression/ExpressionNode.hpp"
+#include "Vypr/AST/Type/IntegralType.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+namespace ExpressionNodeBench
+{
+  /// @brief How the parser's lexer produces tokens.
+  enum class LexMode
+  {
+    /// @brief Tokens are lexed on demand on the parsing thread.
+    Lexing,
+
+    /// @brief The corpus is lexed up front and only parsing is timed.
+    Tokenized,
+
+    /// @brief Tokens are lexed ahead on a thread of their own.
+    Pipelined
+  };
+
+  /// @brief Parses every statement of a generated corpus. Arguments are the
+  /// literal ratio in percent, the expression depth and the corpus size in
+  /// MiB. Wall time is measured so that pipelined runs, whose lexing leaves
+  /// the calling thread, compare with the others.
+  void Parse(benchmark::State &state, LexMode mode)
+  {
+    VyprBench::CorpusOptions options;
+    options.size = static_cast<size_t>(state.range(2)) << 20;
+    options.commentDensity = 0.1;
+    options.literalRatio = static_cast<double>(state.range(0)) / 100.0;
+    options.expressionDepth = static_cast<int>(state.range(1));
+    VyprBench::Corpus corpus = VyprBench::GenerateCorpus(options);
+
+    auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+    Vypr::TypeTable typeTable;
+    for (const std::string &variable : corpus.variables)
+    {
+      typeTable.AddSymbol(identifiers->Intern(variable),
+                          std::make_shared<Vypr::IntegralType>(
+                              Vypr::Integral::Int, false, false, true));
+    }
+
+    for (auto _ : state)
+    {
+      Vypr::CLangLexer lexer(
+          std::make_unique<Vypr::BufferScanner>(corpus.source), identifiers);
+      if (mode == LexMode::Tokenized)
+      {
+        state.PauseTiming();
+        lexer.Tokenize();
+        state.ResumeTiming();
+      }
+      else if (mode == LexMode::Pipelined)
+      {
+        lexer.StartPipeline();
+      }
+      while (lexer.PeekToken().type != Vypr::CLangTokenType::NoToken)
+      {
+        auto expression = Vypr::ExpressionNode::Parse(lexer, typeTable);
+        benchmark::DoNotOptimize(expression);
+        lexer.GetToken();
+      }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(corpus.source.size()));
+    state.counters["nodes"] = benchmark::Counter(
+        static_cast<double>(corpus.nodes),
+        benchmark::Counter::kIsIterationInvariantRate);
+  }
+  BENCHMARK_CAPTURE(Parse, Lexing, LexMode::Lexing)
+      ->ArgNames({"literals", "depth", "MiB"})
+      ->Args({30, 4, 1})
+      ->Args({90, 4, 1})
+      ->Args({30, 10, 1})
+      ->Args({30, 4, 16})
+      ->UseRealTime();
+  BENCHMARK_CAPTURE(Parse, Tokenized, LexMode::Tokenized)
+      ->ArgNames({"literals", "depth", "MiB"})
+      ->Args({30, 4, 1})
+      ->Args({90, 4, 1})
+      ->Args({30, 10, 1})
+      ->UseRealTime();
+  BENCHMARK_CAPTURE(Parse, Pipelined, LexMode::Pipelined)
+      ->ArgNames({"literals", "depth", "MiB"})
+      ->Args({30, 4, 1})
+      ->Args({90, 4, 1})
+      ->Args({30, 10, 1})
+      ->Args({30, 4, 16})
+      ->UseRealTime();
+
+  /// @brief Parses 1 MiB of statements that are each a single constant, as
+  /// in large lookup tables, so that converting the constants dominates.
+  void ParseConstants(benchmark::State &state)
+  {
+    static constexpr const char *Constants[] = {
+        "0",          "7",          "42",         "255",
+        "65535",      "1000000",    "2147483647", "4294967295u",
+        "123456789l", "0x7F",       "0xFFFF",     "0xDEADBEEF",
+        "0x7FFFFFFFFFFFFFFFll",     "0777",       "0b101101",
+        "18446744073709551615ull",  "0.5",        "3.14159265358979",
+        "1e-5f",      "6.02214076e23",            "0x1.8p3",
+        "2.5f"};
+
+    std::string source;
+    for (size_t i = 0; source.size() < (1 << 20); i++)
+    {
+      source += Constants[i % std::size(Constants)];
+      source += ";\n";
+    }
+
+    auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+    Vypr::TypeTable typeTable;
+    for (auto _ : state)
+    {
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::BufferScanner>(source),
+                             identifiers);
+      while (lexer.PeekToken().type != Vypr::CLangTokenType::NoToken)
+      {
+        auto expression = Vypr::ExpressionNode::Parse(lexer, typeTable);
+        benchmark::DoNotOptimize(expression);
+        lexer.GetToken();
+      }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(source.size()));
+  }
+  BENCHMARK(ParseConstants);
+
+  /// @brief Parses 1 MiB of string tables, each a run of adjacent string
+  /// literals that are mostly plain text with an occasional escape.
+  void ParseStrings(benchmark::State &state)
+  {
+    static constexpr const char *Pieces[] = {
+        "\"Usage: vypr [options] file...\\n\"",
+        "\"  -o <file>      Write the output to <file>\\n\"",
+        "\"  -I <dir>       Add <dir> to the include search path\\n\"",
+        "\"\\tTab separated\\tcolumns \\x41\\101 \\u00e9 caf\xC3\xA9\"",
+        "\"A long line of help text without any escape sequence in it\""};
+
+    std::string source;
+    for (size_t i = 0; source.size() < (1 << 20); i++)
+    {
+      for (size_t piece = 0; piece < 8; piece++)
+      {
+        source += Pieces[(i + piece) % std::size(Pieces)];
+        source += "\n    ";
+      }
+      source += ";\n";
+    }
+
+    auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+    Vypr::TypeTable typeTable;
+    for (auto _ : state)
+    {
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::BufferScanner>(source),
+                             identifiers);
+      while (lexer.PeekToken().type != Vypr::CLangTokenType::NoToken)
+      {
+        auto expression = Vypr::ExpressionNode::Parse(lexer, typeTable);
+        benchmark::DoNotOptimize(expression);
+        lexer.GetToken();
+      }
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(source.size()));
+  }
+  BENCHMARK(ParseStrings);
+} // namespace ExpressionNodeBench
@@ -0,0 +1,53 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+  std::atomic<size_t> allocations = 0;
+} // namespace
+
+namespace VyprBench
+{
+  size_t AllocationCount()
+  {
+    return allocations.load(std::memory_order_relaxed);
+  }
+} // namespace VyprBench
+
+void *operator new(size_t size)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *memory = std::malloc(size == 0 ? 1 : size))
+  {
+    return memory;
+  }
+  throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete(void *memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete[](void *memory) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+  std::free(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept
+{
+  std::free(memory);
+}
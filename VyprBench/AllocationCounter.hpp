@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstddef>
+
+namespace VyprBench
+{
+  /// @returns Number of calls to global `operator new` made by the process so
+  /// far.
+  size_t AllocationCount();
+} // namespace VyprBench
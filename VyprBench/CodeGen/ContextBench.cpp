@@ -0,0 +1,158 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <llvm/Support/TargetSelect.h>
+#include <memory>
+#include <vector>
+
+#include "CorpusGenerator.hpp"
+#include "Vypr/AST/Expression/ExpressionNode.hpp"
+#include "Vypr/AST/Type/IntegralType.hpp"
+#include "Vypr/CodeGen/Context.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+namespace ContextBench
+{
+  /// @brief Expressions parsed from a generated corpus.
+  struct ParsedCorpus
+  {
+    VyprBench::Corpus corpus;
+    std::shared_ptr<Vypr::IdentifierTable> identifiers;
+    std::vector<std::unique_ptr<Vypr::ExpressionNode>> expressions;
+  };
+
+  ParsedCorpus ParseCorpus(size_t size, int expressionDepth)
+  {
+    VyprBench::CorpusOptions options;
+    options.size = size;
+    options.commentDensity = 0.0;
+    options.expressionDepth = expressionDepth;
+
+    ParsedCorpus parsed = {
+        .corpus = VyprBench::GenerateCorpus(options),
+        .identifiers = std::make_shared<Vypr::IdentifierTable>()};
+
+    Vypr::TypeTable typeTable;
+    for (const std::string &variable : parsed.corpus.variables)
+    {
+      typeTable.AddSymbol(parsed.identifiers->Intern(variable),
+                          std::make_shared<Vypr::IntegralType>(
+                              Vypr::Integral::Int, false, false, true));
+    }
+
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::BufferScanner>(parsed.corpus.source),
+        parsed.identifiers);
+    while (lexer.PeekToken().type != Vypr::CLangTokenType::NoToken)
+    {
+      parsed.expressions.push_back(
+          Vypr::ExpressionNode::Parse(lexer, typeTable));
+      lexer.GetToken();
+    }
+    return parsed;
+  }
+
+  /// @brief Declares the corpus variables as globals and opens a function for
+  /// the expressions to be generated into.
+  llvm::Function *BeginFunction(Vypr::Context &context,
+                                const ParsedCorpus &parsed)
+  {
+    llvm::Function *function = llvm::Function::Create(
+        llvm::FunctionType::get(context.builder.getVoidTy(), false),
+        llvm::Function::ExternalLinkage, "BenchFunction", context.module);
+    context.builder.SetInsertPoint(
+        llvm::BasicBlock::Create(context.context, "entry", function));
+
+    for (const std::string &variable : parsed.corpus.variables)
+    {
+      llvm::GlobalVariable *global = new llvm::GlobalVariable(
+          context.module, context.builder.getInt32Ty(), false,
+          llvm::GlobalValue::ExternalLinkage, context.builder.getInt32(0),
+          variable);
+      context.symbolTable.AddSymbol(parsed.identifiers->Intern(variable),
+                                    global);
+    }
+    return function;
+  }
+
+  void GenerateExpressions(Vypr::Context &context, const ParsedCorpus &parsed)
+  {
+    for (const auto &expression : parsed.expressions)
+    {
+      benchmark::DoNotOptimize(expression->GenerateCode(context));
+    }
+    context.builder.CreateRetVoid();
+  }
+
+  /// @brief Generates IR for the expressions of a generated corpus of 256 KiB.
+  /// The argument is the expression depth.
+  void GenerateCode(benchmark::State &state)
+  {
+    ParsedCorpus parsed =
+        ParseCorpus(256 << 10, static_cast<int>(state.range(0)));
+
+    size_t instructions = 0;
+    for (auto _ : state)
+    {
+      state.PauseTiming();
+      auto context = std::make_unique<Vypr::Context>("bench");
+      llvm::Function *function = BeginFunction(*context, parsed);
+      state.ResumeTiming();
+
+      GenerateExpressions(*context, parsed);
+
+      state.PauseTiming();
+      instructions += function->getInstructionCount();
+      context.reset();
+      state.ResumeTiming();
+    }
+
+    state.counters["instructions"] = benchmark::Counter(
+        static_cast<double>(instructions), benchmark::Counter::kIsRate);
+    state.counters["nodes"] = benchmark::Counter(
+        static_cast<double>(parsed.corpus.nodes),
+        benchmark::Counter::kIsIterationInvariantRate);
+  }
+  BENCHMARK(GenerateCode)->ArgName("depth")->Arg(4)->Arg(10);
+
+  /// @brief Emits an object file for the IR of a generated corpus of 64 KiB.
+  /// The argument is the expression depth.
+  void GenerateObjectFile(benchmark::State &state)
+  {
+    static bool initialized = [] {
+      llvm::InitializeNativeTarget();
+      llvm::InitializeNativeTargetAsmPrinter();
+      return true;
+    }();
+    benchmark::DoNotOptimize(initialized);
+
+    ParsedCorpus parsed =
+        ParseCorpus(64 << 10, static_cast<int>(state.range(0)));
+    std::filesystem::path path =
+        std::filesystem::temp_directory_path() / "vyprbench.o";
+
+    size_t instructions = 0;
+    for (auto _ : state)
+    {
+      state.PauseTiming();
+      auto context = std::make_unique<Vypr::Context>("bench");
+      llvm::Function *function = BeginFunction(*context, parsed);
+      GenerateExpressions(*context, parsed);
+      instructions += function->getInstructionCount();
+      state.ResumeTiming();
+
+      context->GenerateObjectFile(path.string());
+
+      state.PauseTiming();
+      context.reset();
+      state.ResumeTiming();
+    }
+    std::filesystem::remove(path);
+
+    state.counters["instructions"] = benchmark::Counter(
+        static_cast<double>(instructions), benchmark::Counter::kIsRate);
+  }
+  BENCHMARK(GenerateObjectFile)
+      ->ArgName("depth")
+      ->Arg(4)
+      ->Unit(benchmark::kMillisecond);
+} // namespace ContextBench
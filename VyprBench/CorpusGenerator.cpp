@@ -0,0 +1,149 @@
+#include "CorpusGenerator.hpp"
+
+#include <array>
+#include <random>
+#include <string_view>
+
+namespace VyprBench
+{
+  namespace
+  {
+    constexpr size_t VariableCount = 16;
+
+    constexpr std::array<std::string_view, 8> BinaryOperators = {
+        " + ", " - ", " * ", " < ", " >= ", " == ", " != ", " + "};
+
+    constexpr std::array<std::string_view, 4> CommentWords = {
+        "accumulate", "the running", "total before", "scaling it"};
+
+    class Generator
+    {
+    public:
+      Generator(const CorpusOptions &options, Corpus &corpus)
+          : m_options(options), m_corpus(corpus), m_random(options.seed)
+      {
+      }
+
+      void AppendVariables()
+      {
+        constexpr std::string_view Padding = "_abcdefghijklmnopqrstuvwxyz";
+        for (size_t i = 0; i < VariableCount; i++)
+        {
+          std::string name = "v" + std::to_string(i);
+          while (name.size() < m_options.identifierLength)
+          {
+            name += Padding[name.size() % Padding.size()];
+          }
+          m_corpus.variables.push_back(std::move(name));
+        }
+      }
+
+      void AppendStatement()
+      {
+        if (Chance(m_options.commentDensity))
+        {
+          AppendComment();
+        }
+        AppendExpression(m_options.expressionDepth);
+        m_corpus.source += ";\n";
+        m_corpus.statements += 1;
+      }
+
+    private:
+      bool Chance(double probability)
+      {
+        return std::uniform_real_distribution<double>()(m_random) <
+               probability;
+      }
+
+      size_t Pick(size_t count)
+      {
+        return std::uniform_int_distribution<size_t>(0, count - 1)(m_random);
+      }
+
+      void AppendComment()
+      {
+        bool block = Chance(0.5);
+        m_corpus.source += block ? "/* " : "// ";
+        size_t words = 4 + Pick(8);
+        for (size_t i = 0; i < words; i++)
+        {
+          m_corpus.source += CommentWords[Pick(CommentWords.size())];
+          m_corpus.source += ' ';
+        }
+        m_corpus.source += block ? "*/\n" : "\n";
+      }
+
+      void AppendExpression(int depth)
+      {
+        m_corpus.nodes += 1;
+        if (depth <= 0 || Chance(0.15))
+        {
+          AppendOperand();
+          return;
+        }
+
+        bool group = Chance(0.3);
+        if (group)
+        {
+          m_corpus.source += '(';
+        }
+        AppendExpression(depth - 1);
+        m_corpus.source += BinaryOperators[Pick(BinaryOperators.size())];
+        AppendExpression(depth - 1);
+        if (group)
+        {
+          m_corpus.source += ')';
+        }
+      }
+
+      void AppendOperand()
+      {
+        if (!Chance(m_options.literalRatio))
+        {
+          m_corpus.source += m_corpus.variables[Pick(VariableCount)];
+          return;
+        }
+
+        const LiteralMix &mix = m_options.literals;
+        unsigned total =
+            mix.integer + mix.floating + mix.character + mix.string;
+        unsigned pick = static_cast<unsigned>(Pick(total == 0 ? 1 : total));
+        if (pick < mix.integer || total == 0)
+        {
+          m_corpus.source += Pick(4) == 0 ? "0x1F" : std::to_string(Pick(1000));
+        }
+        else if (pick < mix.integer + mix.floating)
+        {
+          m_corpus.source += std::to_string(Pick(100)) + ".5f";
+        }
+        else if (pick < mix.integer + mix.floating + mix.character)
+        {
+          m_corpus.source += Pick(4) == 0 ? "'\\n'" : "'c'";
+        }
+        else
+        {
+          m_corpus.source += "\"string literal\"";
+        }
+      }
+
+      const CorpusOptions &m_options;
+      Corpus &m_corpus;
+      std::mt19937 m_random;
+    };
+  } // namespace
+
+  Corpus GenerateCorpus(const CorpusOptions &options)
+  {
+    Corpus corpus;
+    corpus.source.reserve(options.size + 4096);
+
+    Generator generator(options, corpus);
+    generator.AppendVariables();
+    while (corpus.source.size() < options.size)
+    {
+      generator.AppendStatement();
+    }
+    return corpus;
+  }
+} // namespace VyprBench
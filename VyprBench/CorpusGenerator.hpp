@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace VyprBench
+{
+  /// @brief Relative weights of each kind of literal among the literal
+  /// operands of generated expressions. The defaults only produce integral
+  /// operands, which is all that binary operators handle so far, so the
+  /// corpus can be parsed and generated as well as lexed.
+  struct LiteralMix
+  {
+    unsigned integer = 4;
+    unsigned floating = 0;
+    unsigned character = 1;
+    unsigned string = 0;
+  };
+
+  /// @brief Shape of a generated corpus.
+  struct CorpusOptions
+  {
+    /// @brief Approximate size of the corpus in bytes.
+    size_t size = 1 << 20;
+
+    /// @brief Chance in [0, 1] that a statement is preceded by a comment.
+    double commentDensity = 0.25;
+
+    /// @brief Length of the variable names used as operands.
+    size_t identifierLength = 8;
+
+    /// @brief Chance in [0, 1] that an operand is a literal instead of a
+    /// variable.
+    double literalRatio = 0.3;
+
+    /// @brief Weights of the kinds of literal operands.
+    LiteralMix literals;
+
+    /// @brief Maximum nesting depth of the operators in each expression.
+    int expressionDepth = 4;
+
+    /// @brief Seed of the generator. Equal options always produce the same
+    /// corpus.
+    uint32_t seed = 1;
+  };
+
+  /// @brief Synthetic C source made of expression statements.
+  struct Corpus
+  {
+    /// @brief Statements of the form `expression;` interleaved with comments.
+    std::string source;
+
+    /// @brief Names of the variables referenced by the expressions. All are
+    /// meant to be declared as `int`.
+    std::vector<std::string> variables;
+
+    /// @brief Number of expression statements in `source`.
+    size_t statements = 0;
+
+    /// @brief Number of operators and operands in all expressions.
+    size_t nodes = 0;
+  };
+
+  /// @brief Generates a corpus. Only binary arithmetic and comparison
+  /// operators are used so that the expressions type check and generate code
+  /// with the default literal mix.
+  ///
+  /// @param options Shape of the corpus.
+  /// @returns Corpus of roughly `options.size` bytes.
+  Corpus GenerateCorpus(const CorpusOptions &options);
+} // namespace VyprBench
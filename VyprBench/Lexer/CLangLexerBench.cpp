@@ -0,0 +1,236 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <string_view>
+
+#include "AllocationCounter.hpp"
+#include "CorpusGenerator.hpp"
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Lexer/CLangSplitPoints.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+namespace CLangLexerBench
+{
+  /// @brief Ordinary code that exercises comments, identifiers, keywords,
+  /// constants and punctuators. Token spellings are kept short so that token
+  /// contents do not allocate.
+  constexpr std::string_view CodeSnippet =
+      "/* block comment */\n"
+      "int value = (count + 0x1F) * 3.5f; // line comment\n"
+      "if (value >= limit && flag != 0) value <<= 2;\n"
+      "while (i < 10) { sum += a[i++] - 'c'; }\n";
+
+  /// @brief Header-style code that is mostly documentation and indentation.
+  constexpr std::string_view CommentedSnippet =
+      "/*\n"
+      " * Copyright (c) Example Authors. Permission is hereby granted, free\n"
+      " * of charge, to any person obtaining a copy of this software.\n"
+      " */\n"
+      "\n"
+      "        /// @brief Returns the number of elements in the container and\n"
+      "        /// never throws.\n"
+      "        ///\n"
+      "        /// @returns Element count.\n"
+      "        long size;\n"
+      "\n";
+
+  /// @brief Code dominated by long descriptive identifiers.
+  constexpr std::string_view IdentifierSnippet =
+      "accumulated_result_value = first_operand_value * scale_factor_x;\n"
+      "ConfigurationManagerInstance.applicationSettingsTable[index];\n";
+
+  /// @brief Half-typed code with a malformed constant or literal on every
+  /// line, as an editor sees it mid-edit.
+  constexpr std::string_view ErrorSnippet =
+      "int value = (count + 0x1G) * 3.5q; // line comment\n"
+      "if (value >= 0b102 && flag != '') value <<= 2;\n"
+      "while (i < 10) { sum += a[i++] - \"c\\q; }\n";
+
+  /// @brief Builds a source of roughly `size` bytes by repeating `snippet`.
+  std::string MakeSource(std::string_view snippet, size_t size)
+  {
+    std::string source;
+    source.reserve(size + snippet.size());
+    while (source.size() < size)
+    {
+      source += snippet;
+    }
+    return source;
+  }
+
+  void LexSource(benchmark::State &state, const std::string &source)
+  {
+    size_t tokens = 0;
+    size_t allocations = 0;
+    for (auto _ : state)
+    {
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::BufferScanner>(source));
+
+      size_t start = VyprBench::AllocationCount();
+      while (true)
+      {
+        Vypr::CLangToken token = lexer.GetToken();
+        if (token.type == Vypr::CLangTokenType::NoToken)
+        {
+          break;
+        }
+        benchmark::DoNotOptimize(token);
+        tokens += 1;
+      }
+      allocations += VyprBench::AllocationCount() - start;
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(source.size()));
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(tokens),
+                           benchmark::Counter::kIsRate);
+    state.counters["allocs/token"] = benchmark::Counter(
+        tokens == 0 ? 0.0
+                    : static_cast<double>(allocations) /
+                          static_cast<double>(tokens));
+  }
+
+  void GetToken(benchmark::State &state)
+  {
+    LexSource(state,
+              MakeSource(CodeSnippet, static_cast<size_t>(state.range(0))));
+  }
+  BENCHMARK(GetToken)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+  void GetTokenCommented(benchmark::State &state)
+  {
+    LexSource(state, MakeSource(CommentedSnippet,
+                                static_cast<size_t>(state.range(0))));
+  }
+  BENCHMARK(GetTokenCommented)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+  void GetTokenIdentifiers(benchmark::State &state)
+  {
+    LexSource(state, MakeSource(IdentifierSnippet,
+                                static_cast<size_t>(state.range(0))));
+  }
+  BENCHMARK(GetTokenIdentifiers)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+  void GetTokenErrors(benchmark::State &state)
+  {
+    LexSource(state,
+              MakeSource(ErrorSnippet, static_cast<size_t>(state.range(0))));
+  }
+  BENCHMARK(GetTokenErrors)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+  /// @brief Lexes a whole source with `Tokenize` and reports the memory the
+  /// token buffer needs per token.
+  void Tokenize(benchmark::State &state)
+  {
+    std::string source =
+        MakeSource(CodeSnippet, static_cast<size_t>(state.range(0)));
+    size_t tokens = 0;
+    size_t bytes = 0;
+    for (auto _ : state)
+    {
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::BufferScanner>(source));
+      lexer.Tokenize();
+      tokens = lexer.GetTokens().GetSize();
+      bytes = lexer.GetTokens().GetCapacityBytes();
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(source.size()));
+    state.counters["tokens"] = benchmark::Counter(
+        static_cast<double>(tokens),
+        benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["bytes/token"] =
+        static_cast<double>(bytes) / static_cast<double>(tokens);
+  }
+  BENCHMARK(Tokenize)->Arg(1 << 20)->Arg(16 << 20);
+
+  /// @brief Lexes a 16 MiB source with `Tokenize` on up to `threads`
+  /// threads. Wall time is measured since the work leaves the calling thread.
+  void TokenizeParallel(benchmark::State &state)
+  {
+    std::string source = MakeSource(CodeSnippet, 16 << 20);
+    size_t threads = static_cast<size_t>(state.range(0));
+    for (auto _ : state)
+    {
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::BufferScanner>(source));
+      lexer.Tokenize(threads);
+      benchmark::DoNotOptimize(lexer.GetTokens().GetSize());
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(source.size()));
+  }
+  BENCHMARK(TokenizeParallel)
+      ->ArgName("threads")
+      ->Arg(1)
+      ->Arg(2)
+      ->Arg(4)
+      ->UseRealTime();
+
+  /// @brief Types and deletes one character in the middle of a tokenized
+  /// source with `Relex`, as an editor does on every keystroke. Compare with
+  /// `Tokenize` at the same size to see the cost of lexing it all again.
+  void Relex(benchmark::State &state)
+  {
+    std::string source =
+        MakeSource(CodeSnippet, static_cast<size_t>(state.range(0)));
+    uint32_t offset =
+        static_cast<uint32_t>(source.find("value", source.size() / 2));
+    std::string edited = source;
+    edited.insert(offset, 1, 'x');
+
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::BufferScanner>(source));
+    lexer.Tokenize();
+    size_t relexed = 0;
+    for (auto _ : state)
+    {
+      relexed += lexer.Relex({.offset = offset, .insertedLength = 1},
+                             std::make_unique<Vypr::BufferScanner>(edited));
+      relexed += lexer.Relex({.offset = offset, .removedLength = 1},
+                             std::make_unique<Vypr::BufferScanner>(source));
+    }
+
+    state.counters["relexed"] = benchmark::Counter(
+        static_cast<double>(relexed) /
+        static_cast<double>(2 * state.iterations()));
+  }
+  BENCHMARK(Relex)->Arg(64 << 10)->Arg(1 << 20)->Arg(16 << 20);
+
+  /// @brief Finds the split points of a 16 MiB source, the serial pre-pass of
+  /// `TokenizeParallel`.
+  void FindSplitPoints(benchmark::State &state)
+  {
+    std::string source = MakeSource(CodeSnippet, 16 << 20);
+    for (auto _ : state)
+    {
+      benchmark::DoNotOptimize(Vypr::FindSplitPoints(source, 4));
+    }
+
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                            static_cast<int64_t>(source.size()));
+  }
+  BENCHMARK(FindSplitPoints);
+
+  /// @brief Lexes a generated corpus of 4 MiB. Arguments are the comment
+  /// density and literal ratio in percent, identifier length and expression
+  /// depth.
+  void GetTokenGenerated(benchmark::State &state)
+  {
+    VyprBench::CorpusOptions options;
+    options.size = 4 << 20;
+    options.commentDensity = static_cast<double>(state.range(0)) / 100.0;
+    options.literalRatio = static_cast<double>(state.range(1)) / 100.0;
+    options.identifierLength = static_cast<size_t>(state.range(2));
+    options.expressionDepth = static_cast<int>(state.range(3));
+    options.literals.floating = 2;
+    options.literals.string = 1;
+    LexSource(state, VyprBench::GenerateCorpus(options).source);
+  }
+  BENCHMARK(GetTokenGenerated)
+      ->ArgNames({"comments", "literals", "identifier", "depth"})
+      ->Args({25, 30, 8, 4})
+      ->Args({75, 30, 8, 4})
+      ->Args({25, 90, 8, 4})
+      ->Args({25, 30, 32, 4})
+      ->Args({25, 30, 8, 10});
+} // namespace CLangLexerBench
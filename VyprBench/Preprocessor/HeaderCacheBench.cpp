@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Preprocessor/HeaderCache.hpp"
+#include "Vypr/Preprocessor/Preprocessor.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+namespace HeaderCacheBench
+{
+  /// @brief Number of translation units compiled per iteration.
+  constexpr int64_t UnitCount = 16;
+
+  /// @brief Directory holding a guarded header of `count` declarations, and
+  /// the main source of a translation unit including it.
+  class Project
+  {
+  public:
+    explicit Project(size_t count)
+        : m_directory(std::filesystem::temp_directory_path() /
+                      ("vyprbench-headers-" + std::to_string(count)))
+    {
+      std::filesystem::create_directories(m_directory);
+      std::string header = "#ifndef SHARED_H\n#define SHARED_H\n";
+      for (size_t i = 0; i < count; i++)
+      {
+        std::string index = std::to_string(i);
+        header += "#define FIELD_" + index + " field_" + index + "\n";
+        header += "extern unsigned long long table_" + index + "[" + index +
+                  " + 1]; /* entry " + index + " */\n";
+      }
+      header += "#endif\n";
+      std::ofstream(m_directory / "shared.h", std::ios::binary) << header;
+      m_source = "#include \"shared.h\"\nint main ;\n";
+    }
+
+    ~Project()
+    {
+      std::filesystem::remove_all(m_directory);
+    }
+
+    /// @brief Preprocesses `UnitCount` translation units, each with an
+    /// identifier table of its own, through `cache` if it is given.
+    /// @returns Number of tokens preprocessed.
+    size_t Compile(const std::shared_ptr<Vypr::HeaderCache> &cache) const
+    {
+      size_t tokenCount = 0;
+      for (int64_t unit = 0; unit < UnitCount; unit++)
+      {
+        Vypr::CLangLexer lexer(std::make_unique<Vypr::BufferScanner>(m_source));
+        Vypr::PreprocessorOptions options;
+        options.sourcePath = m_directory / "main.c";
+        options.headerCache = cache;
+        lexer.StartPreprocessor(options);
+        lexer.Tokenize();
+        tokenCount += lexer.GetTokens().GetSize();
+      }
+      return tokenCount;
+    }
+
+  private:
+    std::filesystem::path m_directory;
+    std::string m_source;
+  };
+
+  /// @brief Compiles translation units that each map and lex the header.
+  void IncludeUncached(benchmark::State &state)
+  {
+    Project project(static_cast<size_t>(state.range(0)));
+    size_t tokenCount = 0;
+    for (auto _ : state)
+    {
+      tokenCount += project.Compile(nullptr);
+    }
+    state.counters["tokens"] = benchmark::Counter(
+        static_cast<double>(tokenCount), benchmark::Counter::kIsRate);
+  }
+  BENCHMARK(IncludeUncached)->Arg(1 << 8)->Arg(1 << 12)->Unit(
+      benchmark::kMillisecond);
+
+  /// @brief Compiles the same translation units through a cache made for the
+  /// iteration, so that the first unit lexes the header and the rest reuse
+  /// it. Compare with `IncludeUncached`.
+  void IncludeCached(benchmark::State &state)
+  {
+    Project project(static_cast<size_t>(state.range(0)));
+    size_t tokenCount = 0;
+    Vypr::HeaderCacheStatistics statistics;
+    for (auto _ : state)
+    {
+      auto cache = std::make_shared<Vypr::HeaderCache>();
+      tokenCount += project.Compile(cache);
+      statistics = cache->GetStatistics();
+    }
+    state.counters["tokens"] = benchmark::Counter(
+        static_cast<double>(tokenCount), benchmark::Counter::kIsRate);
+    state.counters["hitRate"] =
+        static_cast<double>(statistics.hits) /
+        static_cast<double>(statistics.hits + statistics.misses);
+    state.counters["bytesSaved"] = static_cast<double>(statistics.bytesSaved);
+  }
+  BENCHMARK(IncludeCached)->Arg(1 << 8)->Arg(1 << 12)->Unit(
+      benchmark::kMillisecond);
+} // namespace HeaderCacheBench
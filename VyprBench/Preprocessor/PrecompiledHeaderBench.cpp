@@ -0,0 +1,140 @@
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "Vypr/AST/Type/IntegralType.hpp"
+#include "Vypr/AST/Type/PointerType.hpp"
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Preprocessor/PrecompiledHeader.hpp"
+#include "Vypr/Preprocessor/Preprocessor.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+#include "Vypr/Scanner/MappedFileScanner.hpp"
+
+namespace PrecompiledHeaderBench
+{
+  /// @brief Writes a prelude of `count` constants, function-like macros and
+  /// declarations, and a precompiled header of it, to the temporary
+  /// directory.
+  class Prelude
+  {
+  public:
+    explicit Prelude(size_t count)
+        : m_count(count),
+          m_sourcePath(std::filesystem::temp_directory_path() /
+                       ("vyprbench-prelude-" + std::to_string(count) + ".h")),
+          m_headerPath(m_sourcePath.string() + ".pch")
+    {
+      std::string source = "#ifndef PRELUDE_H\n#define PRELUDE_H\n";
+      for (size_t i = 0; i < count; i++)
+      {
+        std::string index = std::to_string(i);
+        source += "#define LIMIT_" + index + " (" + index + " * 16 + 3)\n";
+        source += "#define CHECK_" + index + "(x, y) ((x) < LIMIT_" + index +
+                  " && (y) != \"name_" + index + "\")\n";
+        source += "extern const unsigned short *table_" + index + ";\n";
+      }
+      source += "#endif\n";
+      std::ofstream(m_sourcePath, std::ios::binary) << source;
+
+      auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+      std::unique_ptr<Vypr::CLangLexer> lexer = Compile(identifiers);
+      Vypr::TypeTable types;
+      Declare(*identifiers, types);
+      Vypr::PrecompiledHeader::Write(m_headerPath, *identifiers,
+                                     lexer->GetPreprocessor()->GetMacros(),
+                                     lexer->GetLiterals(), types);
+    }
+
+    ~Prelude()
+    {
+      std::filesystem::remove(m_sourcePath);
+      std::filesystem::remove(m_headerPath);
+    }
+
+    /// @brief Maps, lexes and preprocesses the prelude.
+    std::unique_ptr<Vypr::CLangLexer> Compile(
+        const std::shared_ptr<Vypr::IdentifierTable> &identifiers) const
+    {
+      auto lexer = std::make_unique<Vypr::CLangLexer>(
+          std::make_unique<Vypr::MappedFileScanner>(m_sourcePath),
+          identifiers);
+      Vypr::PreprocessorOptions options;
+      options.sourcePath = m_sourcePath;
+      lexer->StartPreprocessor(options);
+      lexer->Tokenize();
+      return lexer;
+    }
+
+    /// @brief Declares the symbols of the prelude, standing in for a parser
+    /// of its declarations.
+    void Declare(Vypr::IdentifierTable &identifiers,
+                 Vypr::TypeTable &types) const
+    {
+      for (size_t i = 0; i < m_count; i++)
+      {
+        std::unique_ptr<Vypr::StorageType> element =
+            std::make_unique<Vypr::IntegralType>(Vypr::Integral::Short, true,
+                                                 true, false);
+        types.AddSymbol(
+            identifiers.Intern("table_" + std::to_string(i)),
+            std::make_shared<Vypr::PointerType>(element, false, true));
+      }
+    }
+
+    const std::filesystem::path &GetHeaderPath() const
+    {
+      return m_headerPath;
+    }
+
+  private:
+    size_t m_count;
+    std::filesystem::path m_sourcePath;
+    std::filesystem::path m_headerPath;
+  };
+
+  /// @brief Starts a compile by reading the prelude from source.
+  void StartupCold(benchmark::State &state)
+  {
+    Prelude prelude(static_cast<size_t>(state.range(0)));
+    for (auto _ : state)
+    {
+      auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+      std::unique_ptr<Vypr::CLangLexer> lexer = prelude.Compile(identifiers);
+      Vypr::TypeTable types;
+      prelude.Declare(*identifiers, types);
+      benchmark::DoNotOptimize(lexer->GetPreprocessor()->GetMacros());
+      benchmark::DoNotOptimize(types);
+    }
+  }
+  BENCHMARK(StartupCold)->Arg(1 << 8)->Arg(1 << 12)->Unit(
+      benchmark::kMillisecond);
+
+  /// @brief Starts a compile by loading the precompiled prelude into the
+  /// lexer of an empty main source. Compare with `StartupCold`.
+  void StartupPrecompiled(benchmark::State &state)
+  {
+    Prelude prelude(static_cast<size_t>(state.range(0)));
+    std::string source = "main";
+    for (auto _ : state)
+    {
+      auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+      auto header = std::make_shared<Vypr::PrecompiledHeader>(
+          prelude.GetHeaderPath(), identifiers);
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::BufferScanner>(source),
+                             identifiers);
+      Vypr::PreprocessorOptions options;
+      options.precompiledHeader = header;
+      lexer.StartPreprocessor(options);
+      Vypr::TypeTable types;
+      header->LoadSymbols(types);
+      benchmark::DoNotOptimize(lexer.GetPreprocessor()->GetMacros());
+      benchmark::DoNotOptimize(types);
+    }
+  }
+  BENCHMARK(StartupPrecompiled)
+      ->Arg(1 << 8)
+      ->Arg(1 << 12)
+      ->Unit(benchmark::kMillisecond);
+} // namespace PrecompiledHeaderBench
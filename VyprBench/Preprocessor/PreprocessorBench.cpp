@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+#include <string>
+#include <string_view>
+
+#include "AllocationCounter.hpp"
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Preprocessor/Preprocessor.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+namespace PreprocessorBench
+{
+  /// @brief Table generator in the X-macro style, with pasting,
+  /// stringizing and object-like constants.
+  constexpr std::string_view Definitions =
+      "#define FIELDS(X) X(int, id) X(long, size) X(char, tag) X(short, kind)"
+      "\n"
+      "#define DECLARE(type, name) type m_##name;\n"
+      "#define NAME_OF(type, name) #name,\n"
+      "#define COUNT 4\n"
+      "#define LIMIT (COUNT * COUNT)\n"
+      "#define TWICE(x) ((x) + (x))\n";
+
+  /// @brief Code invoking the macros above, repeated to fill a source.
+  constexpr std::string_view Invocations =
+      "struct Record { FIELDS(DECLARE) };\n"
+      "const char *names[COUNT] = { FIELDS(NAME_OF) };\n"
+      "int total = TWICE(LIMIT) * TWICE(total);\n";
+
+  /// @brief Preprocesses `Definitions` followed by `range(0)` copies of
+  /// `Invocations`. The rate of output tokens stays flat as the source grows
+  /// if expansion is linear, and allocations per token fall towards zero
+  /// once the preprocessor's buffers have grown.
+  void Expand(benchmark::State &state)
+  {
+    std::string source(Definitions);
+    for (int64_t i = 0; i < state.range(0); i++)
+    {
+      source += Invocations;
+    }
+
+    size_t tokens = 0;
+    size_t allocations = 0;
+    for (auto _ : state)
+    {
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::BufferScanner>(source));
+      lexer.StartPreprocessor({});
+
+      size_t start = VyprBench::AllocationCount();
+      while (true)
+      {
+        Vypr::CLangToken token = lexer.GetToken();
+        if (token.type == Vypr::CLangTokenType::NoToken)
+        {
+          break;
+        }
+        benchmark::DoNotOptimize(token);
+        tokens += 1;
+      }
+      allocations += VyprBench::AllocationCount() - start;
+
+      const Vypr::PreprocessorStatistics &statistics =
+          lexer.GetPreprocessor()->GetStatistics();
+      state.counters["cached"] =
+          static_cast<double>(statistics.cachedExpansions) /
+          static_cast<double>(statistics.macrosExpanded);
+    }
+
+    state.counters["tokens"] =
+        benchmark::Counter(static_cast<double>(tokens),
+                           benchmark::Counter::kIsRate);
+    state.counters["allocs/token"] = benchmark::Counter(
+        tokens == 0 ? 0.0
+                    : static_cast<double>(allocations) /
+                          static_cast<double>(tokens));
+  }
+  BENCHMARK(Expand)->Arg(1 << 8)->Arg(1 << 12)->Arg(1 << 16);
+} // namespace PreprocessorBench
@@ -12,22 +12,21 @@ namespace ConstantNodeTest
 {
   TEST(Parse, InvalidConstant)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"!"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("!"));
     ASSERT_THROW(Vypr::ConstantNode::Parse(lexer), Vypr::CompileError);
   }
 
 #define PARSE_INT_TEST(testName, content, integralType, sign)                  \
   TEST(Parse, testName)                                                        \
   {                                                                            \
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L##content)); \
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(content));    \
                                                                                \
     std::unique_ptr<Vypr::ConstantNode> constant =                             \
         Vypr::ConstantNode::Parse(lexer);                                      \
                                                                                \
     ASSERT_EQ(lexer.PeekToken().type, Vypr::CLangTokenType::NoToken);          \
     ASSERT_NE(constant, nullptr);                                              \
-    ASSERT_EQ(constant->column, 1);                                            \
-    ASSERT_EQ(constant->line, 1);                                              \
+    ASSERT_EQ(constant->offset, 0U);                                           \
     ASSERT_EQ(constant->type->GetType(), Vypr::StorageMetaType::Integral);     \
                                                                                \
     auto integralType =                                                        \
@@ -63,15 +62,14 @@ namespace ConstantNodeTest
 #define PARSE_FLOAT_TEST(testName, content, realType)                          \
   TEST(Parse, testName)                                                        \
   {                                                                            \
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L##content)); \
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(content));    \
                                                                                \
     std::unique_ptr<Vypr::ConstantNode> constant =                             \
         Vypr::ConstantNode::Parse(lexer);                                      \
                                                                                \
     ASSERT_EQ(lexer.PeekToken().type, Vypr::CLangTokenType::NoToken);          \
     ASSERT_NE(constant, nullptr);                                              \
-    ASSERT_EQ(constant->column, 1);                                            \
-    ASSERT_EQ(constant->line, 1);                                              \
+    ASSERT_EQ(constant->offset, 0U);                                           \
     ASSERT_EQ(constant->type->GetType(), Vypr::StorageMetaType::Real);         \
                                                                                \
     auto realType = dynamic_cast<Vypr::RealType *>(constant->type.get());      \
@@ -90,15 +88,14 @@ namespace ConstantNodeTest
 #define PARSE_FLOAT_TEST(testName, content, realType)                          \
   TEST(Parse, testName)                                                        \
   {                                                                            \
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L##content)); \
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(content));    \
                                                                                \
     std::unique_ptr<Vypr::ConstantNode> constant =                             \
         Vypr::ConstantNode::Parse(lexer);                                      \
                                                                                \
     ASSERT_EQ(lexer.PeekToken().type, Vypr::CLangTokenType::NoToken);          \
     ASSERT_NE(constant, nullptr);                                              \
-    ASSERT_EQ(constant->column, 1);                                            \
-    ASSERT_EQ(constant->line, 1);                                              \
+    ASSERT_EQ(constant->offset, 0U);                                           \
     ASSERT_EQ(constant->type->GetType(), Vypr::StorageMetaType::Real);         \
                                                                                \
     auto realType = dynamic_cast<Vypr::RealType *>(constant->type.get());      \
@@ -110,15 +107,14 @@ namespace ConstantNodeTest
 #define PARSE_CHARACTER_TEST(testName, content)                                \
   TEST(Parse, testName)                                                        \
   {                                                                            \
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L##content)); \
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(content));    \
                                                                                \
     std::unique_ptr<Vypr::ConstantNode> constant =                             \
         Vypr::ConstantNode::Parse(lexer);                                      \
                                                                                \
     ASSERT_EQ(lexer.PeekToken().type, Vypr::CLangTokenType::NoToken);          \
     ASSERT_NE(constant, nullptr);                                              \
-    ASSERT_EQ(constant->column, 1);                                            \
-    ASSERT_EQ(constant->line, 1);                                              \
+    ASSERT_EQ(constant->offset, 0U);                                           \
     ASSERT_EQ(constant->type->GetType(), Vypr::StorageMetaType::Integral);     \
                                                                                \
     auto integralType =                                                        \
@@ -136,15 +132,14 @@ namespace ConstantNodeTest
 #define PARSE_STRING_TEST(testName, content)                                   \
   TEST(Parse, testName)                                                        \
   {                                                                            \
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L##content)); \
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(content));    \
                                                                                \
     std::unique_ptr<Vypr::ConstantNode> constant =                             \
         Vypr::ConstantNode::Parse(lexer);                                      \
                                                                                \
     ASSERT_EQ(lexer.PeekToken().type, Vypr::CLangTokenType::NoToken);          \
     ASSERT_NE(constant, nullptr);                                              \
-    ASSERT_EQ(constant->column, 1);                                            \
-    ASSERT_EQ(constant->line, 1);                                              \
+    ASSERT_EQ(constant->offset, 0U);                                           \
     ASSERT_EQ(constant->type->GetType(), Vypr::StorageMetaType::Pointer);      \
                                                                                \
     auto pointerType =                                                         \
@@ -156,9 +151,27 @@ namespace ConstantNodeTest
   PARSE_STRING_TEST(CommonString, "\"Hello, World\"");
   PARSE_STRING_TEST(EmptyString, "\"\"");
 
+  TEST(GenerateCode, AdjacentStrings)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(
+        "\"Hello\" \", \"\n\"World\\n\""));
+    std::unique_ptr<Vypr::ConstantNode> constant =
+        Vypr::ConstantNode::Parse(lexer);
+    Vypr::Context context("TestModule");
+
+    llvm::Value *code = constant->GenerateCode(context);
+
+    EXPECT_EQ(lexer.PeekToken().type, Vypr::CLangTokenType::NoToken);
+    auto global = llvm::dyn_cast<llvm::GlobalVariable>(code);
+    ASSERT_NE(global, nullptr);
+    EXPECT_EQ(llvm::cast<llvm::ConstantDataArray>(global->getInitializer())
+                  ->getAsCString(),
+              "Hello, World\n");
+  }
+
   TEST(GenerateCode, Int32Common)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"0"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("0"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -173,7 +186,7 @@ namespace ConstantNodeTest
   TEST(GenerateCode, Int32Max)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"2147483647"));
+        std::make_unique<Vypr::StringScanner>("2147483647"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -189,7 +202,7 @@ namespace ConstantNodeTest
   TEST(GenerateCode, Int32AboveMaxAllowed)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"2147483648"));
+        std::make_unique<Vypr::StringScanner>("2147483648"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -204,7 +217,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, UInt32Common)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"120U"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("120U"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -218,7 +231,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, UInt32Min)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"0U"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("0U"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -233,7 +246,7 @@ namespace ConstantNodeTest
   TEST(GenerateCode, UInt32Max)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"4294967295U"));
+        std::make_unique<Vypr::StringScanner>("4294967295U"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -249,7 +262,7 @@ namespace ConstantNodeTest
   TEST(GenerateCode, UInt32AboveMaxAllowed)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"4294967296U"));
+        std::make_unique<Vypr::StringScanner>("4294967296U"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -264,7 +277,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, Int64Common)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"23LL"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("23LL"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -279,7 +292,7 @@ namespace ConstantNodeTest
   TEST(GenerateCode, Int64Max)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"9223372036854775807LL"));
+        std::make_unique<Vypr::StringScanner>("9223372036854775807LL"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -295,7 +308,7 @@ namespace ConstantNodeTest
   TEST(GenerateCode, Int64AboveMaxAllowed)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"9223372036854775808LL"));
+        std::make_unique<Vypr::StringScanner>("9223372036854775808LL"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -310,7 +323,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, UInt64Common)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"23ULL"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("23ULL"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -325,7 +338,7 @@ namespace ConstantNodeTest
   TEST(GenerateCode, UInt64Max)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"18446744073709551615ULL"));
+        std::make_unique<Vypr::StringScanner>("18446744073709551615ULL"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -341,13 +354,13 @@ namespace ConstantNodeTest
   TEST(GenerateCode, UInt64AboveMax)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"18446744073709551616ULL"));
+        std::make_unique<Vypr::StringScanner>("18446744073709551616ULL"));
     ASSERT_THROW(Vypr::ConstantNode::Parse(lexer), Vypr::CompileError);
   }
 
   TEST(GenerateCode, UInt64Min)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"0ULL"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("0ULL"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -362,7 +375,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, HexConstant)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"0x20"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("0x20"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -376,7 +389,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, BinaryConstant)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"0b0110"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("0b0110"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -390,7 +403,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, OctalConstant)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"023"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("023"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -404,7 +417,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, CharacterConstant)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"'a'"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("'a'"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -418,7 +431,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, F32Common)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"2.0f"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("2.0f"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -433,7 +446,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, F32NoDecimal)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"2f"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("2f"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -448,7 +461,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, F32SciFormat)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"2e3f"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("2e3f"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -463,7 +476,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, F64Common)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"2.0"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("2.0"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -478,7 +491,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, F64NoFraction)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"2."));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("2."));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -493,7 +506,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, F64Long)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"2.0L"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("2.0L"));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -508,7 +521,7 @@ namespace ConstantNodeTest
 
   TEST(GenerateCode, StringEmpty)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"\"\""));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("\"\""));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -524,7 +537,7 @@ namespace ConstantNodeTest
   TEST(GenerateCode, StringCommon)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"\"Hello, world\""));
+        std::make_unique<Vypr::StringScanner>("\"Hello, world\""));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -542,7 +555,7 @@ namespace ConstantNodeTest
   TEST(GenerateCode, StringConcat)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"\"Hello,\"\n\" world\""));
+        std::make_unique<Vypr::StringScanner>("\"Hello,\"\n\" world\""));
     std::unique_ptr<Vypr::ConstantNode> constant =
         Vypr::ConstantNode::Parse(lexer);
     Vypr::Context context("TestModule");
@@ -13,7 +13,7 @@ namespace VariableNodeTest
 {
   TEST(Parse, InvalidVariableName)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"34"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("34"));
     Vypr::TypeTable typeTable;
     ASSERT_THROW(Vypr::VariableNode::Parse(lexer, typeTable),
                  Vypr::CompileError);
@@ -21,7 +21,7 @@ namespace VariableNodeTest
 
   TEST(Parse, UndefinedVariable)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"alpha"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("alpha"));
     Vypr::TypeTable typeTable;
     ASSERT_THROW(Vypr::VariableNode::Parse(lexer, typeTable),
                  Vypr::CompileError);
@@ -29,16 +29,16 @@ namespace VariableNodeTest
 
   TEST(Parse, IntegralVariable)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"alpha"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("alpha"));
     Vypr::TypeTable typeTable;
-    typeTable.AddSymbol(L"alpha", std::make_shared<Vypr::IntegralType>(
-                                      Vypr::Integral::Int, false, false, true));
+    typeTable.AddSymbol(lexer.GetIdentifiers().Intern("alpha"),
+                        std::make_shared<Vypr::IntegralType>(
+                            Vypr::Integral::Int, false, false, true));
 
     std::unique_ptr<Vypr::VariableNode> variable =
         Vypr::VariableNode::Parse(lexer, typeTable);
 
-    ASSERT_EQ(variable->column, 1);
-    ASSERT_EQ(variable->line, 1);
+    ASSERT_EQ(variable->offset, 0U);
     ASSERT_EQ(variable->type->GetType(), Vypr::StorageMetaType::Integral);
     ASSERT_EQ(
         dynamic_cast<Vypr::IntegralType *>(variable->type.get())->integral,
@@ -49,16 +49,16 @@ namespace VariableNodeTest
 
   TEST(Parse, RealVariable)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"alpha"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("alpha"));
     Vypr::TypeTable typeTable;
-    typeTable.AddSymbol(L"alpha", std::make_shared<Vypr::RealType>(
-                                      Vypr::Real::Float, false, true));
+    typeTable.AddSymbol(
+        lexer.GetIdentifiers().Intern("alpha"),
+        std::make_shared<Vypr::RealType>(Vypr::Real::Float, false, true));
 
     std::unique_ptr<Vypr::VariableNode> variable =
         Vypr::VariableNode::Parse(lexer, typeTable);
 
-    ASSERT_EQ(variable->column, 1);
-    ASSERT_EQ(variable->line, 1);
+    ASSERT_EQ(variable->offset, 0U);
     ASSERT_EQ(variable->type->GetType(), Vypr::StorageMetaType::Real);
     ASSERT_EQ(dynamic_cast<Vypr::RealType *>(variable->type.get())->real,
               Vypr::Real::Float);
@@ -68,19 +68,19 @@ namespace VariableNodeTest
 
   TEST(Parse, PointerVariable)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"beta"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("beta"));
     Vypr::TypeTable typeTable;
     std::unique_ptr<Vypr::StorageType> storage =
         std::make_unique<Vypr::IntegralType>(Vypr::Integral::Bool, false, false,
                                              true);
     typeTable.AddSymbol(
-        L"beta", std::make_shared<Vypr::PointerType>(storage, false, true));
+        lexer.GetIdentifiers().Intern("beta"),
+        std::make_shared<Vypr::PointerType>(storage, false, true));
 
     std::unique_ptr<Vypr::VariableNode> variable =
         Vypr::VariableNode::Parse(lexer, typeTable);
 
-    ASSERT_EQ(variable->column, 1);
-    ASSERT_EQ(variable->line, 1);
+    ASSERT_EQ(variable->offset, 0U);
     ASSERT_EQ(variable->type->GetType(), Vypr::StorageMetaType::Pointer);
     ASSERT_EQ(variable->type->isLValue, true);
     ASSERT_EQ(variable->type->isConst, false);
@@ -89,9 +89,10 @@ namespace VariableNodeTest
 #define GENCODE_INT_TEST(typeName, bitWidth, testValue)                        \
   TEST(GenerateCode, typeName##Variable)                                       \
   {                                                                            \
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"beta"));    \
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("beta"));     \
+    Vypr::Identifier beta = lexer.GetIdentifiers().Intern("beta");             \
     Vypr::TypeTable typeTable;                                                 \
-    typeTable.AddSymbol(L"beta",                                               \
+    typeTable.AddSymbol(beta,                                                  \
                         std::make_shared<Vypr::IntegralType>(                  \
                             Vypr::Integral::typeName, false, false, true));    \
     Vypr::Context context("module");                                           \
@@ -104,9 +105,9 @@ namespace VariableNodeTest
     context.builder.SetInsertPoint(block);                                     \
     llvm::AllocaInst *allocation = context.builder.CreateAlloca(               \
         context.builder.getInt##bitWidth##Ty(), nullptr, "beta");              \
-    context.symbolTable.AddSymbol(L"beta", allocation);                        \
+    context.symbolTable.AddSymbol(beta, allocation);                           \
     context.builder.CreateStore(context.builder.getInt##bitWidth(testValue),   \
-                                context.symbolTable.GetSymbol(L"beta"));       \
+                                context.symbolTable.GetSymbol(beta));          \
                                                                                \
     std::unique_ptr<Vypr::VariableNode> variable =                             \
         Vypr::VariableNode::Parse(lexer, typeTable);                           \
@@ -124,10 +125,11 @@ namespace VariableNodeTest
 
   TEST(GenerateCode, FloatVariable)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"beta"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("beta"));
+    Vypr::Identifier beta = lexer.GetIdentifiers().Intern("beta");
     Vypr::TypeTable typeTable;
-    typeTable.AddSymbol(L"beta", std::make_shared<Vypr::RealType>(
-                                     Vypr::Real::Float, false, true));
+    typeTable.AddSymbol(beta, std::make_shared<Vypr::RealType>(
+                                  Vypr::Real::Float, false, true));
     Vypr::Context context("module");
 
     llvm::Function *function = llvm::Function::Create(
@@ -138,10 +140,10 @@ namespace VariableNodeTest
     context.builder.SetInsertPoint(block);
     llvm::AllocaInst *allocation = context.builder.CreateAlloca(
         context.builder.getFloatTy(), nullptr, "beta");
-    context.symbolTable.AddSymbol(L"beta", allocation);
+    context.symbolTable.AddSymbol(beta, allocation);
     context.builder.CreateStore(
         llvm::ConstantFP::get(llvm::Type::getFloatTy(context.context), 2.0f),
-        context.symbolTable.GetSymbol(L"beta"));
+        context.symbolTable.GetSymbol(beta));
 
     std::unique_ptr<Vypr::VariableNode> variable =
         Vypr::VariableNode::Parse(lexer, typeTable);
@@ -153,10 +155,11 @@ namespace VariableNodeTest
 
   TEST(GenerateCode, DoubleVariable)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"beta"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("beta"));
+    Vypr::Identifier beta = lexer.GetIdentifiers().Intern("beta");
     Vypr::TypeTable typeTable;
-    typeTable.AddSymbol(L"beta", std::make_shared<Vypr::RealType>(
-                                     Vypr::Real::Double, false, true));
+    typeTable.AddSymbol(beta, std::make_shared<Vypr::RealType>(
+                                  Vypr::Real::Double, false, true));
     Vypr::Context context("module");
 
     llvm::Function *function = llvm::Function::Create(
@@ -167,10 +170,10 @@ namespace VariableNodeTest
     context.builder.SetInsertPoint(block);
     llvm::AllocaInst *allocation = context.builder.CreateAlloca(
         context.builder.getDoubleTy(), nullptr, "beta");
-    context.symbolTable.AddSymbol(L"beta", allocation);
+    context.symbolTable.AddSymbol(beta, allocation);
     context.builder.CreateStore(
         llvm::ConstantFP::get(llvm::Type::getDoubleTy(context.context), 2.0),
-        context.symbolTable.GetSymbol(L"beta"));
+        context.symbolTable.GetSymbol(beta));
 
     std::unique_ptr<Vypr::VariableNode> variable =
         Vypr::VariableNode::Parse(lexer, typeTable);
@@ -182,13 +185,14 @@ namespace VariableNodeTest
 
   TEST(GenerateCode, PointerVariable)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"beta"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("beta"));
+    Vypr::Identifier beta = lexer.GetIdentifiers().Intern("beta");
     Vypr::TypeTable typeTable;
     std::unique_ptr<Vypr::StorageType> storage =
         std::make_unique<Vypr::IntegralType>(Vypr::Integral::Int, false, false,
                                              true);
     typeTable.AddSymbol(
-        L"beta", std::make_shared<Vypr::PointerType>(storage, false, true));
+        beta, std::make_shared<Vypr::PointerType>(storage, false, true));
     Vypr::Context context("module");
 
     llvm::Function *function = llvm::Function::Create(
@@ -199,11 +203,11 @@ namespace VariableNodeTest
     context.builder.SetInsertPoint(block);
     llvm::AllocaInst *allocation = context.builder.CreateAlloca(
         context.builder.getInt32Ty()->getPointerTo(), nullptr, "beta");
-    context.symbolTable.AddSymbol(L"beta", allocation);
+    context.symbolTable.AddSymbol(beta, allocation);
     context.builder.CreateStore(
         llvm::ConstantPointerNull::get(
             context.builder.getInt32Ty()->getPointerTo()),
-        context.symbolTable.GetSymbol(L"beta"));
+        context.symbolTable.GetSymbol(beta));
 
     std::unique_ptr<Vypr::VariableNode> variable =
         Vypr::VariableNode::Parse(lexer, typeTable);
@@ -0,0 +1,53 @@
+#include "Vypr/Lexer/CLangKeywords.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace CLangKeywordsTest
+{
+  TEST(FindKeyword, AllKeywords)
+  {
+    for (const Vypr::CLangKeyword &keyword : Vypr::Keywords)
+    {
+      EXPECT_EQ(Vypr::FindKeyword(keyword.spelling), keyword.type)
+          << keyword.spelling;
+    }
+  }
+
+  TEST(FindKeyword, NearMisses)
+  {
+    for (const Vypr::CLangKeyword &keyword : Vypr::Keywords)
+    {
+      std::string spelling(keyword.spelling);
+
+      EXPECT_EQ(Vypr::FindKeyword(spelling + "_"),
+                Vypr::CLangTokenType::Identifier);
+      EXPECT_EQ(Vypr::FindKeyword(spelling.substr(1)),
+                Vypr::CLangTokenType::Identifier);
+
+      spelling[spelling.size() / 2] ^= 0x20;
+      EXPECT_EQ(Vypr::FindKeyword(spelling), Vypr::CLangTokenType::Identifier);
+    }
+  }
+
+  TEST(FindKeyword, Empty)
+  {
+    EXPECT_EQ(Vypr::FindKeyword(""), Vypr::CLangTokenType::Identifier);
+  }
+
+  TEST(FindKeyword, Constexpr)
+  {
+    static_assert(Vypr::FindKeyword("while") == Vypr::CLangTokenType::While);
+    static_assert(Vypr::FindKeyword("whale") ==
+                  Vypr::CLangTokenType::Identifier);
+  }
+
+  TEST(GetKeywordSpelling, AllKeywords)
+  {
+    for (const Vypr::CLangKeyword &keyword : Vypr::Keywords)
+    {
+      EXPECT_EQ(Vypr::GetKeywordSpelling(keyword.type), keyword.spelling);
+    }
+    EXPECT_TRUE(Vypr::GetKeywordSpelling(Vypr::CLangTokenType::Add).empty());
+  }
+} // namespace CLangKeywordsTest
@@ -1,6 +1,8 @@
 ﻿#include "Vypr/Lexer/CLangLexer.hpp"
 
+#include <algorithm>
 #include <gtest/gtest.h>
+#include <random>
 #include <string>
 
 #include "Vypr/Lexer/CLangToken.hpp"
@@ -10,7 +12,7 @@ namespace CLangLexerTest
 {
   TEST(GetToken, Empty)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L""));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(""));
 
     Vypr::CLangToken token = lexer.GetToken();
 
@@ -19,154 +21,719 @@ namespace CLangLexerTest
 
   TEST(GetToken, LeadingWS)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"   ("));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("   ("));
 
     Vypr::CLangToken token = lexer.GetToken();
 
     EXPECT_EQ(token.type, Vypr::CLangTokenType::LeftParenthesis);
-    EXPECT_EQ(token.line, 1ULL);
-    EXPECT_EQ(token.column, 4ULL);
-    EXPECT_EQ(token.content, L"(");
+    EXPECT_EQ(token.offset, 3U);
+    EXPECT_EQ(lexer.GetSpelling(token), "(");
   }
 
 #define TEST_GET_TOKEN(testName, name, testStr)                                \
   TEST(GetToken, testName##name)                                               \
   {                                                                            \
     Vypr::CLangLexer lexer(                                                    \
-        std::make_unique<Vypr::StringScanner>(testStr L" aaa"));               \
+        std::make_unique<Vypr::StringScanner>(testStr " aaa"));                \
     Vypr::CLangToken token = lexer.GetToken();                                 \
     EXPECT_EQ(token.type, Vypr::CLangTokenType::name);                         \
-    EXPECT_EQ(token.line, 1ULL);                                               \
-    EXPECT_EQ(token.column, 1ULL);                                             \
-    EXPECT_EQ(token.content, std::wstring(testStr));                           \
-  }
-
-  TEST_GET_TOKEN(Operator, LeftBracket, L"[");
-  TEST_GET_TOKEN(Operator, RightBracket, L"]");
-  TEST_GET_TOKEN(Operator, LeftParenthesis, L"(");
-  TEST_GET_TOKEN(Operator, RightParenthesis, L")");
-  TEST_GET_TOKEN(Operator, LeftDragon, L"{");
-  TEST_GET_TOKEN(Operator, RightDragon, L"}");
-  TEST_GET_TOKEN(Operator, Period, L".");
-  TEST_GET_TOKEN(Operator, Increment, L"++");
-  TEST_GET_TOKEN(Operator, Decrement, L"--");
-  TEST_GET_TOKEN(Operator, Star, L"*");
-  TEST_GET_TOKEN(Operator, Add, L"+");
-  TEST_GET_TOKEN(Operator, Subtract, L"-");
-  TEST_GET_TOKEN(Operator, Tilde, L"~");
-  TEST_GET_TOKEN(Operator, Exclamation, L"!");
-  TEST_GET_TOKEN(Operator, Divide, L"/");
-  TEST_GET_TOKEN(Operator, Modulo, L"%");
-  TEST_GET_TOKEN(Operator, ShiftLeft, L"<<");
-  TEST_GET_TOKEN(Operator, ShiftRight, L">>");
-  TEST_GET_TOKEN(Operator, LessThan, L"<");
-  TEST_GET_TOKEN(Operator, GreaterThan, L">");
-  TEST_GET_TOKEN(Operator, LessEqual, L"<=");
-  TEST_GET_TOKEN(Operator, GreaterEqual, L">=");
-  TEST_GET_TOKEN(Operator, Equal, L"==");
-  TEST_GET_TOKEN(Operator, NotEqual, L"!=");
-  TEST_GET_TOKEN(Operator, And, L"&");
-  TEST_GET_TOKEN(Operator, Or, L"|");
-  TEST_GET_TOKEN(Operator, Xor, L"^");
-  TEST_GET_TOKEN(Operator, LogicalAnd, L"&&");
-  TEST_GET_TOKEN(Operator, LogicalOr, L"||");
-  TEST_GET_TOKEN(Operator, TernaryProposition, L"?");
-  TEST_GET_TOKEN(Operator, TernaryDecision, L":");
-  TEST_GET_TOKEN(Operator, StatementDelimiter, L";");
-  TEST_GET_TOKEN(Operator, Variadic, L"...");
-  TEST_GET_TOKEN(Operator, Assign, L"=");
-  TEST_GET_TOKEN(Operator, MultiplyAssign, L"*=");
-  TEST_GET_TOKEN(Operator, DivideAssign, L"/=");
-  TEST_GET_TOKEN(Operator, ModuloAssign, L"%=");
-  TEST_GET_TOKEN(Operator, AddAssign, L"+=");
-  TEST_GET_TOKEN(Operator, SubtractAssign, L"-=");
-  TEST_GET_TOKEN(Operator, LeftShiftAssign, L"<<=");
-  TEST_GET_TOKEN(Operator, RightShiftAssign, L">>=");
-  TEST_GET_TOKEN(Operator, AndAssign, L"&=");
-  TEST_GET_TOKEN(Operator, XorAssign, L"^=");
-  TEST_GET_TOKEN(Operator, OrAssign, L"|=");
-  TEST_GET_TOKEN(Operator, Comma, L",");
-  TEST_GET_TOKEN(Operator, Preprocessor, L"#");
-  TEST_GET_TOKEN(Operator, PreprocessorConcat, L"##");
+    EXPECT_EQ(token.offset, 0U);                                               \
+    EXPECT_EQ(lexer.GetSpelling(token), std::string(testStr));                 \
+  }
+
+  TEST_GET_TOKEN(Operator, LeftBracket, "[");
+  TEST_GET_TOKEN(Operator, RightBracket, "]");
+  TEST_GET_TOKEN(Operator, LeftParenthesis, "(");
+  TEST_GET_TOKEN(Operator, RightParenthesis, ")");
+  TEST_GET_TOKEN(Operator, LeftDragon, "{");
+  TEST_GET_TOKEN(Operator, RightDragon, "}");
+  TEST_GET_TOKEN(Operator, Period, ".");
+  TEST_GET_TOKEN(Operator, Increment, "++");
+  TEST_GET_TOKEN(Operator, Decrement, "--");
+  TEST_GET_TOKEN(Operator, Star, "*");
+  TEST_GET_TOKEN(Operator, Add, "+");
+  TEST_GET_TOKEN(Operator, Subtract, "-");
+  TEST_GET_TOKEN(Operator, Tilde, "~");
+  TEST_GET_TOKEN(Operator, Exclamation, "!");
+  TEST_GET_TOKEN(Operator, Divide, "/");
+  TEST_GET_TOKEN(Operator, Modulo, "%");
+  TEST_GET_TOKEN(Operator, ShiftLeft, "<<");
+  TEST_GET_TOKEN(Operator, ShiftRight, ">>");
+  TEST_GET_TOKEN(Operator, LessThan, "<");
+  TEST_GET_TOKEN(Operator, GreaterThan, ">");
+  TEST_GET_TOKEN(Operator, LessEqual, "<=");
+  TEST_GET_TOKEN(Operator, GreaterEqual, ">=");
+  TEST_GET_TOKEN(Operator, Equal, "==");
+  TEST_GET_TOKEN(Operator, NotEqual, "!=");
+  TEST_GET_TOKEN(Operator, And, "&");
+  TEST_GET_TOKEN(Operator, Or, "|");
+  TEST_GET_TOKEN(Operator, Xor, "^");
+  TEST_GET_TOKEN(Operator, LogicalAnd, "&&");
+  TEST_GET_TOKEN(Operator, LogicalOr, "||");
+  TEST_GET_TOKEN(Operator, TernaryProposition, "?");
+  TEST_GET_TOKEN(Operator, TernaryDecision, ":");
+  TEST_GET_TOKEN(Operator, StatementDelimiter, ";");
+  TEST_GET_TOKEN(Operator, Variadic, "...");
+  TEST_GET_TOKEN(Operator, Assign, "=");
+  TEST_GET_TOKEN(Operator, MultiplyAssign, "*=");
+  TEST_GET_TOKEN(Operator, DivideAssign, "/=");
+  TEST_GET_TOKEN(Operator, ModuloAssign, "%=");
+  TEST_GET_TOKEN(Operator, AddAssign, "+=");
+  TEST_GET_TOKEN(Operator, SubtractAssign, "-=");
+  TEST_GET_TOKEN(Operator, LeftShiftAssign, "<<=");
+  TEST_GET_TOKEN(Operator, RightShiftAssign, ">>=");
+  TEST_GET_TOKEN(Operator, AndAssign, "&=");
+  TEST_GET_TOKEN(Operator, XorAssign, "^=");
+  TEST_GET_TOKEN(Operator, OrAssign, "|=");
+  TEST_GET_TOKEN(Operator, Comma, ",");
+  TEST_GET_TOKEN(Operator, Preprocessor, "#");
+  TEST_GET_TOKEN(Operator, PreprocessorConcat, "##");
 
   TEST(GetToken, PartialVariadic)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L".."));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(".."));
 
     Vypr::CLangToken firstToken = lexer.GetToken();
     Vypr::CLangToken secondToken = lexer.GetToken();
 
     EXPECT_EQ(firstToken.type, Vypr::CLangTokenType::Period);
-    EXPECT_EQ(firstToken.line, 1ULL);
-    EXPECT_EQ(firstToken.column, 1ULL);
-    EXPECT_EQ(firstToken.content, std::wstring(L"."));
+    EXPECT_EQ(firstToken.offset, 0U);
+    EXPECT_EQ(lexer.GetSpelling(firstToken), std::string("."));
 
     EXPECT_EQ(secondToken.type, Vypr::CLangTokenType::Period);
-    EXPECT_EQ(secondToken.line, 1ULL);
-    EXPECT_EQ(secondToken.column, 2ULL);
-    EXPECT_EQ(secondToken.content, std::wstring(L"."));
+    EXPECT_EQ(secondToken.offset, 1U);
+    EXPECT_EQ(lexer.GetSpelling(secondToken), std::string("."));
   }
 
   TEST(GetToken, TwoToken)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"   (}"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("   (}"));
 
     Vypr::CLangToken firstToken = lexer.GetToken();
     Vypr::CLangToken secondToken = lexer.GetToken();
 
     EXPECT_EQ(firstToken.type, Vypr::CLangTokenType::LeftParenthesis);
-    EXPECT_EQ(firstToken.line, 1ULL);
-    EXPECT_EQ(firstToken.column, 4ULL);
-    EXPECT_EQ(firstToken.content, std::wstring(L"("));
+    EXPECT_EQ(firstToken.offset, 3U);
+    EXPECT_EQ(lexer.GetSpelling(firstToken), std::string("("));
 
     EXPECT_EQ(secondToken.type, Vypr::CLangTokenType::RightDragon);
-    EXPECT_EQ(secondToken.line, 1ULL);
-    EXPECT_EQ(secondToken.column, 5ULL);
-    EXPECT_EQ(secondToken.content, std::wstring(L"}"));
+    EXPECT_EQ(secondToken.offset, 4U);
+    EXPECT_EQ(lexer.GetSpelling(secondToken), std::string("}"));
   }
 
   TEST(GetToken, TwoTokenNoSecond)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"   ("));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("   ("));
 
     Vypr::CLangToken firstToken = lexer.GetToken();
     Vypr::CLangToken secondToken = lexer.GetToken();
 
     EXPECT_EQ(firstToken.type, Vypr::CLangTokenType::LeftParenthesis);
-    EXPECT_EQ(firstToken.line, 1ULL);
-    EXPECT_EQ(firstToken.column, 4ULL);
-    EXPECT_EQ(firstToken.content, std::wstring(L"("));
+    EXPECT_EQ(firstToken.offset, 3U);
+    EXPECT_EQ(lexer.GetSpelling(firstToken), std::string("("));
 
     EXPECT_EQ(secondToken.type, Vypr::CLangTokenType::NoToken);
-    EXPECT_EQ(secondToken.line, 0ULL);
-    EXPECT_EQ(secondToken.column, 0ULL);
-    EXPECT_TRUE(secondToken.content.empty());
+    EXPECT_EQ(secondToken.offset, Vypr::CLangToken::NoPosition);
+    EXPECT_TRUE(lexer.GetSpelling(secondToken).empty());
   }
 
   TEST(PeekToken, TwoToken)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"hi 123"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("hi 123"));
 
     Vypr::CLangToken firstToken = lexer.PeekToken();
     Vypr::CLangToken secondToken = lexer.PeekToken();
 
     EXPECT_EQ(firstToken.type, secondToken.type);
-    EXPECT_EQ(firstToken.line, secondToken.line);
-    EXPECT_EQ(firstToken.column, secondToken.column);
-    EXPECT_EQ(firstToken.content, secondToken.content);
+    EXPECT_EQ(firstToken.offset, secondToken.offset);
+    EXPECT_EQ(lexer.GetSpelling(firstToken), lexer.GetSpelling(secondToken));
   }
 
   TEST(PeekToken, PeekGetToken)
   {
-    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(L"hi 123"));
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("hi 123"));
 
     Vypr::CLangToken firstToken = lexer.PeekToken();
     Vypr::CLangToken secondToken = lexer.GetToken();
 
     EXPECT_EQ(firstToken.type, secondToken.type);
-    EXPECT_EQ(firstToken.line, secondToken.line);
-    EXPECT_EQ(firstToken.column, secondToken.column);
-    EXPECT_EQ(firstToken.content, secondToken.content);
+    EXPECT_EQ(firstToken.offset, secondToken.offset);
+    EXPECT_EQ(lexer.GetSpelling(firstToken), lexer.GetSpelling(secondToken));
+  }
+
+  TEST(Mark, ResetReplaysTokens)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("( int ) x"));
+
+    lexer.GetToken();
+    Vypr::TokenMark mark = lexer.Mark();
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "int");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), ")");
+    lexer.Reset(mark);
+    lexer.Release(mark);
+
+    Vypr::CLangToken token = lexer.GetToken();
+    EXPECT_EQ(lexer.GetSpelling(token), "int");
+    EXPECT_EQ(token.offset, 2U);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), ")");
+  }
+
+  TEST(Mark, KeepsPeekedToken)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a b c"));
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.PeekToken()), "a");
+    Vypr::TokenMark mark = lexer.Mark();
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "a");
+    EXPECT_EQ(lexer.GetSpelling(lexer.PeekToken()), "b");
+    lexer.Reset(mark);
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "a");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+    lexer.Reset(mark);
+    lexer.Release(mark);
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.PeekToken()), "a");
+    EXPECT_EQ(lexer.GetToken().offset, 0U);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "c");
+  }
+
+  TEST(Mark, PeekAfterMark)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a b"));
+
+    Vypr::TokenMark mark = lexer.Mark();
+    EXPECT_EQ(lexer.GetSpelling(lexer.PeekToken()), "a");
+    lexer.Reset(mark);
+    lexer.Release(mark);
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "a");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+  }
+
+  TEST(Mark, Nested)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a b c d"));
+
+    Vypr::TokenMark outer = lexer.Mark();
+    lexer.GetToken();
+    Vypr::TokenMark inner = lexer.Mark();
+    lexer.GetToken();
+    lexer.GetToken();
+    lexer.Reset(inner);
+    lexer.Release(inner);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+    lexer.Reset(outer);
+    lexer.Release(outer);
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "a");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "c");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "d");
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::NoToken);
+  }
+
+  TEST(PeekToken, LookAhead)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("( int ) x"));
+
+    EXPECT_EQ(lexer.PeekToken(2).type, Vypr::CLangTokenType::RightParenthesis);
+    EXPECT_EQ(lexer.PeekToken(1).type, Vypr::CLangTokenType::IntegerType);
+    EXPECT_EQ(lexer.PeekToken(4).type, Vypr::CLangTokenType::NoToken);
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::LeftParenthesis);
+    EXPECT_EQ(lexer.PeekToken(2).type, Vypr::CLangTokenType::Identifier);
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::IntegerType);
+  }
+
+  TEST(PeekToken, DropsConsumedTokens)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a b c d"));
+
+    lexer.PeekToken(1);
+    lexer.GetToken();
+    lexer.GetToken();
+    lexer.PeekToken();
+
+    EXPECT_EQ(lexer.GetTokens().GetSize(), 1U);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "c");
+  }
+
+  TEST(Tokenize, MatchesGetToken)
+  {
+    const char *source = "int x = (a << 2) + 0x1F; // c\n\"s\" 'q' 1.5e3f";
+    Vypr::CLangLexer expected(std::make_unique<Vypr::StringScanner>(source));
+    Vypr::CLangLexer actual(std::make_unique<Vypr::StringScanner>(source));
+
+    actual.Tokenize();
+
+    while (true)
+    {
+      Vypr::CLangToken expectedToken = expected.GetToken();
+      Vypr::CLangToken actualToken = actual.GetToken();
+      EXPECT_EQ(actualToken.type, expectedToken.type);
+      EXPECT_EQ(actualToken.offset, expectedToken.offset);
+      EXPECT_EQ(actualToken.length, expectedToken.length);
+      EXPECT_EQ(actualToken.flags, expectedToken.flags);
+      EXPECT_EQ(actual.GetSpelling(actualToken),
+                expected.GetSpelling(expectedToken));
+      if (expectedToken.type == Vypr::CLangTokenType::NoToken)
+      {
+        break;
+      }
+    }
+    EXPECT_EQ(actual.GetToken().type, Vypr::CLangTokenType::NoToken);
+  }
+
+  TEST(Tokenize, AfterGetToken)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a b c"));
+
+    lexer.GetToken();
+    lexer.Tokenize();
+
+    EXPECT_EQ(lexer.GetTokens().GetSize(), 2U);
+    EXPECT_EQ(lexer.PeekToken(1).offset, 4U);
+    EXPECT_EQ(lexer.PeekToken(2).type, Vypr::CLangTokenType::NoToken);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+  }
+
+  TEST(Tokenize, Mark)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a b c"));
+    lexer.Tokenize();
+
+    lexer.GetToken();
+    Vypr::TokenMark mark = lexer.Mark();
+    lexer.GetToken();
+    lexer.GetToken();
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::NoToken);
+    lexer.Reset(mark);
+    lexer.Release(mark);
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+  }
+
+  TEST(Tokenize, Error)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a 0b12 c"));
+
+    lexer.Tokenize();
+
+    ASSERT_EQ(lexer.GetTokens().GetSize(), 3U);
+    EXPECT_EQ(lexer.GetTokens().GetType(1), Vypr::CLangTokenType::Error);
+    EXPECT_EQ(lexer.GetTokens().GetType(2), Vypr::CLangTokenType::Identifier);
+    ASSERT_EQ(lexer.GetDiagnostics().GetCount(), 1U);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(0).id,
+              Vypr::DiagnosticId::InvalidBinaryDigit);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(0).offset, 5U);
+  }
+
+  TEST(GetToken, ErrorSpelling)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("0x1.5q + 1"));
+
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::Error);
+    EXPECT_EQ(token.length, 6U);
+    EXPECT_EQ(lexer.GetSpelling(token), "0x1.5q");
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::Add);
+    EXPECT_EQ(lexer.GetLiterals().GetNumberCount(), 0U);
+  }
+
+  TEST(GetToken, ErrorEscapeSequence)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("\"a\\q\\\"b\" c"));
+
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::Error);
+    EXPECT_EQ(lexer.GetSpelling(token), "\"a\\q\\\"b\"");
+    EXPECT_EQ(lexer.GetDiagnostics().Get(token.value).id,
+              Vypr::DiagnosticId::UnknownEscapeSequence);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(token.value).offset, 3U);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "c");
+  }
+
+  TEST(GetToken, ErrorUnterminatedString)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("\"a\nb"));
+
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::Error);
+    EXPECT_EQ(token.length, 2U);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+  }
+
+  TEST(GetToken, ErrorCharacterConstant)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("'ab' c"));
+
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::Error);
+    EXPECT_EQ(lexer.GetSpelling(token), "'ab'");
+    EXPECT_EQ(lexer.GetDiagnostics().Get(token.value).id,
+              Vypr::DiagnosticId::UnterminatedCharacterConstant);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "c");
+  }
+
+  TEST(GetToken, ErrorUniversalCharacter)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("ab\\u12\"x\" c"));
+
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::Error);
+    EXPECT_EQ(lexer.GetSpelling(token), "ab\\u12");
+    EXPECT_EQ(lexer.GetDiagnostics().Get(token.value).id,
+              Vypr::DiagnosticId::MalformedUniversalCharacter);
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::StringLiteral);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "c");
+  }
+
+  TEST(GetToken, ErrorBackslash)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("\\ b"));
+
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::Error);
+    EXPECT_EQ(token.length, 1U);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+  }
+
+  TEST(GetToken, ErrorsAreIndexed)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("1uu 2 0b3 'x"));
+
+    Vypr::CLangToken first = lexer.GetToken();
+    lexer.GetToken();
+    Vypr::CLangToken second = lexer.GetToken();
+    Vypr::CLangToken third = lexer.GetToken();
+
+    EXPECT_EQ(first.value, 0U);
+    EXPECT_EQ(second.value, 1U);
+    EXPECT_EQ(third.value, 2U);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(third.value).id,
+              Vypr::DiagnosticId::UnterminatedCharacterConstant);
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::NoToken);
+  }
+
+  TEST(GetToken, ErrorOctalDigit)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a 0758 b"));
+
+    lexer.GetToken();
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::Error);
+    EXPECT_EQ(token.length, 4U);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(token.value).id,
+              Vypr::DiagnosticId::InvalidOctalDigit);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(token.value).offset, 5U);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+  }
+
+  TEST(GetToken, ErrorConstantTooLarge)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("a 18446744073709551616 b"));
+
+    lexer.GetToken();
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::Error);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(token.value).id,
+              Vypr::DiagnosticId::ConstantTooLarge);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(token.value).offset, 2U);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+  }
+
+  /// @brief Builds a source of about `size` bytes whose chunk boundaries
+  /// fall inside comments, strings and character constants that hide
+  /// newlines, quotes and comment delimiters.
+  std::string BuildChunkedSource(size_t size)
+  {
+    const char *lines[] = {
+        "int a1 = b + 0x1F; // line comment with \"quote and /* opener\n",
+        "/* block comment\n spanning lines with ' and \" */ x = 1.5e3f;\n",
+        "s = \"// not a comment /* nor this\"; c = '\"'; d = '\\'';\n",
+        "f = \"escaped \\\" quote\" + '\n' + u8\"\\u00e9\";\n",
+        "  value_2 <<= (count >> 3) % 017 ? y : z;\n",
+        "in\\\nt spl\\\r\nit = \"a\\\nb\" /\\\n/ spliced \\\n comment\n",
+        "/* spliced *\\\n/ q = \"*/\";\n",
+    };
+
+    std::string source;
+    std::string longComment = "/*";
+    while (longComment.size() < 80 * 1024)
+    {
+      longComment += " \"unbalanced ' quotes // inside\n";
+    }
+    longComment += "*/\n";
+
+    for (size_t i = 0; source.size() < size; i++)
+    {
+      source += lines[i % std::size(lines)];
+      if (i % 5000 == 4999)
+      {
+        source += longComment;
+      }
+    }
+    return source;
+  }
+
+  void ExpectSameTokens(const std::string &source, size_t threadCount)
+  {
+    Vypr::CLangLexer expected(std::make_unique<Vypr::StringScanner>(source));
+    Vypr::CLangLexer actual(std::make_unique<Vypr::StringScanner>(source));
+
+    expected.Tokenize();
+    actual.Tokenize(threadCount);
+
+    const Vypr::TokenBuffer &expectedTokens = expected.GetTokens();
+    const Vypr::TokenBuffer &actualTokens = actual.GetTokens();
+    ASSERT_EQ(actualTokens.GetSize(), expectedTokens.GetSize());
+    for (size_t i = 0; i < expectedTokens.GetSize(); i++)
+    {
+      Vypr::CLangToken expectedToken = expectedTokens[i];
+      Vypr::CLangToken actualToken = actualTokens[i];
+      ASSERT_EQ(actualToken.type, expectedToken.type) << i;
+      ASSERT_EQ(actualToken.offset, expectedToken.offset) << i;
+      ASSERT_EQ(actualToken.length, expectedToken.length) << i;
+      ASSERT_EQ(actualToken.flags, expectedToken.flags) << i;
+      ASSERT_EQ(actualToken.value, expectedToken.value) << i;
+      ASSERT_EQ(actual.GetSpelling(actualToken),
+                expected.GetSpelling(expectedToken))
+          << i;
+    }
+    EXPECT_EQ(actual.GetIdentifiers().GetCount(),
+              expected.GetIdentifiers().GetCount());
+    EXPECT_EQ(actual.GetLiterals().GetCount(),
+              expected.GetLiterals().GetCount());
+    EXPECT_EQ(actual.GetLiterals().GetNumberCount(),
+              expected.GetLiterals().GetNumberCount());
+    ASSERT_EQ(actual.GetDiagnostics().GetCount(),
+              expected.GetDiagnostics().GetCount());
+    for (uint32_t i = 0; i < expected.GetDiagnostics().GetCount(); i++)
+    {
+      EXPECT_EQ(actual.GetDiagnostics().Get(i).id,
+                expected.GetDiagnostics().Get(i).id);
+      EXPECT_EQ(actual.GetDiagnostics().Get(i).offset,
+                expected.GetDiagnostics().Get(i).offset);
+    }
+    EXPECT_EQ(actual.GetToken().type, expectedTokens[0].type);
+  }
+
+  TEST(Tokenize, ParallelMatchesSequential)
+  {
+    ExpectSameTokens(BuildChunkedSource(1 << 20), 4);
+  }
+
+  TEST(Tokenize, ParallelManyChunks)
+  {
+    ExpectSameTokens(BuildChunkedSource(1 << 20), 16);
+  }
+
+  TEST(Tokenize, ParallelSmallSource)
+  {
+    ExpectSameTokens(BuildChunkedSource(1024), 4);
+  }
+
+  TEST(Tokenize, ParallelSharedIdentifiers)
+  {
+    std::string source = BuildChunkedSource(1 << 20);
+    auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+    Vypr::Identifier first = identifiers->Intern("first");
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source),
+                           identifiers);
+
+    lexer.Tokenize(4);
+    lexer.GetToken();
+    Vypr::Identifier second = lexer.GetToken().GetIdentifier();
+
+    EXPECT_EQ(identifiers->GetName(first), "first");
+    EXPECT_EQ(identifiers->GetName(second), "a1");
+    EXPECT_EQ(static_cast<uint32_t>(second), static_cast<uint32_t>(first) + 1);
+  }
+
+  TEST(Tokenize, ParallelErrors)
+  {
+    const char *errors[] = {"x = 0b12;\n", "'\n\n", "\"a\\\n/* b\n",
+                            "''/* c\n", "\"d\\q\" '\\\n'\n", "e\\u1\"/*\"\n"};
+    std::string source = BuildChunkedSource(1 << 20);
+    for (size_t i = 0; i < 64; i++)
+    {
+      size_t line = source.find('\n', source.size() * i / 64) + 1;
+      source.insert(line, errors[i % std::size(errors)]);
+    }
+
+    ExpectSameTokens(source, 16);
+  }
+
+  TEST(GetToken, InternsIdentifiers)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("alpha beta alpha int"));
+
+    Vypr::Identifier first = lexer.GetToken().GetIdentifier();
+    Vypr::Identifier second = lexer.GetToken().GetIdentifier();
+    Vypr::Identifier third = lexer.GetToken().GetIdentifier();
+    Vypr::CLangToken keyword = lexer.GetToken();
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(first, third);
+    EXPECT_EQ(lexer.GetIdentifiers().GetName(first), "alpha");
+    EXPECT_EQ(keyword.GetIdentifier(), Vypr::Identifier::None);
+    EXPECT_EQ(lexer.GetIdentifiers().GetCount(), 2U);
+  }
+
+  TEST(GetToken, Length)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("while >>= 0x1Fu \"a\\n\""));
+
+    EXPECT_EQ(lexer.GetToken().length, 5U);
+    EXPECT_EQ(lexer.GetToken().length, 3U);
+    EXPECT_EQ(lexer.GetToken().length, 5U);
+    EXPECT_EQ(lexer.GetToken().length, 5U);
+  }
+
+  TEST(GetToken, Flags)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(
+        "  a b/* x\n */c // y\n  d\ne"));
+
+    EXPECT_EQ(lexer.GetToken().flags,
+              Vypr::CLangToken::StartOfLine | Vypr::CLangToken::LeadingSpace);
+    EXPECT_EQ(lexer.GetToken().flags, Vypr::CLangToken::LeadingSpace);
+    EXPECT_EQ(lexer.GetToken().flags, Vypr::CLangToken::LeadingSpace);
+    EXPECT_EQ(lexer.GetToken().flags,
+              Vypr::CLangToken::StartOfLine | Vypr::CLangToken::LeadingSpace);
+    EXPECT_EQ(lexer.GetToken().flags,
+              Vypr::CLangToken::StartOfLine | Vypr::CLangToken::LeadingSpace);
+  }
+
+  TEST(GetToken, FlagsAdjacent)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a+b"));
+
+    EXPECT_EQ(lexer.GetToken().flags, Vypr::CLangToken::StartOfLine);
+    EXPECT_EQ(lexer.GetToken().flags, 0);
+    EXPECT_EQ(lexer.GetToken().flags, 0);
+  }
+
+  TEST(GetToken, SplicedIdentifier)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("in\\\nt x"));
+
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::IntegerType);
+    EXPECT_EQ(token.offset, 0U);
+    EXPECT_EQ(token.length, 5U);
+    EXPECT_EQ(token.flags,
+              Vypr::CLangToken::StartOfLine | Vypr::CLangToken::Spliced);
+    EXPECT_EQ(lexer.GetSpelling(token), "int");
+    token = lexer.GetToken();
+    EXPECT_EQ(lexer.GetSpelling(token), "x");
+    EXPECT_EQ(token.flags, Vypr::CLangToken::LeadingSpace);
+  }
+
+  TEST(GetToken, SplicedPunctuatorAndNumber)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("a <\\\n<= 1\\\r\n2u"));
+
+    lexer.GetToken();
+    Vypr::CLangToken shift = lexer.GetToken();
+    Vypr::CLangToken number = lexer.GetToken();
+
+    EXPECT_EQ(shift.type, Vypr::CLangTokenType::LeftShiftAssign);
+    EXPECT_EQ(shift.length, 5U);
+    EXPECT_EQ(number.type, Vypr::CLangTokenType::IntegerConstant);
+    EXPECT_EQ(number.offset, 8U);
+    EXPECT_EQ(number.length, 6U);
+    EXPECT_EQ(lexer.GetLiterals().GetNumber(number.value).integer, 12U);
+    EXPECT_EQ(lexer.GetLiterals().GetNumber(number.value).suffix,
+              Vypr::NumericLiteral::Unsigned);
+  }
+
+  TEST(GetToken, SpliceBetweenTokens)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("a\\\n+\\\n b"));
+
+    EXPECT_EQ(lexer.GetToken().flags, Vypr::CLangToken::StartOfLine);
+    Vypr::CLangToken plus = lexer.GetToken();
+    EXPECT_EQ(plus.type, Vypr::CLangTokenType::Add);
+    EXPECT_EQ(plus.flags, 0);
+    EXPECT_EQ(lexer.GetToken().flags, Vypr::CLangToken::LeadingSpace);
+  }
+
+  TEST(GetToken, SplicedLiterals)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(
+        "\"a\\\nb\\\r\nc\" '\\\nd\\\n'"));
+
+    Vypr::CLangToken string = lexer.GetToken();
+    Vypr::CLangToken character = lexer.GetToken();
+
+    EXPECT_EQ(string.type, Vypr::CLangTokenType::StringLiteral);
+    EXPECT_EQ(string.length, 10U);
+    EXPECT_EQ(lexer.GetSpelling(string), "abc");
+    EXPECT_EQ(character.type, Vypr::CLangTokenType::CharacterConstant);
+    EXPECT_EQ(lexer.GetSpelling(character), "d");
+  }
+
+  TEST(GetToken, SplicedComments)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(
+        "a // x \\\n y\nb /\\\n/ c\nd /\\\n* e */ f"));
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "a");
+    Vypr::CLangToken token = lexer.GetToken();
+    EXPECT_EQ(lexer.GetSpelling(token), "b");
+    EXPECT_EQ(token.flags,
+              Vypr::CLangToken::StartOfLine | Vypr::CLangToken::LeadingSpace);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "d");
+    token = lexer.GetToken();
+    EXPECT_EQ(lexer.GetSpelling(token), "f");
+    EXPECT_EQ(token.flags, Vypr::CLangToken::LeadingSpace);
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::NoToken);
+  }
+
+  TEST(GetToken, SplicedCommentEnd)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(
+        "/* a *\\\n/y /* *\\ */ z /* **\\\r\n\\\n/ w"));
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "y");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "z");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "w");
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::NoToken);
+  }
+
+  TEST(GetSpelling, FromSource)
+  {
+    std::string source = "return x <<= 0B101;";
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "return");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "x");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "<<=");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "0B101");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), ";");
+    EXPECT_TRUE(lexer.GetSpelling(lexer.GetToken()).empty());
+    EXPECT_EQ(lexer.GetLiterals().GetNumberCount(), 1U);
   }
 
 #define TEST_IDENT_GET_TOKEN(name, testStr)                                    \
@@ -175,20 +742,21 @@ namespace CLangLexerTest
     Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(testStr));    \
     Vypr::CLangToken token = lexer.GetToken();                                 \
     EXPECT_EQ(token.type, Vypr::CLangTokenType::Identifier);                   \
-    EXPECT_EQ(token.line, 1ULL);                                               \
-    EXPECT_EQ(token.column, 1ULL);                                             \
-    EXPECT_EQ(token.content, std::wstring(testStr));                           \
+    EXPECT_EQ(token.offset, 0U);                                               \
+    EXPECT_EQ(lexer.GetSpelling(token), std::string(testStr));                 \
   }
 
-  TEST_IDENT_GET_TOKEN(OnlyLowercase, L"alexander");
-  TEST_IDENT_GET_TOKEN(OnlyUppercase, L"ALEXANDER");
-  TEST_IDENT_GET_TOKEN(CamelCase, L"gramBell");
-  TEST_IDENT_GET_TOKEN(SnakeCase, L"gram_bell");
-  TEST_IDENT_GET_TOKEN(PascalCase, L"VisualStudio");
-  TEST_IDENT_GET_TOKEN(LeadingUnderscore, L"_unusedVariable");
-  TEST_IDENT_GET_TOKEN(WithDigits, L"commander1234");
-  TEST_IDENT_GET_TOKEN(SingleLetter, L"i");
-  TEST_IDENT_GET_TOKEN(Unicode, L"◕‿◕");
+  TEST_IDENT_GET_TOKEN(OnlyLowercase, "alexander");
+  TEST_IDENT_GET_TOKEN(OnlyUppercase, "ALEXANDER");
+  TEST_IDENT_GET_TOKEN(CamelCase, "gramBell");
+  TEST_IDENT_GET_TOKEN(SnakeCase, "gram_bell");
+  TEST_IDENT_GET_TOKEN(PascalCase, "VisualStudio");
+  TEST_IDENT_GET_TOKEN(LeadingUnderscore, "_unusedVariable");
+  TEST_IDENT_GET_TOKEN(WithDigits, "commander1234");
+  TEST_IDENT_GET_TOKEN(SingleLetter, "i");
+  TEST_IDENT_GET_TOKEN(Unicode, "◕‿◕");
+  TEST_IDENT_GET_TOKEN(Long, "a_long_identifier_spanning_several_blocks_0");
+  TEST_IDENT_GET_TOKEN(DollarSign, "price$total");
 
 #define TEST_IDENT_GET_TOKEN_W_RESULT(name, testStr, result)                   \
   TEST(GetToken, Identifier##name)                                             \
@@ -196,197 +764,226 @@ namespace CLangLexerTest
     Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(testStr));    \
     Vypr::CLangToken token = lexer.GetToken();                                 \
     EXPECT_EQ(token.type, Vypr::CLangTokenType::Identifier);                   \
-    EXPECT_EQ(token.line, 1ULL);                                               \
-    EXPECT_EQ(token.column, 1ULL);                                             \
-    EXPECT_EQ(token.content, std::wstring(result));                            \
-  }
-
-  TEST_IDENT_GET_TOKEN_W_RESULT(Universal4, L"\\u2343abc", L"\u2343abc");
-  TEST_IDENT_GET_TOKEN_W_RESULT(Universal8, L"\\U00029617abc",
-                                L"\U00029617abc");
-  TEST_IDENT_GET_TOKEN_W_RESULT(Universal8NoHigh, L"\\U00009617abc",
-                                L"\U00009617abc");
-  TEST_IDENT_GET_TOKEN_W_RESULT(Universal4Inside, L"hello\\u2343there",
-                                L"hello\u2343there");
-  TEST_IDENT_GET_TOKEN_W_RESULT(Universal8Inside, L"hello\\U00029617there",
-                                L"hello\U00029617there");
-
-  TEST_GET_TOKEN(Keyword, Auto, L"auto");
-  TEST_GET_TOKEN(Keyword, Break, L"break");
-  TEST_GET_TOKEN(Keyword, Case, L"case");
-  TEST_GET_TOKEN(Keyword, CharType, L"char");
-  TEST_GET_TOKEN(Keyword, DoubleType, L"double");
-  TEST_GET_TOKEN(Keyword, IntegerType, L"int");
-  TEST_GET_TOKEN(Keyword, FloatType, L"float");
-  TEST_GET_TOKEN(Keyword, LongType, L"long");
-  TEST_GET_TOKEN(Keyword, ShortType, L"short");
-  TEST_GET_TOKEN(Keyword, Const, L"const");
-  TEST_GET_TOKEN(Keyword, Continue, L"continue");
-  TEST_GET_TOKEN(Keyword, Default, L"default");
-  TEST_GET_TOKEN(Keyword, Do, L"do");
-  TEST_GET_TOKEN(Keyword, Else, L"else");
-  TEST_GET_TOKEN(Keyword, Enumeration, L"enum");
-  TEST_GET_TOKEN(Keyword, Extern, L"extern");
-  TEST_GET_TOKEN(Keyword, For, L"for");
-  TEST_GET_TOKEN(Keyword, Goto, L"goto");
-  TEST_GET_TOKEN(Keyword, If, L"if");
-  TEST_GET_TOKEN(Keyword, Inline, L"inline");
-  TEST_GET_TOKEN(Keyword, Register, L"register");
-  TEST_GET_TOKEN(Keyword, Restrict, L"restrict");
-  TEST_GET_TOKEN(Keyword, Return, L"return");
-  TEST_GET_TOKEN(Keyword, Signed, L"signed");
-  TEST_GET_TOKEN(Keyword, Sizeof, L"sizeof");
-  TEST_GET_TOKEN(Keyword, Static, L"static");
-  TEST_GET_TOKEN(Keyword, Struct, L"struct");
-  TEST_GET_TOKEN(Keyword, Switch, L"switch");
-  TEST_GET_TOKEN(Keyword, Typedef, L"typedef");
-  TEST_GET_TOKEN(Keyword, Union, L"union");
-  TEST_GET_TOKEN(Keyword, Unsigned, L"unsigned");
-  TEST_GET_TOKEN(Keyword, Void, L"void");
-  TEST_GET_TOKEN(Keyword, Volatile, L"volatile");
-  TEST_GET_TOKEN(Keyword, While, L"while");
-  TEST_GET_TOKEN(Keyword, AlignAs, L"_Alignas");
-  TEST_GET_TOKEN(Keyword, AlignOf, L"_Alignof");
-  TEST_GET_TOKEN(Keyword, Atomic, L"_Atomic");
-  TEST_GET_TOKEN(Keyword, Boolean, L"_Bool");
-  TEST_GET_TOKEN(Keyword, Complex, L"_Complex");
-  TEST_GET_TOKEN(Keyword, Generic, L"_Generic");
-  TEST_GET_TOKEN(Keyword, Imaginary, L"_Imaginary");
-  TEST_GET_TOKEN(Keyword, NoReturn, L"_Noreturn");
-  TEST_GET_TOKEN(Keyword, StaticAssert, L"_Static_assert");
-  TEST_GET_TOKEN(Keyword, ThreadLocal, L"_Thread_local");
-
-#define TEST_GET_TOKEN_CONSTANT(name, testStr, resultStr, tokenType)           \
+    EXPECT_EQ(token.offset, 0U);                                               \
+    EXPECT_EQ(lexer.GetSpelling(token), std::string(result));                  \
+  }
+
+  TEST_IDENT_GET_TOKEN_W_RESULT(Universal4, "\\u2343abc", "\u2343abc");
+  TEST_IDENT_GET_TOKEN_W_RESULT(Universal8, "\\U00029617abc",
+                                "\U00029617abc");
+  TEST_IDENT_GET_TOKEN_W_RESULT(Universal8NoHigh, "\\U00009617abc",
+                                "\U00009617abc");
+  TEST_IDENT_GET_TOKEN_W_RESULT(Universal4Inside, "hello\\u2343there",
+                                "hello\u2343there");
+  TEST_IDENT_GET_TOKEN_W_RESULT(Universal8Inside, "hello\\U00029617there",
+                                "hello\U00029617there");
+
+  TEST_GET_TOKEN(Keyword, Auto, "auto");
+  TEST_GET_TOKEN(Keyword, Break, "break");
+  TEST_GET_TOKEN(Keyword, Case, "case");
+  TEST_GET_TOKEN(Keyword, CharType, "char");
+  TEST_GET_TOKEN(Keyword, DoubleType, "double");
+  TEST_GET_TOKEN(Keyword, IntegerType, "int");
+  TEST_GET_TOKEN(Keyword, FloatType, "float");
+  TEST_GET_TOKEN(Keyword, LongType, "long");
+  TEST_GET_TOKEN(Keyword, ShortType, "short");
+  TEST_GET_TOKEN(Keyword, Const, "const");
+  TEST_GET_TOKEN(Keyword, Continue, "continue");
+  TEST_GET_TOKEN(Keyword, Default, "default");
+  TEST_GET_TOKEN(Keyword, Do, "do");
+  TEST_GET_TOKEN(Keyword, Else, "else");
+  TEST_GET_TOKEN(Keyword, Enumeration, "enum");
+  TEST_GET_TOKEN(Keyword, Extern, "extern");
+  TEST_GET_TOKEN(Keyword, For, "for");
+  TEST_GET_TOKEN(Keyword, Goto, "goto");
+  TEST_GET_TOKEN(Keyword, If, "if");
+  TEST_GET_TOKEN(Keyword, Inline, "inline");
+  TEST_GET_TOKEN(Keyword, Register, "register");
+  TEST_GET_TOKEN(Keyword, Restrict, "restrict");
+  TEST_GET_TOKEN(Keyword, Return, "return");
+  TEST_GET_TOKEN(Keyword, Signed, "signed");
+  TEST_GET_TOKEN(Keyword, Sizeof, "sizeof");
+  TEST_GET_TOKEN(Keyword, Static, "static");
+  TEST_GET_TOKEN(Keyword, Struct, "struct");
+  TEST_GET_TOKEN(Keyword, Switch, "switch");
+  TEST_GET_TOKEN(Keyword, Typedef, "typedef");
+  TEST_GET_TOKEN(Keyword, Union, "union");
+  TEST_GET_TOKEN(Keyword, Unsigned, "unsigned");
+  TEST_GET_TOKEN(Keyword, Void, "void");
+  TEST_GET_TOKEN(Keyword, Volatile, "volatile");
+  TEST_GET_TOKEN(Keyword, While, "while");
+  TEST_GET_TOKEN(Keyword, AlignAs, "_Alignas");
+  TEST_GET_TOKEN(Keyword, AlignOf, "_Alignof");
+  TEST_GET_TOKEN(Keyword, Atomic, "_Atomic");
+  TEST_GET_TOKEN(Keyword, Boolean, "_Bool");
+  TEST_GET_TOKEN(Keyword, Complex, "_Complex");
+  TEST_GET_TOKEN(Keyword, Generic, "_Generic");
+  TEST_GET_TOKEN(Keyword, Imaginary, "_Imaginary");
+  TEST_GET_TOKEN(Keyword, NoReturn, "_Noreturn");
+  TEST_GET_TOKEN(Keyword, StaticAssert, "_Static_assert");
+  TEST_GET_TOKEN(Keyword, ThreadLocal, "_Thread_local");
+
+  constexpr uint8_t U = Vypr::NumericLiteral::Unsigned;
+  constexpr uint8_t L = Vypr::NumericLiteral::Long;
+  constexpr uint8_t LL = Vypr::NumericLiteral::LongLong;
+  constexpr uint8_t F = Vypr::NumericLiteral::Float;
+
+#define TEST_GET_TOKEN_CONSTANT(name, testStr, tokenType, field, expected,     \
+                                suffixFlags)                                   \
   TEST(GetToken, NumericConstant##name)                                        \
   {                                                                            \
     Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(testStr));    \
                                                                                \
     Vypr::CLangToken token = lexer.GetToken();                                 \
+    const Vypr::NumericLiteral &number =                                       \
+        lexer.GetLiterals().GetNumber(token.value);                            \
                                                                                \
     EXPECT_EQ(token.type, Vypr::CLangTokenType::tokenType);                    \
-    EXPECT_EQ(token.content, resultStr);                                       \
-    EXPECT_EQ(token.line, 1);                                                  \
-    EXPECT_EQ(token.column, 1);                                                \
+    EXPECT_EQ(token.offset, 0U);                                               \
+    EXPECT_EQ(lexer.GetSpelling(token), testStr);                              \
+    EXPECT_EQ(number.field, expected);                                         \
+    EXPECT_EQ(number.suffix, suffixFlags);                                     \
   }
 
-#define TEST_GET_TOKEN_CONSTANT_INTEGER(name, testStr, resultStr)              \
-  TEST_GET_TOKEN_CONSTANT(name, testStr, resultStr, IntegerConstant)
+#define TEST_GET_TOKEN_CONSTANT_INTEGER(name, testStr, value, suffixFlags)     \
+  TEST_GET_TOKEN_CONSTANT(name, testStr, IntegerConstant, integer,             \
+                          static_cast<uint64_t>(value), suffixFlags)
 
-#define TEST_GET_TOKEN_CONSTANT_FLOAT(name, testStr, resultStr)                \
-  TEST_GET_TOKEN_CONSTANT(name, testStr, resultStr, FloatConstant)
+#define TEST_GET_TOKEN_CONSTANT_FLOAT(name, testStr, value, suffixFlags)       \
+  TEST_GET_TOKEN_CONSTANT(name, testStr, FloatConstant, real,                  \
+                          static_cast<double>(value), suffixFlags)
 
-#define TEST_GET_TOKEN_THROW(name, testStr)                                    \
+#define TEST_GET_TOKEN_ERROR(name, testStr)                                    \
   TEST(GetToken, NumericConstant##name)                                        \
   {                                                                            \
     Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(testStr));    \
                                                                                \
-    EXPECT_THROW((void)lexer.GetToken(), Vypr::ParsingException);              \
-  }
-
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinaryZero, L"0b0", L"0b0");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinaryOne, L"0b1", L"0b1");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinaryCommon, L"0b101", L"0b101");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinaryBigLetter, L"0B1", L"0b1");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixU, L"0B1U", L"0b1u");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixu, L"0B1u", L"0b1u");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixL, L"0B1L", L"0b1l");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixl, L"0B1l", L"0b1l");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixUL, L"0B1ul", L"0b1ul");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixLU, L"0B1lu", L"0b1lu");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixLL, L"0B1ll", L"0b1ll");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixULL, L"0B1ull", L"0b1ull");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixLLU, L"0B1llu", L"0b1llu");
-  TEST_GET_TOKEN_THROW(BinaryBadNum, L"0b21");
-  TEST_GET_TOKEN_THROW(BinaryBadSuffix, L"0b1A");
-  TEST_GET_TOKEN_THROW(BinarySuffixUU, L"0b1UU");
-  TEST_GET_TOKEN_THROW(BinarySuffixLUL, L"0b2LUL");
-
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexZero, L"0x0", L"0x0");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexOne, L"0x1", L"0x1");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexCommon, L"0xDED", L"0xded");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexBigLetter, L"0X1", L"0x1");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixU, L"0x1U", L"0x1u");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixu, L"0x1u", L"0x1u");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixL, L"0x1L", L"0x1l");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixl, L"0x1l", L"0x1l");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixUL, L"0x1ul", L"0x1ul");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixLU, L"0x1lu", L"0x1lu");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixLL, L"0x1ll", L"0x1ll");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixULL, L"0x1ull", L"0x1ull");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixLLU, L"0x1llu", L"0x1llu");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPoint, L"0xDED.ADp3", L"0xded.adp3");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointNoBase, L"0x.ADp3", L"0x.adp3");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointNoFraction, L"0x1.p3",
-                                L"0x1.p3");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointLongExponent, L"0x.ADp323",
-                                L"0x.adp323");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointUppercaseExponent, L"0x.ADP323",
-                                L"0x.adp323");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointZeroExponent, L"0xded.ADp0",
-                                L"0xded.adp0");
+    Vypr::CLangToken token = lexer.GetToken();                                 \
+                                                                               \
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::Error);                        \
+    EXPECT_EQ(token.offset, 0U);                                               \
+    EXPECT_EQ(lexer.GetDiagnostics().GetCount(), 1U);                          \
+    EXPECT_EQ(token.value, 0U);                                                \
+  }
+
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinaryZero, "0b0", 0b0, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinaryOne, "0b1", 0b1, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinaryCommon, "0b101", 0b101, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinaryBigLetter, "0B1", 0b1, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixU, "0B1U", 0b1, U);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixu, "0B1u", 0b1, U);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixL, "0B1L", 0b1, L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixl, "0B1l", 0b1, L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixUL, "0B1ul", 0b1, U | L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixLU, "0B1lu", 0b1, U | L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixLL, "0B1ll", 0b1, LL);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixULL, "0B1ull", 0b1, U | LL);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(BinarySuffixLLU, "0B1llu", 0b1, U | LL);
+  TEST_GET_TOKEN_ERROR(BinaryBadNum, "0b21");
+  TEST_GET_TOKEN_ERROR(BinaryBadSuffix, "0b1A");
+  TEST_GET_TOKEN_ERROR(BinarySuffixUU, "0b1UU");
+  TEST_GET_TOKEN_ERROR(BinarySuffixLUL, "0b2LUL");
+
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexZero, "0x0", 0x0, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexOne, "0x1", 0x1, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexCommon, "0xDED", 0xded, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexBigLetter, "0X1", 0x1, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixU, "0x1U", 0x1, U);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixu, "0x1u", 0x1, U);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixL, "0x1L", 0x1, L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixl, "0x1l", 0x1, L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixUL, "0x1ul", 0x1, U | L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixLU, "0x1lu", 0x1, U | L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixLL, "0x1ll", 0x1, LL);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixULL, "0x1ull", 0x1, U | LL);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexSuffixLLU, "0x1llu", 0x1, U | LL);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPoint, "0xDED.ADp3", 0xded.adp3, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointNoBase, "0x.ADp3", 0x.adp3, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointNoFraction, "0x1.p3",
+                                0x1.p3, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointLongExponent, "0x.ADp323",
+                                0x.adp323, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointUppercaseExponent, "0x.ADP323",
+                                0x.adp323, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointZeroExponent, "0xded.ADp0",
+                                0xded.adp0, 0);
   TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointPositiveExponent,
-                                L"0xded.ADp+323", L"0xded.adp+323");
+                                "0xded.ADp+323", 0xded.adp+323, 0);
   TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointNegativeExponent,
-                                L"0xded.ADp-323", L"0xded.adp-323");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointSuffixF, L"0xDED.ADp3F",
-                                L"0xded.adp3f");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointSuffixf, L"0xDED.ADp3f",
-                                L"0xded.adp3f");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointSuffixL, L"0xDED.ADp3L",
-                                L"0xded.adp3l");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointSuffixl, L"0xDED.ADp3l",
-                                L"0xded.adp3l");
-  TEST_GET_TOKEN_THROW(HexBadSuffix, L"0x21Z");
-  TEST_GET_TOKEN_THROW(HexSuffixUU, L"0xaEUU");
-  TEST_GET_TOKEN_THROW(HexSuffixLUL, L"0xdelul");
-  TEST_GET_TOKEN_THROW(HexDecimalOnly, L"0x3.");
-  TEST_GET_TOKEN_THROW(HexNoBaseNoFraction, L"0x.p3");
-  TEST_GET_TOKEN_THROW(HexNoExponent, L"0x12.12p");
-
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalZero, L"0", L"0");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalOne, L"1", L"1");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalCommon, L"145", L"145");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixU, L"1U", L"1u");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixu, L"1u", L"1u");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixL, L"1L", L"1l");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixl, L"1l", L"1l");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixUL, L"1ul", L"1ul");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixLU, L"1lu", L"1lu");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixLL, L"1ll", L"1ll");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixULL, L"1ull", L"1ull");
-  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixLLU, L"1llu", L"1llu");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatSuffixOnly, L"3F", L"3f");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointNoFraction, L"12e3",
-                                L"12e3");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointZeroExponent, L"12e0",
-                                L"12e0");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointPositiveExponent, L"12e+23",
-                                L"12e+23");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointNegativeExponent, L"12e-23",
-                                L"12e-23");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalZeroExponent, L"0e3", L"0e3");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalZeroFloat, L"0.0", L"0.0");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalZeroFloatNoFraction, L"0.", L"0.");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPoint, L"1434.23e3",
-                                L"1434.23e3");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointNoBase, L".12", L".12");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointNoExponent, L"12.0",
-                                L"12.0");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointLongExponent, L"12.0e123",
-                                L"12.0e123");
+                                "0xded.ADp-323", 0xded.adp-323, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointSuffixF, "0xDED.ADp3F",
+                                0xded.adp3f, F);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointSuffixf, "0xDED.ADp3f",
+                                0xded.adp3f, F);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointSuffixL, "0xDED.ADp3L",
+                                0xded.adp3, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(HexFloatingPointSuffixl, "0xDED.ADp3l",
+                                0xded.adp3, 0);
+  TEST_GET_TOKEN_ERROR(HexBadSuffix, "0x21Z");
+  TEST_GET_TOKEN_ERROR(HexSuffixUU, "0xaEUU");
+  TEST_GET_TOKEN_ERROR(HexSuffixLUL, "0xdelul");
+  TEST_GET_TOKEN_ERROR(HexDecimalOnly, "0x3.");
+  TEST_GET_TOKEN_ERROR(HexNoBaseNoFraction, "0x.p3");
+  TEST_GET_TOKEN_ERROR(HexNoExponent, "0x12.12p");
+
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalZero, "0", 0, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalOne, "1", 1, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalCommon, "145", 145, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixU, "1U", 1, U);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixu, "1u", 1, U);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixL, "1L", 1, L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixl, "1l", 1, L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixUL, "1ul", 1, U | L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixLU, "1lu", 1, U | L);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixLL, "1ll", 1, LL);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixULL, "1ull", 1, U | LL);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalSuffixLLU, "1llu", 1, U | LL);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatSuffixOnly, "3F", 3.0f, F);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointNoFraction, "12e3",
+                                12e3, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointZeroExponent, "12e0",
+                                12e0, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointPositiveExponent, "12e+23",
+                                12e+23, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointNegativeExponent, "12e-23",
+                                12e-23, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalZeroExponent, "0e3", 0e3, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalZeroFloat, "0.0", 0.0, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalZeroFloatNoFraction, "0.", 0., 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPoint, "1434.23e3",
+                                1434.23e3, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointNoBase, ".12", .12, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointNoExponent, "12.0",
+                                12.0, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointLongExponent, "12.0e123",
+                                12.0e123, 0);
   TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointUppercaseExponent,
-                                L"12.0E123", L"12.0e123");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointSuffixF, L"23.3F",
-                                L"23.3f");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointSuffixf, L"23.3f",
-                                L"23.3f");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointSuffixL, L"23.3L",
-                                L"23.3l");
-  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointSuffixl, L"23.3l",
-                                L"23.3l");
-  TEST_GET_TOKEN_THROW(DecimalBadSuffix, L"12.0Z");
-  TEST_GET_TOKEN_THROW(DecimalSuffixUU, L"12UU");
-  TEST_GET_TOKEN_THROW(DecimalSuffixLUL, L"12lul");
+                                "12.0E123", 12.0e123, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointSuffixF, "23.3F", 23.3f, F);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointSuffixf, "23.3f", 23.3f, F);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointSuffixL, "23.3L", 23.3, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatingPointSuffixl, "23.3l", 23.3, 0);
+  TEST_GET_TOKEN_ERROR(DecimalBadSuffix, "12.0Z");
+  TEST_GET_TOKEN_ERROR(DecimalSuffixUU, "12UU");
+  TEST_GET_TOKEN_ERROR(DecimalSuffixLUL, "12lul");
+  TEST_GET_TOKEN_ERROR(DecimalSuffixLLL, "12lll");
+
+  TEST_GET_TOKEN_CONSTANT_INTEGER(OctalCommon, "0755", 0755, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(OctalMax, "01777777777777777777777",
+                                  01777777777777777777777, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalMax, "18446744073709551615u",
+                                  18446744073709551615u, U);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(DecimalLeadingZeros, "000000000000000000001",
+                                  1, 0);
+  TEST_GET_TOKEN_CONSTANT_INTEGER(HexMax, "0xFFFFFFFFFFFFFFFF",
+                                  0xFFFFFFFFFFFFFFFF, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalLeadingZeroFloat, "0129.5", 129.5, 0);
+  TEST_GET_TOKEN_CONSTANT_FLOAT(DecimalFloatOutOfRange, "1e100f", 1e100, 0);
+  TEST_GET_TOKEN_ERROR(OctalBadDigit, "0758");
+  TEST_GET_TOKEN_ERROR(OctalTooLarge, "02000000000000000000000");
+  TEST_GET_TOKEN_ERROR(DecimalTooLarge, "18446744073709551616");
+  TEST_GET_TOKEN_ERROR(HexTooLarge, "0x10000000000000000");
+  TEST_GET_TOKEN_ERROR(DecimalFloatTooLarge, "1e400");
 
 #define TEST_GET_TOKEN_CHAR_CONSTANT(name, testStr, resultStr)                 \
   TEST(GetToken, CharacterConstant##name)                                      \
@@ -396,31 +993,32 @@ namespace CLangLexerTest
     Vypr::CLangToken token = lexer.GetToken();                                 \
                                                                                \
     EXPECT_EQ(token.type, Vypr::CLangTokenType::CharacterConstant);            \
-    EXPECT_EQ(token.content, resultStr);                                       \
-    EXPECT_EQ(token.line, 1);                                                  \
-    EXPECT_EQ(token.column, 1);                                                \
-  }
-
-  TEST_GET_TOKEN_CHAR_CONSTANT(RegularCharacter, L"'a'", L"a");
-  TEST_GET_TOKEN_CHAR_CONSTANT(AlertCharacter, L"'\\a'", L"\a");
-  TEST_GET_TOKEN_CHAR_CONSTANT(BackspaceCharacter, L"'\\b'", L"\b");
-  TEST_GET_TOKEN_CHAR_CONSTANT(EscapeCharacter, L"'\\e'", L"\e");
-  TEST_GET_TOKEN_CHAR_CONSTANT(FormfeedCharacter, L"'\\f'", L"\f");
-  TEST_GET_TOKEN_CHAR_CONSTANT(NewlineCharacter, L"'\\n'", L"\n");
-  TEST_GET_TOKEN_CHAR_CONSTANT(CarriageReturnCharacter, L"'\\r'", L"\r");
-  TEST_GET_TOKEN_CHAR_CONSTANT(TabCharacter, L"'\\t'", L"\t");
-  TEST_GET_TOKEN_CHAR_CONSTANT(VerticalTabCharacter, L"'\\v'", L"\v");
-  TEST_GET_TOKEN_CHAR_CONSTANT(BackslashCharacter, L"'\\\\'", L"\\");
-  TEST_GET_TOKEN_CHAR_CONSTANT(SingleQuoteCharacter, L"'\\''", L"\'");
-  TEST_GET_TOKEN_CHAR_CONSTANT(DoubleQuoteCharacter, L"'\\\"'", L"\"");
-  TEST_GET_TOKEN_CHAR_CONSTANT(QuestionMarkCharacter, L"'\\?'", L"\?");
-  TEST_GET_TOKEN_CHAR_CONSTANT(OctalMarkCharacter, L"'\101'", L"A");
-  TEST_GET_TOKEN_CHAR_CONSTANT(HexMarkCharacter, L"'\x65'", L"e");
-  TEST_GET_TOKEN_CHAR_CONSTANT(Unicode16MarkCharacter, L"'\u0065'", L"e");
-  TEST_GET_TOKEN_CHAR_CONSTANT(Unicode32MarkCharacter, L"'\U00000065'", L"e");
-  TEST_GET_TOKEN_THROW(MissingTerminator, L"'a");
-  TEST_GET_TOKEN_THROW(MissingContent, L"''");
-  TEST_GET_TOKEN_THROW(TooMuchContent, L"'aa'");
+    EXPECT_EQ(lexer.GetSpelling(token), resultStr);                            \
+    EXPECT_EQ(token.offset, 0U);                                               \
+  }
+
+  TEST_GET_TOKEN_CHAR_CONSTANT(RegularCharacter, "'a'", "a");
+  TEST_GET_TOKEN_CHAR_CONSTANT(AlertCharacter, "'\\a'", "\a");
+  TEST_GET_TOKEN_CHAR_CONSTANT(BackspaceCharacter, "'\\b'", "\b");
+  TEST_GET_TOKEN_CHAR_CONSTANT(EscapeCharacter, "'\\e'", "\e");
+  TEST_GET_TOKEN_CHAR_CONSTANT(FormfeedCharacter, "'\\f'", "\f");
+  TEST_GET_TOKEN_CHAR_CONSTANT(NewlineCharacter, "'\\n'", "\n");
+  TEST_GET_TOKEN_CHAR_CONSTANT(CarriageReturnCharacter, "'\\r'", "\r");
+  TEST_GET_TOKEN_CHAR_CONSTANT(TabCharacter, "'\\t'", "\t");
+  TEST_GET_TOKEN_CHAR_CONSTANT(VerticalTabCharacter, "'\\v'", "\v");
+  TEST_GET_TOKEN_CHAR_CONSTANT(BackslashCharacter, "'\\\\'", "\\");
+  TEST_GET_TOKEN_CHAR_CONSTANT(SingleQuoteCharacter, "'\\''", "\'");
+  TEST_GET_TOKEN_CHAR_CONSTANT(DoubleQuoteCharacter, "'\\\"'", "\"");
+  TEST_GET_TOKEN_CHAR_CONSTANT(QuestionMarkCharacter, "'\\?'", "\?");
+  TEST_GET_TOKEN_CHAR_CONSTANT(OctalMarkCharacter, "'\101'", "A");
+  TEST_GET_TOKEN_CHAR_CONSTANT(HexMarkCharacter, "'\x65'", "e");
+  TEST_GET_TOKEN_CHAR_CONSTANT(Unicode16MarkCharacter, "'\u0065'", "e");
+  TEST_GET_TOKEN_CHAR_CONSTANT(Unicode32MarkCharacter, "'\U00000065'", "e");
+  TEST_GET_TOKEN_CHAR_CONSTANT(HexEscapeCharacter, "'\\x41'", "A");
+  TEST_GET_TOKEN_CHAR_CONSTANT(Utf8Character, "'\xC3\xA9'", "\xC3\xA9");
+  TEST_GET_TOKEN_ERROR(MissingTerminator, "'a");
+  TEST_GET_TOKEN_ERROR(MissingContent, "''");
+  TEST_GET_TOKEN_ERROR(TooMuchContent, "'aa'");
 
 #define TEST_GET_TOKEN_STRING_CONSTANT(name, testStr, resultStr)               \
   TEST(GetToken, StringLiteral##name)                                          \
@@ -430,81 +1028,126 @@ namespace CLangLexerTest
     Vypr::CLangToken token = lexer.GetToken();                                 \
                                                                                \
     EXPECT_EQ(token.type, Vypr::CLangTokenType::StringLiteral);                \
-    EXPECT_EQ(token.content, resultStr);                                       \
-    EXPECT_EQ(token.line, 1);                                                  \
-    EXPECT_EQ(token.column, 1);                                                \
+    EXPECT_EQ(lexer.GetSpelling(token), resultStr);                            \
+    EXPECT_EQ(token.offset, 0U);                                               \
   }
 
-  TEST_GET_TOKEN_STRING_CONSTANT(CommonString, L"\"helloworld\"",
-                                 L"helloworld");
-  TEST_GET_TOKEN_STRING_CONSTANT(NewLineString, L"\"hello\\nworld\"",
-                                 L"hello\nworld");
-  TEST_GET_TOKEN_STRING_CONSTANT(EmptyString, L"\"\"", L"");
-  TEST_GET_TOKEN_THROW(MissingTerminatorStringLiteral, L"\"a");
-  TEST_GET_TOKEN_THROW(NewlineInStringLiteral, L"\"a\n\"");
+  TEST_GET_TOKEN_STRING_CONSTANT(CommonString, "\"helloworld\"",
+                                 "helloworld");
+  TEST_GET_TOKEN_STRING_CONSTANT(NewLineString, "\"hello\\nworld\"",
+                                 "hello\nworld");
+  TEST_GET_TOKEN_STRING_CONSTANT(EmptyString, "\"\"", "");
+  TEST_GET_TOKEN_STRING_CONSTANT(UniversalCharacterString,
+                                 "\"caf\\u00e9\"", "caf\xC3\xA9");
+  TEST_GET_TOKEN_STRING_CONSTANT(EscapesBetweenRuns,
+                                 "\"tab\\there \\x41\\101\\u00e9 \\\"end\\\"\"",
+                                 "tab\there AA\xC3\xA9 \"end\"");
+  TEST_GET_TOKEN_ERROR(MissingTerminatorStringLiteral, "\"a");
+  TEST_GET_TOKEN_ERROR(NewlineInStringLiteral, "\"a\n\"");
+
+  TEST(GetToken, StringLiteralErrorDropsValue)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("\"ab\\qcd\" \"ok\""));
+
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::Error);
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::StringLiteral);
+    EXPECT_EQ(lexer.GetSpelling(token), "ok");
+    EXPECT_EQ(lexer.GetLiterals().GetCount(), 1U);
+    EXPECT_EQ(lexer.GetLiterals().Join(0, 0), "ok");
+  }
 
   TEST(GetToken, SingleLineComment)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"// Hello\nint"));
+        std::make_unique<Vypr::StringScanner>("// Hello\nint"));
 
     Vypr::CLangToken token = lexer.GetToken();
 
     EXPECT_EQ(token.type, Vypr::CLangTokenType::IntegerType);
-    EXPECT_EQ(token.column, 1);
-    EXPECT_EQ(token.line, 2);
-    EXPECT_EQ(token.content, L"int");
+    Vypr::SourceLocation location =
+        lexer.GetSourceManager().GetLocation(token.offset);
+    EXPECT_EQ(location.line, 2U);
+    EXPECT_EQ(location.column, 1U);
+    EXPECT_EQ(lexer.GetSpelling(token), "int");
   }
 
   TEST(GetToken, MultiLineOneLineComment)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"/* Hello */int"));
+        std::make_unique<Vypr::StringScanner>("/* Hello */int"));
 
     Vypr::CLangToken token = lexer.GetToken();
 
     EXPECT_EQ(token.type, Vypr::CLangTokenType::IntegerType);
-    EXPECT_EQ(token.column, 12);
-    EXPECT_EQ(token.line, 1);
-    EXPECT_EQ(token.content, L"int");
+    EXPECT_EQ(token.offset, 11U);
+    EXPECT_EQ(lexer.GetSpelling(token), "int");
   }
 
   TEST(GetToken, MultiLineSplitLineComment)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"/* Hello */\nint"));
+        std::make_unique<Vypr::StringScanner>("/* Hello */\nint"));
 
     Vypr::CLangToken token = lexer.GetToken();
 
     EXPECT_EQ(token.type, Vypr::CLangTokenType::IntegerType);
-    EXPECT_EQ(token.column, 1);
-    EXPECT_EQ(token.line, 2);
-    EXPECT_EQ(token.content, L"int");
+    Vypr::SourceLocation location =
+        lexer.GetSourceManager().GetLocation(token.offset);
+    EXPECT_EQ(location.line, 2U);
+    EXPECT_EQ(location.column, 1U);
+    EXPECT_EQ(lexer.GetSpelling(token), "int");
   }
 
   TEST(GetToken, MultiLineManyLineComment)
   {
     Vypr::CLangLexer lexer(
-        std::make_unique<Vypr::StringScanner>(L"/* \nHello \n*/\nint"));
+        std::make_unique<Vypr::StringScanner>("/* \nHello \n*/\nint"));
+
+    Vypr::CLangToken token = lexer.GetToken();
+
+    EXPECT_EQ(token.type, Vypr::CLangTokenType::IntegerType);
+    Vypr::SourceLocation location =
+        lexer.GetSourceManager().GetLocation(token.offset);
+    EXPECT_EQ(location.line, 4U);
+    EXPECT_EQ(location.column, 1U);
+    EXPECT_EQ(lexer.GetSpelling(token), "int");
+  }
+
+  TEST(GetToken, LongCommentsAndWhitespace)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(
+        "/*****************************************************************\n"
+        " * License text that spans several vector blocks ** / * /\n"
+        " *****************************************************************/\n"
+        "                                        // trailing comment *\n"
+        "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+        "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\tint"));
 
     Vypr::CLangToken token = lexer.GetToken();
 
     EXPECT_EQ(token.type, Vypr::CLangTokenType::IntegerType);
-    EXPECT_EQ(token.column, 1);
-    EXPECT_EQ(token.line, 4);
-    EXPECT_EQ(token.content, L"int");
+    Vypr::SourceLocation location =
+        lexer.GetSourceManager().GetLocation(token.offset);
+    EXPECT_EQ(location.line, 5U);
+    EXPECT_EQ(location.column, 36U);
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::NoToken);
   }
 
   TEST(GetToken, ManyTokens)
   {
     Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(
-        L"hi 33.2f \nint i = 0;/* \nHello \n*/\nint"));
+        "hi 33.2f \nint i = 0;/* \nHello \n*/\nint"));
 
     std::vector<std::tuple<Vypr::CLangTokenType, size_t, size_t>> tokens;
     Vypr::CLangToken token = lexer.GetToken();
     while (token.type != Vypr::CLangTokenType::NoToken)
     {
-      tokens.push_back({token.type, token.column, token.line});
+      Vypr::SourceLocation location =
+          lexer.GetSourceManager().GetLocation(token.offset);
+      tokens.push_back({token.type, location.column, location.line});
       token = lexer.GetToken();
     }
 
@@ -524,6 +1167,242 @@ namespace CLangLexerTest
       auto &[type, col, line] = tokens[i];
       auto &[ttype, tcol, tline] = groundTruth[i];
       ASSERT_EQ(type, ttype);
+      EXPECT_EQ(col, tcol);
+      EXPECT_EQ(line, tline);
+    }
+  }
+
+  /// @brief Applies an edit to a source and to its tokens, then checks them
+  /// against tokens lexed from scratch.
+  ///
+  /// @returns Number of tokens that were lexed again.
+  size_t ExpectRelexed(Vypr::CLangLexer &lexer, std::string &source,
+                       uint32_t offset, uint32_t removedLength,
+                       const std::string &inserted)
+  {
+    source.replace(offset, removedLength, inserted);
+    size_t relexed = lexer.Relex(
+        {.offset = offset,
+         .removedLength = removedLength,
+         .insertedLength = static_cast<uint32_t>(inserted.size())},
+        std::make_unique<Vypr::StringScanner>(source));
+
+    Vypr::CLangLexer expected(std::make_unique<Vypr::StringScanner>(source));
+    expected.Tokenize();
+    const Vypr::TokenBuffer &expectedTokens = expected.GetTokens();
+    const Vypr::TokenBuffer &actualTokens = lexer.GetTokens();
+    EXPECT_EQ(actualTokens.GetSize(), expectedTokens.GetSize()) << source;
+    for (size_t i = 0;
+         i < std::min(actualTokens.GetSize(), expectedTokens.GetSize()); i++)
+    {
+      Vypr::CLangToken expectedToken = expectedTokens[i];
+      Vypr::CLangToken actualToken = actualTokens[i];
+      EXPECT_EQ(actualToken.type, expectedToken.type) << i << source;
+      EXPECT_EQ(actualToken.offset, expectedToken.offset) << i << source;
+      EXPECT_EQ(actualToken.length, expectedToken.length) << i << source;
+      EXPECT_EQ(actualToken.flags, expectedToken.flags) << i << source;
+      EXPECT_EQ(lexer.GetSpelling(actualToken),
+                expected.GetSpelling(expectedToken))
+          << i << source;
+      if (expectedToken.type == Vypr::CLangTokenType::Error)
+      {
+        EXPECT_EQ(actualToken.value, expectedToken.value) << i << source;
+      }
     }
+
+    const Vypr::DiagnosticSink &diagnostics = lexer.GetDiagnostics();
+    EXPECT_EQ(diagnostics.GetCount(), expected.GetDiagnostics().GetCount())
+        << source;
+    for (uint32_t i = 0; i < std::min(diagnostics.GetCount(),
+                                      expected.GetDiagnostics().GetCount());
+         i++)
+    {
+      EXPECT_EQ(diagnostics.Get(i).id, expected.GetDiagnostics().Get(i).id)
+          << i << source;
+      EXPECT_EQ(diagnostics.Get(i).offset,
+                expected.GetDiagnostics().Get(i).offset)
+          << i << source;
+    }
+    return relexed;
+  }
+
+  TEST(Relex, ReplaceIdentifier)
+  {
+    std::string source = "int alpha = beta + 1;\nreturn alpha;\n";
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+    lexer.Tokenize();
+
+    ExpectRelexed(lexer, source, 12, 4, "gamma");
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "int");
+  }
+
+  TEST(Relex, JoinsPunctuators)
+  {
+    std::string source = "a + +b; c < = d; e - > f;";
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+    lexer.Tokenize();
+
+    ExpectRelexed(lexer, source, 3, 1, "");
+    ExpectRelexed(lexer, source, 10, 1, "");
+    ExpectRelexed(lexer, source, 18, 1, "");
+    ExpectRelexed(lexer, source, 18, 0, " ");
+  }
+
+  TEST(Relex, OpensAndClosesComment)
+  {
+    std::string source = "a = 1;\nb = 2;\nc = 3;\nd = 4;\n";
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+    lexer.Tokenize();
+
+    ExpectRelexed(lexer, source, 7, 0, "/*");
+    ExpectRelexed(lexer, source, 23, 0, "*/");
+    ExpectRelexed(lexer, source, 7, 2, "");
+    ExpectRelexed(lexer, source, 0, 0, "\"");
+    ExpectRelexed(lexer, source, 0, 1, "");
+  }
+
+  TEST(Relex, Splices)
+  {
+    std::string source = "int a\\\nb = c;\nd = e;\n";
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+    lexer.Tokenize();
+
+    ExpectRelexed(lexer, source, 7, 0, "x");
+    ExpectRelexed(lexer, source, 7, 1, " ");
+    ExpectRelexed(lexer, source, 6, 1, "");
+    ExpectRelexed(lexer, source, 13, 0, "\\");
+  }
+
+  TEST(Relex, KeepsDiagnosticsInOrder)
+  {
+    std::string source = "a = 0b2; b = ''; c = '\\q'; d = 09;";
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+    lexer.Tokenize();
+
+    ExpectRelexed(lexer, source, 13, 2, "'x'");
+    ExpectRelexed(lexer, source, 4, 0, "'' + ");
+    ExpectRelexed(lexer, source, 0, 0, "0b3 ");
+    ExpectRelexed(lexer, source, 0, 9, "");
+  }
+
+  TEST(Relex, LocalEditRelexesFewTokens)
+  {
+    std::string source = BuildChunkedSource(64 * 1024);
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+    lexer.Tokenize();
+    size_t size = lexer.GetTokens().GetSize();
+
+    size_t offset = source.find("value_2", source.size() / 2);
+    size_t relexed = ExpectRelexed(lexer, source,
+                                   static_cast<uint32_t>(offset), 0, "x");
+
+    EXPECT_LE(relexed, 2U);
+    EXPECT_EQ(lexer.GetTokens().GetSize(), size);
+  }
+
+  TEST(Relex, RandomEdits)
+  {
+    const char *snippets[] = {"/*", "*/", "\"", "'", "\n", "x", "1",
+                              ".",  "+",  "=",  " ", "\\", "0x", "e"};
+    std::mt19937 random(19);
+    std::string source = BuildChunkedSource(4096);
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+    lexer.Tokenize();
+
+    for (int i = 0; i < 300 && !HasFailure(); i++)
+    {
+      uint32_t offset = static_cast<uint32_t>(random() % (source.size() + 1));
+      uint32_t removed = static_cast<uint32_t>(
+          std::min<size_t>(random() % 4, source.size() - offset));
+      std::string inserted = random() % 3 == 0
+                                 ? std::string()
+                                 : snippets[random() % std::size(snippets)];
+
+      ExpectRelexed(lexer, source, offset, removed, inserted);
+    }
+  }
+
+  TEST(StartPipeline, SameTokens)
+  {
+    std::string source = BuildChunkedSource(256 * 1024) + "a = 0b2 + 'x';";
+    Vypr::CLangLexer expected(std::make_unique<Vypr::StringScanner>(source));
+    Vypr::CLangLexer actual(std::make_unique<Vypr::StringScanner>(source));
+    expected.Tokenize();
+
+    actual.StartPipeline();
+
+    const Vypr::TokenBuffer &expectedTokens = expected.GetTokens();
+    for (size_t i = 0; i < expectedTokens.GetSize(); i++)
+    {
+      Vypr::CLangToken expectedToken = expectedTokens[i];
+      Vypr::CLangToken actualToken = actual.GetToken();
+      ASSERT_EQ(actualToken.type, expectedToken.type) << i;
+      ASSERT_EQ(actualToken.offset, expectedToken.offset) << i;
+      ASSERT_EQ(actualToken.length, expectedToken.length) << i;
+      ASSERT_EQ(actualToken.flags, expectedToken.flags) << i;
+      ASSERT_EQ(actualToken.value, expectedToken.value) << i;
+      ASSERT_EQ(actual.GetSpelling(actualToken),
+                expected.GetSpelling(expectedToken))
+          << i;
+      if (expectedToken.type == Vypr::CLangTokenType::IntegerConstant)
+      {
+        EXPECT_EQ(actual.GetLiterals().GetNumber(actualToken.value).integer,
+                  expected.GetLiterals()
+                      .GetNumber(expectedToken.value)
+                      .integer);
+      }
+    }
+    EXPECT_EQ(actual.GetToken().type, Vypr::CLangTokenType::NoToken);
+    EXPECT_EQ(actual.GetToken().type, Vypr::CLangTokenType::NoToken);
+    ASSERT_EQ(actual.GetDiagnostics().GetCount(),
+              expected.GetDiagnostics().GetCount());
+    EXPECT_EQ(actual.GetDiagnostics().Get(0).offset,
+              expected.GetDiagnostics().Get(0).offset);
+  }
+
+  TEST(StartPipeline, PeekAndMark)
+  {
+    Vypr::CLangLexer lexer(
+        std::make_unique<Vypr::StringScanner>("int a = b * 2;"));
+    lexer.StartPipeline();
+
+    EXPECT_EQ(lexer.PeekToken(2).type, Vypr::CLangTokenType::Assign);
+    Vypr::TokenMark mark = lexer.Mark();
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::IntegerType);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "a");
+    lexer.Reset(mark);
+    lexer.Release(mark);
+
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::IntegerType);
+    lexer.Tokenize();
+    EXPECT_EQ(lexer.GetTokens().GetSize(), 7U);
+  }
+
+  TEST(StartPipeline, StopsWithLexer)
+  {
+    std::string source = BuildChunkedSource(4 << 20);
+    {
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+      lexer.StartPipeline();
+
+      EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::IntegerType);
+    }
+    {
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source));
+      lexer.StartPipeline();
+    }
+  }
+
+  TEST(StartPipeline, AfterReading)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>("a b c"));
+    lexer.GetToken();
+
+    lexer.StartPipeline();
+
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "b");
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "c");
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::NoToken);
   }
 } // namespace CLangLexerTest
\ No newline at end of file
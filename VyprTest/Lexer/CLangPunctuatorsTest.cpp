@@ -0,0 +1,111 @@
+#include "Vypr/Lexer/CLangPunctuators.hpp"
+
+#include <gtest/gtest.h>
+#include <string_view>
+
+namespace CLangPunctuatorsTest
+{
+  struct Spelling
+  {
+    std::string_view text;
+    Vypr::CLangTokenType type;
+  };
+
+  constexpr Spelling Punctuators[] = {
+      {"[", Vypr::CLangTokenType::LeftBracket},
+      {"]", Vypr::CLangTokenType::RightBracket},
+      {"(", Vypr::CLangTokenType::LeftParenthesis},
+      {")", Vypr::CLangTokenType::RightParenthesis},
+      {"{", Vypr::CLangTokenType::LeftDragon},
+      {"}", Vypr::CLangTokenType::RightDragon},
+      {".", Vypr::CLangTokenType::Period},
+      {"->", Vypr::CLangTokenType::Arrow},
+      {"++", Vypr::CLangTokenType::Increment},
+      {"--", Vypr::CLangTokenType::Decrement},
+      {"*", Vypr::CLangTokenType::Star},
+      {"+", Vypr::CLangTokenType::Add},
+      {"-", Vypr::CLangTokenType::Subtract},
+      {"~", Vypr::CLangTokenType::Tilde},
+      {"!", Vypr::CLangTokenType::Exclamation},
+      {"/", Vypr::CLangTokenType::Divide},
+      {"%", Vypr::CLangTokenType::Modulo},
+      {"<<", Vypr::CLangTokenType::ShiftLeft},
+      {">>", Vypr::CLangTokenType::ShiftRight},
+      {"<", Vypr::CLangTokenType::LessThan},
+      {">", Vypr::CLangTokenType::GreaterThan},
+      {"<=", Vypr::CLangTokenType::LessEqual},
+      {">=", Vypr::CLangTokenType::GreaterEqual},
+      {"==", Vypr::CLangTokenType::Equal},
+      {"!=", Vypr::CLangTokenType::NotEqual},
+      {"&", Vypr::CLangTokenType::And},
+      {"|", Vypr::CLangTokenType::Or},
+      {"^", Vypr::CLangTokenType::Xor},
+      {"&&", Vypr::CLangTokenType::LogicalAnd},
+      {"||", Vypr::CLangTokenType::LogicalOr},
+      {"?", Vypr::CLangTokenType::TernaryProposition},
+      {":", Vypr::CLangTokenType::TernaryDecision},
+      {";", Vypr::CLangTokenType::StatementDelimiter},
+      {"...", Vypr::CLangTokenType::Variadic},
+      {"=", Vypr::CLangTokenType::Assign},
+      {"*=", Vypr::CLangTokenType::MultiplyAssign},
+      {"/=", Vypr::CLangTokenType::DivideAssign},
+      {"%=", Vypr::CLangTokenType::ModuloAssign},
+      {"+=", Vypr::CLangTokenType::AddAssign},
+      {"-=", Vypr::CLangTokenType::SubtractAssign},
+      {"<<=", Vypr::CLangTokenType::LeftShiftAssign},
+      {">>=", Vypr::CLangTokenType::RightShiftAssign},
+      {"&=", Vypr::CLangTokenType::AndAssign},
+      {"^=", Vypr::CLangTokenType::XorAssign},
+      {"|=", Vypr::CLangTokenType::OrAssign},
+      {",", Vypr::CLangTokenType::Comma},
+      {"#", Vypr::CLangTokenType::Preprocessor},
+      {"##", Vypr::CLangTokenType::PreprocessorConcat}};
+
+  Vypr::CLangPunctuator Find(std::string_view text)
+  {
+    auto at = [&](size_t i) { return i < text.size() ? text[i] : '\0'; };
+    return Vypr::FindPunctuator(at(0), at(1), at(2));
+  }
+
+  TEST(FindPunctuator, AllPunctuators)
+  {
+    for (const Spelling &punctuator : Punctuators)
+    {
+      Vypr::CLangPunctuator found = Find(punctuator.text);
+      EXPECT_EQ(found.type, punctuator.type) << punctuator.text;
+      EXPECT_EQ(found.length, punctuator.text.size()) << punctuator.text;
+    }
+  }
+
+  TEST(FindPunctuator, MaximalMunch)
+  {
+    EXPECT_EQ(Find("<<=").length, 3U);
+    EXPECT_EQ(Find("<<<").type, Vypr::CLangTokenType::ShiftLeft);
+    EXPECT_EQ(Find("..").type, Vypr::CLangTokenType::Period);
+    EXPECT_EQ(Find("..").length, 1U);
+    EXPECT_EQ(Find("+++").type, Vypr::CLangTokenType::Increment);
+    EXPECT_EQ(Find("->=").type, Vypr::CLangTokenType::Arrow);
+  }
+
+  TEST(FindPunctuator, NotPunctuator)
+  {
+    EXPECT_EQ(Find("a+").type, Vypr::CLangTokenType::NoToken);
+    EXPECT_EQ(Find("a+").length, 0U);
+  }
+
+  TEST(GetPunctuatorSpelling, AllPunctuators)
+  {
+    for (const Spelling &punctuator : Punctuators)
+    {
+      EXPECT_EQ(Vypr::GetPunctuatorSpelling(punctuator.type), punctuator.text);
+    }
+  }
+
+  TEST(GetPunctuatorSpelling, NotPunctuator)
+  {
+    EXPECT_TRUE(
+        Vypr::GetPunctuatorSpelling(Vypr::CLangTokenType::While).empty());
+    EXPECT_TRUE(
+        Vypr::GetPunctuatorSpelling(Vypr::CLangTokenType::Identifier).empty());
+  }
+} // namespace CLangPunctuatorsTest
@@ -0,0 +1,149 @@
+#include "Vypr/Lexer/CLangSplitPoints.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace CLangSplitPointsTest
+{
+  /// @brief Asking for a chunk per byte returns every usable line start.
+  std::vector<uint32_t> FindLineStarts(std::string_view source)
+  {
+    return Vypr::FindSplitPoints(source, source.size());
+  }
+
+  uint32_t OffsetOf(std::string_view source, std::string_view text)
+  {
+    return static_cast<uint32_t>(source.find(text));
+  }
+
+  TEST(FindSplitPoints, Empty)
+  {
+    EXPECT_TRUE(Vypr::FindSplitPoints("", 4).empty());
+  }
+
+  TEST(FindSplitPoints, SingleChunk)
+  {
+    EXPECT_TRUE(Vypr::FindSplitPoints("a\nb\nc\n", 1).empty());
+  }
+
+  TEST(FindSplitPoints, LineStarts)
+  {
+    EXPECT_EQ(FindLineStarts("a\nb\nc"), (std::vector<uint32_t>{2, 4}));
+  }
+
+  TEST(FindSplitPoints, TrailingNewline)
+  {
+    EXPECT_EQ(FindLineStarts("a\nb\n"), (std::vector<uint32_t>{2}));
+  }
+
+  TEST(FindSplitPoints, LongLine)
+  {
+    std::string source(1000, 'a');
+    source += "\nb";
+
+    EXPECT_EQ(Vypr::FindSplitPoints(source, 4),
+              (std::vector<uint32_t>{1001}));
+  }
+
+  TEST(FindSplitPoints, Targets)
+  {
+    std::string source;
+    for (int i = 0; i < 100; i++)
+    {
+      source += "line\n";
+    }
+
+    EXPECT_EQ(Vypr::FindSplitPoints(source, 4),
+              (std::vector<uint32_t>{125, 250, 375}));
+  }
+
+  TEST(FindSplitPoints, BlockComment)
+  {
+    std::string_view source = "a /* b\nc\n*/ d\ne";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "e")}));
+  }
+
+  TEST(FindSplitPoints, LineComment)
+  {
+    std::string_view source = "a // /* b\nc\nd */";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "c"),
+                                     OffsetOf(source, "d")}));
+  }
+
+  TEST(FindSplitPoints, SplicedLines)
+  {
+    std::string_view source = "a \\\nb\\\r\nc\nd // e\\\nf\ng";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "d"),
+                                     OffsetOf(source, "g")}));
+  }
+
+  TEST(FindSplitPoints, SplicedBlockCommentEnd)
+  {
+    std::string_view source = "a /* b *\\\n/ c\nd /* *\\ */\ne";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "d"),
+                                     OffsetOf(source, "e")}));
+  }
+
+  TEST(FindSplitPoints, CommentInString)
+  {
+    std::string_view source = "\"/*\" a\nb /* c\nd */\ne";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "b"),
+                                     OffsetOf(source, "e")}));
+  }
+
+  TEST(FindSplitPoints, EscapedQuoteInString)
+  {
+    std::string_view source = "\"\\\"/*\" a\nb";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "b")}));
+  }
+
+  TEST(FindSplitPoints, DoubleQuoteCharacter)
+  {
+    std::string_view source = "'\"' /* a\nb */\nc";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "c")}));
+  }
+
+  TEST(FindSplitPoints, EscapedQuoteCharacter)
+  {
+    std::string_view source = "'\\'' /* a\nb */\nc";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "c")}));
+  }
+
+  TEST(FindSplitPoints, NewlineCharacter)
+  {
+    std::string_view source = "'\n' /* a\nb */\nc";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "c")}));
+  }
+
+  TEST(FindSplitPoints, UnterminatedString)
+  {
+    std::string_view source = "\"abc\nd";
+
+    EXPECT_EQ(FindLineStarts(source),
+              (std::vector<uint32_t>{OffsetOf(source, "d")}));
+  }
+
+  TEST(FindSplitPoints, UnterminatedComment)
+  {
+    EXPECT_TRUE(FindLineStarts("a /* b\nc\n").empty());
+  }
+} // namespace CLangSplitPointsTest
@@ -0,0 +1,70 @@
+#include "Vypr/Lexer/DiagnosticSink.hpp"
+
+#include <gtest/gtest.h>
+
+namespace DiagnosticSinkTest
+{
+  TEST(Report, Indexes)
+  {
+    Vypr::DiagnosticSink diagnostics;
+
+    uint32_t first =
+        diagnostics.Report(Vypr::DiagnosticId::InvalidBinaryDigit, 4);
+    uint32_t second =
+        diagnostics.Report(Vypr::DiagnosticId::UnknownEscapeSequence, 9);
+
+    EXPECT_EQ(first, 0U);
+    EXPECT_EQ(second, 1U);
+    EXPECT_EQ(diagnostics.GetCount(), 2U);
+    EXPECT_EQ(diagnostics.Get(first).id,
+              Vypr::DiagnosticId::InvalidBinaryDigit);
+    EXPECT_EQ(diagnostics.Get(second).offset, 9U);
+  }
+
+  TEST(Append, OffsetsPositions)
+  {
+    Vypr::DiagnosticSink diagnostics;
+    Vypr::DiagnosticSink other;
+    diagnostics.Report(Vypr::DiagnosticId::InvalidBinaryDigit, 4);
+    other.Report(Vypr::DiagnosticId::EmptyCharacterConstant, 2);
+
+    uint32_t first = diagnostics.Append(other, 100);
+
+    EXPECT_EQ(first, 1U);
+    EXPECT_EQ(diagnostics.Get(first).id,
+              Vypr::DiagnosticId::EmptyCharacterConstant);
+    EXPECT_EQ(diagnostics.Get(first).offset, 102U);
+  }
+
+  TEST(Splice, ReplacesRangeWithNewest)
+  {
+    Vypr::DiagnosticSink diagnostics;
+    diagnostics.Report(Vypr::DiagnosticId::InvalidBinaryDigit, 1);
+    diagnostics.Report(Vypr::DiagnosticId::EmptyCharacterConstant, 5);
+    diagnostics.Report(Vypr::DiagnosticId::UnknownEscapeSequence, 9);
+    diagnostics.Report(Vypr::DiagnosticId::InvalidOctalDigit, 4);
+    diagnostics.Report(Vypr::DiagnosticId::ConstantTooLarge, 6);
+
+    diagnostics.Splice(1, 1, 3, 2);
+
+    ASSERT_EQ(diagnostics.GetCount(), 4U);
+    EXPECT_EQ(diagnostics.Get(0).offset, 1U);
+    EXPECT_EQ(diagnostics.Get(1).id, Vypr::DiagnosticId::InvalidOctalDigit);
+    EXPECT_EQ(diagnostics.Get(2).id, Vypr::DiagnosticId::ConstantTooLarge);
+    EXPECT_EQ(diagnostics.Get(3).id,
+              Vypr::DiagnosticId::UnknownEscapeSequence);
+    EXPECT_EQ(diagnostics.Get(3).offset, 11U);
+  }
+
+  TEST(GetMessage, EveryId)
+  {
+    for (int id = 0;
+         id <= static_cast<int>(Vypr::DiagnosticId::InvalidTokenPaste);
+         id++)
+    {
+      EXPECT_NE(Vypr::DiagnosticSink::GetMessage(
+                    static_cast<Vypr::DiagnosticId>(id)),
+                "Unknown error");
+    }
+  }
+} // namespace DiagnosticSinkTest
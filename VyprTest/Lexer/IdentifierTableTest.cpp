@@ -0,0 +1,67 @@
+#include "Vypr/Lexer/IdentifierTable.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace IdentifierTableTest
+{
+  TEST(Intern, RepeatedName)
+  {
+    Vypr::IdentifierTable identifiers;
+
+    Vypr::Identifier first = identifiers.Intern("alpha");
+    Vypr::Identifier second = identifiers.Intern(std::string("alpha"));
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(identifiers.GetCount(), 1U);
+  }
+
+  TEST(Intern, DistinctNames)
+  {
+    Vypr::IdentifierTable identifiers;
+
+    Vypr::Identifier alpha = identifiers.Intern("alpha");
+    Vypr::Identifier beta = identifiers.Intern("beta");
+
+    EXPECT_NE(alpha, beta);
+    EXPECT_EQ(identifiers.GetName(alpha), "alpha");
+    EXPECT_EQ(identifiers.GetName(beta), "beta");
+  }
+
+  TEST(Intern, CopiesName)
+  {
+    Vypr::IdentifierTable identifiers;
+    std::string name = "gamma";
+
+    Vypr::Identifier gamma = identifiers.Intern(name);
+    name[0] = 'x';
+
+    EXPECT_EQ(identifiers.GetName(gamma), "gamma");
+    EXPECT_EQ(identifiers.Find("gamma"), gamma);
+  }
+
+  TEST(Intern, StableNames)
+  {
+    Vypr::IdentifierTable identifiers;
+    Vypr::Identifier first = identifiers.Intern("first");
+    std::string_view name = identifiers.GetName(first);
+
+    for (int i = 0; i < 10000; i++)
+    {
+      identifiers.Intern("name_" + std::to_string(i));
+    }
+    identifiers.Intern(std::string(100000, 'x'));
+
+    EXPECT_EQ(name.data(), identifiers.GetName(first).data());
+    EXPECT_EQ(identifiers.GetName(identifiers.Find("name_9999")),
+              "name_9999");
+    EXPECT_EQ(identifiers.GetCount(), 10002U);
+  }
+
+  TEST(Find, Missing)
+  {
+    Vypr::IdentifierTable identifiers;
+
+    EXPECT_EQ(identifiers.Find("delta"), Vypr::Identifier::None);
+  }
+} // namespace IdentifierTableTest
@@ -0,0 +1,129 @@
+#include "Vypr/Lexer/LiteralTable.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace LiteralTableTest
+{
+  TEST(Add, CopiesValue)
+  {
+    Vypr::LiteralTable literals;
+    std::string value = "0x1f";
+
+    uint32_t index = literals.Add(value);
+    value[0] = 'x';
+
+    EXPECT_EQ(literals.Get(index), "0x1f");
+  }
+
+  TEST(Add, KeepsDuplicates)
+  {
+    Vypr::LiteralTable literals;
+
+    uint32_t first = literals.Add("1");
+    uint32_t second = literals.Add("1");
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(literals.GetCount(), 2U);
+  }
+
+  TEST(Add, ManyValues)
+  {
+    Vypr::LiteralTable literals;
+    uint32_t first = literals.Add("first");
+
+    for (int i = 0; i < 10000; i++)
+    {
+      literals.Add(std::to_string(i));
+    }
+
+    EXPECT_EQ(literals.Get(first), "first");
+    EXPECT_EQ(literals.Get(first + 1), "0");
+    EXPECT_EQ(literals.Get(first + 10000), "9999");
+  }
+
+  TEST(Append, OffsetsIndices)
+  {
+    Vypr::LiteralTable literals;
+    Vypr::LiteralTable other;
+    literals.Add("1");
+    other.Add("two");
+    other.Add("");
+    other.Add("3.0");
+
+    uint32_t first = literals.Append(other);
+
+    EXPECT_EQ(first, 1U);
+    EXPECT_EQ(literals.GetCount(), 4U);
+    EXPECT_EQ(literals.Get(0), "1");
+    EXPECT_EQ(literals.Get(first), "two");
+    EXPECT_EQ(literals.Get(first + 1), "");
+    EXPECT_EQ(literals.Get(first + 2), "3.0");
+  }
+
+  TEST(AddNumber, KeepsValueAndSuffix)
+  {
+    Vypr::LiteralTable literals;
+    Vypr::NumericLiteral integer = {.integer = UINT64_MAX,
+                                    .suffix = Vypr::NumericLiteral::Unsigned};
+    Vypr::NumericLiteral real = {.real = 0.1,
+                                 .suffix = Vypr::NumericLiteral::Float};
+
+    uint32_t first = literals.AddNumber(integer);
+    uint32_t second = literals.AddNumber(real);
+
+    EXPECT_EQ(literals.GetNumberCount(), 2U);
+    EXPECT_EQ(literals.GetCount(), 0U);
+    EXPECT_EQ(literals.GetNumber(first).integer, UINT64_MAX);
+    EXPECT_EQ(literals.GetNumber(first).suffix,
+              Vypr::NumericLiteral::Unsigned);
+    EXPECT_EQ(literals.GetNumber(second).real, 0.1);
+    EXPECT_EQ(literals.GetNumber(second).suffix, Vypr::NumericLiteral::Float);
+  }
+
+  TEST(Append, KeepsNumbers)
+  {
+    Vypr::LiteralTable literals;
+    Vypr::LiteralTable other;
+    literals.AddNumber({.integer = 1, .suffix = 0});
+    other.Add("two");
+    other.AddNumber({.integer = 3, .suffix = 0});
+
+    literals.Append(other);
+
+    EXPECT_EQ(literals.GetNumberCount(), 2U);
+    EXPECT_EQ(literals.GetNumber(0).integer, 1U);
+    EXPECT_EQ(literals.GetNumber(1).integer, 3U);
+    EXPECT_EQ(literals.Get(0), "two");
+  }
+
+  TEST(Extend, BuildsValueInPlace)
+  {
+    Vypr::LiteralTable literals;
+    literals.Add("first");
+
+    literals.Extend("sec");
+    literals.Extend("ond");
+    uint32_t second = literals.Finish();
+    literals.Extend("dropped");
+    literals.Discard();
+    literals.Extend("third");
+    uint32_t third = literals.Finish();
+
+    EXPECT_EQ(literals.GetCount(), 3U);
+    EXPECT_EQ(literals.Get(second), "second");
+    EXPECT_EQ(literals.Get(third), "third");
+  }
+
+  TEST(Join, AdjacentValues)
+  {
+    Vypr::LiteralTable literals;
+    uint32_t first = literals.Add("Hello, ");
+    literals.Add("");
+    uint32_t last = literals.Add("World");
+
+    EXPECT_EQ(literals.Join(first, last), "Hello, World");
+    EXPECT_EQ(literals.Join(last, last), "World");
+    EXPECT_EQ(literals.Join(first + 1, last), "World");
+  }
+} // namespace LiteralTableTest
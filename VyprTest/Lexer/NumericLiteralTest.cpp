@@ -0,0 +1,105 @@
+#include "Vypr/Lexer/NumericLiteral.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace NumericLiteralTest
+{
+  TEST(ConvertDigits, EveryDecimalLength)
+  {
+    std::string digits;
+    uint64_t expected = 0;
+    for (int length = 1; length <= 19; length++)
+    {
+      char digit = static_cast<char>('0' + (length * 7) % 10);
+      digits += digit;
+      expected = expected * 10 + static_cast<uint64_t>(digit - '0');
+
+      EXPECT_EQ(Vypr::ConvertDigits(digits, 10), expected) << digits;
+    }
+  }
+
+  TEST(ConvertDigits, EveryHexadecimalLength)
+  {
+    std::string digits;
+    uint64_t expected = 0;
+    for (int length = 1; length <= 16; length++)
+    {
+      digits += "0123456789abcDEF"[length - 1];
+      expected = expected * 16 + static_cast<uint64_t>(length - 1);
+
+      EXPECT_EQ(Vypr::ConvertDigits(digits, 16), expected) << digits;
+    }
+  }
+
+  TEST(ConvertDigits, EveryBinaryLength)
+  {
+    std::string digits;
+    uint64_t expected = 0;
+    for (int length = 1; length <= 64; length++)
+    {
+      digits += length % 3 == 0 ? '0' : '1';
+      expected = expected * 2 + (length % 3 == 0 ? 0 : 1);
+
+      EXPECT_EQ(Vypr::ConvertDigits(digits, 2), expected) << digits;
+    }
+  }
+
+  TEST(ConvertDigits, EveryOctalLength)
+  {
+    std::string digits;
+    uint64_t expected = 0;
+    for (int length = 1; length <= 21; length++)
+    {
+      char digit = static_cast<char>('0' + length % 8);
+      digits += digit;
+      expected = expected * 8 + static_cast<uint64_t>(digit - '0');
+
+      EXPECT_EQ(Vypr::ConvertDigits(digits, 8), expected) << digits;
+    }
+  }
+
+  TEST(ConvertDigits, Limits)
+  {
+    EXPECT_EQ(Vypr::ConvertDigits("18446744073709551615", 10), UINT64_MAX);
+    EXPECT_EQ(Vypr::ConvertDigits("18446744073709551616", 10), std::nullopt);
+    EXPECT_EQ(Vypr::ConvertDigits("99999999999999999999", 10), std::nullopt);
+    EXPECT_EQ(Vypr::ConvertDigits("100000000000000000000", 10), std::nullopt);
+    EXPECT_EQ(Vypr::ConvertDigits("ffffffffffffffff", 16), UINT64_MAX);
+    EXPECT_EQ(Vypr::ConvertDigits("10000000000000000", 16), std::nullopt);
+    EXPECT_EQ(Vypr::ConvertDigits("1777777777777777777777", 8), UINT64_MAX);
+    EXPECT_EQ(Vypr::ConvertDigits("2000000000000000000000", 8), std::nullopt);
+    EXPECT_EQ(Vypr::ConvertDigits(std::string(64, '1'), 2), UINT64_MAX);
+    EXPECT_EQ(Vypr::ConvertDigits("1" + std::string(64, '0'), 2),
+              std::nullopt);
+  }
+
+  TEST(ConvertDigits, LeadingZeros)
+  {
+    EXPECT_EQ(Vypr::ConvertDigits("0", 10), 0U);
+    EXPECT_EQ(Vypr::ConvertDigits("0000000000000000000000000", 8), 0U);
+    EXPECT_EQ(Vypr::ConvertDigits("000000000018446744073709551615", 10),
+              UINT64_MAX);
+    EXPECT_EQ(Vypr::ConvertDigits("00000000000000000000ff", 16), 0xFFU);
+  }
+
+  TEST(ConvertReal, CorrectlyRounded)
+  {
+    EXPECT_EQ(Vypr::ConvertReal("0.1", false, false), 0.1);
+    EXPECT_EQ(Vypr::ConvertReal("2.2250738585072014e-308", false, false),
+              2.2250738585072014e-308);
+    EXPECT_EQ(Vypr::ConvertReal("9007199254740993", false, false),
+              9007199254740992.0);
+    EXPECT_EQ(Vypr::ConvertReal("0.1", false, true), 0.1f);
+    EXPECT_EQ(Vypr::ConvertReal("1.8p3", true, false), 0x1.8p3);
+    EXPECT_EQ(Vypr::ConvertReal("DED.ADP3", true, false), 0xded.adp3);
+    EXPECT_EQ(Vypr::ConvertReal("12E+3", false, false), 12e3);
+  }
+
+  TEST(ConvertReal, OutOfRange)
+  {
+    EXPECT_EQ(Vypr::ConvertReal("1e400", false, false), std::nullopt);
+    EXPECT_EQ(Vypr::ConvertReal("1e40", false, true), std::nullopt);
+    EXPECT_EQ(Vypr::ConvertReal("1e40", false, false), 1e40);
+  }
+} // namespace NumericLiteralTest
@@ -0,0 +1,120 @@
+#include "Vypr/Lexer/TokenBuffer.hpp"
+
+#include <gtest/gtest.h>
+
+namespace TokenBufferTest
+{
+  TEST(Append, RoundTrip)
+  {
+    Vypr::TokenBuffer tokens;
+    Vypr::CLangToken first = {.type = Vypr::CLangTokenType::Identifier,
+                              .flags = Vypr::CLangToken::StartOfLine,
+                              .offset = 4,
+                              .length = 5,
+                              .value = 7};
+    Vypr::CLangToken second = {.type = Vypr::CLangTokenType::Add,
+                               .flags = Vypr::CLangToken::LeadingSpace,
+                               .offset = 10,
+                               .length = 1};
+
+    tokens.Append(first);
+    tokens.Append(second);
+
+    ASSERT_EQ(tokens.GetSize(), 2U);
+    EXPECT_EQ(tokens[0].type, first.type);
+    EXPECT_EQ(tokens[0].flags, first.flags);
+    EXPECT_EQ(tokens[0].offset, first.offset);
+    EXPECT_EQ(tokens[0].length, first.length);
+    EXPECT_EQ(tokens[0].value, first.value);
+    EXPECT_EQ(tokens.GetType(1), Vypr::CLangTokenType::Add);
+    EXPECT_EQ(tokens.GetOffset(1), 10U);
+    EXPECT_EQ(tokens[1].value, Vypr::CLangToken::NoValue);
+  }
+
+  TEST(Replace, GrowsAndShrinks)
+  {
+    Vypr::TokenBuffer tokens;
+    for (uint32_t i = 0; i < 5; i++)
+    {
+      tokens.Append({.type = Vypr::CLangTokenType::Identifier, .offset = i});
+    }
+    Vypr::TokenBuffer replacement;
+    for (uint32_t i = 0; i < 3; i++)
+    {
+      replacement.Append({.type = Vypr::CLangTokenType::Comma,
+                          .offset = 10 + i,
+                          .length = 1});
+    }
+
+    tokens.Replace(1, 1, replacement);
+
+    ASSERT_EQ(tokens.GetSize(), 7U);
+    EXPECT_EQ(tokens.GetOffset(0), 0U);
+    EXPECT_EQ(tokens.GetType(1), Vypr::CLangTokenType::Comma);
+    EXPECT_EQ(tokens.GetOffset(3), 12U);
+    EXPECT_EQ(tokens[3].length, 1U);
+    EXPECT_EQ(tokens.GetType(4), Vypr::CLangTokenType::Identifier);
+    EXPECT_EQ(tokens.GetOffset(6), 4U);
+
+    tokens.Replace(0, 5, Vypr::TokenBuffer());
+
+    ASSERT_EQ(tokens.GetSize(), 2U);
+    EXPECT_EQ(tokens.GetOffset(0), 3U);
+    EXPECT_EQ(tokens.GetOffset(1), 4U);
+  }
+
+  TEST(ShiftOffsets, Wraps)
+  {
+    Vypr::TokenBuffer tokens;
+    tokens.Append({.type = Vypr::CLangTokenType::Identifier, .offset = 4});
+    tokens.Append({.type = Vypr::CLangTokenType::Identifier, .offset = 8});
+    tokens.Append({.type = Vypr::CLangTokenType::Error, .value = 2});
+
+    tokens.ShiftOffsets(1, static_cast<uint32_t>(-3));
+    tokens.ShiftValues(0, Vypr::CLangTokenType::Error, 1);
+
+    EXPECT_EQ(tokens.GetOffset(0), 4U);
+    EXPECT_EQ(tokens.GetOffset(1), 5U);
+    EXPECT_EQ(tokens[2].value, 3U);
+    EXPECT_EQ(tokens[0].value, Vypr::CLangToken::NoValue);
+  }
+
+  TEST(Clear, KeepsCapacity)
+  {
+    Vypr::TokenBuffer tokens;
+    tokens.Reserve(64);
+    size_t capacity = tokens.GetCapacityBytes();
+
+    tokens.Append({.type = Vypr::CLangTokenType::Comma});
+    tokens.Clear();
+
+    EXPECT_EQ(tokens.GetSize(), 0U);
+    EXPECT_EQ(tokens.GetCapacityBytes(), capacity);
+  }
+
+  TEST(ShrinkToFit, BytesPerToken)
+  {
+    Vypr::TokenBuffer tokens;
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+      tokens.Append({.type = Vypr::CLangTokenType::Identifier, .offset = i});
+    }
+
+    tokens.ShrinkToFit();
+
+    EXPECT_EQ(tokens.GetCapacityBytes(),
+              1000 * Vypr::TokenBuffer::BytesPerToken);
+    EXPECT_EQ(tokens.GetOffset(999), 999U);
+  }
+
+  TEST(Reserve, MillionTokens)
+  {
+    constexpr size_t Count = 1'000'000;
+    Vypr::TokenBuffer tokens;
+
+    tokens.Reserve(Count);
+
+    EXPECT_LE(Vypr::TokenBuffer::BytesPerToken, sizeof(Vypr::CLangToken));
+    EXPECT_LE(tokens.GetCapacityBytes(), 16U * Count);
+  }
+} // namespace TokenBufferTest
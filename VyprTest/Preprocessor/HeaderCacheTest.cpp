@@ -0,0 +1,136 @@
+#include "Vypr/Preprocessor/HeaderCache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "Vypr/Lexer/CLangLexer.hpp"
+
+namespace HeaderCacheTest
+{
+  class HeaderCacheTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      m_directory =
+          std::filesystem::temp_directory_path() /
+          (std::string("vypr-") +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name());
+      std::filesystem::create_directories(m_directory);
+    }
+
+    void TearDown() override
+    {
+      std::filesystem::remove_all(m_directory);
+    }
+
+    std::filesystem::path WriteFile(const std::string &name,
+                                    const std::string &contents)
+    {
+      std::filesystem::path path = m_directory / name;
+      std::ofstream file(path, std::ios::binary | std::ios::trunc);
+      file << contents;
+      return path;
+    }
+
+  private:
+    std::filesystem::path m_directory;
+  };
+
+  TEST_F(HeaderCacheTest, ReusesUnchangedFiles)
+  {
+    std::filesystem::path path = WriteFile("a.h", "int a;");
+    Vypr::HeaderCache cache;
+
+    std::shared_ptr<const Vypr::CLangLexer> first = cache.Get(path);
+    std::shared_ptr<const Vypr::CLangLexer> second = cache.Get(path);
+
+    EXPECT_EQ(first, second);
+    ASSERT_EQ(first->GetTokens().GetSize(), 3U);
+    EXPECT_EQ(first->GetIdentifiers().GetName(
+                  first->GetTokens()[1].GetIdentifier()),
+              "a");
+    Vypr::HeaderCacheStatistics statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.hits, 1U);
+    EXPECT_EQ(statistics.misses, 1U);
+    EXPECT_EQ(statistics.bytesSaved, 6U);
+  }
+
+  TEST_F(HeaderCacheTest, RereadsChangedFiles)
+  {
+    std::filesystem::path path = WriteFile("a.h", "int a;");
+    Vypr::HeaderCache cache;
+    std::shared_ptr<const Vypr::CLangLexer> first = cache.Get(path);
+
+    WriteFile("a.h", "int a, b;");
+    std::shared_ptr<const Vypr::CLangLexer> second = cache.Get(path);
+
+    EXPECT_NE(first, second);
+    EXPECT_EQ(first->GetTokens().GetSize(), 3U);
+    EXPECT_EQ(second->GetTokens().GetSize(), 5U);
+    EXPECT_EQ(cache.GetStatistics().misses, 2U);
+  }
+
+  TEST_F(HeaderCacheTest, LinksShareAnEntry)
+  {
+    std::filesystem::path path = WriteFile("a.h", "int a;");
+    std::filesystem::path link = path.parent_path() / "b.h";
+    std::error_code error;
+    std::filesystem::create_hard_link(path, link, error);
+    if (error)
+    {
+      GTEST_SKIP() << "Hard links are not supported here";
+    }
+    Vypr::HeaderCache cache;
+
+    EXPECT_EQ(cache.Get(path), cache.Get(link));
+    EXPECT_EQ(cache.GetStatistics().hits, 1U);
+  }
+
+  TEST_F(HeaderCacheTest, MissingFile)
+  {
+    std::filesystem::path directory = WriteFile("a.h", "").parent_path();
+    Vypr::HeaderCache cache;
+
+    EXPECT_THROW(cache.Get(directory / "missing.h"), std::system_error);
+    EXPECT_EQ(cache.GetStatistics().misses, 0U);
+  }
+
+  TEST_F(HeaderCacheTest, ConcurrentLookupsLexOnce)
+  {
+    std::string contents;
+    for (int i = 0; i < 4096; i++)
+    {
+      contents += "extern int value_" + std::to_string(i) + ";\n";
+    }
+    std::filesystem::path path = WriteFile("a.h", contents);
+    Vypr::HeaderCache cache;
+
+    constexpr size_t ThreadCount = 8;
+    std::vector<std::shared_ptr<const Vypr::CLangLexer>> files(ThreadCount);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ThreadCount; i++)
+    {
+      threads.emplace_back([&, i] { files[i] = cache.Get(path); });
+    }
+    for (std::thread &thread : threads)
+    {
+      thread.join();
+    }
+
+    for (const std::shared_ptr<const Vypr::CLangLexer> &file : files)
+    {
+      EXPECT_EQ(file, files[0]);
+    }
+    Vypr::HeaderCacheStatistics statistics = cache.GetStatistics();
+    EXPECT_EQ(statistics.misses, 1U);
+    EXPECT_EQ(statistics.hits, ThreadCount - 1);
+    EXPECT_EQ(statistics.bytesSaved, (ThreadCount - 1) * contents.size());
+  }
+} // namespace HeaderCacheTest
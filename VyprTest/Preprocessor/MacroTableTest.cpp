@@ -0,0 +1,112 @@
+#include "Vypr/Preprocessor/MacroTable.hpp"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace MacroTableTest
+{
+  TEST(Define, ObjectLike)
+  {
+    Vypr::IdentifierTable identifiers;
+    Vypr::Identifier name = identifiers.Intern("SIZE");
+    std::vector<Vypr::CLangToken> replacement = {
+        {.type = Vypr::CLangTokenType::IntegerConstant, .value = 0},
+        {.type = Vypr::CLangTokenType::Star},
+        {.type = Vypr::CLangTokenType::IntegerConstant, .value = 1}};
+    Vypr::MacroTable macros;
+
+    macros.Define(name, {}, replacement, 0);
+
+    const Vypr::Macro *macro = macros.Find(name);
+    ASSERT_NE(macro, nullptr);
+    EXPECT_EQ(macro->name, name);
+    EXPECT_EQ(macro->flags, 0);
+    EXPECT_TRUE(macros.GetParameters(*macro).empty());
+    ASSERT_EQ(macros.GetReplacement(*macro).size(), 3U);
+    EXPECT_EQ(macros.GetReplacement(*macro)[1].type,
+              Vypr::CLangTokenType::Star);
+    EXPECT_EQ(macros.GetReplacement(*macro)[2].value, 1U);
+    EXPECT_EQ(macros.GetCount(), 1U);
+  }
+
+  TEST(Define, FunctionLike)
+  {
+    Vypr::IdentifierTable identifiers;
+    Vypr::Identifier name = identifiers.Intern("MAX");
+    std::vector<Vypr::Identifier> parameters = {identifiers.Intern("a"),
+                                                identifiers.Intern("b")};
+    Vypr::MacroTable macros;
+
+    macros.Define(identifiers.Intern("OTHER"), {}, {}, 0);
+    macros.Define(name, parameters, {}, Vypr::Macro::FunctionLike);
+
+    const Vypr::Macro *macro = macros.Find(name);
+    ASSERT_NE(macro, nullptr);
+    EXPECT_EQ(macro->flags, Vypr::Macro::FunctionLike);
+    ASSERT_EQ(macros.GetParameters(*macro).size(), 2U);
+    EXPECT_EQ(macros.GetParameters(*macro)[1], parameters[1]);
+    EXPECT_TRUE(macros.GetReplacement(*macro).empty());
+  }
+
+  TEST(Define, Redefine)
+  {
+    Vypr::IdentifierTable identifiers;
+    Vypr::Identifier name = identifiers.Intern("VALUE");
+    Vypr::CLangToken first = {.type = Vypr::CLangTokenType::Identifier,
+                              .value = 0};
+    Vypr::CLangToken second = {.type = Vypr::CLangTokenType::Comma};
+    Vypr::MacroTable macros;
+
+    macros.Define(name, {}, {&first, 1}, 0);
+    macros.Define(name, {}, {&second, 1}, 0);
+
+    const Vypr::Macro *macro = macros.Find(name);
+    ASSERT_NE(macro, nullptr);
+    ASSERT_EQ(macros.GetReplacement(*macro).size(), 1U);
+    EXPECT_EQ(macros.GetReplacement(*macro)[0].type,
+              Vypr::CLangTokenType::Comma);
+    EXPECT_EQ(macros.GetCount(), 1U);
+  }
+
+  TEST(Undefine, RemovesDefinition)
+  {
+    Vypr::IdentifierTable identifiers;
+    Vypr::Identifier name = identifiers.Intern("DEBUG");
+    Vypr::MacroTable macros;
+    macros.Define(name, {}, {}, 0);
+
+    macros.Undefine(name);
+    macros.Undefine(identifiers.Intern("UNKNOWN"));
+
+    EXPECT_FALSE(macros.IsDefined(name));
+    EXPECT_EQ(macros.Find(name), nullptr);
+    EXPECT_EQ(macros.GetCount(), 0U);
+  }
+
+  TEST(Find, Undefined)
+  {
+    Vypr::IdentifierTable identifiers;
+    Vypr::MacroTable macros;
+
+    EXPECT_EQ(macros.Find(identifiers.Intern("NAME")), nullptr);
+    EXPECT_EQ(macros.Find(Vypr::Identifier::None), nullptr);
+  }
+
+  TEST(GetGeneration, ChangesWithDefinitions)
+  {
+    Vypr::IdentifierTable identifiers;
+    Vypr::Identifier name = identifiers.Intern("FLAG");
+    Vypr::MacroTable macros;
+    uint32_t start = macros.GetGeneration();
+
+    macros.Define(name, {}, {}, 0);
+    uint32_t defined = macros.GetGeneration();
+    macros.Undefine(identifiers.Intern("UNKNOWN"));
+    uint32_t unchanged = macros.GetGeneration();
+    macros.Undefine(name);
+
+    EXPECT_NE(defined, start);
+    EXPECT_EQ(unchanged, defined);
+    EXPECT_NE(macros.GetGeneration(), defined);
+  }
+} // namespace MacroTableTest
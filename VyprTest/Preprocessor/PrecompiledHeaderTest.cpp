@@ -0,0 +1,193 @@
+#include "Vypr/Preprocessor/PrecompiledHeader.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "Vypr/AST/Type/ArrayType.hpp"
+#include "Vypr/AST/Type/IntegralType.hpp"
+#include "Vypr/AST/Type/PointerType.hpp"
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Preprocessor/Preprocessor.hpp"
+#include "Vypr/Scanner/StringScanner.hpp"
+
+namespace PrecompiledHeaderTest
+{
+  class PrecompiledHeaderTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      m_path =
+          std::filesystem::temp_directory_path() /
+          (std::string("vypr-") +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+           ".pch");
+    }
+
+    void TearDown() override
+    {
+      std::filesystem::remove(m_path);
+    }
+
+    /// @brief Preprocesses a prelude and writes it with `types`.
+    void WritePrelude(const std::string &prelude,
+                      const Vypr::TypeTable &types)
+    {
+      auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+      Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(prelude),
+                             identifiers);
+      lexer.StartPreprocessor({});
+      lexer.Tokenize();
+      Vypr::PrecompiledHeader::Write(m_path, *identifiers,
+                                     lexer.GetPreprocessor()->GetMacros(),
+                                     lexer.GetLiterals(), types);
+    }
+
+    /// @brief Overwrites the file with `contents`.
+    void WriteFile(const std::string &contents)
+    {
+      std::ofstream file(m_path, std::ios::binary | std::ios::trunc);
+      file << contents;
+    }
+
+    std::string ReadFile() const
+    {
+      std::ifstream file(m_path, std::ios::binary);
+      return {std::istreambuf_iterator<char>(file), {}};
+    }
+
+    const std::filesystem::path &GetPath() const
+    {
+      return m_path;
+    }
+
+  private:
+    std::filesystem::path m_path;
+  };
+
+  TEST_F(PrecompiledHeaderTest, LoadsMacros)
+  {
+    WritePrelude("#define ONE 1\n#define NAME \"n\\t\"\n"
+                 "#define ADD(a, ...) ((a) + (__VA_ARGS__))\n"
+                 "#define BAD 0b2\nint ignored;",
+                 {});
+    auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+    identifiers->Intern("unrelated");
+    auto header =
+        std::make_shared<Vypr::PrecompiledHeader>(GetPath(), identifiers);
+    std::string source = "ADD(ONE, 2) NAME BAD";
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StringScanner>(source),
+                           identifiers);
+
+    Vypr::PreprocessorOptions options;
+    options.precompiledHeader = header;
+    lexer.StartPreprocessor(options);
+
+    std::string text;
+    for (Vypr::CLangToken token = lexer.GetToken();
+         token.type != Vypr::CLangTokenType::NoToken;
+         token = lexer.GetToken())
+    {
+      text += text.empty() ? "" : " ";
+      text += token.type == Vypr::CLangTokenType::IntegerConstant
+                  ? std::to_string(
+                        lexer.GetLiterals().GetNumber(token.value).integer)
+                  : std::string(lexer.GetSpelling(token));
+    }
+    EXPECT_EQ(text, "( ( 1 ) + ( 2 ) ) n\t BAD");
+    EXPECT_EQ(lexer.GetPreprocessor()->GetMacros().GetCount(), 3U);
+  }
+
+  TEST_F(PrecompiledHeaderTest, LoadsSymbols)
+  {
+    auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+    Vypr::TypeTable types;
+    std::unique_ptr<Vypr::StorageType> byte =
+        std::make_unique<Vypr::IntegralType>(Vypr::Integral::Byte, false,
+                                             true, false);
+    std::unique_ptr<Vypr::StorageType> element =
+        std::make_unique<Vypr::IntegralType>(Vypr::Integral::Short, true,
+                                             false, false);
+    types.AddSymbol(identifiers->Intern("count"),
+                    std::make_shared<Vypr::IntegralType>(
+                        Vypr::Integral::Int, false, false, true));
+    types.AddSymbol(identifiers->Intern("name"),
+                    std::make_shared<Vypr::PointerType>(byte, false, true));
+    types.AddSymbol(identifiers->Intern("table"),
+                    std::make_shared<Vypr::ArrayType>(element, 4, true));
+    Vypr::MacroTable macros;
+    Vypr::LiteralTable literals;
+    Vypr::PrecompiledHeader::Write(GetPath(), *identifiers, macros, literals,
+                                   types);
+
+    auto loadedIdentifiers = std::make_shared<Vypr::IdentifierTable>();
+    loadedIdentifiers->Intern("unrelated");
+    Vypr::PrecompiledHeader header(GetPath(), loadedIdentifiers);
+    Vypr::TypeTable loaded;
+    header.LoadSymbols(loaded);
+
+    ASSERT_EQ(loaded.GetGlobalScope().size(), 3U);
+    for (const char *name : {"count", "name", "table"})
+    {
+      std::shared_ptr<Vypr::StorageType> expected =
+          types.GetSymbol(identifiers->Find(name));
+      std::shared_ptr<Vypr::StorageType> actual =
+          loaded.GetSymbol(loadedIdentifiers->Find(name));
+      ASSERT_NE(actual, nullptr) << name;
+      EXPECT_EQ(actual->GetType(), expected->GetType()) << name;
+      EXPECT_EQ(actual->PrettyPrint(), expected->PrettyPrint()) << name;
+    }
+  }
+
+  TEST_F(PrecompiledHeaderTest, RejectsOtherFiles)
+  {
+    auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+    EXPECT_THROW(Vypr::PrecompiledHeader(GetPath(), identifiers),
+                 std::system_error);
+
+    WriteFile("#define ONE 1\n");
+    EXPECT_THROW(Vypr::PrecompiledHeader(GetPath(), identifiers),
+                 std::runtime_error);
+
+    WritePrelude("#define ONE 1\n", {});
+    std::string image = ReadFile();
+    WriteFile(image.substr(0, image.size() - 1));
+    EXPECT_THROW(Vypr::PrecompiledHeader(GetPath(), identifiers),
+                 std::runtime_error);
+
+    image[8] += 1;
+    WriteFile(image);
+    EXPECT_THROW(Vypr::PrecompiledHeader(GetPath(), identifiers),
+                 std::runtime_error);
+  }
+
+  TEST_F(PrecompiledHeaderTest, RejectsUnknownTokenTypes)
+  {
+    WritePrelude("#define ONE 1\n", {});
+    std::string image = ReadFile();
+
+    // The header is the magic, version and section count in 16 bytes, then
+    // the offset and size of each section. Replacement tokens are the
+    // seventh section, and the type is the first byte of a token.
+    constexpr size_t MacroTokensEntry = 16 + 6 * 2 * sizeof(uint64_t);
+    uint64_t offset;
+    std::memcpy(&offset, image.data() + MacroTokensEntry, sizeof(offset));
+    ASSERT_LT(offset, image.size());
+    ASSERT_EQ(static_cast<Vypr::CLangTokenType>(image[offset]),
+              Vypr::CLangTokenType::IntegerConstant);
+    image[offset] = static_cast<char>(0xFF);
+    WriteFile(image);
+
+    auto identifiers = std::make_shared<Vypr::IdentifierTable>();
+    EXPECT_THROW(Vypr::PrecompiledHeader(GetPath(), identifiers),
+                 std::runtime_error);
+  }
+} // namespace PrecompiledHeaderTest
@@ -0,0 +1,529 @@
+#include "Vypr/Preprocessor/Preprocessor.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Preprocessor/HeaderCache.hpp"
+#include "Vypr/Scanner/StringScanner.hpp"
+
+namespace PreprocessorTest
+{
+  class PreprocessorTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override
+    {
+      m_directory =
+          std::filesystem::temp_directory_path() /
+          (std::string("vypr-") +
+           ::testing::UnitTest::GetInstance()->current_test_info()->name());
+      std::filesystem::create_directories(m_directory / "include");
+    }
+
+    void TearDown() override
+    {
+      std::filesystem::remove_all(m_directory);
+    }
+
+    void WriteFile(const std::string &name, const std::string &contents)
+    {
+      std::ofstream file(m_directory / name, std::ios::binary);
+      file << contents;
+    }
+
+    /// @brief Preprocesses a main source in the test directory, which has
+    /// an `include` directory on the search path.
+    Vypr::CLangLexer &Preprocess(
+        const std::string &source,
+        std::shared_ptr<Vypr::HeaderCache> headerCache = nullptr)
+    {
+      m_source = source;
+      m_lexer = std::make_unique<Vypr::CLangLexer>(
+          std::make_unique<Vypr::StringScanner>(m_source));
+      Vypr::PreprocessorOptions options;
+      options.sourcePath = m_directory / "main.c";
+      options.includeDirectories.push_back(m_directory / "include");
+      options.headerCache = std::move(headerCache);
+      m_lexer->StartPreprocessor(options);
+      return *m_lexer;
+    }
+
+    /// @brief Spells the remaining tokens separated by spaces. Integer
+    /// constants are spelled by value and errors by their diagnostic.
+    std::string Spell()
+    {
+      std::string text;
+      for (Vypr::CLangToken token = m_lexer->GetToken();
+           token.type != Vypr::CLangTokenType::NoToken;
+           token = m_lexer->GetToken())
+      {
+        text += text.empty() ? "" : " ";
+        if (token.type == Vypr::CLangTokenType::IntegerConstant)
+        {
+          text += std::to_string(
+              m_lexer->GetLiterals().GetNumber(token.value).integer);
+        }
+        else if (token.type == Vypr::CLangTokenType::Error)
+        {
+          text += "<";
+          text += Vypr::DiagnosticSink::GetMessage(
+              m_lexer->GetDiagnostics().Get(token.value).id);
+          text += ">";
+        }
+        else
+        {
+          text += m_lexer->GetSpelling(token);
+        }
+      }
+      return text;
+    }
+
+    const Vypr::PreprocessorStatistics &GetStatistics() const
+    {
+      return m_lexer->GetPreprocessor()->GetStatistics();
+    }
+
+  private:
+    std::filesystem::path m_directory;
+    std::string m_source;
+    std::unique_ptr<Vypr::CLangLexer> m_lexer;
+  };
+
+  TEST_F(PreprocessorTest, PassesTokensThrough)
+  {
+    Preprocess("int a = 1;\nchar *b = \"text\";");
+
+    EXPECT_EQ(Spell(), "int a = 1 ; char * b = text ;");
+    EXPECT_EQ(GetStatistics().filesEntered, 1U);
+  }
+
+  TEST_F(PreprocessorTest, DefineAndIfdef)
+  {
+    Vypr::CLangLexer &lexer =
+        Preprocess("#define FEATURE\n"
+                   "#ifdef FEATURE\nyes\n#else\nno\n#endif\n"
+                   "#ifndef FEATURE\nno\n#endif\n"
+                   "#undef FEATURE\n"
+                   "#ifdef FEATURE\nno\n#else\nafter\n#endif");
+
+    EXPECT_EQ(Spell(), "yes after");
+    EXPECT_EQ(lexer.GetPreprocessor()->GetMacros().GetCount(), 0U);
+  }
+
+  TEST_F(PreprocessorTest, DefineStoresReplacement)
+  {
+    Vypr::CLangLexer &lexer = Preprocess("#define MAX(a, b) a > b\n"
+                                         "#define LIST (x)\n"
+                                         "#define LOG(format, ...)\n");
+
+    EXPECT_EQ(Spell(), "");
+    const Vypr::MacroTable &macros = lexer.GetPreprocessor()->GetMacros();
+    const Vypr::Macro *max =
+        macros.Find(lexer.GetIdentifiers().Intern("MAX"));
+    ASSERT_NE(max, nullptr);
+    EXPECT_EQ(max->flags, Vypr::Macro::FunctionLike);
+    EXPECT_EQ(macros.GetParameters(*max).size(), 2U);
+    EXPECT_EQ(macros.GetReplacement(*max).size(), 3U);
+    const Vypr::Macro *list =
+        macros.Find(lexer.GetIdentifiers().Intern("LIST"));
+    ASSERT_NE(list, nullptr);
+    EXPECT_EQ(list->flags, 0);
+    EXPECT_EQ(macros.GetReplacement(*list).size(), 3U);
+    const Vypr::Macro *log =
+        macros.Find(lexer.GetIdentifiers().Intern("LOG"));
+    ASSERT_NE(log, nullptr);
+    EXPECT_EQ(log->flags, Vypr::Macro::FunctionLike | Vypr::Macro::Variadic);
+    EXPECT_EQ(macros.GetParameters(*log).size(), 1U);
+  }
+
+  TEST_F(PreprocessorTest, SplicedDirectives)
+  {
+    Vypr::CLangLexer &lexer = Preprocess("#define F(x) \\\n  x + 1\n"
+                                         "#def\\\nine G\\\n(x) x\n"
+                                         "#if F(1) == \\\r\n 2\nyes\n#endif\n"
+                                         "F(2) G(3) in\\\nt");
+
+    EXPECT_EQ(Spell(), "yes 2 + 1 3 int");
+    const Vypr::Macro *g = lexer.GetPreprocessor()->GetMacros().Find(
+        lexer.GetIdentifiers().Intern("G"));
+    ASSERT_NE(g, nullptr);
+    EXPECT_EQ(g->flags, Vypr::Macro::FunctionLike);
+  }
+
+  TEST_F(PreprocessorTest, MalformedDefine)
+  {
+    Preprocess("#define\n#define 1 x\n#define F(a b) a\nafter");
+
+    EXPECT_EQ(Spell(), "<Malformed preprocessing directive> "
+                       "<Malformed preprocessing directive> "
+                       "<Malformed preprocessing directive> after");
+  }
+
+  TEST_F(PreprocessorTest, IfExpressions)
+  {
+    Preprocess("#if 1 + 2 * 3 == 7 && (8 >> 1) == 4\na\n#endif\n"
+               "#if -1 < 0u\nno\n#else\nb\n#endif\n"
+               "#if 0 && 1 / 0\nno\n#elif 1 || 1 % 0\nc\n#endif\n"
+               "#if 'A' == 65 ? ~0 == -1 : 0\nd\n#endif\n"
+               "#define X\n#if defined X && defined(X) && !defined Y\ne\n"
+               "#endif\n"
+               "#if UNDEFINED_NAME\nno\n#endif\n"
+               "#if 0x10 - 16\nno\n#elif 0\nno\n#elif 2\nf\n#else\nno\n"
+               "#endif");
+
+    EXPECT_EQ(Spell(), "a b c d e f");
+  }
+
+  TEST_F(PreprocessorTest, InvalidCondition)
+  {
+    Preprocess("#if 1 +\nno\n#endif\n#if 1 / 0\nno\n#endif\n#if\nno\n"
+               "#endif\nafter");
+
+    EXPECT_EQ(Spell(), "<Invalid preprocessing condition> "
+                       "<Invalid preprocessing condition> "
+                       "<Invalid preprocessing condition> after");
+  }
+
+  TEST_F(PreprocessorTest, SkippedGroupsAreNotLexedForErrors)
+  {
+    Vypr::CLangLexer &lexer = Preprocess(
+        "#if 0\ndon't 0b2\n#if 1\n#bogus\n#endif\n#else\nkept\n#endif");
+
+    EXPECT_EQ(Spell(), "kept");
+    EXPECT_EQ(lexer.GetDiagnostics().GetCount(), 0U);
+  }
+
+  TEST_F(PreprocessorTest, UnmatchedAndUnterminated)
+  {
+    Preprocess("#endif\n#else\n#if 1\n#else\n#else\n#endif\n#ifdef A\n");
+
+    EXPECT_EQ(Spell(), "<Conditional directive without matching #if> "
+                       "<Conditional directive without matching #if> "
+                       "<Conditional directive without matching #if> "
+                       "<Expected #endif to end conditional>");
+  }
+
+  TEST_F(PreprocessorTest, UnknownAndErrorDirectives)
+  {
+    Preprocess("#\n#line 4\n#pragma pack\n#bogus\n#error stop here\nend");
+
+    EXPECT_EQ(Spell(), "<Unknown preprocessing directive> "
+                       "<#error directive> end");
+  }
+
+  TEST_F(PreprocessorTest, IncludeQuotedAndAngled)
+  {
+    WriteFile("local.h", "int local ;");
+    WriteFile("include/system.h", "int system ;\n#include \"nested.h\"");
+    WriteFile("include/nested.h", "int nested ;");
+    WriteFile("include/local.h", "int wrong ;");
+
+    Preprocess("#include \"local.h\"\n#include <system.h>\n#include <local.h>"
+               "\nint main ;");
+
+    EXPECT_EQ(Spell(), "int local ; int system ; int nested ; int wrong ; "
+                       "int main ;");
+    EXPECT_EQ(GetStatistics().filesEntered, 5U);
+  }
+
+  TEST_F(PreprocessorTest, IncludedTokensAreRelocated)
+  {
+    WriteFile("header.h", "value 42 \"text\" 0b2");
+
+    Vypr::CLangLexer &lexer = Preprocess("first\n#include \"header.h\"\n");
+
+    EXPECT_EQ(lexer.GetToken().offset, 0U);
+    Vypr::CLangToken identifier = lexer.GetToken();
+    EXPECT_EQ(identifier.offset, 6U);
+    EXPECT_TRUE(identifier.flags & Vypr::CLangToken::Relocated);
+    EXPECT_EQ(lexer.GetSpelling(identifier), "value");
+    Vypr::CLangToken number = lexer.GetToken();
+    EXPECT_EQ(lexer.GetLiterals().GetNumber(number.value).integer, 42U);
+    EXPECT_EQ(lexer.GetSpelling(lexer.GetToken()), "text");
+    Vypr::CLangToken error = lexer.GetToken();
+    ASSERT_EQ(error.type, Vypr::CLangTokenType::Error);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(error.value).id,
+              Vypr::DiagnosticId::InvalidBinaryDigit);
+    EXPECT_EQ(lexer.GetDiagnostics().Get(error.value).offset, 6U);
+    EXPECT_EQ(lexer.GetToken().type, Vypr::CLangTokenType::NoToken);
+  }
+
+  TEST_F(PreprocessorTest, IncludeNotFound)
+  {
+    Preprocess("#include \"missing.h\"\n#include <missing.h>\n#include x\n"
+               "after");
+
+    EXPECT_EQ(Spell(), "<Included file not found> <Included file not found> "
+                       "<Malformed preprocessing directive> after");
+  }
+
+  TEST_F(PreprocessorTest, IncludeNestingTooDeep)
+  {
+    WriteFile("self.h", "x\n#include \"self.h\"\n");
+
+    Preprocess("#include \"self.h\"\n");
+
+    std::string text = Spell();
+    EXPECT_NE(text.find("<Includes nested too deeply>"), std::string::npos);
+    EXPECT_EQ(GetStatistics().filesEntered,
+              Vypr::Preprocessor::MaximumIncludeDepth);
+  }
+
+  TEST_F(PreprocessorTest, PragmaOnce)
+  {
+    WriteFile("once.h", "#pragma once\nint once ;");
+
+    Preprocess("#include \"once.h\"\n#include \"once.h\"\n"
+               "#include \"./once.h\"");
+
+    EXPECT_EQ(Spell(), "int once ;");
+    EXPECT_EQ(GetStatistics().filesEntered, 2U);
+    EXPECT_EQ(GetStatistics().includesSkipped, 2U);
+  }
+
+  TEST_F(PreprocessorTest, IncludeGuardSkipsFile)
+  {
+    WriteFile("guarded.h", "// Comment\n#ifndef GUARDED_H\n#define GUARDED_H\n"
+                           "int guarded ;\n#ifdef X\n#endif\n#endif\n");
+    WriteFile("defined.h", "#if !defined(DEFINED_H)\n#define DEFINED_H\n"
+                           "int defined ;\n#endif");
+
+    Preprocess("#include \"guarded.h\"\n#include \"guarded.h\"\n"
+               "#include \"defined.h\"\n#include \"defined.h\"\n"
+               "#undef GUARDED_H\n#include \"guarded.h\"");
+
+    EXPECT_EQ(Spell(), "int guarded ; int defined ; int guarded ;");
+    EXPECT_EQ(GetStatistics().filesEntered, 4U);
+    EXPECT_EQ(GetStatistics().includesSkipped, 2U);
+  }
+
+  TEST_F(PreprocessorTest, NotAnIncludeGuard)
+  {
+    WriteFile("after.h", "#ifndef AFTER_H\n#define AFTER_H\n#endif\nafter");
+    WriteFile("before.h", "before\n#ifndef BEFORE_H\n#define BEFORE_H\n"
+                          "#endif");
+    WriteFile("else.h", "#ifndef ELSE_H\n#define ELSE_H\n#else\nelse\n"
+                        "#endif");
+
+    Preprocess("#include \"after.h\"\n#include \"after.h\"\n"
+               "#include \"before.h\"\n#include \"before.h\"\n"
+               "#include \"else.h\"\n#include \"else.h\"");
+
+    EXPECT_EQ(Spell(), "after after before before else");
+    EXPECT_EQ(GetStatistics().filesEntered, 7U);
+    EXPECT_EQ(GetStatistics().includesSkipped, 0U);
+  }
+
+  TEST_F(PreprocessorTest, ConditionalsDoNotSpanFiles)
+  {
+    WriteFile("open.h", "#if 1\nopen\n");
+    WriteFile("close.h", "#endif\n");
+
+    Preprocess("#if 1\n#include \"open.h\"\n#include \"close.h\"\n#endif\n"
+               "end");
+
+    EXPECT_EQ(Spell(), "open <Expected #endif to end conditional> "
+                       "<Conditional directive without matching #if> end");
+  }
+
+  TEST_F(PreprocessorTest, CachedHeadersAreShared)
+  {
+    WriteFile("include/shared.h",
+              "#ifndef SHARED_H\n#define SHARED_H\n"
+              "#define SCALE(x) ((x) * FACTOR)\n"
+              "#if defined(FACTOR) && FACTOR > 1\nint scaled ;\n#endif\n"
+              "int shared = 7 ; \"text\"\n#endif\n");
+    auto cache = std::make_shared<Vypr::HeaderCache>();
+
+    // The units intern names in different orders, so identifiers of the
+    // cached tokens are mapped to each unit's own.
+    Preprocess("#define FACTOR 2\n#include <shared.h>\n#include <shared.h>\n"
+               "SCALE(size)",
+               cache);
+    EXPECT_EQ(Spell(), "int scaled ; int shared = 7 ; text ( ( size ) * 2 )");
+    EXPECT_EQ(GetStatistics().cachedFiles, 1U);
+    EXPECT_EQ(GetStatistics().includesSkipped, 1U);
+
+    Preprocess("other first\n#include <shared.h>\nSCALE(1)", cache);
+    EXPECT_EQ(Spell(), "other first int shared = 7 ; text ( ( 1 ) * FACTOR )");
+    EXPECT_EQ(GetStatistics().cachedFiles, 1U);
+
+    Vypr::HeaderCacheStatistics statistics = cache->GetStatistics();
+    EXPECT_EQ(statistics.hits, 1U);
+    EXPECT_EQ(statistics.misses, 1U);
+  }
+
+  TEST_F(PreprocessorTest, ObjectLikeMacros)
+  {
+    Preprocess("#define ONE 1\n#define TWO ONE + ONE\n#define EMPTY\n"
+               "int x = TWO EMPTY;");
+
+    EXPECT_EQ(Spell(), "int x = 1 + 1 ;");
+    EXPECT_EQ(GetStatistics().macrosExpanded, 2U);
+  }
+
+  TEST_F(PreprocessorTest, FunctionLikeMacros)
+  {
+    Preprocess("#define MAX(a, b) ((a) > (b) ? (a) : (b))\n"
+               "#define ID(x) x\n#define NONE() none\n"
+               "MAX(1, ID(2)) ID((3, 4)) NONE() ID ;");
+
+    EXPECT_EQ(Spell(), "( ( 1 ) > ( 2 ) ? ( 1 ) : ( 2 ) ) ( 3 , 4 ) none "
+                       "ID ;");
+  }
+
+  TEST_F(PreprocessorTest, MacrosAreNotExpandedInThemselves)
+  {
+    Preprocess("#define foo foo + 1\n#define N M\n#define M N\n"
+               "#define f(x) f(x) x\nfoo N M f(2)");
+
+    EXPECT_EQ(Spell(), "foo + 1 N M f ( 2 ) 2");
+  }
+
+  TEST_F(PreprocessorTest, NameAtEndOfReplacementTakesFileArguments)
+  {
+    Preprocess("#define F f\n#define f(x) x + 1\nF(2) f(f)(3)");
+
+    EXPECT_EQ(Spell(), "2 + 1 f + 1 ( 3 )");
+  }
+
+  TEST_F(PreprocessorTest, Stringize)
+  {
+    Preprocess("#define STR(x) #x\n#define XSTR(x) STR(x)\n#define V 42\n"
+               "STR(a  +  \"b\\n\") XSTR(V) STR( ( x ,y ) )");
+
+    EXPECT_EQ(Spell(), "a + \"b\\n\" 42 ( x ,y )");
+  }
+
+  TEST_F(PreprocessorTest, Paste)
+  {
+    Preprocess("#define CAT(a, b) a ## b\n"
+               "CAT(foo, bar) CAT(1, 2) CAT(<, <=) CAT(in, t) CAT(, x) "
+               "CAT(y, ) CAT(+, -)");
+
+    EXPECT_EQ(Spell(), "foobar 12 <<= int x y "
+                       "<Pasting does not form a single token> + -");
+  }
+
+  TEST_F(PreprocessorTest, VariadicMacros)
+  {
+    Preprocess("#define LOG(f, ...) print(f, __VA_ARGS__)\n"
+               "#define ALL(...) #__VA_ARGS__\n"
+               "LOG(x, 1, (2, 3)) LOG(y) ALL(a, b)");
+
+    EXPECT_EQ(Spell(), "print ( x , 1 , ( 2 , 3 ) ) print ( y , ) a, b");
+  }
+
+  TEST_F(PreprocessorTest, MalformedInvocations)
+  {
+    Preprocess("#define F(a, b) a b\nF(1) F(1, 2, 3) after\nF(1,");
+
+    EXPECT_EQ(Spell(), "<Wrong number of macro arguments> "
+                       "<Wrong number of macro arguments> after "
+                       "<Expected ) to end macro arguments>");
+  }
+
+  TEST_F(PreprocessorTest, ConditionsExpandMacros)
+  {
+    Preprocess("#define VERSION 3\n#define AT_LEAST(v) (VERSION >= (v))\n"
+               "#if AT_LEAST(2) && defined VERSION && defined(AT_LEAST)\na\n"
+               "#endif\n#if AT_LEAST(4)\nno\n#else\nb\n#endif");
+
+    EXPECT_EQ(Spell(), "a b");
+  }
+
+  TEST_F(PreprocessorTest, XMacros)
+  {
+    Preprocess("#define COLORS(X) X(Red, 1) X(Green, 2)\n"
+               "#define ENUM(name, value) Color##name = value,\n"
+               "#define NAME(name, value) #name,\n"
+               "enum { COLORS(ENUM) };\n"
+               "const char *names[] = { COLORS(NAME) };");
+
+    EXPECT_EQ(Spell(), "enum { ColorRed = 1 , ColorGreen = 2 , } ; "
+                       "const char * names [ ] = { Red , Green , } ;");
+  }
+
+  TEST_F(PreprocessorTest, MultiLineXMacroTable)
+  {
+    Preprocess("#define ERRORS(X) \\\n"
+               "  X(NotFound, 404, \"not found\") \\\n"
+               "  X(Teapot,   418, \"teapot\")    \\\n"
+               "  X(Internal, 500, \"internal\")\n"
+               "#define CODE(name, code, text) Error##name = code,\n"
+               "#define TEXT(name, code, text) [code] = text,\n"
+               "enum { ERRORS(CODE) };\n"
+               "const char *texts[] = { ERRORS(TEXT) };");
+
+    EXPECT_EQ(Spell(), "enum { ErrorNotFound = 404 , ErrorTeapot = 418 , "
+                       "ErrorInternal = 500 , } ; "
+                       "const char * texts [ ] = { [ 404 ] = not found , "
+                       "[ 418 ] = teapot , [ 500 ] = internal , } ;");
+    EXPECT_EQ(GetStatistics().macrosExpanded, 8U);
+  }
+
+  TEST_F(PreprocessorTest, ExpansionsTakeOffsetOfName)
+  {
+    Vypr::CLangLexer &lexer = Preprocess("x\n#define M a b\n  M");
+
+    EXPECT_EQ(lexer.GetToken().offset, 0U);
+    Vypr::CLangToken first = lexer.GetToken();
+    Vypr::CLangToken second = lexer.GetToken();
+    EXPECT_EQ(first.offset, 18U);
+    EXPECT_EQ(first.flags, Vypr::CLangToken::StartOfLine |
+                               Vypr::CLangToken::LeadingSpace |
+                               Vypr::CLangToken::Relocated);
+    EXPECT_EQ(second.offset, 18U);
+    EXPECT_EQ(second.flags, Vypr::CLangToken::LeadingSpace |
+                                Vypr::CLangToken::Relocated);
+  }
+
+  TEST_F(PreprocessorTest, ObjectLikeExpansionsAreCached)
+  {
+    Preprocess("#define A B\n#define B 1\nA A A");
+
+    EXPECT_EQ(Spell(), "1 1 1");
+    EXPECT_EQ(GetStatistics().macrosExpanded, 3U);
+    EXPECT_EQ(GetStatistics().cachedExpansions, 3U);
+  }
+
+  TEST_F(PreprocessorTest, RedefiningInvalidatesCache)
+  {
+    Preprocess("#define A B\n#define B 1\nA\n#undef B\n#define B 2\nA");
+
+    EXPECT_EQ(Spell(), "1 2");
+    EXPECT_EQ(GetStatistics().cachedExpansions, 2U);
+  }
+
+  TEST_F(PreprocessorTest, UnrelatedDirectivesKeepCache)
+  {
+    Preprocess("#define A B\n#define B 1\nA\n#define C 2\n#undef C\nA\n"
+               "#undef B\n#define B 3\nA");
+
+    EXPECT_EQ(Spell(), "1 1 3");
+    EXPECT_EQ(GetStatistics().cachedExpansions, 3U);
+    EXPECT_EQ(GetStatistics().cacheMisses, 2U);
+  }
+
+  TEST_F(PreprocessorTest, DefiningUsedNameInvalidatesCache)
+  {
+    Preprocess("#define A B\nA\n#define B 1\nA");
+
+    EXPECT_EQ(Spell(), "B 1");
+    EXPECT_EQ(GetStatistics().cacheMisses, 2U);
+  }
+
+  TEST_F(PreprocessorTest, IncompleteExpansionsAreNotCached)
+  {
+    Vypr::CLangLexer &lexer =
+        Preprocess("#define F(x) x\n#define G F(\nG 2) G 3)");
+
+    EXPECT_EQ(Spell(), "2 3");
+    EXPECT_EQ(GetStatistics().cachedExpansions, 0U);
+    EXPECT_EQ(lexer.GetDiagnostics().GetCount(), 0U);
+  }
+} // namespace PreprocessorTest
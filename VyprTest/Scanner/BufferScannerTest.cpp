@@ -0,0 +1,202 @@
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+#include <gtest/gtest.h>
+
+namespace BufferScannerTest
+{
+  TEST(Next, Empty)
+  {
+    std::unique_ptr<Vypr::Scanner> scanner =
+        std::make_unique<Vypr::BufferScanner>();
+
+    char result = scanner->Next();
+
+    EXPECT_EQ(result, Vypr::Scanner::EndOfFile);
+    EXPECT_TRUE(scanner->Finished());
+  }
+
+  TEST(Next, MultipleCharacters)
+  {
+    std::unique_ptr<Vypr::Scanner> scanner =
+        std::make_unique<Vypr::BufferScanner>("ab\nc");
+
+    char result1 = scanner->Next();
+    char result2 = scanner->Next();
+    char result3 = scanner->Next();
+
+    EXPECT_EQ(result1, 'a');
+    EXPECT_EQ(result2, 'b');
+    EXPECT_EQ(result3, '\n');
+    EXPECT_EQ(scanner->GetLine(), 2);
+    EXPECT_EQ(scanner->GetColumn(), 1);
+  }
+
+  TEST(Next, Utf8Sequences)
+  {
+    std::unique_ptr<Vypr::Scanner> scanner =
+        std::make_unique<Vypr::BufferScanner>("\xC3\xA9!");
+
+    char result1 = scanner->Next();
+    char result2 = scanner->Next();
+    char result3 = scanner->Next();
+
+    EXPECT_EQ(result1, '\xC3');
+    EXPECT_EQ(result2, '\xA9');
+    EXPECT_EQ(result3, '!');
+    EXPECT_EQ(scanner->GetColumn(), 4);
+    EXPECT_TRUE(scanner->Finished());
+  }
+
+  TEST(LookAhead, ToEnd)
+  {
+    std::unique_ptr<Vypr::Scanner> scanner =
+        std::make_unique<Vypr::BufferScanner>("ab");
+
+    EXPECT_EQ(scanner->LookAhead(1), 'b');
+    EXPECT_EQ(scanner->LookAhead(2), Vypr::Scanner::EndOfFile);
+    EXPECT_EQ(scanner->GetColumn(), 1);
+  }
+
+  TEST(LookAhead, ViewIntoBuffer)
+  {
+    std::string_view source = "/* x */";
+    Vypr::BufferScanner scanner(source);
+
+    std::string_view result = scanner.LookAhead(0, 2);
+
+    EXPECT_EQ(result, "/*");
+    EXPECT_EQ(result.data(), source.data());
+    EXPECT_EQ(scanner.LookAhead(5, 4), "*/");
+    EXPECT_TRUE(scanner.LookAhead(7, 1).empty());
+    EXPECT_EQ(scanner.GetColumn(), 1);
+  }
+
+  TEST(Matches, Text)
+  {
+    Vypr::BufferScanner scanner("//a");
+
+    EXPECT_TRUE(scanner.Matches("//"));
+    EXPECT_TRUE(scanner.Matches('/'));
+    EXPECT_FALSE(scanner.Matches("/*"));
+    EXPECT_FALSE(scanner.Matches("//ab"));
+  }
+
+  TEST(Next, ViewIntoBuffer)
+  {
+    std::string_view source = "int\nx";
+    Vypr::BufferScanner scanner(source);
+
+    std::string_view result = scanner.Next(4);
+
+    EXPECT_EQ(result, "int\n");
+    EXPECT_EQ(result.data(), source.data());
+    EXPECT_EQ(scanner.Next(8), "x");
+    EXPECT_EQ(scanner.GetLine(), 2);
+    EXPECT_EQ(scanner.GetColumn(), 2);
+  }
+
+  TEST(Next, AcrossLines)
+  {
+    Vypr::BufferScanner scanner("a\nbc\nde");
+
+    EXPECT_EQ(scanner.Next(6), "a\nbc\nd");
+    EXPECT_EQ(scanner.GetLine(), 3);
+    EXPECT_EQ(scanner.GetColumn(), 2);
+  }
+
+  TEST(NextWhile, ViewIntoBuffer)
+  {
+    std::string_view source = "abc1";
+    Vypr::BufferScanner scanner(source);
+
+    std::string_view result =
+        scanner.NextWhile([](char c) { return c >= 'a' && c <= 'z'; });
+
+    EXPECT_EQ(result, "abc");
+    EXPECT_EQ(result.data(), source.data());
+    EXPECT_EQ(scanner.LookAhead(0), '1');
+  }
+
+  TEST(NextStringRun, StopsAtSpecialCharacters)
+  {
+    std::string source = std::string(70, 'a') + "\\n\" b\nc";
+    Vypr::BufferScanner scanner(source);
+
+    EXPECT_EQ(scanner.NextStringRun(), std::string(70, 'a'));
+    EXPECT_EQ(scanner.Next(), '\\');
+    EXPECT_EQ(scanner.NextStringRun(), "n");
+    EXPECT_EQ(scanner.Next(), '"');
+    EXPECT_EQ(scanner.NextStringRun(), " b");
+    EXPECT_EQ(scanner.Next(), '\n');
+    EXPECT_EQ(scanner.NextStringRun(), "c");
+    EXPECT_TRUE(scanner.Finished());
+  }
+
+  TEST(SkipWhitespace, LongRun)
+  {
+    std::string source = std::string(70, ' ') + "\n\t x";
+    Vypr::BufferScanner scanner(source);
+
+    scanner.SkipWhitespace();
+
+    EXPECT_EQ(scanner.LookAhead(0), 'x');
+    EXPECT_EQ(scanner.GetLine(), 2);
+    EXPECT_EQ(scanner.GetColumn(), 3);
+  }
+
+  TEST(SkipLine, StopsAtNewline)
+  {
+    Vypr::BufferScanner scanner("// comment\nx");
+
+    scanner.SkipLine();
+
+    EXPECT_EQ(scanner.LookAhead(0), '\n');
+    EXPECT_EQ(scanner.GetOffset(), 10);
+  }
+
+  TEST(SkipBlockComment, Terminated)
+  {
+    std::string source = "a\n" + std::string(50, '*') + "/x";
+    Vypr::BufferScanner scanner(source);
+
+    EXPECT_TRUE(scanner.SkipBlockComment());
+    EXPECT_EQ(scanner.LookAhead(0), 'x');
+    EXPECT_EQ(scanner.GetLine(), 2);
+    EXPECT_EQ(scanner.GetColumn(), 52);
+  }
+
+  TEST(SkipBlockComment, Unterminated)
+  {
+    Vypr::BufferScanner scanner("abc *");
+
+    EXPECT_FALSE(scanner.SkipBlockComment());
+    EXPECT_TRUE(scanner.Finished());
+  }
+
+  TEST(Finished, BorrowsBuffer)
+  {
+    std::string source = "abc";
+    Vypr::BufferScanner scanner(source);
+
+    source[0] = 'x';
+
+    EXPECT_EQ(scanner.LookAhead(0), 'x');
+    EXPECT_FALSE(scanner.Finished());
+  }
+
+  TEST(Mark, Reset)
+  {
+    Vypr::BufferScanner scanner("ab\ncd");
+
+    scanner.Next();
+    Vypr::ScannerMark mark = scanner.Mark();
+    EXPECT_EQ(scanner.Next(3), "b\nc");
+    EXPECT_EQ(scanner.GetLine(), 2);
+    scanner.Reset(mark);
+    scanner.Release(mark);
+
+    EXPECT_EQ(scanner.GetOffset(), 1U);
+    EXPECT_EQ(scanner.GetLine(), 1);
+    EXPECT_EQ(scanner.Next(4), "b\ncd");
+  }
+} // namespace BufferScannerTest
@@ -0,0 +1,218 @@
+#include "Vypr/Scanner/CharacterScan.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "Vypr/Scanner/CharacterClass.hpp"
+
+namespace CharacterScanTest
+{
+  // Lengths cover empty input, partial vector blocks and several full blocks
+  // so both the vector loop and the scalar tail are exercised.
+  constexpr size_t MaxLength = 100;
+
+  TEST(FindNonWhitespace, Empty)
+  {
+    std::string source;
+
+    EXPECT_EQ(Vypr::FindNonWhitespace(source.data(), source.data()),
+              source.data());
+  }
+
+  TEST(FindNonWhitespace, EveryPosition)
+  {
+    const std::string whitespace = " \t\n\v\f\r";
+    for (size_t length = 1; length < MaxLength; length++)
+    {
+      for (size_t position = 0; position < length; position++)
+      {
+        std::string source;
+        for (size_t i = 0; i < length; i++)
+        {
+          source += whitespace[i % whitespace.size()];
+        }
+        source[position] = 'x';
+
+        const char *result = Vypr::FindNonWhitespace(
+            source.data(), source.data() + source.size());
+        ASSERT_EQ(result - source.data(), position);
+      }
+    }
+  }
+
+  TEST(FindNonWhitespace, AllWhitespace)
+  {
+    std::string source(MaxLength, ' ');
+
+    EXPECT_EQ(Vypr::FindNonWhitespace(source.data(),
+                                      source.data() + source.size()),
+              source.data() + source.size());
+  }
+
+  TEST(FindNonWhitespace, NonAsciiIsNotWhitespace)
+  {
+    for (char character : {'\x08', '\x0E', '\x85', '\xA0', '\xFF'})
+    {
+      std::string source(40, ' ');
+      source[35] = character;
+
+      const char *result = Vypr::FindNonWhitespace(
+          source.data(), source.data() + source.size());
+      EXPECT_EQ(result - source.data(), 35);
+    }
+  }
+
+  TEST(FindCharacter, EveryPosition)
+  {
+    for (size_t length = 1; length < MaxLength; length++)
+    {
+      for (size_t position = 0; position < length; position++)
+      {
+        std::string source(length, 'a');
+        source[position] = '\n';
+
+        const char *result = Vypr::FindCharacter(
+            source.data(), source.data() + source.size(), '\n');
+        ASSERT_EQ(result - source.data(), position);
+      }
+    }
+  }
+
+  TEST(FindCharacter, Missing)
+  {
+    std::string source(MaxLength, 'a');
+
+    EXPECT_EQ(Vypr::FindCharacter(source.data(),
+                                  source.data() + source.size(), '\n'),
+              source.data() + source.size());
+  }
+
+  TEST(FindAny, EveryPosition)
+  {
+    const std::string characters = "\"'/";
+    for (size_t length = 1; length < MaxLength; length++)
+    {
+      for (size_t position = 0; position < length; position++)
+      {
+        std::string source(length, 'a');
+        source[position] = characters[position % characters.size()];
+
+        const char *result = Vypr::FindAny(
+            source.data(), source.data() + source.size(), '"', '\'', '/');
+        ASSERT_EQ(result - source.data(), position);
+      }
+    }
+  }
+
+  TEST(FindAny, Missing)
+  {
+    std::string source(MaxLength, 'a');
+
+    EXPECT_EQ(Vypr::FindAny(source.data(), source.data() + source.size(), '"',
+                            '\'', '/'),
+              source.data() + source.size());
+  }
+
+  TEST(FindAny, TwoCharacters)
+  {
+    for (size_t length = 1; length < MaxLength; length++)
+    {
+      for (size_t position = 0; position < length; position++)
+      {
+        std::string source(length, 'a');
+        source[position] = position % 2 == 0 ? '\n' : '\\';
+
+        const char *result = Vypr::FindAny(
+            source.data(), source.data() + source.size(), '\n', '\\');
+        ASSERT_EQ(result - source.data(), position);
+      }
+    }
+    std::string missing(MaxLength, 'a');
+    EXPECT_EQ(Vypr::FindAny(missing.data(), missing.data() + missing.size(),
+                            '\n', '\\'),
+              missing.data() + missing.size());
+  }
+
+  TEST(FindPair, EveryPosition)
+  {
+    for (size_t length = 2; length < MaxLength; length++)
+    {
+      for (size_t position = 0; position + 1 < length; position++)
+      {
+        // Lone halves of the pair before the match must be skipped.
+        std::string source(length, '*');
+        for (size_t i = 1; i < length; i += 2)
+        {
+          source[i] = 'a';
+        }
+        source[position] = '*';
+        source[position + 1] = '/';
+        if (position > 0 && source[position - 1] == '*')
+        {
+          source[position - 1] = 'a';
+        }
+
+        const char *result = Vypr::FindPair(
+            source.data(), source.data() + source.size(), '*', '/');
+        ASSERT_EQ(result - source.data(), position);
+      }
+    }
+  }
+
+  TEST(FindPair, SplitAcrossEnd)
+  {
+    std::string source(MaxLength, 'a');
+    source.back() = '*';
+
+    EXPECT_EQ(Vypr::FindPair(source.data(), source.data() + source.size(),
+                             '*', '/'),
+              source.data() + source.size());
+  }
+
+  TEST(FindIdentifierEnd, EveryPosition)
+  {
+    for (char separator : {' ', '\n', '(', '#', '"', '\'', '\\'})
+    {
+      for (size_t length = 1; length < MaxLength; length++)
+      {
+        for (size_t position = 0; position < length; position++)
+        {
+          std::string source;
+          for (size_t i = 0; i < length; i++)
+          {
+            source += "aZ_09$\xC3\xA9"[i % 7];
+          }
+          source[position] = separator;
+
+          const char *result = Vypr::FindIdentifierEnd(
+              source.data(), source.data() + source.size());
+          ASSERT_EQ(result - source.data(), position);
+        }
+      }
+    }
+  }
+
+  TEST(FindIdentifierEnd, ToEnd)
+  {
+    std::string source(MaxLength, 'x');
+
+    EXPECT_EQ(Vypr::FindIdentifierEnd(source.data(),
+                                      source.data() + source.size()),
+              source.data() + source.size());
+  }
+
+  TEST(FindIdentifierEnd, SeparatorsOutsideLetterRanges)
+  {
+    // Bytes next to the ranges matched by the vector compare.
+    for (char separator : {'@', '[', '`', '{', '/', ':'})
+    {
+      std::string source(40, 'k');
+      source[20] = separator;
+
+      const char *result = Vypr::FindIdentifierEnd(
+          source.data(), source.data() + source.size());
+      EXPECT_EQ(result - source.data(), Vypr::IsIdentifier(separator) ? 40 : 20)
+          << separator;
+    }
+  }
+} // namespace CharacterScanTest
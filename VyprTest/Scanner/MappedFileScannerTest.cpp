@@ -0,0 +1,71 @@
+#include "Vypr/Scanner/MappedFileScanner.hpp"
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <system_error>
+
+#include "Vypr/Scanner/SourceManager.hpp"
+
+namespace MappedFileScannerTest
+{
+  class MappedFileScannerTest : public ::testing::Test
+  {
+  protected:
+    void TearDown() override
+    {
+      std::filesystem::remove(m_path);
+    }
+
+    const std::filesystem::path &WriteSource(const std::string &contents)
+    {
+      m_path = std::filesystem::temp_directory_path() /
+               (std::string("vypr-") +
+                ::testing::UnitTest::GetInstance()->current_test_info()->name() +
+                ".c");
+      std::ofstream file(m_path, std::ios::binary);
+      file << contents;
+      return m_path;
+    }
+
+  private:
+    std::filesystem::path m_path;
+  };
+
+  TEST_F(MappedFileScannerTest, Empty)
+  {
+    Vypr::MappedFileScanner scanner(WriteSource(""));
+
+    EXPECT_TRUE(scanner.Finished());
+    EXPECT_EQ(scanner.Next(), Vypr::Scanner::EndOfFile);
+  }
+
+  TEST_F(MappedFileScannerTest, ScansContents)
+  {
+    Vypr::MappedFileScanner scanner(WriteSource("int\n\xC3\xA9"));
+
+    EXPECT_EQ(scanner.Next(3), "int");
+    EXPECT_EQ(scanner.Next(), '\n');
+    EXPECT_EQ(scanner.Next(2), "\xC3\xA9");
+    EXPECT_EQ(scanner.GetLine(), 2);
+    EXPECT_EQ(scanner.GetColumn(), 3);
+    EXPECT_TRUE(scanner.Finished());
+  }
+
+  TEST_F(MappedFileScannerTest, MissingFile)
+  {
+    EXPECT_THROW(Vypr::MappedFileScanner scanner(
+                     std::filesystem::temp_directory_path() /
+                     "vypr-file-that-does-not-exist.c"),
+                 std::system_error);
+  }
+
+  TEST_F(MappedFileScannerTest, FileTooLarge)
+  {
+    // Sparse, so the file takes no space on disk.
+    const std::filesystem::path &path = WriteSource("");
+    std::filesystem::resize_file(path, uint64_t(Vypr::SourceManager::MaxSize) +
+                                           1);
+
+    EXPECT_THROW(Vypr::MappedFileScanner scanner(path), std::system_error);
+  }
+} // namespace MappedFileScannerTest
@@ -0,0 +1,109 @@
+#include "Vypr/Scanner/SourceManager.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <system_error>
+
+namespace SourceManagerTest
+{
+  TEST(GetLocation, Empty)
+  {
+    Vypr::SourceManager sourceManager;
+
+    Vypr::SourceLocation location = sourceManager.GetLocation(0);
+
+    EXPECT_EQ(location.line, 1);
+    EXPECT_EQ(location.column, 1);
+  }
+
+  TEST(GetLocation, SingleLine)
+  {
+    Vypr::SourceManager sourceManager("int a;");
+
+    Vypr::SourceLocation location = sourceManager.GetLocation(4);
+
+    EXPECT_EQ(location.line, 1);
+    EXPECT_EQ(location.column, 5);
+  }
+
+  TEST(GetLocation, MultipleLines)
+  {
+    Vypr::SourceManager sourceManager("a\nbc\n\nd");
+
+    EXPECT_EQ(sourceManager.GetLocation(1).line, 1);
+    EXPECT_EQ(sourceManager.GetLocation(1).column, 2);
+    EXPECT_EQ(sourceManager.GetLocation(2).line, 2);
+    EXPECT_EQ(sourceManager.GetLocation(2).column, 1);
+    EXPECT_EQ(sourceManager.GetLocation(5).line, 3);
+    EXPECT_EQ(sourceManager.GetLocation(6).line, 4);
+    EXPECT_EQ(sourceManager.GetLocation(6).column, 1);
+  }
+
+  TEST(GetLocation, AcrossVectorBlocks)
+  {
+    std::string source;
+    for (int line = 0; line < 100; line++)
+    {
+      source += std::string(static_cast<size_t>(line % 37), 'x') + '\n';
+    }
+    Vypr::SourceManager sourceManager(source);
+
+    size_t expectedLine = 1;
+    size_t expectedColumn = 1;
+    for (size_t offset = 0; offset < source.size(); offset++)
+    {
+      Vypr::SourceLocation location =
+          sourceManager.GetLocation(static_cast<uint32_t>(offset));
+      ASSERT_EQ(location.line, expectedLine);
+      ASSERT_EQ(location.column, expectedColumn);
+
+      if (source[offset] == '\n')
+      {
+        expectedLine += 1;
+        expectedColumn = 1;
+      }
+      else
+      {
+        expectedColumn += 1;
+      }
+    }
+  }
+
+  TEST(GetLocation, PastEnd)
+  {
+    Vypr::SourceManager sourceManager("ab\nc");
+
+    Vypr::SourceLocation location =
+        sourceManager.GetLocation(Vypr::SourceManager::NoOffset);
+
+    EXPECT_EQ(location.line, 2);
+    EXPECT_EQ(location.column, 2);
+  }
+
+  TEST(Reset, DropsLineTable)
+  {
+    Vypr::SourceManager sourceManager("a\nb");
+    EXPECT_EQ(sourceManager.GetLocation(2).line, 2);
+
+    sourceManager.Reset("ab");
+
+    EXPECT_EQ(sourceManager.GetLocation(1).line, 1);
+    EXPECT_EQ(sourceManager.GetLocation(1).column, 2);
+  }
+
+  TEST(Append, TooLarge)
+  {
+    Vypr::SourceManager sourceManager;
+    std::string chunk(64 * 1024 * 1024, 'a');
+    uint64_t size = 0;
+    while (size + chunk.size() <= Vypr::SourceManager::MaxSize)
+    {
+      sourceManager.Append(chunk);
+      size += chunk.size();
+    }
+
+    EXPECT_THROW(sourceManager.Append(chunk), std::system_error);
+    EXPECT_EQ(sourceManager.GetLocation(Vypr::SourceManager::NoOffset).column,
+              size + 1);
+  }
+} // namespace SourceManagerTest
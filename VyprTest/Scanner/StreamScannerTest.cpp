@@ -0,0 +1,251 @@
+#include "Vypr/Scanner/StreamScanner.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "Vypr/Lexer/CLangLexer.hpp"
+#include "Vypr/Preprocessor/Preprocessor.hpp"
+#include "Vypr/Scanner/BufferScanner.hpp"
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#define pipe(fileDescriptors) _pipe(fileDescriptors, 4096, _O_BINARY)
+#define write _write
+#define close _close
+#else
+#include <unistd.h>
+#endif
+
+namespace StreamScannerTest
+{
+  /// @brief Pipe whose write end has been filled with a source and closed.
+  class StreamScannerTest : public ::testing::Test
+  {
+  protected:
+    void TearDown() override
+    {
+      if (m_readEnd >= 0)
+      {
+        close(m_readEnd);
+      }
+    }
+
+    int WriteSource(const std::string &contents)
+    {
+      int fileDescriptors[2];
+      EXPECT_EQ(pipe(fileDescriptors), 0);
+      EXPECT_EQ(write(fileDescriptors[1], contents.data(),
+                      static_cast<unsigned>(contents.size())),
+                static_cast<int>(contents.size()));
+      close(fileDescriptors[1]);
+      m_readEnd = fileDescriptors[0];
+      return m_readEnd;
+    }
+
+    /// @brief Lexes a source streamed in chunks of `chunkSize` characters
+    /// and checks its tokens against those lexed from a buffer.
+    void ExpectLexesLikeBuffer(const std::string &source, size_t chunkSize)
+    {
+      Vypr::CLangLexer expected(std::make_unique<Vypr::BufferScanner>(source));
+      Vypr::CLangLexer actual(std::make_unique<Vypr::StreamScanner>(
+          WriteSource(source), chunkSize));
+
+      while (true)
+      {
+        Vypr::CLangToken expectedToken = expected.GetToken();
+        Vypr::CLangToken actualToken = actual.GetToken();
+        ASSERT_EQ(actualToken.type, expectedToken.type) << chunkSize;
+        if (expectedToken.type == Vypr::CLangTokenType::IntegerConstant)
+        {
+          // Streamed sources are not kept, so constants are compared by
+          // value.
+          EXPECT_EQ(
+              actual.GetLiterals().GetNumber(actualToken.value).integer,
+              expected.GetLiterals().GetNumber(expectedToken.value).integer);
+        }
+        else if (expectedToken.type == Vypr::CLangTokenType::FloatConstant)
+        {
+          EXPECT_EQ(
+              actual.GetLiterals().GetNumber(actualToken.value).real,
+              expected.GetLiterals().GetNumber(expectedToken.value).real);
+        }
+        else
+        {
+          EXPECT_EQ(actual.GetSpelling(actualToken),
+                    expected.GetSpelling(expectedToken))
+              << chunkSize;
+        }
+        EXPECT_EQ(actualToken.offset, expectedToken.offset) << chunkSize;
+        EXPECT_EQ(actualToken.length, expectedToken.length) << chunkSize;
+        EXPECT_EQ(actualToken.flags, expectedToken.flags) << chunkSize;
+        if (expectedToken.type == Vypr::CLangTokenType::NoToken)
+        {
+          break;
+        }
+      }
+
+      // Each call pipes a new source, so the previous read end is closed.
+      close(m_readEnd);
+      m_readEnd = -1;
+    }
+
+  private:
+    int m_readEnd = -1;
+  };
+
+  TEST_F(StreamScannerTest, Empty)
+  {
+    Vypr::StreamScanner scanner(WriteSource(""), 4);
+
+    EXPECT_TRUE(scanner.Finished());
+    EXPECT_EQ(scanner.Next(), Vypr::Scanner::EndOfFile);
+    EXPECT_EQ(scanner.LookAhead(0, 4), "");
+  }
+
+  TEST_F(StreamScannerTest, AcrossChunks)
+  {
+    Vypr::StreamScanner scanner(WriteSource("abcdefghij"), 4);
+
+    EXPECT_EQ(scanner.Next(3), "abc");
+    EXPECT_EQ(scanner.LookAhead(0, 4), "defg");
+    EXPECT_EQ(scanner.LookAhead(6), 'j');
+    EXPECT_EQ(scanner.LookAhead(7), Vypr::Scanner::EndOfFile);
+    EXPECT_TRUE(scanner.Matches("defghij"));
+    EXPECT_EQ(scanner.GetOffset(), 3U);
+    EXPECT_EQ(scanner.Next(10), "defghij");
+    EXPECT_EQ(scanner.GetOffset(), 10U);
+    EXPECT_TRUE(scanner.Finished());
+  }
+
+  TEST_F(StreamScannerTest, RunLongerThanChunk)
+  {
+    Vypr::StreamScanner scanner(WriteSource("  identifier_longer_than_chunk+"),
+                                4);
+
+    scanner.SkipWhitespace();
+    EXPECT_EQ(scanner.NextIdentifierRun(), "identifier_longer_than_chunk");
+    EXPECT_EQ(scanner.NextWhile([](char c) { return c == '+'; }), "+");
+    EXPECT_TRUE(scanner.Finished());
+  }
+
+  TEST_F(StreamScannerTest, StringRunLongerThanChunk)
+  {
+    Vypr::StreamScanner scanner(WriteSource("\"string longer than chunk\"+"),
+                                4);
+
+    scanner.Next();
+    EXPECT_EQ(scanner.NextStringRun(), "string longer than chunk");
+    EXPECT_EQ(scanner.Next(), '"');
+    EXPECT_EQ(scanner.Next(), '+');
+  }
+
+  TEST_F(StreamScannerTest, SkipsAcrossChunks)
+  {
+    Vypr::StreamScanner scanner(WriteSource("a comment *** here */b\nc"), 4);
+
+    scanner.Next();
+    EXPECT_TRUE(scanner.SkipBlockComment());
+    EXPECT_EQ(scanner.Next(), 'b');
+    scanner.SkipLine();
+    EXPECT_EQ(scanner.Next(), '\n');
+    EXPECT_EQ(scanner.Next(), 'c');
+  }
+
+  TEST_F(StreamScannerTest, SplitCommentTerminator)
+  {
+    Vypr::StreamScanner scanner(WriteSource("abc*/d"), 4);
+
+    EXPECT_TRUE(scanner.SkipBlockComment());
+    EXPECT_EQ(scanner.Next(), 'd');
+  }
+
+  TEST_F(StreamScannerTest, UnterminatedComment)
+  {
+    Vypr::StreamScanner scanner(WriteSource("abcdef*"), 4);
+
+    EXPECT_FALSE(scanner.SkipBlockComment());
+    EXPECT_TRUE(scanner.Finished());
+  }
+
+  TEST_F(StreamScannerTest, Locations)
+  {
+    Vypr::StreamScanner scanner(WriteSource("ab\ncdef\n\ngh"), 4);
+
+    scanner.Next(10);
+    EXPECT_EQ(scanner.GetLine(), 4);
+    EXPECT_EQ(scanner.GetColumn(), 2);
+    EXPECT_EQ(scanner.GetSourceManager().GetLocation(4).line, 2);
+    EXPECT_EQ(scanner.GetSourceManager().GetLocation(4).column, 2);
+  }
+
+  TEST_F(StreamScannerTest, MarkKeepsCharacters)
+  {
+    Vypr::StreamScanner scanner(WriteSource("abcdefghijklmnop"), 4);
+
+    scanner.Next(2);
+    Vypr::ScannerMark outer = scanner.Mark();
+    scanner.Next(4);
+    Vypr::ScannerMark inner = scanner.Mark();
+    EXPECT_EQ(scanner.Next(7), "ghijklm");
+    scanner.Reset(inner);
+    scanner.Release(inner);
+    EXPECT_EQ(scanner.Next(3), "ghi");
+    scanner.Reset(outer);
+    scanner.Release(outer);
+
+    EXPECT_EQ(scanner.GetOffset(), 2U);
+    EXPECT_EQ(scanner.Next(14), "cdefghijklmnop");
+    EXPECT_TRUE(scanner.Finished());
+  }
+
+  TEST_F(StreamScannerTest, LexesLikeBuffer)
+  {
+    const std::string source =
+        "int main(void)\n{\n  /* block\n comment */ return 0x1F + 'a'"
+        " >>= very_long_identifier_name; // line\n  \"string \\n\" 1.5e3f;\n"
+        "  abc\\\n d abc\\\nd in\\\nt Rb\\u88da x\\U0001F600y;\n"
+        "  /* spliced *\\\n/ e;\n}";
+
+    for (size_t chunkSize : {1, 2, 4, 7})
+    {
+      ExpectLexesLikeBuffer(source, chunkSize);
+    }
+  }
+
+  TEST_F(StreamScannerTest, LexesSpliceAcrossChunks)
+  {
+    // The pipe holds the whole source, so it stays below the pipe's buffer.
+    constexpr size_t ChunkSize = 4096;
+    std::string source(ChunkSize - 4, ' ');
+    source += "abc\\\n d abc\\\nd";
+
+    ExpectLexesLikeBuffer(source, ChunkSize);
+  }
+
+  TEST_F(StreamScannerTest, PreprocessesStreamedSource)
+  {
+    Vypr::CLangLexer lexer(std::make_unique<Vypr::StreamScanner>(
+        WriteSource("#define TWICE(x) \\\n  x + x\n"
+                    "#if defined TWICE\nint a = TWICE(1);\n#endif\n"),
+        4));
+    Vypr::PreprocessorOptions options;
+    options.sourcePath = "stdin.c";
+
+    lexer.StartPreprocessor(options);
+
+    std::string spelled;
+    for (Vypr::CLangToken token = lexer.GetToken();
+         token.type != Vypr::CLangTokenType::NoToken;
+         token = lexer.GetToken())
+    {
+      // Expanded constants are relocated, so they are spelled by value.
+      spelled += token.type == Vypr::CLangTokenType::IntegerConstant
+                     ? std::to_string(
+                           lexer.GetLiterals().GetNumber(token.value).integer)
+                     : std::string(lexer.GetSpelling(token));
+    }
+    EXPECT_EQ(spelled, "inta=1+1;");
+    EXPECT_EQ(lexer.GetDiagnostics().GetCount(), 0U);
+  }
+} // namespace StreamScannerTest
@@ -9,9 +9,9 @@ namespace StringScannerTest
     std::unique_ptr<Vypr::Scanner> scanner =
         std::make_unique<Vypr::StringScanner>();
 
-    wchar_t result = scanner->Next();
+    char result = scanner->Next();
 
-    EXPECT_EQ(result, std::char_traits<wchar_t>::eof());
+    EXPECT_EQ(result, Vypr::Scanner::EndOfFile);
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 1);
   }
@@ -19,11 +19,11 @@ namespace StringScannerTest
   TEST(Next, OneCharacter)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"a");
+        std::make_unique<Vypr::StringScanner>("a");
 
-    wchar_t result = scanner->Next();
+    char result = scanner->Next();
 
-    EXPECT_EQ(result, L'a');
+    EXPECT_EQ(result, 'a');
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 2);
   }
@@ -31,15 +31,15 @@ namespace StringScannerTest
   TEST(Next, MultipleCharacters)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"abcde");
+        std::make_unique<Vypr::StringScanner>("abcde");
 
-    wchar_t result1 = scanner->Next();
-    wchar_t result2 = scanner->Next();
-    wchar_t result3 = scanner->Next();
+    char result1 = scanner->Next();
+    char result2 = scanner->Next();
+    char result3 = scanner->Next();
 
-    EXPECT_EQ(result1, L'a');
-    EXPECT_EQ(result2, L'b');
-    EXPECT_EQ(result3, L'c');
+    EXPECT_EQ(result1, 'a');
+    EXPECT_EQ(result2, 'b');
+    EXPECT_EQ(result3, 'c');
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 4);
   }
@@ -47,13 +47,13 @@ namespace StringScannerTest
   TEST(Next, ToEnd)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"a");
+        std::make_unique<Vypr::StringScanner>("a");
 
-    wchar_t result = scanner->Next();
-    wchar_t eofResult = scanner->Next();
+    char result = scanner->Next();
+    char eofResult = scanner->Next();
 
-    EXPECT_EQ(result, L'a');
-    EXPECT_EQ(eofResult, std::char_traits<wchar_t>::eof());
+    EXPECT_EQ(result, 'a');
+    EXPECT_EQ(eofResult, Vypr::Scanner::EndOfFile);
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 2);
   }
@@ -61,13 +61,13 @@ namespace StringScannerTest
   TEST(Next, NextLine)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"a\na");
+        std::make_unique<Vypr::StringScanner>("a\na");
 
-    wchar_t result1 = scanner->Next();
-    wchar_t result2 = scanner->Next();
+    char result1 = scanner->Next();
+    char result2 = scanner->Next();
 
-    EXPECT_EQ(result1, L'a');
-    EXPECT_EQ(result2, L'\n');
+    EXPECT_EQ(result1, 'a');
+    EXPECT_EQ(result2, '\n');
     EXPECT_EQ(scanner->GetLine(), 2);
     EXPECT_EQ(scanner->GetColumn(), 1);
   }
@@ -77,9 +77,9 @@ namespace StringScannerTest
     std::unique_ptr<Vypr::Scanner> scanner =
         std::make_unique<Vypr::StringScanner>();
 
-    wchar_t result = scanner->LookAhead(0);
+    char result = scanner->LookAhead(0);
 
-    EXPECT_EQ(result, std::char_traits<wchar_t>::eof());
+    EXPECT_EQ(result, Vypr::Scanner::EndOfFile);
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 1);
   }
@@ -87,11 +87,11 @@ namespace StringScannerTest
   TEST(LookAhead, OneCharacter)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"a");
+        std::make_unique<Vypr::StringScanner>("a");
 
-    wchar_t result = scanner->LookAhead(0);
+    char result = scanner->LookAhead(0);
 
-    EXPECT_EQ(result, L'a');
+    EXPECT_EQ(result, 'a');
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 1);
   }
@@ -99,11 +99,11 @@ namespace StringScannerTest
   TEST(LookAhead, MultipleCharacters)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"abcde");
+        std::make_unique<Vypr::StringScanner>("abcde");
 
-    wchar_t result = scanner->LookAhead(2);
+    char result = scanner->LookAhead(2);
 
-    EXPECT_EQ(result, L'c');
+    EXPECT_EQ(result, 'c');
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 1);
   }
@@ -111,11 +111,11 @@ namespace StringScannerTest
   TEST(LookAhead, ToEnd)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"a");
+        std::make_unique<Vypr::StringScanner>("a");
 
-    wchar_t result = scanner->LookAhead(5);
+    char result = scanner->LookAhead(5);
 
-    EXPECT_EQ(result, std::char_traits<wchar_t>::eof());
+    EXPECT_EQ(result, Vypr::Scanner::EndOfFile);
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 1);
   }
@@ -130,14 +130,14 @@ namespace StringScannerTest
   TEST(Finished, ManyCharactersFalse)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"abc");
+        std::make_unique<Vypr::StringScanner>("abc");
     EXPECT_TRUE(!scanner->Finished());
   }
 
   TEST(Finished, ManyCharactersTrue)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"abc");
+        std::make_unique<Vypr::StringScanner>("abc");
     scanner->Next();
     scanner->Next();
     scanner->Next();
@@ -149,7 +149,7 @@ namespace StringScannerTest
     std::unique_ptr<Vypr::Scanner> scanner =
         std::make_unique<Vypr::StringScanner>();
 
-    std::wstring result = scanner->NextWhile([](wchar_t c) { return true; });
+    std::string_view result = scanner->NextWhile([](char) { return true; });
 
     EXPECT_TRUE(result.empty());
     EXPECT_EQ(scanner->GetLine(), 1);
@@ -159,12 +159,12 @@ namespace StringScannerTest
   TEST(NextWhile, MultipleCharacters)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"aaab");
+        std::make_unique<Vypr::StringScanner>("aaab");
 
-    std::wstring result =
-        scanner->NextWhile([](wchar_t c) { return c == 'a'; });
+    std::string_view result =
+        scanner->NextWhile([](char c) { return c == 'a'; });
 
-    EXPECT_EQ(result, L"aaa");
+    EXPECT_EQ(result, "aaa");
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 4);
   }
@@ -172,12 +172,12 @@ namespace StringScannerTest
   TEST(NextWhile, ToEnd)
   {
     std::unique_ptr<Vypr::Scanner> scanner =
-        std::make_unique<Vypr::StringScanner>(L"aa");
+        std::make_unique<Vypr::StringScanner>("aa");
 
-    std::wstring result =
-        scanner->NextWhile([](wchar_t c) { return c == 'a'; });
+    std::string_view result =
+        scanner->NextWhile([](char c) { return c == 'a'; });
 
-    EXPECT_EQ(result, L"aa");
+    EXPECT_EQ(result, "aa");
     EXPECT_EQ(scanner->GetLine(), 1);
     EXPECT_EQ(scanner->GetColumn(), 3);
   }
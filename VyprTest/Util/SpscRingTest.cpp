@@ -0,0 +1,67 @@
+#include "Vypr/Util/SpscRing.hpp"
+
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+
+namespace SpscRingTest
+{
+  TEST(SpscRing, RoundsCapacity)
+  {
+    Vypr::SpscRing<int> ring(5);
+
+    EXPECT_EQ(ring.GetCapacity(), 8U);
+  }
+
+  TEST(SpscRing, FullAndEmpty)
+  {
+    Vypr::SpscRing<int> ring(4);
+    int value = 0;
+
+    EXPECT_FALSE(ring.TryPop(value));
+    for (int i = 0; i < 4; i++)
+    {
+      value = i;
+      EXPECT_TRUE(ring.TryPush(value));
+    }
+    value = 4;
+    EXPECT_FALSE(ring.TryPush(value));
+    EXPECT_EQ(value, 4);
+
+    for (int i = 0; i < 4; i++)
+    {
+      ASSERT_TRUE(ring.TryPop(value));
+      EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.TryPop(value));
+  }
+
+  TEST(SpscRing, WrapsAround)
+  {
+    Vypr::SpscRing<std::unique_ptr<int>> ring(2);
+
+    for (int i = 0; i < 10; i++)
+    {
+      ring.Push(std::make_unique<int>(i));
+      EXPECT_EQ(*ring.Pop(), i);
+    }
+  }
+
+  TEST(SpscRing, AcrossThreads)
+  {
+    constexpr int Count = 100000;
+    Vypr::SpscRing<int> ring(16);
+
+    std::jthread producer([&ring]() {
+      for (int i = 0; i < Count; i++)
+      {
+        ring.Push(i);
+      }
+    });
+
+    for (int i = 0; i < Count; i++)
+    {
+      EXPECT_EQ(ring.Pop(), i);
+    }
+  }
+} // namespace SpscRingTest